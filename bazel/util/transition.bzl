@@ -167,3 +167,23 @@ extra_copts_for_all_deps = declare_transtion(
         "//command_line_option:copt": "extra_copts",
     },
 )
+
+# This transition sets the pico_float and pico_double implementations, so that
+# one binary can be built per implementation (e.g. for pico_float_bench).
+pico_float_impl_binary = declare_transtion(
+    attrs = {
+        "float_impl": attr.string(mandatory = True),
+        "double_impl": attr.string(default = "auto"),
+        "pico_printf_impl": attr.string(default = "pico"),
+        # This could be shared, but we don't in order to make it clearer that
+        # a transition is in use.
+        "_allowlist_function_transition": attr.label(
+            default = "@bazel_tools//tools/allowlists/function_transition_allowlist",
+        ),
+    },
+    flag_overrides = {
+        "@pico-sdk//bazel/config:PICO_DEFAULT_FLOAT_IMPL": "float_impl",
+        "@pico-sdk//bazel/config:PICO_DEFAULT_DOUBLE_IMPL": "double_impl",
+        "@pico-sdk//bazel/config:PICO_DEFAULT_PRINTF_IMPL": "pico_printf_impl",
+    },
+)
@@ -58,10 +58,21 @@
  * \cond pico_aon_timer \defgroup pico_aon_timer pico_aon_timer \endcond
  * \cond pico_async_context \defgroup pico_async_context pico_async_context \endcond
  * \cond pico_bootsel_via_double_reset \defgroup pico_bootsel_via_double_reset pico_bootsel_via_double_reset \endcond
+ * \cond pico_dma_crc \defgroup pico_dma_crc pico_dma_crc \endcond
+ * \cond pico_dma_stream \defgroup pico_dma_stream pico_dma_stream \endcond
  * \cond pico_fix \defgroup pico_fix pico_fix \endcond
  * \cond pico_flash \defgroup pico_flash pico_flash \endcond
+ * \cond pico_flash_page_buffer \defgroup pico_flash_page_buffer pico_flash_page_buffer \endcond
+ * \cond pico_flash_stream \defgroup pico_flash_stream pico_flash_stream \endcond
+ * \cond pico_hmac_sha256 \defgroup pico_hmac_sha256 pico_hmac_sha256 \endcond
  * \cond pico_i2c_slave \defgroup pico_i2c_slave pico_i2c_slave \endcond
+ * \cond pico_kvstore \defgroup pico_kvstore pico_kvstore \endcond
+ * \cond pico_math_array \defgroup pico_math_array pico_math_array \endcond
  * \cond pico_multicore \defgroup pico_multicore pico_multicore \endcond
+ * \cond pico_pio_blob \defgroup pico_pio_blob pico_pio_blob \endcond
+ * \cond pico_pio_buffer \defgroup pico_pio_buffer pico_pio_buffer \endcond
+ * \cond pico_pio_stats \defgroup pico_pio_stats pico_pio_stats \endcond
+ * \cond pico_prng \defgroup pico_prng pico_prng \endcond
  * \cond pico_rand \defgroup pico_rand pico_rand \endcond
  * \cond pico_sha256 \defgroup pico_sha256 pico_sha256 \endcond
  * \cond pico_status_led \defgroup pico_status_led pico_status_led \endcond
@@ -69,6 +80,7 @@
  * \cond pico_sync \defgroup pico_sync pico_sync \endcond
  * \cond pico_time \defgroup pico_time pico_time \endcond
  * \cond pico_unique_id \defgroup pico_unique_id pico_unique_id \endcond
+ * \cond pico_xip_profile \defgroup pico_xip_profile pico_xip_profile \endcond
  * \cond pico_util \defgroup pico_util pico_util \endcond
  * @}
  *
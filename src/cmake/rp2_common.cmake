@@ -19,12 +19,20 @@ if (NOT PICO_BARE_METAL)
     pico_add_subdirectory(common/pico_bit_ops_headers)
     pico_add_subdirectory(common/pico_binary_info)
     pico_add_subdirectory(common/pico_divider_headers)
+    pico_add_subdirectory(common/pico_dma_crc)
+    pico_add_subdirectory(common/pico_flash_page_buffer)
+    pico_add_subdirectory(common/pico_hmac_sha256)
+    pico_add_subdirectory(common/pico_kvstore)
+    pico_add_subdirectory(common/pico_math_array)
+    pico_add_subdirectory(common/pico_prng)
+    pico_add_subdirectory(common/pico_sha256)
     pico_add_subdirectory(common/pico_sync)
     pico_add_subdirectory(common/pico_time)
     pico_add_subdirectory(common/pico_util)
     pico_add_subdirectory(common/pico_stdlib_headers)
 endif()
 pico_add_subdirectory(common/hardware_claim)
+pico_add_subdirectory(common/hardware_pio_alloc)
 #
 # RP2040/RP2350 specific From standard build variants
 pico_add_subdirectory(${RP2_VARIANT_DIR}/pico_platform)
@@ -95,23 +103,25 @@ if (NOT PICO_BARE_METAL)
     pico_add_subdirectory(rp2_common/pico_bootsel_via_double_reset)
     pico_add_subdirectory(rp2_common/pico_multicore)
     pico_add_subdirectory(rp2_common/pico_unique_id)
+    pico_add_subdirectory(rp2_common/pico_xip_profile)
 
     pico_add_subdirectory(rp2_common/pico_atomic)
     pico_add_subdirectory(rp2_common/pico_bit_ops)
     pico_add_subdirectory(rp2_common/pico_divider)
+    pico_add_subdirectory(rp2_common/pico_dma_stream)
     pico_add_subdirectory(rp2_common/pico_double)
     pico_add_subdirectory(rp2_common/pico_int64_ops)
     pico_add_subdirectory(rp2_common/pico_flash)
+    pico_add_subdirectory(rp2_common/pico_flash_stream)
     pico_add_subdirectory(rp2_common/pico_float)
     pico_add_subdirectory(rp2_common/pico_mem_ops)
     pico_add_subdirectory(rp2_common/pico_malloc)
+    pico_add_subdirectory(rp2_common/pico_pio_blob)
+    pico_add_subdirectory(rp2_common/pico_pio_buffer)
+    pico_add_subdirectory(rp2_common/pico_pio_stats)
     pico_add_subdirectory(rp2_common/pico_printf)
     pico_add_subdirectory(rp2_common/pico_rand)
 
-    if (PICO_COMBINED_DOCS OR NOT PICO_RP2040)
-        pico_add_subdirectory(rp2_common/pico_sha256)
-    endif()
-
     pico_add_subdirectory(rp2_common/pico_stdio_semihosting)
     pico_add_subdirectory(rp2_common/pico_stdio_uart)
     pico_add_subdirectory(rp2_common/pico_stdio_rtt)
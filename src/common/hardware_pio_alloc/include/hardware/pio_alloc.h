@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _HARDWARE_PIO_ALLOC_H
+#define _HARDWARE_PIO_ALLOC_H
+
+#include "pico.h"
+
+/** \file hardware/pio_alloc.h
+ *  \ingroup hardware_pio
+ *
+ * \brief PIO instruction memory placement
+ *
+ * These functions decide where programs are placed in a PIO instance's 32 instruction slots, and where
+ * they move to when the instruction memory is compacted. They only deal with masks of used slots and
+ * program lengths, not the hardware itself; they are used by \ref pio_add_program and
+ * \ref pio_compact_programs, and are separate so that they can also be tested on the host.
+ */
+
+// PICO_CONFIG: PICO_PIO_BEST_FIT_PLACEMENT, Place PIO programs in the smallest free gap in instruction memory which will hold them, rather than the highest, type=bool, default=0, group=hardware_pio
+#ifndef PICO_PIO_BEST_FIT_PLACEMENT
+#define PICO_PIO_BEST_FIT_PLACEMENT 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PIO_ALLOC_INSTRUCTION_COUNT 32u
+
+/*! \brief Find an offset in instruction memory for a program
+ *  \ingroup hardware_pio
+ *
+ * \param used_mask bit n is set if instruction slot n is in use
+ * \param length the program length
+ * \param origin the offset the program must be loaded at, or -1 if it can go anywhere
+ * \param best_fit if true, use the smallest free gap which can hold the program (the highest, if there are
+ * several the same size); if false, use the highest free position. Either way the program is placed at the
+ * top of the chosen gap
+ * \return the offset, or PICO_ERROR_INSUFFICIENT_RESOURCES if there is no room, or PICO_ERROR_GENERIC if
+ * the program's origin is not available
+ */
+int pio_alloc_find_offset(uint32_t used_mask, uint length, int origin, bool best_fit);
+
+/*! \brief Work out where programs should move to in order to compact instruction memory
+ *  \ingroup hardware_pio
+ *
+ * Programs which aren't fixed slide up towards the next fixed program (or the top of instruction memory)
+ * above them, keeping their order, so that the free space between each pair of fixed programs ends up in
+ * one gap at the bottom. Programs only ever move up.
+ *
+ * \param lengths the length of the program starting at each offset, or 0 if none starts there
+ * \param fixed_mask bit n is set if the program starting at offset n must not move
+ * \param new_offsets set to the new offset of the program starting at each offset (and to the offset itself
+ * where no program starts)
+ * \return the number of programs which move
+ */
+uint pio_alloc_plan_compaction(const uint8_t lengths[PIO_ALLOC_INSTRUCTION_COUNT], uint32_t fixed_mask,
+                               uint8_t new_offsets[PIO_ALLOC_INSTRUCTION_COUNT]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "hardware/pio_alloc.h"
+
+static inline uint32_t length_mask(uint length) {
+    return length >= 32 ? ~0u : (1u << length) - 1;
+}
+
+int pio_alloc_find_offset(uint32_t used_mask, uint length, int origin, bool best_fit) {
+    if (!length || length > PIO_ALLOC_INSTRUCTION_COUNT) return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    uint32_t program_mask = length_mask(length);
+    if (origin >= 0) {
+        if (origin > (int)(PIO_ALLOC_INSTRUCTION_COUNT - length)) return PICO_ERROR_GENERIC;
+        return used_mask & (program_mask << origin) ? PICO_ERROR_GENERIC : origin;
+    }
+    int best = PICO_ERROR_INSUFFICIENT_RESOURCES;
+    uint best_gap = PIO_ALLOC_INSTRUCTION_COUNT + 1;
+    // walk the free gaps from the top down
+    int top = PIO_ALLOC_INSTRUCTION_COUNT;
+    while (top > 0) {
+        while (top > 0 && (used_mask & (1u << (top - 1)))) top--;
+        int bottom = top;
+        while (bottom > 0 && !(used_mask & (1u << (bottom - 1)))) bottom--;
+        uint gap = (uint)(top - bottom);
+        if (gap >= length) {
+            if (!best_fit) return top - (int)length;
+            if (gap < best_gap) {
+                best_gap = gap;
+                best = top - (int)length;
+            }
+        }
+        top = bottom;
+    }
+    return best;
+}
+
+uint pio_alloc_plan_compaction(const uint8_t lengths[PIO_ALLOC_INSTRUCTION_COUNT], uint32_t fixed_mask,
+                               uint8_t new_offsets[PIO_ALLOC_INSTRUCTION_COUNT]) {
+    uint moved = 0;
+    // everything at or above 'limit' has been placed
+    uint limit = PIO_ALLOC_INSTRUCTION_COUNT;
+    for (uint offset = PIO_ALLOC_INSTRUCTION_COUNT; offset--; ) {
+        new_offsets[offset] = (uint8_t)offset;
+        if (!lengths[offset]) continue;
+        if (!(fixed_mask & (1u << offset))) {
+            // programs don't overlap, so the space between the end of this one and the limit is free
+            new_offsets[offset] = (uint8_t)(limit - lengths[offset]);
+            if (new_offsets[offset] != offset) moved++;
+        }
+        limit = new_offsets[offset];
+    }
+    return moved;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pico/dma_crc.h"
+
+#if !PICO_NO_HARDWARE
+#include "hardware/dma.h"
+#include "hardware/claim.h"
+#endif
+
+// CRC-32 (reflected polynomial 0xedb88320) a nibble at a time, to keep the table small
+static const uint32_t crc32_nibble_table[16] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+    0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+};
+
+// CRC-16-CCITT (polynomial 0x1021) a nibble at a time
+static const uint16_t crc16_ccitt_nibble_table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50a5, 0x60c6, 0x70e7,
+    0x8108, 0x9129, 0xa14a, 0xb16b, 0xc18c, 0xd1ad, 0xe1ce, 0xf1ef,
+};
+
+uint32_t dma_crc32_sw(uint32_t crc, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        crc = (crc >> 4) ^ crc32_nibble_table[crc & 0xfu];
+        crc = (crc >> 4) ^ crc32_nibble_table[crc & 0xfu];
+    }
+    return ~crc;
+}
+
+uint16_t dma_crc16_ccitt_sw(uint16_t crc, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    while (len--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        crc = (uint16_t)((crc << 4) ^ crc16_ccitt_nibble_table[crc >> 12]);
+        crc = (uint16_t)((crc << 4) ^ crc16_ccitt_nibble_table[crc >> 12]);
+    }
+    return crc;
+}
+
+uint32_t dma_sum32_sw(uint32_t sum, const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    while (len--) {
+        sum += *p++;
+    }
+    return sum;
+}
+
+#if !PICO_NO_HARDWARE
+static bool sniffer_claimed;
+
+static bool sniffer_try_claim(void) {
+    uint32_t save = hw_claim_lock();
+    bool claimed = !sniffer_claimed;
+    sniffer_claimed = true;
+    hw_claim_unlock(save);
+    return claimed;
+}
+
+static uint32_t bit_reverse32(uint32_t x) {
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+    return __builtin_bswap32(x);
+}
+
+bool dma_crc_sniff_start(uint channel, dma_crc_type_t type, uint32_t initial) {
+    if (!sniffer_try_claim()) return false;
+    uint32_t seed;
+    switch (type) {
+        case DMA_CRC_TYPE_CRC32:
+            // The sniffer's CRC-32 is not reflected, but feeding it bit-reversed data and reversing (and inverting)
+            // the output gives the standard reflected CRC-32, whose internal state is the bit reverse of ours
+            dma_sniffer_enable(channel, DMA_SNIFF_CTRL_CALC_VALUE_CRC32R, true);
+            dma_sniffer_set_output_reverse_enabled(true);
+            dma_sniffer_set_output_invert_enabled(true);
+            seed = bit_reverse32(~initial);
+            break;
+        case DMA_CRC_TYPE_CRC16_CCITT:
+            dma_sniffer_enable(channel, DMA_SNIFF_CTRL_CALC_VALUE_CRC16, true);
+            seed = initial & 0xffffu;
+            break;
+        default:
+            dma_sniffer_enable(channel, DMA_SNIFF_CTRL_CALC_VALUE_SUM, true);
+            seed = initial;
+            break;
+    }
+    dma_sniffer_set_data_accumulator(seed);
+    return true;
+}
+
+uint32_t dma_crc_sniff_finish(dma_crc_type_t type) {
+    uint32_t result = dma_sniffer_get_data_accumulator();
+    if (type == DMA_CRC_TYPE_CRC16_CCITT) result &= 0xffffu;
+    dma_sniffer_disable();
+    __compiler_memory_barrier();
+    sniffer_claimed = false;
+    return result;
+}
+
+// returns false if the sniffer or a DMA channel was unavailable, in which case the caller should fall back to software
+static bool dma_crc_compute(dma_crc_type_t type, uint32_t initial, const void *data, size_t len, uint32_t *result) {
+    if (len < PICO_DMA_CRC_MIN_DMA_LENGTH) return false;
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) return false;
+    dma_channel_config_t c = dma_channel_get_default_config((uint)channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_sniff_enable(&c, true);
+    dma_channel_set_config((uint)channel, &c, false);
+    if (!dma_crc_sniff_start((uint)channel, type, initial)) {
+        dma_channel_unclaim((uint)channel);
+        return false;
+    }
+    // the data is only read; the writes all go to a dummy word
+    static uint32_t sink;
+    dma_channel_set_write_addr((uint)channel, &sink, false);
+    const uint8_t *p = (const uint8_t *)data;
+    while (len) {
+        // transfer count is limited to 28 bits on RP2350
+        size_t chunk = MIN(len, 0x0fffffffu);
+        dma_channel_set_read_addr((uint)channel, p, false);
+        dma_channel_set_transfer_count((uint)channel, dma_encode_transfer_count((uint)chunk), true);
+        dma_channel_wait_for_finish_blocking((uint)channel);
+        p += chunk;
+        len -= chunk;
+    }
+    *result = dma_crc_sniff_finish(type);
+    dma_channel_cleanup((uint)channel);
+    dma_channel_unclaim((uint)channel);
+    return true;
+}
+#else
+static bool dma_crc_compute(__unused dma_crc_type_t type, __unused uint32_t initial, __unused const void *data,
+                            __unused size_t len, __unused uint32_t *result) {
+    return false;
+}
+#endif
+
+uint32_t dma_crc32(uint32_t crc, const void *data, size_t len) {
+    uint32_t result;
+    if (dma_crc_compute(DMA_CRC_TYPE_CRC32, crc, data, len, &result)) return result;
+    return dma_crc32_sw(crc, data, len);
+}
+
+uint16_t dma_crc16_ccitt(uint16_t crc, const void *data, size_t len) {
+    uint32_t result;
+    if (dma_crc_compute(DMA_CRC_TYPE_CRC16_CCITT, crc, data, len, &result)) return (uint16_t)result;
+    return dma_crc16_ccitt_sw(crc, data, len);
+}
+
+uint32_t dma_sum32(uint32_t sum, const void *data, size_t len) {
+    uint32_t result;
+    if (dma_crc_compute(DMA_CRC_TYPE_SUM32, sum, data, len, &result)) return result;
+    return dma_sum32_sw(sum, data, len);
+}
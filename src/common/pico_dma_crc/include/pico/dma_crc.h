@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_DMA_CRC_H
+#define _PICO_DMA_CRC_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \file pico/dma_crc.h
+ *  \defgroup pico_dma_crc pico_dma_crc
+ *
+ * \brief Checksums computed by the DMA sniffer
+ *
+ * The DMA block contains a "sniffer" which can calculate a CRC-32, CRC-16-CCITT or simple sum over
+ * the data passing through one DMA channel. This library uses it to checksum memory (including flash via XIP)
+ * at DMA speed, or to checksum data as a side effect of a transfer the application is already doing.
+ *
+ * There is only one sniffer; if it (or a DMA channel) is unavailable, or the buffer is too small to be worth
+ * setting up a transfer for, the checksum is calculated in software instead. The software implementations
+ * are also available directly, and are used on platforms without the DMA hardware (e.g. PICO_PLATFORM=host),
+ * so results can be verified against the same test vectors everywhere.
+ *
+ * The checksums are:
+ *
+ * Type | Algorithm
+ * -----|----------
+ * \ref DMA_CRC_TYPE_CRC32 | CRC-32 (IEEE 802.3), as used by zlib, Ethernet, PNG etc.
+ * \ref DMA_CRC_TYPE_CRC16_CCITT | CRC-16-CCITT, polynomial 0x1021, not reflected, no final XOR (a.k.a CRC-16/CCITT-FALSE when started from 0xffff)
+ * \ref DMA_CRC_TYPE_SUM32 | 32-bit sum of the bytes
+ *
+ * Each function takes the value returned for the preceding data, so a checksum can be computed piecewise.
+ */
+
+// PICO_CONFIG: PICO_DMA_CRC_MIN_DMA_LENGTH, Minimum buffer length in bytes for which the DMA sniffer is used rather than the software implementation, type=int, default=64, group=pico_dma_crc
+#ifndef PICO_DMA_CRC_MIN_DMA_LENGTH
+#define PICO_DMA_CRC_MIN_DMA_LENGTH 64
+#endif
+
+/*! \brief Initial value for a CRC-32
+ *  \ingroup pico_dma_crc
+ */
+#define DMA_CRC32_INIT 0u
+
+/*! \brief Initial value for a CRC-16-CCITT (giving CRC-16/CCITT-FALSE)
+ *  \ingroup pico_dma_crc
+ */
+#define DMA_CRC16_CCITT_INIT 0xffffu
+
+/*! \brief Initial value for a 32-bit sum
+ *  \ingroup pico_dma_crc
+ */
+#define DMA_SUM32_INIT 0u
+
+/*! \brief Checksum types supported by the DMA sniffer
+ *  \ingroup pico_dma_crc
+ */
+typedef enum {
+    DMA_CRC_TYPE_CRC32,       ///< CRC-32 (IEEE 802.3)
+    DMA_CRC_TYPE_CRC16_CCITT, ///< CRC-16-CCITT
+    DMA_CRC_TYPE_SUM32,       ///< 32-bit sum of the bytes
+} dma_crc_type_t;
+
+/*! \brief Calculate a CRC-32 over a buffer
+ *  \ingroup pico_dma_crc
+ *
+ * \param crc the CRC-32 of any preceding data, or \ref DMA_CRC32_INIT
+ * \param data the data
+ * \param len the length of the data in bytes
+ * \return the CRC-32 of the preceding data followed by this data
+ */
+uint32_t dma_crc32(uint32_t crc, const void *data, size_t len);
+
+/*! \brief Calculate a CRC-16-CCITT over a buffer
+ *  \ingroup pico_dma_crc
+ *
+ * \param crc the CRC of any preceding data, or \ref DMA_CRC16_CCITT_INIT
+ * \param data the data
+ * \param len the length of the data in bytes
+ * \return the CRC of the preceding data followed by this data
+ */
+uint16_t dma_crc16_ccitt(uint16_t crc, const void *data, size_t len);
+
+/*! \brief Calculate a 32-bit sum of the bytes in a buffer
+ *  \ingroup pico_dma_crc
+ *
+ * \param sum the sum of any preceding data, or \ref DMA_SUM32_INIT
+ * \param data the data
+ * \param len the length of the data in bytes
+ * \return the sum of the preceding data and this data
+ */
+uint32_t dma_sum32(uint32_t sum, const void *data, size_t len);
+
+/*! \brief Calculate a CRC-32 over a buffer in software
+ *  \ingroup pico_dma_crc
+ *
+ * \see dma_crc32
+ */
+uint32_t dma_crc32_sw(uint32_t crc, const void *data, size_t len);
+
+/*! \brief Calculate a CRC-16-CCITT over a buffer in software
+ *  \ingroup pico_dma_crc
+ *
+ * \see dma_crc16_ccitt
+ */
+uint16_t dma_crc16_ccitt_sw(uint16_t crc, const void *data, size_t len);
+
+/*! \brief Calculate a 32-bit sum of the bytes in a buffer in software
+ *  \ingroup pico_dma_crc
+ *
+ * \see dma_sum32
+ */
+uint32_t dma_sum32_sw(uint32_t sum, const void *data, size_t len);
+
+#if !PICO_NO_HARDWARE
+/*! \brief Attach the DMA sniffer to a channel, to checksum a transfer made by the application
+ *  \ingroup pico_dma_crc
+ *
+ * The channel must be configured for 8-bit transfers, and should be configured (and sniffing enabled in
+ * its configuration via \ref channel_config_set_sniff_enable, as this function also sets it) before the
+ * transfer is triggered. When the transfer has completed, call \ref dma_crc_sniff_finish to get the result
+ * and release the sniffer.
+ *
+ * \param channel the DMA channel to sniff
+ * \param type the checksum type
+ * \param initial the checksum of any preceding data, or the corresponding initial value
+ * \return true if the sniffer was available, false if it is in use
+ */
+bool dma_crc_sniff_start(uint channel, dma_crc_type_t type, uint32_t initial);
+
+/*! \brief Get the checksum calculated by the DMA sniffer, and release it
+ *  \ingroup pico_dma_crc
+ *
+ * \param type the checksum type passed to \ref dma_crc_sniff_start
+ * \return the checksum
+ */
+uint32_t dma_crc_sniff_finish(dma_crc_type_t type);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
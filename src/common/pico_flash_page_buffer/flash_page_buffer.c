@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include "pico/flash_page_buffer.h"
+
+#define PAGE_MASK (FLASH_PAGE_BUFFER_PAGE_SIZE - 1)
+
+void flash_page_buffer_init(flash_page_buffer_t *buffer, flash_page_buffer_program_func_t program, void *context) {
+    buffer->program = program;
+    buffer->context = context;
+    buffer->page_offset = FLASH_PAGE_BUFFER_EMPTY;
+}
+
+// ANDs the part of [offset, offset + size) which lies in the page at page_offset into the page
+static void merge(uint8_t *page, uint32_t page_offset, uint32_t offset, const uint8_t *data, uint32_t size) {
+    uint32_t start = MAX(offset, page_offset);
+    uint32_t end = MIN(offset + size, page_offset + FLASH_PAGE_BUFFER_PAGE_SIZE);
+    for (uint32_t a = start; a < end; a++) {
+        page[a - page_offset] &= data[a - offset];
+    }
+}
+
+uint32_t flash_page_buffer_batch_get_page(const flash_page_buffer_batch_t *batch, uint i, uint8_t *page) {
+    const flash_page_buffer_t *buffer = batch->buffer;
+    if (batch->flush_buffered) {
+        if (!i) {
+            memcpy(page, buffer->page, FLASH_PAGE_BUFFER_PAGE_SIZE);
+            return buffer->page_offset;
+        }
+        i--;
+    }
+    uint32_t page_offset = batch->first_page + i * FLASH_PAGE_BUFFER_PAGE_SIZE;
+    if (page_offset == buffer->page_offset) {
+        memcpy(page, buffer->page, FLASH_PAGE_BUFFER_PAGE_SIZE);
+    } else {
+        memset(page, 0xff, FLASH_PAGE_BUFFER_PAGE_SIZE);
+    }
+    merge(page, page_offset, batch->offset, batch->data, batch->size);
+    return page_offset;
+}
+
+static void write_pages(flash_page_buffer_t *buffer, uint32_t offset, const uint8_t *data, uint32_t size, bool hold_last) {
+    if (!size) return;
+    uint32_t first_page = offset & ~PAGE_MASK;
+    uint32_t last_page = (offset + size - 1) & ~PAGE_MASK;
+    uint32_t end_page = hold_last ? last_page : last_page + FLASH_PAGE_BUFFER_PAGE_SIZE;
+    uint32_t buffered = buffer->page_offset;
+    flash_page_buffer_batch_t batch = {
+        .buffer = buffer,
+        .data = data,
+        .offset = offset,
+        .size = size,
+        .first_page = first_page,
+        .page_count = (end_page - first_page) / FLASH_PAGE_BUFFER_PAGE_SIZE,
+        // a buffered page within the write is merged into it instead
+        .flush_buffered = buffered != FLASH_PAGE_BUFFER_EMPTY && (buffered < first_page || buffered > last_page),
+    };
+    batch.page_count += batch.flush_buffered;
+    if (batch.page_count) buffer->program(buffer, &batch);
+    if (!hold_last) {
+        buffer->page_offset = FLASH_PAGE_BUFFER_EMPTY;
+        return;
+    }
+    if (buffered != last_page) {
+        memset(buffer->page, 0xff, FLASH_PAGE_BUFFER_PAGE_SIZE);
+        buffer->page_offset = last_page;
+    }
+    merge(buffer->page, last_page, offset, data, size);
+}
+
+void flash_page_buffer_write(flash_page_buffer_t *buffer, uint32_t offset, const void *data, uint32_t size) {
+    write_pages(buffer, offset, (const uint8_t *)data, size, true);
+}
+
+void flash_page_buffer_write_through(flash_page_buffer_t *buffer, uint32_t offset, const void *data, uint32_t size) {
+    write_pages(buffer, offset, (const uint8_t *)data, size, false);
+}
+
+void flash_page_buffer_flush(flash_page_buffer_t *buffer) {
+    if (buffer->page_offset == FLASH_PAGE_BUFFER_EMPTY) return;
+    flash_page_buffer_batch_t batch = {
+        .buffer = buffer,
+        .page_count = 1,
+        .flush_buffered = true,
+    };
+    buffer->program(buffer, &batch);
+    buffer->page_offset = FLASH_PAGE_BUFFER_EMPTY;
+}
+
+void flash_page_buffer_erase(flash_page_buffer_t *buffer, uint32_t offset, uint32_t size) {
+    if (buffer->page_offset - offset < size) {
+        buffer->page_offset = FLASH_PAGE_BUFFER_EMPTY;
+    } else {
+        flash_page_buffer_flush(buffer);
+    }
+}
+
+void flash_page_buffer_apply(const flash_page_buffer_t *buffer, uint32_t offset, void *data, uint32_t size) {
+    uint32_t page_offset = buffer->page_offset;
+    if (page_offset == FLASH_PAGE_BUFFER_EMPTY) return;
+    uint8_t *d = (uint8_t *)data;
+    uint32_t start = MAX(offset, page_offset);
+    uint32_t end = MIN(offset + size, page_offset + FLASH_PAGE_BUFFER_PAGE_SIZE);
+    for (uint32_t a = start; a < end; a++) {
+        d[a - offset] &= buffer->page[a - page_offset];
+    }
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_FLASH_PAGE_BUFFER_H
+#define _PICO_FLASH_PAGE_BUFFER_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \file pico/flash_page_buffer.h
+ *  \defgroup pico_flash_page_buffer pico_flash_page_buffer
+ *
+ * \brief Write-back buffering of small writes to NOR flash
+ *
+ * Programming flash has a fixed cost per operation (e.g. the other core must be locked out and XIP disabled),
+ * so many small writes to the same page are much more expensive than one write of the whole page. This
+ * library holds the last page written to in RAM, so that further writes to it are merged, and programs it
+ * only when a write moves on to another page, or when it is explicitly flushed. A write spanning several
+ * pages is passed to the flash as a single batch, together with any page which must be flushed first.
+ *
+ * Writes follow NOR flash semantics: bits can only be cleared, so writing a byte twice leaves the AND of the
+ * two values. Pages are written in the order in which they were first written to, so a log written in order
+ * remains consistent if power is lost, apart from the buffered page.
+ *
+ * The library does not access flash itself; the flash is programmed by a callback, so it can be used with
+ * the on-chip flash or a simulation, including on PICO_PLATFORM=host.
+ */
+
+/*! \brief Size of a flash page in bytes
+ *  \ingroup pico_flash_page_buffer
+ */
+#define FLASH_PAGE_BUFFER_PAGE_SIZE 256u
+
+/*! \brief Value of \ref flash_page_buffer::page_offset when no page is buffered
+ *  \ingroup pico_flash_page_buffer
+ */
+#define FLASH_PAGE_BUFFER_EMPTY 0xffffffffu
+
+typedef struct flash_page_buffer flash_page_buffer_t;
+
+/*! \brief A batch of whole pages to be programmed
+ *  \ingroup pico_flash_page_buffer
+ *
+ * The contents of the pages are assembled on demand by \ref flash_page_buffer_batch_get_page, so a batch takes no
+ * more RAM than one page, however many pages it covers. The contents of this structure are private.
+ */
+typedef struct flash_page_buffer_batch {
+    const flash_page_buffer_t *buffer;
+    const uint8_t *data;     ///< data being written, starting at offset
+    uint32_t offset;
+    uint32_t size;
+    uint32_t first_page;     ///< offset of the first page of the write to program
+    uint page_count;         ///< number of pages in the batch
+    bool flush_buffered;     ///< the buffered page (which is not written to) is programmed first
+} flash_page_buffer_batch_t;
+
+/*! \brief Callback to program the pages of a batch
+ *  \ingroup pico_flash_page_buffer
+ *
+ * The callback should program each page i (from 0 to \ref flash_page_buffer_batch_get_page_count - 1) in order, after
+ * assembling it with \ref flash_page_buffer_batch_get_page. Doing this all in one go (e.g. inside a single
+ * flash_safe_execute) is the point of batching.
+ */
+typedef void (*flash_page_buffer_program_func_t)(flash_page_buffer_t *buffer, const flash_page_buffer_batch_t *batch);
+
+/*! \brief Write-back buffer for a single flash page
+ *  \ingroup pico_flash_page_buffer
+ */
+struct flash_page_buffer {
+    flash_page_buffer_program_func_t program;
+    void *context;          ///< for use by the program callback
+    uint32_t page_offset;   ///< flash offset of the buffered page, or FLASH_PAGE_BUFFER_EMPTY
+    uint8_t page[FLASH_PAGE_BUFFER_PAGE_SIZE];
+};
+
+/*! \brief Initialize a page buffer
+ *  \ingroup pico_flash_page_buffer
+ *
+ * \param buffer the buffer
+ * \param program callback to program pages
+ * \param context stored in the buffer for use by the callback
+ */
+void flash_page_buffer_init(flash_page_buffer_t *buffer, flash_page_buffer_program_func_t program, void *context);
+
+/*! \brief Write data, which is buffered if it ends in the page already buffered or there is none
+ *  \ingroup pico_flash_page_buffer
+ *
+ * The page buffered beforehand and any pages of the write before its last are programmed as one batch; the last
+ * page of the write is then held in the buffer.
+ *
+ * \param buffer the buffer
+ * \param offset the flash offset to write at
+ * \param data the data
+ * \param size the size of the data in bytes
+ */
+void flash_page_buffer_write(flash_page_buffer_t *buffer, uint32_t offset, const void *data, uint32_t size);
+
+/*! \brief Write data without buffering it
+ *  \ingroup pico_flash_page_buffer
+ *
+ * The page buffered beforehand and all the pages of the write are programmed as one batch, leaving nothing buffered.
+ *
+ * \param buffer the buffer
+ * \param offset the flash offset to write at
+ * \param data the data
+ * \param size the size of the data in bytes
+ */
+void flash_page_buffer_write_through(flash_page_buffer_t *buffer, uint32_t offset, const void *data, uint32_t size);
+
+/*! \brief Program the buffered page, if there is one
+ *  \ingroup pico_flash_page_buffer
+ *
+ * \param buffer the buffer
+ */
+void flash_page_buffer_flush(flash_page_buffer_t *buffer);
+
+/*! \brief Discard the buffered page if it lies within a range of flash which is about to be erased
+ *  \ingroup pico_flash_page_buffer
+ *
+ * A buffered page outside the range is flushed, so that it is not reordered with the erase.
+ *
+ * \param buffer the buffer
+ * \param offset the flash offset of the range
+ * \param size the size of the range in bytes
+ */
+void flash_page_buffer_erase(flash_page_buffer_t *buffer, uint32_t offset, uint32_t size);
+
+/*! \brief Apply buffered data to data read from flash
+ *  \ingroup pico_flash_page_buffer
+ *
+ * \param buffer the buffer
+ * \param offset the flash offset from which the data was read
+ * \param data the data as read from flash, which is updated with any buffered writes
+ * \param size the size of the data in bytes
+ */
+void flash_page_buffer_apply(const flash_page_buffer_t *buffer, uint32_t offset, void *data, uint32_t size);
+
+/*! \brief Get the number of pages in a batch
+ *  \ingroup pico_flash_page_buffer
+ */
+static inline uint flash_page_buffer_batch_get_page_count(const flash_page_buffer_batch_t *batch) {
+    return batch->page_count;
+}
+
+/*! \brief Assemble the contents of a page of a batch
+ *  \ingroup pico_flash_page_buffer
+ *
+ * Bytes of the page which are not being written are set to 0xff, so programming them leaves them unchanged.
+ *
+ * \param batch the batch
+ * \param i the index of the page within the batch
+ * \param page receives the FLASH_PAGE_BUFFER_PAGE_SIZE bytes of the page
+ * \return the flash offset of the page
+ */
+uint32_t flash_page_buffer_batch_get_page(const flash_page_buffer_batch_t *batch, uint i, uint8_t *page);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
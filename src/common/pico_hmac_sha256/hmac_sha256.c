@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "pico/hmac_sha256.h"
+
+#define HMAC_IPAD 0x36
+#define HMAC_OPAD 0x5c
+
+#define HKDF_MAX_OKM_BYTES (255 * SHA256_RESULT_BYTES)
+
+int pico_hmac_sha256_key_init(pico_hmac_sha256_key_t *key, const uint8_t *key_data, size_t key_size_bytes) {
+    uint8_t block[HMAC_SHA256_BLOCK_SIZE_BYTES] = {0};
+    if (key_size_bytes > HMAC_SHA256_BLOCK_SIZE_BYTES) {
+        pico_sha256_state_t state;
+        int rc = pico_sha256_start_blocking(&state, SHA256_BIG_ENDIAN, false);
+        if (rc != PICO_OK) return rc;
+        pico_sha256_update_blocking(&state, key_data, key_size_bytes);
+        sha256_result_t hash;
+        pico_sha256_finish(&state, &hash);
+        memcpy(block, hash.bytes, sizeof(hash.bytes));
+        memset(&hash, 0, sizeof(hash));
+    } else if (key_size_bytes) {
+        memcpy(block, key_data, key_size_bytes);
+    }
+    for (uint i = 0; i < sizeof(block); i++) {
+        block[i] ^= HMAC_IPAD;
+    }
+#if PICO_SHA256_SOFTWARE
+    pico_sha256_try_start(&key->inner, SHA256_BIG_ENDIAN, false);
+    pico_sha256_update_blocking(&key->inner, block, sizeof(block));
+#else
+    memcpy(key->ipad, block, sizeof(block));
+#endif
+    for (uint i = 0; i < sizeof(block); i++) {
+        block[i] ^= HMAC_IPAD ^ HMAC_OPAD;
+    }
+#if PICO_SHA256_SOFTWARE
+    pico_sha256_try_start(&key->outer, SHA256_BIG_ENDIAN, false);
+    pico_sha256_update_blocking(&key->outer, block, sizeof(block));
+#else
+    memcpy(key->opad, block, sizeof(block));
+#endif
+    memset(block, 0, sizeof(block));
+    return PICO_OK;
+}
+
+#if PICO_SHA256_SOFTWARE
+int pico_hmac_sha256_try_start(pico_hmac_sha256_state_t *state, const pico_hmac_sha256_key_t *key, __unused bool use_dma) {
+    // resume from the hash of the inner padded key
+    state->key = key;
+    state->sha256 = key->inner;
+    return PICO_OK;
+}
+
+int pico_hmac_sha256_start_blocking_until(pico_hmac_sha256_state_t *state, const pico_hmac_sha256_key_t *key, bool use_dma, __unused absolute_time_t until) {
+    return pico_hmac_sha256_try_start(state, key, use_dma);
+}
+#else
+int pico_hmac_sha256_try_start(pico_hmac_sha256_state_t *state, const pico_hmac_sha256_key_t *key, bool use_dma) {
+    int rc = pico_sha256_try_start(&state->sha256, SHA256_BIG_ENDIAN, use_dma);
+    if (rc == PICO_OK) {
+        state->key = key;
+        pico_sha256_update(&state->sha256, key->ipad, sizeof(key->ipad));
+    }
+    return rc;
+}
+
+int pico_hmac_sha256_start_blocking_until(pico_hmac_sha256_state_t *state, const pico_hmac_sha256_key_t *key, bool use_dma, absolute_time_t until) {
+    int rc = pico_sha256_start_blocking_until(&state->sha256, SHA256_BIG_ENDIAN, use_dma, until);
+    if (rc == PICO_OK) {
+        state->key = key;
+        pico_sha256_update(&state->sha256, key->ipad, sizeof(key->ipad));
+    }
+    return rc;
+}
+#endif
+
+void pico_hmac_sha256_update(pico_hmac_sha256_state_t *state, const uint8_t *data, size_t data_size_bytes) {
+    pico_sha256_update(&state->sha256, data, data_size_bytes);
+}
+
+int pico_hmac_sha256_finish(pico_hmac_sha256_state_t *state, sha256_result_t *out) {
+    if (!out) {
+        pico_sha256_finish(&state->sha256, NULL);
+        return PICO_OK;
+    }
+    sha256_result_t inner;
+    pico_sha256_finish(&state->sha256, &inner);
+#if PICO_SHA256_SOFTWARE
+    state->sha256 = state->key->outer;
+#else
+    // without DMA, this can only wait
+    int rc = pico_sha256_start_blocking(&state->sha256, SHA256_BIG_ENDIAN, false);
+    if (rc != PICO_OK) {
+        memset(&inner, 0, sizeof(inner));
+        return rc;
+    }
+    pico_sha256_update(&state->sha256, state->key->opad, sizeof(state->key->opad));
+#endif
+    pico_sha256_update_blocking(&state->sha256, inner.bytes, sizeof(inner.bytes));
+    pico_sha256_finish(&state->sha256, out);
+    memset(&inner, 0, sizeof(inner));
+    return PICO_OK;
+}
+
+int pico_hmac_sha256(const pico_hmac_sha256_key_t *key, const uint8_t *data, size_t data_size_bytes, sha256_result_t *out) {
+    pico_hmac_sha256_state_t state;
+    int rc = pico_hmac_sha256_start_blocking(&state, key, false);
+    if (rc != PICO_OK) return rc;
+    pico_hmac_sha256_update(&state, data, data_size_bytes);
+    return pico_hmac_sha256_finish(&state, out);
+}
+
+int pico_hkdf_sha256_extract(const uint8_t *salt, size_t salt_size_bytes, const uint8_t *ikm, size_t ikm_size_bytes, sha256_result_t *prk) {
+    // no salt is the same as a salt of zeros, as the key is padded with zeros anyway
+    pico_hmac_sha256_key_t key;
+    int rc = pico_hmac_sha256_key_init(&key, salt, salt_size_bytes);
+    if (rc == PICO_OK) {
+        rc = pico_hmac_sha256(&key, ikm, ikm_size_bytes, prk);
+    }
+    memset(&key, 0, sizeof(key));
+    return rc;
+}
+
+int pico_hkdf_sha256_expand(const pico_hmac_sha256_key_t *prk, const uint8_t *info, size_t info_size_bytes, uint8_t *okm, size_t okm_size_bytes) {
+    if (okm_size_bytes > HKDF_MAX_OKM_BYTES) return PICO_ERROR_INVALID_ARG;
+    // T(n) = HMAC(PRK, T(n-1) | info | n), where T(0) is empty
+    sha256_result_t t;
+    for (uint8_t n = 1; okm_size_bytes; n++) {
+        pico_hmac_sha256_state_t state;
+        int rc = pico_hmac_sha256_start_blocking(&state, prk, false);
+        if (rc != PICO_OK) return rc;
+        if (n > 1) pico_hmac_sha256_update(&state, t.bytes, sizeof(t.bytes));
+        pico_hmac_sha256_update(&state, info, info_size_bytes);
+        pico_hmac_sha256_update(&state, &n, 1);
+        rc = pico_hmac_sha256_finish(&state, &t);
+        if (rc != PICO_OK) {
+            memset(&t, 0, sizeof(t));
+            return rc;
+        }
+        size_t len = MIN(okm_size_bytes, sizeof(t.bytes));
+        memcpy(okm, t.bytes, len);
+        okm += len;
+        okm_size_bytes -= len;
+    }
+    memset(&t, 0, sizeof(t));
+    return PICO_OK;
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_HMAC_SHA256_H
+#define _PICO_HMAC_SHA256_H
+
+#include "pico/sha256.h"
+
+/** \file pico/hmac_sha256.h
+ *  \defgroup pico_hmac_sha256 pico_hmac_sha256
+ *
+ * \brief HMAC-SHA256 (RFC 2104) and HKDF (RFC 5869) on top of \ref pico_sha256
+ *
+ * The work which depends only on the key is done once, by \ref pico_hmac_sha256_key_init, so that a key used for
+ * many messages (e.g. to authenticate each packet of a link) costs little more per message than hashing it.
+ * With the software SHA-256 implementation, the key holds the hash state after the inner and outer padded key
+ * blocks, so these blocks are not hashed again for each message. The SHA-256 hardware cannot be loaded with a
+ * saved state, so with it the key holds the padded key blocks instead.
+ *
+ * \code
+ * pico_hmac_sha256_key_t key;
+ * pico_hmac_sha256_key_init(&key, secret, sizeof(secret));
+ * ...
+ * sha256_result_t mac;
+ * pico_hmac_sha256(&key, packet, packet_size, &mac);
+ * \endcode
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HMAC_SHA256_BLOCK_SIZE_BYTES 64
+
+/*! \brief An HMAC-SHA256 key, prepared by \ref pico_hmac_sha256_key_init
+ *  \ingroup pico_hmac_sha256
+ *
+ * The contents of this structure are private. It holds secret material, so should be cleared when no longer needed.
+ */
+typedef struct {
+#if PICO_SHA256_SOFTWARE
+    pico_sha256_state_t inner;  ///< hash state after the key XOR ipad
+    pico_sha256_state_t outer;  ///< hash state after the key XOR opad
+#else
+    uint8_t ipad[HMAC_SHA256_BLOCK_SIZE_BYTES];
+    uint8_t opad[HMAC_SHA256_BLOCK_SIZE_BYTES];
+#endif
+} pico_hmac_sha256_key_t;
+
+/*! \brief HMAC-SHA256 state used by the API
+ *  \ingroup pico_hmac_sha256
+ */
+typedef struct {
+    const pico_hmac_sha256_key_t *key;
+    pico_sha256_state_t sha256;
+} pico_hmac_sha256_state_t;
+
+/*! \brief Prepare a key for use with HMAC-SHA256
+ *  \ingroup pico_hmac_sha256
+ *
+ * A key longer than the SHA-256 block size (64 bytes) is hashed, as the HMAC specification requires, waiting for
+ * the SHA-256 hardware to be available if need be.
+ *
+ * @param key the key to prepare
+ * @param key_data the key material
+ * @param key_size_bytes the size of the key material, which may be 0
+ * @return PICO_OK, or an error if the key could not be hashed
+ */
+int pico_hmac_sha256_key_init(pico_hmac_sha256_key_t *key, const uint8_t *key_data, size_t key_size_bytes);
+
+/*! \brief Start an HMAC-SHA256 calculation returning immediately with an error if the SHA-256 hardware is not available
+ *  \ingroup pico_hmac_sha256
+ *
+ * @param state A pointer to a pico_hmac_sha256_state_t instance
+ * @param key The key, which must remain valid until the calculation is finished
+ * @param use_dma Set to true to use DMA internally to copy data to hardware
+ * @return Returns PICO_OK if the calculation could be started, otherwise an error is returned
+ */
+int pico_hmac_sha256_try_start(pico_hmac_sha256_state_t *state, const pico_hmac_sha256_key_t *key, bool use_dma);
+
+/*! \brief Start an HMAC-SHA256 calculation waiting for a defined period for the SHA-256 hardware to be available
+ *  \ingroup pico_hmac_sha256
+ *
+ * @param state A pointer to a pico_hmac_sha256_state_t instance
+ * @param key The key, which must remain valid until the calculation is finished
+ * @param use_dma Set to true to use DMA internally to copy data to hardware
+ * @param until How long to wait for the SHA hardware to be available
+ * @return Returns PICO_OK if the calculation could be started in time, otherwise an error is returned
+ */
+int pico_hmac_sha256_start_blocking_until(pico_hmac_sha256_state_t *state, const pico_hmac_sha256_key_t *key, bool use_dma, absolute_time_t until);
+
+/*! \brief Start an HMAC-SHA256 calculation, blocking forever waiting until the SHA-256 hardware is available
+ *  \ingroup pico_hmac_sha256
+ *
+ * @param state A pointer to a pico_hmac_sha256_state_t instance
+ * @param key The key, which must remain valid until the calculation is finished
+ * @param use_dma Set to true to use DMA internally to copy data to hardware
+ * @return Returns PICO_OK if the calculation could be started, otherwise an error is returned
+ */
+static inline int pico_hmac_sha256_start_blocking(pico_hmac_sha256_state_t *state, const pico_hmac_sha256_key_t *key, bool use_dma) {
+    return pico_hmac_sha256_start_blocking_until(state, key, use_dma, at_the_end_of_time);
+}
+
+/*! \brief Add byte data to the HMAC-SHA256 calculation
+ *  \ingroup pico_hmac_sha256
+ *
+ * @param state A pointer to a pico_hmac_sha256_state_t instance
+ * @param data Pointer to the data to be added to the calculation
+ * @param data_size_bytes Amount of data to add
+ *
+ * @note As for \ref pico_sha256_update, the data must remain valid and unchanged until the next call.
+ */
+void pico_hmac_sha256_update(pico_hmac_sha256_state_t *state, const uint8_t *data, size_t data_size_bytes);
+
+/*! \brief Finish the HMAC-SHA256 calculation and return the result
+ *  \ingroup pico_hmac_sha256
+ *
+ * With the SHA-256 hardware, this releases the hardware between the inner and outer hashes, and waits for it to
+ * be available again for the outer hash.
+ *
+ * @param state A pointer to a pico_hmac_sha256_state_t instance
+ * @param out The HMAC, or NULL to abandon the calculation
+ * @return PICO_OK, or the error from \ref pico_sha256_start_blocking if the outer hash could not be started, in
+ * which case out is not written
+ */
+int pico_hmac_sha256_finish(pico_hmac_sha256_state_t *state, sha256_result_t *out);
+
+/*! \brief Calculate the HMAC-SHA256 of a message
+ *  \ingroup pico_hmac_sha256
+ *
+ * This blocks until the SHA-256 hardware is available, and does not use DMA.
+ *
+ * @param key The key
+ * @param data The message
+ * @param data_size_bytes The size of the message
+ * @param out The HMAC
+ * @return PICO_OK, or an error if the calculation could not be started
+ */
+int pico_hmac_sha256(const pico_hmac_sha256_key_t *key, const uint8_t *data, size_t data_size_bytes, sha256_result_t *out);
+
+/*! \brief HKDF-Extract: derive a pseudorandom key from input keying material
+ *  \ingroup pico_hmac_sha256
+ *
+ * @param salt The salt, or NULL
+ * @param salt_size_bytes The size of the salt, which may be 0
+ * @param ikm The input keying material
+ * @param ikm_size_bytes The size of the input keying material
+ * @param prk The pseudorandom key
+ * @return PICO_OK, or an error if the calculation could not be started
+ */
+int pico_hkdf_sha256_extract(const uint8_t *salt, size_t salt_size_bytes, const uint8_t *ikm, size_t ikm_size_bytes, sha256_result_t *prk);
+
+/*! \brief HKDF-Expand: derive output keying material from a pseudorandom key
+ *  \ingroup pico_hmac_sha256
+ *
+ * The pseudorandom key (e.g. from \ref pico_hkdf_sha256_extract) is passed prepared as an HMAC key, so that it
+ * can be prepared once for many expansions with different info.
+ *
+ * @param prk The pseudorandom key, prepared with \ref pico_hmac_sha256_key_init
+ * @param info The context and application specific information, or NULL
+ * @param info_size_bytes The size of info, which may be 0
+ * @param okm The output keying material
+ * @param okm_size_bytes The size of the output keying material, at most 255 * SHA256_RESULT_BYTES
+ * @return PICO_OK, PICO_ERROR_INVALID_ARG if okm_size_bytes is too large, or an error if the calculation could
+ * not be started
+ */
+int pico_hkdf_sha256_expand(const pico_hmac_sha256_key_t *prk, const uint8_t *info, size_t info_size_bytes, uint8_t *okm, size_t okm_size_bytes);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
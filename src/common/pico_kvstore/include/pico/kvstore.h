@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_KVSTORE_H
+#define _PICO_KVSTORE_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \file pico/kvstore.h
+ *  \defgroup pico_kvstore pico_kvstore
+ *
+ * \brief Wear levelled, power loss safe key/value store in flash
+ *
+ * Records (a key and its value, or the deletion of a key) are appended to a log which runs circularly through
+ * a number of flash sectors, so updating a value costs a page program rather than a sector erase. Values are
+ * read directly from the memory mapped flash (e.g. via XIP), found through an index in RAM which is built when
+ * the store is opened.
+ *
+ * When the log needs more space, the oldest sector's records which are still current are copied to the head of
+ * the log, and only then is that sector (now entirely stale) erased. Sectors are used in turn, so wear is spread
+ * evenly over them. Two sectors are always kept erased, so that this can be completed however the store was left.
+ *
+ * Every record and sector header is protected by a CRC-32, and nothing is erased until what it holds is stored
+ * elsewhere, so if power is lost at any point the store opens with each key holding either its previous or its
+ * new value. A partially written record at the head of the log is skipped over when the store is next opened.
+ *
+ * The flash is accessed through a \ref kvstore_flash_t, which can be the on-chip flash (see
+ * \ref kvstore_flash_init_onchip), or an emulation in RAM with simulated power failures (see
+ * \ref kvstore_ram_flash_init), with which the store can be tested on any platform, including
+ * PICO_PLATFORM=host.
+ *
+ * \note The store is not thread safe; calls for the same store must not be made concurrently.
+ */
+
+// PICO_CONFIG: PICO_KVSTORE_MAX_KEY_LENGTH, Maximum length of a key in bytes, type=int, default=32, max=255, group=pico_kvstore
+#ifndef PICO_KVSTORE_MAX_KEY_LENGTH
+#define PICO_KVSTORE_MAX_KEY_LENGTH 32
+#endif
+
+/*! \brief Number of sectors of the store which are kept erased
+ *  \ingroup pico_kvstore
+ */
+#define KVSTORE_SPARE_SECTORS 2
+
+/*! \brief Size of the header at the start of each sector of the store
+ *  \ingroup pico_kvstore
+ */
+#define KVSTORE_SECTOR_HEADER_SIZE 32
+
+/*! \brief Size of the header of each record; the key and value follow it, padded to a multiple of 4 bytes
+ *  \ingroup pico_kvstore
+ */
+#define KVSTORE_RECORD_HEADER_SIZE 8
+
+typedef struct kvstore_flash kvstore_flash_t;
+
+/*! \brief A region of NOR flash (or an emulation of it) holding a store
+ *  \ingroup pico_kvstore
+ *
+ * The region is made up of sector_count sectors of sector_size bytes each, which read as 0xff when erased;
+ * programming can only clear bits. Offsets are relative to the start of the region.
+ */
+struct kvstore_flash {
+    const uint8_t *contents; ///< The memory mapped contents of the region, from which the store reads
+    uint32_t sector_size;    ///< Size of a sector in bytes (a multiple of 4, at most 65536)
+    uint32_t sector_count;   ///< Number of sectors (at least 3)
+    /*! Program len bytes (a multiple of 4) at offset (a multiple of 4); returns PICO_OK or an error */
+    int (*program)(kvstore_flash_t *flash, uint32_t offset, const void *data, uint32_t len);
+    /*! Erase the sector starting at offset; returns PICO_OK or an error */
+    int (*erase)(kvstore_flash_t *flash, uint32_t offset);
+};
+
+/*! \brief Entry in the in-RAM index of a store
+ *  \ingroup pico_kvstore
+ */
+typedef struct kvstore_index_entry {
+    uint32_t key_hash;
+    uint32_t location;   ///< offset of the key's current record in the flash region
+} kvstore_index_entry_t;
+
+/*! \brief A key/value store
+ *  \ingroup pico_kvstore
+ *
+ * The contents of this structure are private.
+ */
+typedef struct kvstore {
+    kvstore_flash_t *flash;
+    kvstore_index_entry_t *index;
+    uint index_capacity;
+    uint index_count;
+    int head;             ///< sector holding the head of the log, or -1 if the store is empty
+    uint32_t head_offset; ///< offset within the head sector to append at
+    uint32_t head_seq;
+    uint32_t live_bytes;  ///< total size of the current records
+} kvstore_t;
+
+/*! \brief Open the store in a flash region, formatting any part of it which does not hold the store
+ *  \ingroup pico_kvstore
+ *
+ * Blank or invalid sectors (including those left by an interrupted erase or write) are erased, and any
+ * interrupted garbage collection is completed.
+ *
+ * \param kv the store
+ * \param flash the flash region, which must remain valid while the store is in use
+ * \param index storage for the index, with one entry for each key the store can hold
+ * \param index_capacity the number of entries in index
+ * \return PICO_OK, PICO_ERROR_INVALID_ARG if the flash region is unsuitable, PICO_ERROR_BUFFER_TOO_SMALL if the store
+ * holds more keys than the index has entries, or an error from the flash
+ */
+int kvstore_init(kvstore_t *kv, kvstore_flash_t *flash, kvstore_index_entry_t *index, uint index_capacity);
+
+/*! \brief Erase the whole store
+ *  \ingroup pico_kvstore
+ *
+ * \param kv the store
+ * \return PICO_OK or an error from the flash
+ */
+int kvstore_format(kvstore_t *kv);
+
+/*! \brief Find the value of a key in flash
+ *  \ingroup pico_kvstore
+ *
+ * \param kv the store
+ * \param key the key (a NUL terminated string)
+ * \param len if not NULL, receives the length of the value
+ * \return a pointer to the value in the memory mapped flash, which remains valid until the store is next modified,
+ * or NULL if the key is not present
+ */
+const void *kvstore_get_pointer(const kvstore_t *kv, const char *key, size_t *len);
+
+/*! \brief Copy the value of a key
+ *  \ingroup pico_kvstore
+ *
+ * \param kv the store
+ * \param key the key (a NUL terminated string)
+ * \param value buffer for the value, which is truncated if it is longer than value_size
+ * \param value_size the size of the buffer
+ * \return the length of the value, or PICO_ERROR_NOT_FOUND if the key is not present
+ */
+int kvstore_get(const kvstore_t *kv, const char *key, void *value, size_t value_size);
+
+/*! \brief Set the value of a key
+ *  \ingroup pico_kvstore
+ *
+ * Nothing is written if the key already has this value.
+ *
+ * \param kv the store
+ * \param key the key (a NUL terminated string of 1 to PICO_KVSTORE_MAX_KEY_LENGTH bytes)
+ * \param value the value
+ * \param len the length of the value, which must be small enough for the record to fit in a sector
+ * \return PICO_OK, PICO_ERROR_INVALID_ARG if the key or value is too long, PICO_ERROR_INSUFFICIENT_RESOURCES if the
+ * store or its index is full, or an error from the flash
+ */
+int kvstore_set(kvstore_t *kv, const char *key, const void *value, size_t len);
+
+/*! \brief Remove a key
+ *  \ingroup pico_kvstore
+ *
+ * \param kv the store
+ * \param key the key (a NUL terminated string)
+ * \return PICO_OK, PICO_ERROR_NOT_FOUND if the key is not present, or another error as for \ref kvstore_set
+ */
+int kvstore_delete(kvstore_t *kv, const char *key);
+
+/*! \brief Get the number of keys in the store
+ *  \ingroup pico_kvstore
+ */
+static inline uint kvstore_get_key_count(const kvstore_t *kv) {
+    return kv->index_count;
+}
+
+/*! \brief Call a function for each key in the store
+ *  \ingroup pico_kvstore
+ *
+ * The store must not be modified during the iteration.
+ *
+ * \param kv the store
+ * \param func called with each key (which is not NUL terminated), its length, its value and the value's length;
+ * iteration stops if it returns false
+ * \param user_data passed to func
+ */
+void kvstore_for_each(const kvstore_t *kv, bool (*func)(const char *key, uint key_len, const void *value, size_t len, void *user_data),
+                      void *user_data);
+
+/*! \brief An emulation of flash in RAM, with simulated power failures
+ *  \ingroup pico_kvstore
+ */
+typedef struct kvstore_ram_flash {
+    kvstore_flash_t flash;   ///< The flash region, to pass to \ref kvstore_init
+    uint8_t *buffer;
+    int32_t power_cut_countdown; ///< bytes which may still be programmed or erased before power is lost, or -1
+    bool powered_off;
+    uint32_t program_count;  ///< number of program operations
+    uint32_t erase_count;    ///< number of sector erases
+} kvstore_ram_flash_t;
+
+/*! \brief Initialize an emulation of flash in a RAM buffer
+ *  \ingroup pico_kvstore
+ *
+ * The buffer is erased (filled with 0xff).
+ *
+ * \param ram the emulation
+ * \param buffer the buffer, of sector_size * sector_count bytes
+ * \param sector_size size of a sector in bytes
+ * \param sector_count number of sectors
+ */
+void kvstore_ram_flash_init(kvstore_ram_flash_t *ram, uint8_t *buffer, uint32_t sector_size, uint32_t sector_count);
+
+/*! \brief Simulate power being lost part way through a later operation
+ *  \ingroup pico_kvstore
+ *
+ * After a further `bytes` bytes have been programmed or erased, the byte being programmed at the time is left
+ * with only some of its bits programmed (or, if it was being erased, with only some set), nothing more is
+ * changed, and all further operations fail with PICO_ERROR_IO until \ref kvstore_ram_flash_power_on is called.
+ *
+ * \param ram the emulation
+ * \param bytes the number of bytes which complete, or -1 never to lose power
+ */
+void kvstore_ram_flash_cut_power_after(kvstore_ram_flash_t *ram, int32_t bytes);
+
+/*! \brief Restore power after a simulated power failure
+ *  \ingroup pico_kvstore
+ *
+ * The contents are kept; a store using the emulation should then be re-opened with \ref kvstore_init.
+ *
+ * \param ram the emulation
+ */
+void kvstore_ram_flash_power_on(kvstore_ram_flash_t *ram);
+
+#if !PICO_NO_HARDWARE
+/*! \brief Describe a region of the on-chip flash for use by a store
+ *  \ingroup pico_kvstore
+ *
+ * Programming and erasing are done via \ref flash_safe_execute, so the other core (if running) is locked out
+ * while they happen.
+ *
+ * \param flash the flash region
+ * \param flash_offset offset of the region from the start of flash, which must be a multiple of FLASH_SECTOR_SIZE
+ * \param sector_count number of FLASH_SECTOR_SIZE sectors in the region
+ */
+void kvstore_flash_init_onchip(kvstore_flash_t *flash, uint32_t flash_offset, uint32_t sector_count);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
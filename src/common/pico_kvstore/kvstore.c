@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include "pico/kvstore.h"
+#include "pico/dma_crc.h"
+
+#define KVSTORE_MAGIC 0x3153564bu // "KVS1"
+#define ERASED_WORD 0xffffffffu
+
+// sector header offsets; the magic and sequence number are followed by their CRC-32
+#define SECTOR_MAGIC 0
+#define SECTOR_SEQ 4
+#define SECTOR_CRC 8
+// programmed to 0 once the live records in the sector have been copied elsewhere, just before it is erased
+#define SECTOR_STATE 12
+// pairs of words (from | to << 16, ~(from | to << 16)), each recording that the records in the sector carry on at
+// offset 'to' after a region left by an interrupted write at offset 'from'
+#define SECTOR_SKIP 16
+#define SKIP_SLOTS 2
+
+static_assert(SECTOR_SKIP + SKIP_SLOTS * 8 == KVSTORE_SECTOR_HEADER_SIZE, "");
+
+// record header: key length, type, value length (16 bits) then the CRC-32 of the first word, the key and the value
+#define RECORD_VALUE 1
+#define RECORD_TOMBSTONE 2
+
+static inline uint32_t read_word(const kvstore_t *kv, uint32_t location) {
+    uint32_t w;
+    memcpy(&w, kv->flash->contents + location, sizeof(w));
+    return w;
+}
+
+static inline uint32_t sector_base(const kvstore_t *kv, uint sector) {
+    return sector * kv->flash->sector_size;
+}
+
+static inline uint32_t payload_size(const kvstore_t *kv) {
+    return kv->flash->sector_size - KVSTORE_SECTOR_HEADER_SIZE;
+}
+
+static inline uint32_t record_size(uint key_len, uint value_len) {
+    return (KVSTORE_RECORD_HEADER_SIZE + key_len + value_len + 3u) & ~3u;
+}
+
+static inline uint record_type(uint32_t header) {
+    return (header >> 8) & 0xffu;
+}
+
+static inline uint32_t header_record_size(uint32_t header) {
+    return record_size(header & 0xffu, header >> 16);
+}
+
+static int program(kvstore_t *kv, uint32_t location, const void *data, uint32_t len) {
+    return kv->flash->program(kv->flash, location, data, len);
+}
+
+static int erase_sector(kvstore_t *kv, uint sector) {
+    return kv->flash->erase(kv->flash, sector_base(kv, sector));
+}
+
+static bool is_blank(const kvstore_t *kv, uint32_t location, uint32_t len) {
+    for (uint32_t i = 0; i < len; i += 4) {
+        if (read_word(kv, location + i) != ERASED_WORD) return false;
+    }
+    return true;
+}
+
+// once the store has been opened, any sector starting with an erased word is entirely erased
+static inline bool is_sector_erased(const kvstore_t *kv, uint sector) {
+    return read_word(kv, sector_base(kv, sector)) == ERASED_WORD;
+}
+
+static bool is_sector_valid(const kvstore_t *kv, uint sector) {
+    uint32_t base = sector_base(kv, sector);
+    return read_word(kv, base + SECTOR_MAGIC) == KVSTORE_MAGIC &&
+           read_word(kv, base + SECTOR_CRC) == dma_crc32_sw(DMA_CRC32_INIT, kv->flash->contents + base, SECTOR_CRC) &&
+           read_word(kv, base + SECTOR_STATE) == ERASED_WORD;
+}
+
+static inline uint32_t sector_seq(const kvstore_t *kv, uint sector) {
+    return read_word(kv, sector_base(kv, sector) + SECTOR_SEQ);
+}
+
+static uint count_erased_sectors(const kvstore_t *kv) {
+    uint count = 0;
+    for (uint s = 0; s < kv->flash->sector_count; s++) {
+        count += is_sector_erased(kv, s);
+    }
+    return count;
+}
+
+static bool find_skip(const kvstore_t *kv, uint sector, uint32_t from, uint32_t *to) {
+    uint32_t slot = sector_base(kv, sector) + SECTOR_SKIP;
+    for (uint i = 0; i < SKIP_SLOTS; i++, slot += 8) {
+        uint32_t v = read_word(kv, slot);
+        if (v == ~read_word(kv, slot + 4) && (v & 0xffffu) == from && (v >> 16) > from) {
+            *to = v >> 16;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the header of the valid record at *offset in a sector, first moving *offset past any region skipped there,
+// or 0 (which is never a valid header) at the end of the records in the sector
+static uint32_t next_record(const kvstore_t *kv, uint sector, uint32_t *offset) {
+    uint32_t sector_size = kv->flash->sector_size;
+    uint32_t base = sector_base(kv, sector);
+    for (uint i = 0; i <= SKIP_SLOTS; i++) {
+        uint32_t off = *offset;
+        if (off + KVSTORE_RECORD_HEADER_SIZE <= sector_size) {
+            uint32_t h = read_word(kv, base + off);
+            uint key_len = h & 0xffu;
+            uint type = record_type(h);
+            if (key_len && (type == RECORD_VALUE || (type == RECORD_TOMBSTONE && !(h >> 16))) &&
+                header_record_size(h) <= sector_size - off) {
+                const uint8_t *r = kv->flash->contents + base + off;
+                uint32_t crc = dma_crc32_sw(dma_crc32_sw(DMA_CRC32_INIT, r, 4), r + KVSTORE_RECORD_HEADER_SIZE,
+                                            key_len + (h >> 16));
+                if (crc == read_word(kv, base + off + 4)) return h;
+            }
+        }
+        uint32_t to;
+        if (!find_skip(kv, sector, off, &to)) break;
+        *offset = to;
+    }
+    return 0;
+}
+
+// FNV-1a
+static uint32_t key_hash(const char *key, uint key_len) {
+    uint32_t hash = 0x811c9dc5u;
+    for (uint i = 0; i < key_len; i++) {
+        hash = (hash ^ (uint8_t)key[i]) * 0x01000193u;
+    }
+    return hash;
+}
+
+static int find_key(const kvstore_t *kv, const char *key, uint key_len, uint32_t hash) {
+    for (uint i = 0; i < kv->index_count; i++) {
+        if (kv->index[i].key_hash != hash) continue;
+        uint32_t location = kv->index[i].location;
+        if ((read_word(kv, location) & 0xffu) == key_len &&
+            !memcmp(kv->flash->contents + location + KVSTORE_RECORD_HEADER_SIZE, key, key_len)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static int find_location(const kvstore_t *kv, uint32_t location) {
+    for (uint i = 0; i < kv->index_count; i++) {
+        if (kv->index[i].location == location) return (int)i;
+    }
+    return -1;
+}
+
+static void remove_from_index(kvstore_t *kv, uint i) {
+    kv->live_bytes -= header_record_size(read_word(kv, kv->index[i].location));
+    kv->index[i] = kv->index[--kv->index_count];
+}
+
+// applies a record found when opening the store, which supersedes any earlier record for the key
+static int index_record(kvstore_t *kv, uint32_t location, uint32_t h) {
+    uint key_len = h & 0xffu;
+    const char *key = (const char *)kv->flash->contents + location + KVSTORE_RECORD_HEADER_SIZE;
+    uint32_t hash = key_hash(key, key_len);
+    int i = find_key(kv, key, key_len, hash);
+    if (record_type(h) == RECORD_TOMBSTONE) {
+        if (i >= 0) remove_from_index(kv, (uint)i);
+        return PICO_OK;
+    }
+    if (i >= 0) {
+        kv->live_bytes -= header_record_size(read_word(kv, kv->index[i].location));
+    } else {
+        if (kv->index_count == kv->index_capacity) return PICO_ERROR_BUFFER_TOO_SMALL;
+        i = (int)kv->index_count++;
+        kv->index[i].key_hash = hash;
+    }
+    kv->index[i].location = location;
+    kv->live_bytes += header_record_size(h);
+    return PICO_OK;
+}
+
+// starts a new head sector, choosing the next erased one after the current head so that all are used in turn
+static int open_head(kvstore_t *kv) {
+    uint count = kv->flash->sector_count;
+    uint start = kv->head < 0 ? 0 : (uint)kv->head + 1;
+    for (uint i = 0; i < count; i++) {
+        uint sector = (start + i) % count;
+        if (!is_sector_erased(kv, sector)) continue;
+        uint32_t header[3] = { KVSTORE_MAGIC, kv->head_seq + 1, 0 };
+        header[2] = dma_crc32_sw(DMA_CRC32_INIT, header, SECTOR_CRC);
+        int rc = program(kv, sector_base(kv, sector), header, sizeof(header));
+        if (rc) return rc;
+        kv->head = (int)sector;
+        kv->head_seq++;
+        kv->head_offset = KVSTORE_SECTOR_HEADER_SIZE;
+        return PICO_OK;
+    }
+    return PICO_ERROR_INSUFFICIENT_RESOURCES;
+}
+
+static int find_tail(const kvstore_t *kv) {
+    int tail = -1;
+    uint32_t tail_seq = 0;
+    for (uint s = 0; s < kv->flash->sector_count; s++) {
+        if (!is_sector_valid(kv, s)) continue;
+        uint32_t seq = sector_seq(kv, s);
+        if (tail < 0 || seq < tail_seq) {
+            tail = (int)s;
+            tail_seq = seq;
+        }
+    }
+    return tail;
+}
+
+// Copies the live records in the oldest sector to the head, then erases it. Nothing in the sector is lost if this
+// is interrupted; tombstones are dropped, as there are no older records for them to hide.
+static int collect_tail(kvstore_t *kv) {
+    int tail = find_tail(kv);
+    if (tail < 0) return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    int rc;
+    if (tail == kv->head && (rc = open_head(kv))) return rc;
+    uint32_t base = sector_base(kv, (uint)tail);
+    uint32_t offset = KVSTORE_SECTOR_HEADER_SIZE;
+    uint32_t h;
+    while ((h = next_record(kv, (uint)tail, &offset))) {
+        uint32_t size = header_record_size(h);
+        int i = find_location(kv, base + offset);
+        if (i >= 0) {
+            if (kv->head_offset + size > kv->flash->sector_size && (rc = open_head(kv))) return rc;
+            uint32_t dest = sector_base(kv, (uint)kv->head) + kv->head_offset;
+            rc = program(kv, dest, kv->flash->contents + base + offset, size);
+            if (rc) return rc;
+            kv->head_offset += size;
+            kv->index[i].location = dest;
+        }
+        offset += size;
+    }
+    static const uint32_t obsolete = 0;
+    rc = program(kv, base + SECTOR_STATE, &obsolete, sizeof(obsolete));
+    if (rc) return rc;
+    return erase_sector(kv, (uint)tail);
+}
+
+// Makes room for a record of 'need' bytes at the head, keeping KVSTORE_SPARE_SECTORS sectors erased. One spare sector
+// is enough for collect_tail to complete; the other leaves room for the log to be moved on.
+static int make_room(kvstore_t *kv, uint32_t need) {
+    for (uint i = 0; i <= 2 * kv->flash->sector_count; i++) {
+        uint erased = count_erased_sectors(kv);
+        bool fits = kv->head >= 0 ? kv->head_offset + need <= kv->flash->sector_size : !need;
+        if (fits && erased >= KVSTORE_SPARE_SECTORS) return PICO_OK;
+        int rc = !fits && erased > KVSTORE_SPARE_SECTORS ? open_head(kv) : collect_tail(kv);
+        if (rc) return rc;
+    }
+    // the live records are too fragmented across sectors for another to be freed
+    return PICO_ERROR_INSUFFICIENT_RESOURCES;
+}
+
+// Records are written in chunks which end at multiples of this offset, so that each chunk lies within one page of
+// flash with pages of this size (or a divisor of it), and programming a record costs one program per page.
+#define PROGRAM_CHUNK_SIZE 256
+
+typedef struct {
+    kvstore_t *kv;
+    uint32_t location;
+    uint fill;
+    int rc;
+    uint32_t buffer[PROGRAM_CHUNK_SIZE / 4];
+} record_writer_t;
+
+static inline uint writer_space(const record_writer_t *w) {
+    return PROGRAM_CHUNK_SIZE - w->location % PROGRAM_CHUNK_SIZE - w->fill;
+}
+
+static void writer_flush(record_writer_t *w) {
+    if (w->rc || !w->fill) return;
+    uint8_t *b = (uint8_t *)w->buffer;
+    while (w->fill & 3u) b[w->fill++] = 0xff;
+    w->rc = program(w->kv, w->location, w->buffer, w->fill);
+    w->location += w->fill;
+    w->fill = 0;
+}
+
+static void writer_put(record_writer_t *w, const void *data, size_t len) {
+    const uint8_t *src = (const uint8_t *)data;
+    while (len && !w->rc) {
+        size_t n = MIN(len, writer_space(w));
+        memcpy((uint8_t *)w->buffer + w->fill, src, n);
+        w->fill += n;
+        src += n;
+        len -= n;
+        if (!writer_space(w)) writer_flush(w);
+    }
+}
+
+static int append_record(kvstore_t *kv, uint type, const char *key, uint key_len, const void *value, uint value_len,
+                         uint32_t *location) {
+    uint32_t size = record_size(key_len, value_len);
+    int rc = make_room(kv, size);
+    if (rc) return rc;
+    uint32_t header[2] = { key_len | (type << 8) | (value_len << 16), 0 };
+    header[1] = dma_crc32_sw(dma_crc32_sw(dma_crc32_sw(DMA_CRC32_INIT, header, 4), key, key_len), value, value_len);
+    record_writer_t w = { .kv = kv, .location = sector_base(kv, (uint)kv->head) + kv->head_offset };
+    *location = w.location;
+    writer_put(&w, header, sizeof(header));
+    writer_put(&w, key, key_len);
+    writer_put(&w, value, value_len);
+    writer_flush(&w);
+    if (w.rc) return w.rc;
+    kv->head_offset += size;
+    return PICO_OK;
+}
+
+// Makes sure the rest of the head sector is erased, so that records can be appended to it. If a write was interrupted,
+// a skip slot records where the records carry on after the region it left; if there are none left, the head is full.
+static int recover_head(kvstore_t *kv) {
+    uint32_t sector_size = kv->flash->sector_size;
+    uint32_t base = sector_base(kv, (uint)kv->head);
+    uint32_t from = kv->head_offset;
+    if (from >= sector_size || is_blank(kv, base + from, sector_size - from)) return PICO_OK;
+    uint32_t to = sector_size;
+    while (read_word(kv, base + to - 4) == ERASED_WORD) to -= 4;
+    kv->head_offset = sector_size;
+    if (to + KVSTORE_RECORD_HEADER_SIZE > sector_size) return PICO_OK;
+    uint32_t slot = base + SECTOR_SKIP;
+    for (uint i = 0; i < SKIP_SLOTS; i++, slot += 8) {
+        if (read_word(kv, slot) != ERASED_WORD || read_word(kv, slot + 4) != ERASED_WORD) continue;
+        uint32_t skip[2] = { from | (to << 16), ~(from | (to << 16)) };
+        int rc = program(kv, slot, skip, sizeof(skip));
+        if (rc) return rc;
+        kv->head_offset = to;
+        break;
+    }
+    return PICO_OK;
+}
+
+int kvstore_init(kvstore_t *kv, kvstore_flash_t *flash, kvstore_index_entry_t *index, uint index_capacity) {
+    if (flash->sector_count <= KVSTORE_SPARE_SECTORS || (flash->sector_size & 3u) ||
+        flash->sector_size < 4 * KVSTORE_SECTOR_HEADER_SIZE || flash->sector_size > 0x10000) {
+        return PICO_ERROR_INVALID_ARG;
+    }
+    *kv = (kvstore_t) {
+        .flash = flash,
+        .index = index,
+        .index_capacity = index_capacity,
+        .head = -1,
+    };
+    int rc;
+    // erase anything which isn't a sector of the store in use, including what is left by an interrupted erase
+    for (uint s = 0; s < flash->sector_count; s++) {
+        if (!is_sector_valid(kv, s) && !is_blank(kv, sector_base(kv, s), flash->sector_size) &&
+            (rc = erase_sector(kv, s))) {
+            return rc;
+        }
+    }
+    // replay the records, oldest sector first
+    for (;;) {
+        int sector = -1;
+        uint32_t seq = 0;
+        for (uint s = 0; s < flash->sector_count; s++) {
+            if (!is_sector_valid(kv, s)) continue;
+            uint32_t s_seq = sector_seq(kv, s);
+            if ((kv->head < 0 || s_seq > kv->head_seq) && (sector < 0 || s_seq < seq)) {
+                sector = (int)s;
+                seq = s_seq;
+            }
+        }
+        if (sector < 0) break;
+        uint32_t base = sector_base(kv, (uint)sector);
+        uint32_t offset = KVSTORE_SECTOR_HEADER_SIZE;
+        uint32_t h;
+        while ((h = next_record(kv, (uint)sector, &offset))) {
+            rc = index_record(kv, base + offset, h);
+            if (rc) return rc;
+            offset += header_record_size(h);
+        }
+        kv->head = sector;
+        kv->head_seq = seq;
+        kv->head_offset = offset;
+    }
+    if (kv->head >= 0 && (rc = recover_head(kv))) return rc;
+    // finish any interrupted garbage collection
+    return make_room(kv, 0);
+}
+
+int kvstore_format(kvstore_t *kv) {
+    for (uint s = 0; s < kv->flash->sector_count; s++) {
+        if (!is_blank(kv, sector_base(kv, s), kv->flash->sector_size)) {
+            int rc = erase_sector(kv, s);
+            if (rc) return rc;
+        }
+    }
+    kv->index_count = 0;
+    kv->head = -1;
+    kv->head_offset = 0;
+    kv->head_seq = 0;
+    kv->live_bytes = 0;
+    return PICO_OK;
+}
+
+const void *kvstore_get_pointer(const kvstore_t *kv, const char *key, size_t *len) {
+    size_t key_len = strlen(key);
+    if (key_len > 0xff) return NULL;
+    int i = find_key(kv, key, (uint)key_len, key_hash(key, (uint)key_len));
+    if (i < 0) return NULL;
+    uint32_t location = kv->index[i].location;
+    if (len) *len = read_word(kv, location) >> 16;
+    return kv->flash->contents + location + KVSTORE_RECORD_HEADER_SIZE + key_len;
+}
+
+int kvstore_get(const kvstore_t *kv, const char *key, void *value, size_t value_size) {
+    size_t len;
+    const void *v = kvstore_get_pointer(kv, key, &len);
+    if (!v) return PICO_ERROR_NOT_FOUND;
+    memcpy(value, v, MIN(len, value_size));
+    return (int)len;
+}
+
+int kvstore_set(kvstore_t *kv, const char *key, const void *value, size_t len) {
+    size_t key_len = strlen(key);
+    if (!key_len || key_len > PICO_KVSTORE_MAX_KEY_LENGTH || len > 0xffff ||
+        record_size((uint)key_len, (uint)len) > payload_size(kv)) {
+        return PICO_ERROR_INVALID_ARG;
+    }
+    uint32_t hash = key_hash(key, (uint)key_len);
+    int i = find_key(kv, key, (uint)key_len, hash);
+    if (i >= 0) {
+        uint32_t location = kv->index[i].location;
+        if ((read_word(kv, location) >> 16) == len &&
+            (!len || !memcmp(kv->flash->contents + location + KVSTORE_RECORD_HEADER_SIZE + key_len, value, len))) {
+            return PICO_OK;
+        }
+    } else if (kv->index_count == kv->index_capacity) {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+    uint32_t size = record_size((uint)key_len, (uint)len);
+    // the current record stays live until the new one is written
+    if (kv->live_bytes + size > (kv->flash->sector_count - KVSTORE_SPARE_SECTORS) * payload_size(kv)) {
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+    uint32_t location;
+    int rc = append_record(kv, RECORD_VALUE, key, (uint)key_len, value, (uint)len, &location);
+    if (rc) return rc;
+    if (i >= 0) {
+        kv->live_bytes -= header_record_size(read_word(kv, kv->index[i].location));
+    } else {
+        i = (int)kv->index_count++;
+        kv->index[i].key_hash = hash;
+    }
+    kv->index[i].location = location;
+    kv->live_bytes += size;
+    return PICO_OK;
+}
+
+int kvstore_delete(kvstore_t *kv, const char *key) {
+    size_t key_len = strlen(key);
+    int i = key_len && key_len <= PICO_KVSTORE_MAX_KEY_LENGTH ? find_key(kv, key, (uint)key_len, key_hash(key, (uint)key_len)) : -1;
+    if (i < 0) return PICO_ERROR_NOT_FOUND;
+    uint32_t location;
+    int rc = append_record(kv, RECORD_TOMBSTONE, key, (uint)key_len, NULL, 0, &location);
+    if (rc) return rc;
+    remove_from_index(kv, (uint)i);
+    return PICO_OK;
+}
+
+void kvstore_for_each(const kvstore_t *kv, bool (*func)(const char *key, uint key_len, const void *value, size_t len, void *user_data),
+                      void *user_data) {
+    for (uint i = 0; i < kv->index_count; i++) {
+        uint32_t location = kv->index[i].location;
+        uint32_t h = read_word(kv, location);
+        const char *key = (const char *)kv->flash->contents + location + KVSTORE_RECORD_HEADER_SIZE;
+        if (!func(key, h & 0xffu, key + (h & 0xffu), h >> 16, user_data)) break;
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pico/kvstore.h"
+
+#if !PICO_NO_HARDWARE
+#include <string.h>
+#include "hardware/flash.h"
+#include "pico/flash.h"
+
+// PICO_CONFIG: PICO_KVSTORE_FLASH_SAFE_EXECUTE_TIMEOUT_MS, Timeout in milliseconds for flash_safe_execute when programming or erasing the on-chip flash, type=int, default=1000, group=pico_kvstore
+#ifndef PICO_KVSTORE_FLASH_SAFE_EXECUTE_TIMEOUT_MS
+#define PICO_KVSTORE_FLASH_SAFE_EXECUTE_TIMEOUT_MS 1000
+#endif
+
+typedef struct {
+    uint32_t flash_offs;
+    const uint8_t *data;
+    uint32_t len;
+} flash_op_t;
+
+// Programs the whole range with one flash_safe_execute. XIP is only disabled within each flash_range_program call,
+// so the data may itself be in flash; each page is copied to RAM first.
+static void program_range(void *param) {
+    const flash_op_t *op = (const flash_op_t *)param;
+    uint8_t page[FLASH_PAGE_SIZE];
+    uint32_t offs = op->flash_offs;
+    const uint8_t *src = op->data;
+    uint32_t len = op->len;
+    while (len) {
+        uint32_t page_offset = offs & (FLASH_PAGE_SIZE - 1);
+        uint32_t n = MIN(len, FLASH_PAGE_SIZE - page_offset);
+        // the rest of the page is programmed with 0xff, which leaves it unchanged
+        memset(page, 0xff, sizeof(page));
+        memcpy(page + page_offset, src, n);
+        flash_range_program(offs - page_offset, page, FLASH_PAGE_SIZE);
+        offs += n;
+        src += n;
+        len -= n;
+    }
+}
+
+static void erase_sector(void *param) {
+    const flash_op_t *op = (const flash_op_t *)param;
+    flash_range_erase(op->flash_offs, FLASH_SECTOR_SIZE);
+}
+
+static inline uint32_t region_flash_offs(const kvstore_flash_t *flash) {
+    return (uint32_t)((uintptr_t)flash->contents - XIP_BASE);
+}
+
+static int onchip_program(kvstore_flash_t *flash, uint32_t offset, const void *data, uint32_t len) {
+    flash_op_t op = {
+        .flash_offs = region_flash_offs(flash) + offset,
+        .data = (const uint8_t *)data,
+        .len = len,
+    };
+    return flash_safe_execute(program_range, &op, PICO_KVSTORE_FLASH_SAFE_EXECUTE_TIMEOUT_MS);
+}
+
+static int onchip_erase(kvstore_flash_t *flash, uint32_t offset) {
+    flash_op_t op = {
+        .flash_offs = region_flash_offs(flash) + offset,
+    };
+    return flash_safe_execute(erase_sector, &op, PICO_KVSTORE_FLASH_SAFE_EXECUTE_TIMEOUT_MS);
+}
+
+void kvstore_flash_init_onchip(kvstore_flash_t *flash, uint32_t flash_offset, uint32_t sector_count) {
+    *flash = (kvstore_flash_t) {
+        .contents = (const uint8_t *)(XIP_BASE + flash_offset),
+        .sector_size = FLASH_SECTOR_SIZE,
+        .sector_count = sector_count,
+        .program = onchip_program,
+        .erase = onchip_erase,
+    };
+}
+#endif
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include "pico/kvstore.h"
+
+// Counts down a byte of work; returns true if power is lost during it, in which case the byte is left with only
+// some of its bits changed
+static bool lose_power(kvstore_ram_flash_t *ram, uint8_t *byte, uint8_t target) {
+    if (ram->power_cut_countdown < 0) return false;
+    if (ram->power_cut_countdown--) return false;
+    uint8_t partial = (uint8_t)(0x5au ^ (uintptr_t)byte);
+    *byte = (uint8_t)((*byte & ~partial) | (target & partial));
+    ram->powered_off = true;
+    return true;
+}
+
+static int ram_program(kvstore_flash_t *flash, uint32_t offset, const void *data, uint32_t len) {
+    kvstore_ram_flash_t *ram = (kvstore_ram_flash_t *)flash;
+    if (ram->powered_off) return PICO_ERROR_IO;
+    if ((offset | len) & 3u || offset + len > flash->sector_size * flash->sector_count) return PICO_ERROR_INVALID_ARG;
+    ram->program_count++;
+    const uint8_t *src = (const uint8_t *)data;
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t *b = ram->buffer + offset + i;
+        // programming can only clear bits
+        if (lose_power(ram, b, *b & src[i])) return PICO_ERROR_IO;
+        *b &= src[i];
+    }
+    return PICO_OK;
+}
+
+static int ram_erase(kvstore_flash_t *flash, uint32_t offset) {
+    kvstore_ram_flash_t *ram = (kvstore_ram_flash_t *)flash;
+    if (ram->powered_off) return PICO_ERROR_IO;
+    if (offset % flash->sector_size || offset >= flash->sector_size * flash->sector_count) return PICO_ERROR_INVALID_ARG;
+    ram->erase_count++;
+    for (uint32_t i = 0; i < flash->sector_size; i++) {
+        uint8_t *b = ram->buffer + offset + i;
+        if (lose_power(ram, b, 0xff)) return PICO_ERROR_IO;
+        *b = 0xff;
+    }
+    return PICO_OK;
+}
+
+void kvstore_ram_flash_init(kvstore_ram_flash_t *ram, uint8_t *buffer, uint32_t sector_size, uint32_t sector_count) {
+    memset(buffer, 0xff, sector_size * sector_count);
+    *ram = (kvstore_ram_flash_t) {
+        .flash = {
+            .contents = buffer,
+            .sector_size = sector_size,
+            .sector_count = sector_count,
+            .program = ram_program,
+            .erase = ram_erase,
+        },
+        .buffer = buffer,
+        .power_cut_countdown = -1,
+    };
+}
+
+void kvstore_ram_flash_cut_power_after(kvstore_ram_flash_t *ram, int32_t bytes) {
+    ram->power_cut_countdown = bytes;
+}
+
+void kvstore_ram_flash_power_on(kvstore_ram_flash_t *ram) {
+    ram->powered_off = false;
+    ram->power_cut_countdown = -1;
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_MATH_ARRAY_H
+#define _PICO_MATH_ARRAY_H
+
+#include <math.h>
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \file pico/math_array.h
+ *  \defgroup pico_math_array pico_math_array
+ *
+ * \brief Floating point math functions applied to whole arrays
+ *
+ * These functions apply a single or double-precision math function to every element of an array. On the RP2350
+ * Arm cores, the scale, multiply-add and square root functions use dedicated block kernels, running several elements
+ * at once through the FPU (single precision) or the double coprocessor (double precision, when \ref pico_double
+ * uses it). Elsewhere, and for the remaining functions, they are loops over the scalar functions built on top of
+ * whichever \ref pico_float and \ref pico_double implementations are selected. Either way each element produces
+ * exactly the same result as the corresponding scalar function or C expression. The arithmetic functions are
+ * compiled without floating point contraction, so they are never fused into a multiply-accumulate and round like
+ * the equivalent C expression. On platforms without pico_float/pico_double (e.g. PICO_PLATFORM=host) the C library
+ * implementations are used.
+ *
+ * In all cases the output array may be the same as (any of) the input arrays, so the operations can be done in
+ * place; otherwise the arrays must not overlap.
+ */
+
+/*! \brief Calculate the sine of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values in radians
+ * \param count the number of elements
+ */
+void float_sin_array(float *out, const float *in, size_t count);
+
+/*! \brief Calculate the cosine of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values in radians
+ * \param count the number of elements
+ */
+void float_cos_array(float *out, const float *in, size_t count);
+
+/*! \brief Calculate both the sine and cosine of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param sin_out receives the sines
+ * \param cos_out receives the cosines
+ * \param in the input values in radians
+ * \param count the number of elements
+ */
+void float_sincos_array(float *sin_out, float *cos_out, const float *in, size_t count);
+
+/*! \brief Calculate e raised to the power of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values
+ * \param count the number of elements
+ */
+void float_exp_array(float *out, const float *in, size_t count);
+
+/*! \brief Calculate the natural logarithm of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values
+ * \param count the number of elements
+ */
+void float_log_array(float *out, const float *in, size_t count);
+
+/*! \brief Calculate the square root of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values
+ * \param count the number of elements
+ */
+void float_sqrt_array(float *out, const float *in, size_t count);
+
+/*! \brief Scale and offset each element of an array
+ *  \ingroup pico_math_array
+ *
+ * Calculates out[i] = in[i] * scale + offset
+ *
+ * \param out receives the results
+ * \param in the input values
+ * \param scale the value to multiply each element by
+ * \param offset the value to add to each product
+ * \param count the number of elements
+ */
+void float_scale_array(float *out, const float *in, float scale, float offset, size_t count);
+
+/*! \brief Multiply and add corresponding elements of three arrays
+ *  \ingroup pico_math_array
+ *
+ * Calculates out[i] = a[i] * b[i] + c[i]
+ *
+ * \param out receives the results
+ * \param a the first multiplicands
+ * \param b the second multiplicands
+ * \param c the addends
+ * \param count the number of elements
+ */
+void float_mul_add_array(float *out, const float *a, const float *b, const float *c, size_t count);
+
+/*! \brief Calculate the sine of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values in radians
+ * \param count the number of elements
+ */
+void double_sin_array(double *out, const double *in, size_t count);
+
+/*! \brief Calculate the cosine of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values in radians
+ * \param count the number of elements
+ */
+void double_cos_array(double *out, const double *in, size_t count);
+
+/*! \brief Calculate both the sine and cosine of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param sin_out receives the sines
+ * \param cos_out receives the cosines
+ * \param in the input values in radians
+ * \param count the number of elements
+ */
+void double_sincos_array(double *sin_out, double *cos_out, const double *in, size_t count);
+
+/*! \brief Calculate e raised to the power of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values
+ * \param count the number of elements
+ */
+void double_exp_array(double *out, const double *in, size_t count);
+
+/*! \brief Calculate the natural logarithm of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values
+ * \param count the number of elements
+ */
+void double_log_array(double *out, const double *in, size_t count);
+
+/*! \brief Calculate the square root of each element of an array
+ *  \ingroup pico_math_array
+ *
+ * \param out receives the results
+ * \param in the input values
+ * \param count the number of elements
+ */
+void double_sqrt_array(double *out, const double *in, size_t count);
+
+/*! \brief Scale and offset each element of an array
+ *  \ingroup pico_math_array
+ *
+ * Calculates out[i] = in[i] * scale + offset
+ *
+ * \param out receives the results
+ * \param in the input values
+ * \param scale the value to multiply each element by
+ * \param offset the value to add to each product
+ * \param count the number of elements
+ */
+void double_scale_array(double *out, const double *in, double scale, double offset, size_t count);
+
+/*! \brief Multiply and add corresponding elements of three arrays
+ *  \ingroup pico_math_array
+ *
+ * Calculates out[i] = a[i] * b[i] + c[i]
+ *
+ * \param out receives the results
+ * \param a the first multiplicands
+ * \param b the second multiplicands
+ * \param c the addends
+ * \param count the number of elements
+ */
+void double_mul_add_array(double *out, const double *a, const double *b, const double *c, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
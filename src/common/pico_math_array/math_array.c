@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pico/math_array.h"
+
+#if !PICO_NO_HARDWARE
+#include "pico/float.h"
+#include "pico/double.h"
+#endif
+
+// sincosf/sincos are only guaranteed to be available (and cheaper than separate calls) with the SDK implementations
+#if LIB_PICO_FLOAT_PICO && !defined(__riscv)
+#define HAS_SINCOSF 1
+#endif
+#if LIB_PICO_DOUBLE_PICO && !defined(__riscv)
+#define HAS_SINCOS 1
+#endif
+
+// scale/mul_add must round like the C expressions they are documented as, so this file is compiled with
+// -ffp-contract=off (see CMakeLists.txt and BUILD.bazel) to stop them being fused into multiply-adds
+
+// Batch kernels (in math_array_m33.S) for the RP2350 Arm cores: VFP for float, and the DCP for double when the
+// pico_double DCP implementation is in use (which they match exactly). Elsewhere, and for the functions without
+// a kernel, the portable loops below are used; with the soft-float implementations the per-element cost is the
+// wrapped function itself, and only the call overhead from the application is saved.
+#if !PICO_NO_HARDWARE && !PICO_RP2040 && !defined(__riscv) && defined(__ARM_FP) && (__ARM_FP & 4)
+#define MATH_ARRAY_VFP_KERNELS 1
+void __math_array_vfp_scale(float *out, const float *in, const float coeffs[2], size_t count);
+void __math_array_vfp_mul_add(float *out, const float *const in[3], size_t count);
+void __math_array_vfp_sqrt(float *out, const float *in, size_t count);
+#endif
+#if LIB_PICO_DOUBLE_PICO && HAS_DOUBLE_COPROCESSOR && !defined(__riscv)
+#define MATH_ARRAY_DCP_KERNELS 1
+void __math_array_dcp_scale(double *out, const double *in, const double coeffs[2], size_t count);
+void __math_array_dcp_mul_add(double *out, const double *const in[3], size_t count);
+void __math_array_dcp_sqrt(double *out, const double *in, size_t count);
+#endif
+
+#define MATH_ARRAY_UNARY(type, name, func) \
+void type ## _ ## name ## _array(type *out, const type *in, size_t count) { \
+    for (size_t i = 0; i < count; i++) { \
+        out[i] = func(in[i]); \
+    } \
+}
+
+MATH_ARRAY_UNARY(float, sin, sinf)
+MATH_ARRAY_UNARY(float, cos, cosf)
+MATH_ARRAY_UNARY(float, exp, expf)
+MATH_ARRAY_UNARY(float, log, logf)
+
+MATH_ARRAY_UNARY(double, sin, sin)
+MATH_ARRAY_UNARY(double, cos, cos)
+MATH_ARRAY_UNARY(double, exp, exp)
+MATH_ARRAY_UNARY(double, log, log)
+
+void float_sqrt_array(float *out, const float *in, size_t count) {
+#if MATH_ARRAY_VFP_KERNELS
+    __math_array_vfp_sqrt(out, in, count);
+#else
+    for (size_t i = 0; i < count; i++) {
+        out[i] = sqrtf(in[i]);
+    }
+#endif
+}
+
+void double_sqrt_array(double *out, const double *in, size_t count) {
+#if MATH_ARRAY_DCP_KERNELS
+    __math_array_dcp_sqrt(out, in, count);
+#else
+    for (size_t i = 0; i < count; i++) {
+        out[i] = sqrt(in[i]);
+    }
+#endif
+}
+
+void float_sincos_array(float *sin_out, float *cos_out, const float *in, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        float x = in[i];
+#if HAS_SINCOSF
+        sincosf(x, &sin_out[i], &cos_out[i]);
+#else
+        sin_out[i] = sinf(x);
+        cos_out[i] = cosf(x);
+#endif
+    }
+}
+
+void double_sincos_array(double *sin_out, double *cos_out, const double *in, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        double x = in[i];
+#if HAS_SINCOS
+        sincos(x, &sin_out[i], &cos_out[i]);
+#else
+        sin_out[i] = sin(x);
+        cos_out[i] = cos(x);
+#endif
+    }
+}
+
+void float_scale_array(float *out, const float *in, float scale, float offset, size_t count) {
+#if MATH_ARRAY_VFP_KERNELS
+    const float coeffs[2] = {scale, offset};
+    __math_array_vfp_scale(out, in, coeffs, count);
+#else
+    for (size_t i = 0; i < count; i++) {
+        out[i] = in[i] * scale + offset;
+    }
+#endif
+}
+
+void double_scale_array(double *out, const double *in, double scale, double offset, size_t count) {
+#if MATH_ARRAY_DCP_KERNELS
+    const double coeffs[2] = {scale, offset};
+    __math_array_dcp_scale(out, in, coeffs, count);
+#else
+    for (size_t i = 0; i < count; i++) {
+        out[i] = in[i] * scale + offset;
+    }
+#endif
+}
+
+void float_mul_add_array(float *out, const float *a, const float *b, const float *c, size_t count) {
+#if MATH_ARRAY_VFP_KERNELS
+    const float *const in[3] = {a, b, c};
+    __math_array_vfp_mul_add(out, in, count);
+#else
+    for (size_t i = 0; i < count; i++) {
+        out[i] = a[i] * b[i] + c[i];
+    }
+#endif
+}
+
+void double_mul_add_array(double *out, const double *a, const double *b, const double *c, size_t count) {
+#if MATH_ARRAY_DCP_KERNELS
+    const double *const in[3] = {a, b, c};
+    __math_array_dcp_mul_add(out, in, count);
+#else
+    for (size_t i = 0; i < count; i++) {
+        out[i] = a[i] * b[i] + c[i];
+    }
+#endif
+}
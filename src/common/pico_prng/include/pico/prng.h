@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_PRNG_H
+#define _PICO_PRNG_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \file pico/prng.h
+ *  \defgroup pico_prng pico_prng
+ *
+ * \brief Seeded pseudo random number generators for bulk output
+ *
+ * These generators are entirely deterministic, and take no locks. The caller owns the state, seeds it from a
+ * source of entropy, and reseeds it whenever the generator asks. The generators stop producing output once a given
+ * number of bytes has been produced since the last reseed, so a caller cannot forget to reseed.
+ *
+ * Two generators are provided:
+ *
+ *  - xoroshiro128**, which is very fast, but not cryptographically secure; used by \ref get_rand_bytes
+ *  - a ChaCha20 based DRBG, which is cryptographically secure given a good seed; used by
+ *    \ref get_secure_rand_bytes
+ *
+ * \ref pico_rand keeps one of each per core, and reseeds it from its entropy sources.
+ */
+
+// PICO_CONFIG: PICO_PRNG_MAX_SEED_BYTES, Size of the buffer passed to the prng_seed_func_t of a prng_chacha20_per_core_t, type=int, default=256, min=16, group=pico_prng
+#ifndef PICO_PRNG_MAX_SEED_BYTES
+#define PICO_PRNG_MAX_SEED_BYTES 256
+#endif
+
+/*! \brief Clear memory holding secrets in a way the compiler cannot optimize away
+ *  \ingroup pico_prng
+ *
+ * \param p the memory
+ * \param len the size of the memory in bytes
+ */
+void prng_secure_wipe(void *p, size_t len);
+
+/*! \brief State of a xoroshiro128** generator
+ *  \ingroup pico_prng
+ *
+ * A zero initialized state needs reseeding before any output is produced.
+ */
+typedef struct {
+    uint64_t s[2];
+    uint32_t bytes_until_reseed;
+} prng_xoroshiro_t;
+
+/*! \brief Mix a seed into a xoroshiro128** generator
+ *  \ingroup pico_prng
+ *
+ * The seed is hashed and mixed into the existing state, rather than replacing it, so the output depends on every
+ * seed since the state was zero.
+ *
+ * \param prng the generator
+ * \param seed 128 bits of seed, which should contain fresh entropy
+ * \param reseed_interval the number of bytes the generator may produce before it must be reseeded again
+ */
+void prng_xoroshiro_reseed(prng_xoroshiro_t *prng, const uint64_t seed[2], uint32_t reseed_interval);
+
+/*! \brief Check whether a xoroshiro128** generator must be reseeded before producing more output
+ *  \ingroup pico_prng
+ *
+ * \param prng the generator
+ * \return true if \ref prng_xoroshiro_fill will produce no output until \ref prng_xoroshiro_reseed is called
+ */
+static inline bool prng_xoroshiro_needs_reseed(const prng_xoroshiro_t *prng) {
+    return !prng->bytes_until_reseed;
+}
+
+/*! \brief Fill a buffer from a xoroshiro128** generator
+ *  \ingroup pico_prng
+ *
+ * Output is produced 8 bytes at a time; any bytes of the last 8 which do not fit in the buffer are discarded.
+ *
+ * \param prng the generator
+ * \param buf the buffer, which need not be aligned
+ * \param len the size of the buffer in bytes
+ * \return the number of bytes written, which is less than len only if the generator needs reseeding
+ */
+size_t prng_xoroshiro_fill(prng_xoroshiro_t *prng, void *buf, size_t len);
+
+/*! \brief Gather a seed for a per core generator
+ *  \ingroup pico_prng
+ *
+ * Called with interrupts enabled whenever the calling core's generator needs reseeding.
+ *
+ * \param seed the buffer to fill, which is 8 byte aligned
+ * \param max_len the size of the buffer in bytes
+ * \return the number of bytes of seed written
+ */
+typedef size_t (*prng_seed_func_t)(void *seed, size_t max_len);
+
+/*! \brief A xoroshiro128** generator per core, reseeded on demand
+ *  \ingroup pico_prng
+ *
+ * The application initializes get_seed and reseed_interval; the generators start zero initialized, so are seeded
+ * before their first output.
+ */
+typedef struct {
+    prng_xoroshiro_t prng[NUM_CORES];
+    prng_seed_func_t get_seed;      ///< gathers 16 bytes of seed for \ref prng_xoroshiro_reseed
+    uint32_t reseed_interval;       ///< the reseed_interval passed to \ref prng_xoroshiro_reseed
+} prng_xoroshiro_per_core_t;
+
+/*! \brief Fill a buffer from the calling core's xoroshiro128** generator
+ *  \ingroup pico_prng
+ *
+ * The generator is only used with interrupts disabled, so that an IRQ on the same core cannot produce the same
+ * bytes again; they are disabled for at most 64 bytes of output at a time. When the generator needs reseeding, the
+ * seed is gathered with interrupts enabled.
+ *
+ * \param pc the generators
+ * \param buf the buffer, which need not be aligned
+ * \param len the size of the buffer in bytes
+ */
+void prng_xoroshiro_per_core_fill(prng_xoroshiro_per_core_t *pc, void *buf, size_t len);
+
+/*! \brief State of a ChaCha20 DRBG
+ *  \ingroup pico_prng
+ *
+ * The output for each request is the ChaCha20 keystream (with a zero nonce, from block 1) of a key used only for that
+ * request. Block 0 of the keystream becomes the generator's next key, so the state after a request reveals nothing
+ * about the output of that request, or of any earlier one ("fast key erasure").
+ *
+ * A zero initialized state needs reseeding before any output is produced.
+ */
+typedef struct {
+    uint32_t key[8];
+    uint32_t bytes_until_reseed;
+} prng_chacha20_t;
+
+/*! \brief Mix a seed into a ChaCha20 DRBG
+ *  \ingroup pico_prng
+ *
+ * The seed is absorbed 32 bytes at a time: each is XORed into the key, which is then replaced by block 0 of its
+ * keystream. The output therefore depends on every seed since the state was zero, and no seed can be recovered
+ * from the state.
+ *
+ * \param prng the generator
+ * \param seed the seed, which should contain at least 256 bits of entropy
+ * \param seed_len the size of the seed in bytes
+ * \param reseed_interval the number of bytes the generator may produce before it must be reseeded again
+ */
+void prng_chacha20_reseed(prng_chacha20_t *prng, const void *seed, size_t seed_len, uint32_t reseed_interval);
+
+/*! \brief Check whether a ChaCha20 DRBG must be reseeded before producing more output
+ *  \ingroup pico_prng
+ *
+ * \param prng the generator
+ * \return true if \ref prng_chacha20_fill will produce no output until \ref prng_chacha20_reseed is called
+ */
+static inline bool prng_chacha20_needs_reseed(const prng_chacha20_t *prng) {
+    return !prng->bytes_until_reseed;
+}
+
+/*! \brief Reserve a request from a ChaCha20 DRBG, replacing its key
+ *  \ingroup pico_prng
+ *
+ * This is the part of \ref prng_chacha20_fill which updates the generator; it computes a single ChaCha20 block.
+ * The output can then be generated from request_key by \ref prng_chacha20_output without any further access to the
+ * generator, e.g. with interrupts enabled, or while another request is reserved.
+ *
+ * \param prng the generator
+ * \param len the size of the request in bytes
+ * \param request_key receives the key for the request, which should be cleared after use
+ * \return the number of bytes which may be generated from request_key, which is less than len only if the generator
+ * needs reseeding (in which case the request key must not be used if 0 is returned)
+ */
+size_t prng_chacha20_reserve(prng_chacha20_t *prng, size_t len, uint32_t request_key[8]);
+
+/*! \brief Generate the output of a request reserved by \ref prng_chacha20_reserve
+ *  \ingroup pico_prng
+ *
+ * \param request_key the key for the request
+ * \param buf the buffer, which need not be aligned
+ * \param len the size of the buffer in bytes, at most the size of the request
+ */
+void prng_chacha20_output(const uint32_t request_key[8], void *buf, size_t len);
+
+/*! \brief Fill a buffer from a ChaCha20 DRBG
+ *  \ingroup pico_prng
+ *
+ * \param prng the generator
+ * \param buf the buffer, which need not be aligned
+ * \param len the size of the buffer in bytes
+ * \return the number of bytes written, which is less than len only if the generator needs reseeding
+ */
+size_t prng_chacha20_fill(prng_chacha20_t *prng, void *buf, size_t len);
+
+/*! \brief A ChaCha20 DRBG per core, reseeded on demand
+ *  \ingroup pico_prng
+ *
+ * The application initializes get_seed and reseed_interval; the DRBGs start zero initialized, so are seeded before
+ * their first output.
+ */
+typedef struct {
+    prng_chacha20_t prng[NUM_CORES];
+    prng_seed_func_t get_seed;      ///< gathers up to \ref PICO_PRNG_MAX_SEED_BYTES of seed for \ref prng_chacha20_reseed
+    uint32_t reseed_interval;       ///< the reseed_interval passed to \ref prng_chacha20_reseed
+} prng_chacha20_per_core_t;
+
+/*! \brief Fill a buffer from the calling core's ChaCha20 DRBG
+ *  \ingroup pico_prng
+ *
+ * Interrupts are disabled only while each request is reserved (see \ref prng_chacha20_reserve), and while the DRBG
+ * is reseeded; the output is generated, and the seed gathered, with interrupts enabled. The seed is cleared after use.
+ *
+ * \param pc the DRBGs
+ * \param buf the buffer, which need not be aligned
+ * \param len the size of the buffer in bytes
+ */
+void prng_chacha20_per_core_fill(prng_chacha20_per_core_t *pc, void *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/*  xoroshiro128ss(), rotl() and splitmix64() are as in pico_rand, after
+
+    Written in 2015 and 2018 by David Blackman and Sebastiano Vigna (vigna@acm.org)
+
+    To the extent possible under law, the author has dedicated all copyright
+    and related and neighboring rights to this software to the public domain
+    worldwide. This software is distributed without any warranty.
+
+    See <http://creativecommons.org/publicdomain/zero/1.0/>
+*/
+
+#include <string.h>
+#include "pico/prng.h"
+#include "hardware/sync.h"
+
+static uint64_t splitmix64(uint64_t x) {
+    uint64_t z = x + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static inline uint64_t rotl(const uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t xoroshiro128ss(uint64_t *s) {
+    const uint64_t s0 = s[0];
+    uint64_t s1 = s[1];
+    const uint64_t result = rotl(s0 * 5, 7) * 9;
+    s1 ^= s0;
+    s[0] = rotl(s0, 24) ^ s1 ^ (s1 << 16); // a, b
+    s[1] = rotl(s1, 37); // c
+    return result;
+}
+
+void prng_xoroshiro_reseed(prng_xoroshiro_t *prng, const uint64_t seed[2], uint32_t reseed_interval) {
+    prng->s[0] ^= splitmix64(seed[0]);
+    prng->s[1] ^= splitmix64(seed[1]);
+    // the state must not be all zeros; this is vanishingly unlikely, but cheap to prevent
+    if (!prng->s[0] && !prng->s[1]) prng->s[1] = 1;
+    // churn, so the first output is not a simple function of the seed
+    (void) xoroshiro128ss(prng->s);
+    prng->bytes_until_reseed = reseed_interval;
+}
+
+size_t prng_xoroshiro_fill(prng_xoroshiro_t *prng, void *buf, size_t len) {
+    size_t n = MIN(len, prng->bytes_until_reseed);
+    uint8_t *p = (uint8_t *) buf;
+    size_t remaining = n;
+    while (remaining >= sizeof(uint64_t)) {
+        uint64_t r = xoroshiro128ss(prng->s);
+        memcpy(p, &r, sizeof(r));
+        p += sizeof(r);
+        remaining -= sizeof(r);
+    }
+    if (remaining) {
+        uint64_t r = xoroshiro128ss(prng->s);
+        memcpy(p, &r, remaining);
+    }
+    prng->bytes_until_reseed -= (uint32_t) n;
+    return n;
+}
+
+// prng_xoroshiro_per_core_fill generates at most this many bytes with interrupts disabled
+#define XOROSHIRO_PER_CORE_CHUNK_SIZE 64
+
+void prng_xoroshiro_per_core_fill(prng_xoroshiro_per_core_t *pc, void *buf, size_t len) {
+    uint8_t *p = (uint8_t *) buf;
+    while (len) {
+        // the generator belongs to this core, so it is only necessary to keep out an IRQ on this core which would
+        // otherwise produce the same bytes again; the core is chosen with interrupts disabled, so the caller (e.g.
+        // a FreeRTOS SMP task) cannot migrate to the other core while using it
+        uint32_t save = save_and_disable_interrupts();
+        size_t n = prng_xoroshiro_fill(&pc->prng[get_core_num()], p, MIN(len, XOROSHIRO_PER_CORE_CHUNK_SIZE));
+        restore_interrupts(save);
+        if (n) {
+            p += n;
+            len -= n;
+        } else {
+            uint64_t seed[2] = {0};
+            pc->get_seed(seed, sizeof(seed));
+            save = save_and_disable_interrupts();
+            prng_xoroshiro_reseed(&pc->prng[get_core_num()], seed, pc->reseed_interval);
+            restore_interrupts(save);
+        }
+    }
+}
+
+// ChaCha20 as in RFC 8439, with a zero nonce
+#define CHACHA20_BLOCK_SIZE_BYTES 64
+
+static inline uint32_t rotl32(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+#define QUARTER_ROUND(a, b, c, d) do { \
+    a += b; d = rotl32(d ^ a, 16); \
+    c += d; b = rotl32(b ^ c, 12); \
+    a += b; d = rotl32(d ^ a, 8); \
+    c += d; b = rotl32(b ^ c, 7); \
+} while (0)
+
+static void __not_in_flash_func(chacha20_block)(const uint32_t key[8], uint32_t counter, uint32_t out[16]) {
+    uint32_t x0 = 0x61707865, x1 = 0x3320646e, x2 = 0x79622d32, x3 = 0x6b206574;
+    uint32_t x4 = key[0], x5 = key[1], x6 = key[2], x7 = key[3];
+    uint32_t x8 = key[4], x9 = key[5], x10 = key[6], x11 = key[7];
+    uint32_t x12 = counter, x13 = 0, x14 = 0, x15 = 0;
+    for (uint i = 0; i < 10; i++) {
+        QUARTER_ROUND(x0, x4, x8, x12);
+        QUARTER_ROUND(x1, x5, x9, x13);
+        QUARTER_ROUND(x2, x6, x10, x14);
+        QUARTER_ROUND(x3, x7, x11, x15);
+        QUARTER_ROUND(x0, x5, x10, x15);
+        QUARTER_ROUND(x1, x6, x11, x12);
+        QUARTER_ROUND(x2, x7, x8, x13);
+        QUARTER_ROUND(x3, x4, x9, x14);
+    }
+    out[0] = x0 + 0x61707865; out[1] = x1 + 0x3320646e; out[2] = x2 + 0x79622d32; out[3] = x3 + 0x6b206574;
+    out[4] = x4 + key[0]; out[5] = x5 + key[1]; out[6] = x6 + key[2]; out[7] = x7 + key[3];
+    out[8] = x8 + key[4]; out[9] = x9 + key[5]; out[10] = x10 + key[6]; out[11] = x11 + key[7];
+    out[12] = x12 + counter; out[13] = x13; out[14] = x14; out[15] = x15;
+}
+
+void prng_secure_wipe(void *p, size_t len) {
+    volatile uint8_t *v = (volatile uint8_t *) p;
+    while (len--) *v++ = 0;
+}
+
+// replace the key with the first half of block 0 of its keystream
+static void chacha20_rekey(uint32_t key[8]) {
+    uint32_t block[16];
+    chacha20_block(key, 0, block);
+    memcpy(key, block, 8 * sizeof(uint32_t));
+    prng_secure_wipe(block, sizeof(block));
+}
+
+void prng_chacha20_reseed(prng_chacha20_t *prng, const void *seed, size_t seed_len, uint32_t reseed_interval) {
+    const uint8_t *p = (const uint8_t *) seed;
+    do {
+        uint32_t chunk[8] = {0};
+        size_t n = MIN(seed_len, sizeof(chunk));
+        memcpy(chunk, p, n);
+        for (uint i = 0; i < 8; i++) {
+            prng->key[i] ^= chunk[i];
+        }
+        prng_secure_wipe(chunk, sizeof(chunk));
+        chacha20_rekey(prng->key);
+        p += n;
+        seed_len -= n;
+    } while (seed_len);
+    prng->bytes_until_reseed = reseed_interval;
+}
+
+size_t prng_chacha20_reserve(prng_chacha20_t *prng, size_t len, uint32_t request_key[8]) {
+    size_t n = MIN(len, prng->bytes_until_reseed);
+    if (n) {
+        memcpy(request_key, prng->key, 8 * sizeof(uint32_t));
+        chacha20_rekey(prng->key);
+        prng->bytes_until_reseed -= (uint32_t) n;
+    }
+    return n;
+}
+
+void prng_chacha20_output(const uint32_t request_key[8], void *buf, size_t len) {
+    uint8_t *p = (uint8_t *) buf;
+    uint32_t block[16];
+    // block 0 was used for the generator's next key
+    for (uint32_t counter = 1; len; counter++) {
+        size_t n = MIN(len, CHACHA20_BLOCK_SIZE_BYTES);
+        chacha20_block(request_key, counter, block);
+        memcpy(p, block, n);
+        p += n;
+        len -= n;
+    }
+    prng_secure_wipe(block, sizeof(block));
+}
+
+size_t prng_chacha20_fill(prng_chacha20_t *prng, void *buf, size_t len) {
+    uint32_t request_key[8];
+    size_t n = prng_chacha20_reserve(prng, len, request_key);
+    if (n) {
+        prng_chacha20_output(request_key, buf, n);
+        prng_secure_wipe(request_key, sizeof(request_key));
+    }
+    return n;
+}
+
+void prng_chacha20_per_core_fill(prng_chacha20_per_core_t *pc, void *buf, size_t len) {
+    uint8_t *p = (uint8_t *) buf;
+    uint32_t request_key[8];
+    while (len) {
+        // only reserving the request updates the DRBG, so only that needs to keep out an IRQ on this core; the core
+        // is chosen with interrupts disabled, so the caller cannot migrate to the other core in between
+        uint32_t save = save_and_disable_interrupts();
+        size_t n = prng_chacha20_reserve(&pc->prng[get_core_num()], len, request_key);
+        restore_interrupts(save);
+        if (n) {
+            prng_chacha20_output(request_key, p, n);
+            p += n;
+            len -= n;
+        } else {
+            uint64_t seed[PICO_PRNG_MAX_SEED_BYTES / sizeof(uint64_t)];
+            size_t seed_len = pc->get_seed(seed, sizeof(seed));
+            save = save_and_disable_interrupts();
+            prng_chacha20_reseed(&pc->prng[get_core_num()], seed, seed_len, pc->reseed_interval);
+            restore_interrupts(save);
+            prng_secure_wipe(seed, seed_len);
+        }
+    }
+    prng_secure_wipe(request_key, sizeof(request_key));
+}
@@ -7,9 +7,22 @@
 #ifndef _PICO_SHA256_H
 #define _PICO_SHA256_H
 
+#include "pico.h"
 #include "pico/time.h"
+
+// PICO_CONFIG: PICO_SHA256_SOFTWARE, Use the software implementation of SHA-256 rather than the SHA-256 hardware, type=bool, default=1 if there is no SHA-256 hardware (e.g. on RP2040 or the host) otherwise 0, group=pico_sha256
+#ifndef PICO_SHA256_SOFTWARE
+#if defined(SHA256_BASE) && !PICO_NO_HARDWARE
+#define PICO_SHA256_SOFTWARE 0
+#else
+#define PICO_SHA256_SOFTWARE 1
+#endif
+#endif
+
+#if !PICO_SHA256_SOFTWARE
 #include "hardware/dma.h"
 #include "hardware/sha256.h"
+#endif
 
 /** \file pico/sha256.h
  *  \defgroup pico_sha256 pico_sha256
@@ -19,6 +32,11 @@
  * RP2350 is equipped with a hardware accelerated implementation of the SHA-256 hash algorithm.
  * This should be much quicker than performing a SHA-256 checksum in software.
  *
+ * Where there is no SHA-256 hardware (on RP2040, or on the host), or if PICO_SHA256_SOFTWARE is set, the same API
+ * is provided by a software implementation instead. It has no lock, so any number of calculations may be in
+ * progress at once, and the use_dma arguments are ignored. The request queue hashes each job as it is submitted,
+ * calling its callback before \ref pico_sha256_queue_submit returns.
+ *
  * \code
  * pico_sha256_state_t state;
  * if (pico_sha256_try_start(&state, SHA256_BIG_ENDIAN, true) == PICO_OK) {
@@ -42,11 +60,34 @@
 extern "C" {
 #endif
 
+#if PICO_SHA256_SOFTWARE
+// as in hardware/sha256.h
+#define SHA256_RESULT_BYTES 32
+
+enum sha256_endianness {
+    SHA256_LITTLE_ENDIAN, ///< Little Endian
+    SHA256_BIG_ENDIAN,    ///< Big Endian
+};
+
+typedef union {
+    uint32_t words[SHA256_RESULT_BYTES/4];
+    uint8_t  bytes[SHA256_RESULT_BYTES];
+} sha256_result_t;
+#endif
+
 /*! \brief SHA-256 state used by the API
  *  \ingroup pico_sha256
  */
 typedef struct pico_sha256_state {
     enum sha256_endianness endianness;
+#if PICO_SHA256_SOFTWARE
+    bool locked;
+    uint32_t hash[8];
+    union {
+        uint32_t words[16];
+        uint8_t bytes[64];
+    } block;
+#else
     int8_t channel;
     bool locked;
     uint8_t cache_used;
@@ -55,6 +96,7 @@ typedef struct pico_sha256_state {
         uint8_t bytes[4];
     } cache;
     dma_channel_config config;
+#endif
     size_t total_data_size;
 } pico_sha256_state_t;
 
@@ -153,6 +195,104 @@ void pico_sha256_update_blocking(pico_sha256_state_t *state, const uint8_t *data
  */
 void pico_sha256_finish(pico_sha256_state_t *state, sha256_result_t *out);
 
+// PICO_CONFIG: PICO_SHA256_QUEUE_MAX_BUFFERS, Maximum number of buffers in a job submitted to the SHA-256 request queue, type=int, default=8, group=pico_sha256
+#ifndef PICO_SHA256_QUEUE_MAX_BUFFERS
+#define PICO_SHA256_QUEUE_MAX_BUFFERS 8
+#endif
+
+/*! \brief Maximum size in bytes of a single buffer of a \ref pico_sha256_job_t
+ *  \ingroup pico_sha256
+ *
+ * Each buffer is a single DMA transfer of bytes, so its size must fit the transfer count field of a DMA channel's
+ * TRANS_COUNT register.
+ */
+#define PICO_SHA256_QUEUE_MAX_BUFFER_SIZE 0x0fffffffu
+
+/*! \brief A buffer of data to be hashed by a \ref pico_sha256_job_t
+ *  \ingroup pico_sha256
+ */
+typedef struct {
+    const void *data;
+    size_t size;
+} pico_sha256_buffer_t;
+
+typedef struct pico_sha256_job pico_sha256_job_t;
+
+/*! \brief Callback made from the DMA IRQ handler when a job submitted to the SHA-256 request queue is complete
+ *  \ingroup pico_sha256
+ *
+ * The job's result is valid, and the job may be reused (e.g. submitted again) from within the callback.
+ */
+typedef void (*pico_sha256_job_callback_t)(pico_sha256_job_t *job, void *user_data);
+
+/*! \brief A message to be hashed by the SHA-256 request queue
+ *  \ingroup pico_sha256
+ *
+ * The message is the concatenation of the buffers. The application fills in the fields up to and including
+ * user_data before submitting the job with \ref pico_sha256_queue_submit; the buffers and their contents must
+ * remain valid until the job is done.
+ */
+struct pico_sha256_job {
+    const pico_sha256_buffer_t *buffers;    ///< the buffers making up the message
+    uint buffer_count;                      ///< number of buffers, at most PICO_SHA256_QUEUE_MAX_BUFFERS
+    enum sha256_endianness endianness;      ///< SHA256_BIG_ENDIAN or SHA256_LITTLE_ENDIAN for data in and data out
+    pico_sha256_job_callback_t callback;    ///< called when the job is done, or NULL
+    void *user_data;                        ///< passed to the callback
+    sha256_result_t result;                 ///< the SHA-256 of the message, once the job is done
+    // private
+    volatile bool done;
+    uint8_t padding_size;
+    pico_sha256_job_t *next;
+    uint8_t padding[72];    // at most 0x80, 63 zero bytes and the 8 byte length
+};
+
+/*! \brief Initialize the SHA-256 request queue
+ *  \ingroup pico_sha256
+ *
+ * The request queue hashes messages submitted with \ref pico_sha256_queue_submit one after another, each fed to
+ * the hardware by a chain of DMA transfers, one per buffer and one for the padding, without any intervention from
+ * the CPU until the message is complete. The next job is then started from the DMA IRQ handler, so the SHA-256
+ * hardware is claimed when the queue becomes busy, and released only when it is empty again, rather than for each
+ * message.
+ *
+ * While the queue is busy, the blocking API (e.g. \ref pico_sha256_try_start) will find the hardware in use.
+ *
+ * Two DMA channels are claimed, and the DMA IRQ handler runs on the calling core.
+ *
+ * @param dma_irq_index the DMA IRQ to use; 0 for DMA_IRQ_0 or 1 for DMA_IRQ_1
+ * @return PICO_OK, or PICO_ERROR_INSUFFICIENT_RESOURCES if two DMA channels were not available
+ */
+int pico_sha256_queue_init(uint dma_irq_index);
+
+/*! \brief Release the DMA channels used by the SHA-256 request queue
+ *  \ingroup pico_sha256
+ *
+ * There must be no jobs in the queue.
+ */
+void pico_sha256_queue_deinit(void);
+
+/*! \brief Submit a job to the SHA-256 request queue
+ *  \ingroup pico_sha256
+ *
+ * This may be called from either core, or from a job's callback.
+ *
+ * @param job the job, which must not already be in the queue
+ * @return PICO_OK if the job was queued, PICO_ERROR_INVALID_ARG if it has too many buffers or a buffer larger than
+ * \ref PICO_SHA256_QUEUE_MAX_BUFFER_SIZE, or
+ * PICO_ERROR_RESOURCE_IN_USE if the queue was empty and the SHA-256 hardware is in use by the blocking API
+ */
+int pico_sha256_queue_submit(pico_sha256_job_t *job);
+
+/*! \brief Check whether a job submitted to the SHA-256 request queue is done
+ *  \ingroup pico_sha256
+ *
+ * @param job the job
+ * @return true if the job's result is valid
+ */
+static inline bool pico_sha256_job_is_done(const pico_sha256_job_t *job) {
+    return job->done;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -8,10 +8,13 @@
 #include <string.h>
 #include <inttypes.h>
 
+#include "pico/sha256.h"
+
+#if !PICO_SHA256_SOFTWARE
 #include "hardware/sha256.h"
 #include "pico/bootrom/lock.h"
-#include "pico/sha256.h"
 #include "pico/time.h"
+#include "pico/critical_section.h"
 
 // We add one 0x80 byte, then 8 bytes for the size
 #define SHA256_PADDING_DATA_BYTES 9
@@ -189,3 +192,137 @@ void pico_sha256_finish(pico_sha256_state_t *state, sha256_result_t *out) {
     }
     pico_sha256_unlock(state);
 }
+
+// the descriptors loaded into the data channel by the control channel: a {count, read address} pair for each buffer
+// and the padding, followed by a null pair which stops the chain and raises the data channel's IRQ
+typedef struct {
+    uint32_t count;
+    const void *read_addr;
+} sha256_queue_descriptor_t;
+
+static struct {
+    pico_sha256_job_t *head;
+    pico_sha256_job_t *tail;
+    critical_section_t critical_section;
+    pico_sha256_state_t lock_state;
+    uint8_t data_channel;
+    uint8_t control_channel;
+    uint8_t irq_index;
+    sha256_queue_descriptor_t descriptors[PICO_SHA256_QUEUE_MAX_BUFFERS + 2];
+} queue;
+
+static void queue_start_job(pico_sha256_job_t *job) {
+    uint n = 0;
+    for (uint i = 0; i < job->buffer_count; i++) {
+        // a transfer count of zero would not complete, so empty buffers are skipped
+        if (job->buffers[i].size) {
+            queue.descriptors[n++] = (sha256_queue_descriptor_t) {job->buffers[i].size, job->buffers[i].data};
+        }
+    }
+    queue.descriptors[n++] = (sha256_queue_descriptor_t) {job->padding_size, job->padding};
+    queue.descriptors[n] = (sha256_queue_descriptor_t) {0, NULL};
+    sha256_err_not_ready_clear();
+    sha256_set_dma_size(1);
+    sha256_set_bswap(job->endianness == SHA256_BIG_ENDIAN);
+    sha256_start();
+    dma_channel_set_read_addr(queue.control_channel, queue.descriptors, true);
+}
+
+static void queue_irq_handler(__unused uint channel, __unused void *user_data) {
+    pico_sha256_job_t *job = queue.head;
+    if (!job) return;
+    sha256_wait_valid_blocking();
+    sha256_get_result(&job->result, job->endianness);
+    critical_section_enter_blocking(&queue.critical_section);
+    queue.head = job->next;
+    if (queue.head) {
+        queue_start_job(queue.head);
+    } else {
+        queue.tail = NULL;
+        pico_sha256_unlock(&queue.lock_state);
+    }
+    critical_section_exit(&queue.critical_section);
+    job->done = true;
+    if (job->callback) job->callback(job, job->user_data);
+}
+
+int pico_sha256_queue_init(uint dma_irq_index) {
+    int data_channel = dma_claim_unused_channel(false);
+    if (data_channel < 0) return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    int control_channel = dma_claim_unused_channel(false);
+    if (control_channel < 0) {
+        dma_channel_unclaim((uint)data_channel);
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+    if (!critical_section_is_initialized(&queue.critical_section)) {
+        critical_section_init(&queue.critical_section);
+    }
+    queue.data_channel = (uint8_t)data_channel;
+    queue.control_channel = (uint8_t)control_channel;
+    queue.irq_index = (uint8_t)dma_irq_index;
+
+    // the data channel writes bytes to the hardware as it is ready for them, then chains to the control channel
+    // for the next descriptor; it raises its IRQ only when the control channel writes the null descriptor
+    dma_channel_config c = dma_channel_get_default_config(queue.data_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, DREQ_SHA256);
+    channel_config_set_chain_to(&c, queue.control_channel);
+    channel_config_set_irq_quiet(&c, true);
+    dma_channel_configure(queue.data_channel, &c, sha256_get_write_addr(), NULL, 0, false);
+
+    // the control channel writes each descriptor to the data channel's TRANS_COUNT and READ_ADDR_TRIG
+    c = dma_channel_get_default_config(queue.control_channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, 3);
+    dma_channel_configure(queue.control_channel, &c, &dma_hw->ch[queue.data_channel].al3_transfer_count, NULL,
+                          sizeof(sha256_queue_descriptor_t) / 4, false);
+
+    dma_irqn_set_channel_callback(dma_irq_index, queue.data_channel, queue_irq_handler, NULL);
+    return PICO_OK;
+}
+
+void pico_sha256_queue_deinit(void) {
+    assert(!queue.head);
+    dma_irqn_clear_channel_callback(queue.irq_index, queue.data_channel);
+    dma_channel_unclaim(queue.data_channel);
+    dma_channel_unclaim(queue.control_channel);
+}
+
+int pico_sha256_queue_submit(pico_sha256_job_t *job) {
+    if (job->buffer_count > PICO_SHA256_QUEUE_MAX_BUFFERS) return PICO_ERROR_INVALID_ARG;
+    uint64_t total_size = 0;
+    for (uint i = 0; i < job->buffer_count; i++) {
+        // a larger count would spill into the TRANS_COUNT mode field on RP2350
+        if (job->buffers[i].size > PICO_SHA256_QUEUE_MAX_BUFFER_SIZE) return PICO_ERROR_INVALID_ARG;
+        total_size += job->buffers[i].size;
+    }
+    // 0x80, then zeros up to 8 bytes short of a multiple of the block size, then the size in bits, big endian
+    uint padding_size = (uint)(((total_size + SHA256_PADDING_DATA_BYTES + (SHA256_BLOCK_SIZE_BYTES - 1)) & ~(uint64_t)(SHA256_BLOCK_SIZE_BYTES - 1)) - total_size);
+    memset(job->padding, 0, padding_size);
+    job->padding[0] = 0x80;
+    uint64_t size_bits = __builtin_bswap64(total_size * 8);
+    memcpy(job->padding + padding_size - sizeof(size_bits), &size_bits, sizeof(size_bits));
+    job->padding_size = (uint8_t)padding_size;
+    job->next = NULL;
+    job->done = false;
+
+    int rc = PICO_OK;
+    critical_section_enter_blocking(&queue.critical_section);
+    if (queue.tail) {
+        queue.tail->next = job;
+        queue.tail = job;
+    } else if (pico_sha256_lock(&queue.lock_state)) {
+        queue.head = queue.tail = job;
+        queue_start_job(job);
+    } else {
+        rc = PICO_ERROR_RESOURCE_IN_USE;
+    }
+    critical_section_exit(&queue.critical_section);
+    return rc;
+}
+
+#endif
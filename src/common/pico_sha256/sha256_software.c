@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+
+#include "pico/sha256.h"
+
+#if PICO_SHA256_SOFTWARE
+
+#define SHA256_BLOCK_SIZE_BYTES 64
+
+// read every round, so kept in RAM along with sha256_compress
+static const uint32_t __not_in_flash("sha256") sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+static const uint32_t sha256_initial_hash[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+#define ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+#define SIGMA0(x) (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define SIGMA1(x) (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define sigma0(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
+#define sigma1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
+#define CH(e, f, g) ((g) ^ ((e) & ((f) ^ (g))))
+#define MAJ(a, b, c) (((a) & (b)) | ((c) & ((a) | (b))))
+
+// the message schedule is kept in a ring of 16 words, each replaced by the word 16 rounds on when it is next used
+#define W_LOAD(i) w[i]
+#define W_NEXT(i) (w[(i) & 15] += sigma1(w[((i) - 2) & 15]) + w[((i) - 7) & 15] + sigma0(w[((i) - 15) & 15]))
+
+// rather than moving the working variables along after each round, the caller rotates their names
+#define ROUND(a, b, c, d, e, f, g, h, i, W) do { \
+    uint32_t t1 = (h) + SIGMA1(e) + CH(e, f, g) + sha256_k[i] + W(i); \
+    (d) += t1; \
+    (h) = t1 + SIGMA0(a) + MAJ(a, b, c); \
+} while (0)
+
+#define ROUNDS8(i, W) do { \
+    ROUND(a, b, c, d, e, f, g, h, (i) + 0, W); \
+    ROUND(h, a, b, c, d, e, f, g, (i) + 1, W); \
+    ROUND(g, h, a, b, c, d, e, f, (i) + 2, W); \
+    ROUND(f, g, h, a, b, c, d, e, (i) + 3, W); \
+    ROUND(e, f, g, h, a, b, c, d, (i) + 4, W); \
+    ROUND(d, e, f, g, h, a, b, c, (i) + 5, W); \
+    ROUND(c, d, e, f, g, h, a, b, (i) + 6, W); \
+    ROUND(b, c, d, e, f, g, h, a, (i) + 7, W); \
+} while (0)
+
+// As for the hardware, the message is read as big endian words if bswap is set, otherwise as native (little endian)
+// words. Run from RAM (as are the round constants), as the XIP cache would otherwise be thrashed by the rounds and
+// whatever calls them
+static void __not_in_flash_func(sha256_compress)(uint32_t *hash, const uint8_t *data, size_t blocks, bool bswap) {
+    uint32_t w[16];
+    while (blocks--) {
+        if ((uintptr_t)data & 3) {
+            memcpy(w, data, sizeof(w));
+        } else {
+            const uint32_t *words = (const uint32_t *)data;
+            for (uint i = 0; i < 16; i++) {
+                w[i] = words[i];
+            }
+        }
+        if (bswap) {
+            for (uint i = 0; i < 16; i++) {
+                w[i] = __builtin_bswap32(w[i]);
+            }
+        }
+        uint32_t a = hash[0], b = hash[1], c = hash[2], d = hash[3];
+        uint32_t e = hash[4], f = hash[5], g = hash[6], h = hash[7];
+        for (uint i = 0; i < 16; i += 8) {
+            ROUNDS8(i, W_LOAD);
+        }
+        for (uint i = 16; i < 64; i += 8) {
+            ROUNDS8(i, W_NEXT);
+        }
+        hash[0] += a; hash[1] += b; hash[2] += c; hash[3] += d;
+        hash[4] += e; hash[5] += f; hash[6] += g; hash[7] += h;
+        data += SHA256_BLOCK_SIZE_BYTES;
+    }
+}
+
+void pico_sha256_cleanup(pico_sha256_state_t *state) {
+    state->locked = false;
+}
+
+int pico_sha256_try_start(pico_sha256_state_t *state, enum sha256_endianness endianness, __unused bool use_dma) {
+    memset(state, 0, sizeof(*state));
+    state->endianness = endianness;
+    memcpy(state->hash, sha256_initial_hash, sizeof(state->hash));
+    state->locked = true;
+    return PICO_OK;
+}
+
+int pico_sha256_start_blocking_until(pico_sha256_state_t *state, enum sha256_endianness endianness, bool use_dma, __unused absolute_time_t until) {
+    return pico_sha256_try_start(state, endianness, use_dma);
+}
+
+void pico_sha256_update_blocking(pico_sha256_state_t *state, const uint8_t *data, size_t data_size_bytes) {
+    assert(state->locked);
+    bool bswap = state->endianness == SHA256_BIG_ENDIAN;
+    size_t used = state->total_data_size & (SHA256_BLOCK_SIZE_BYTES - 1);
+    state->total_data_size += data_size_bytes;
+    if (used) {
+        // top up the partial block
+        size_t n = MIN(data_size_bytes, SHA256_BLOCK_SIZE_BYTES - used);
+        memcpy(state->block.bytes + used, data, n);
+        if (used + n < SHA256_BLOCK_SIZE_BYTES) return;
+        sha256_compress(state->hash, state->block.bytes, 1, bswap);
+        data += n;
+        data_size_bytes -= n;
+    }
+    // whole blocks are hashed straight from the caller's data
+    size_t blocks = data_size_bytes / SHA256_BLOCK_SIZE_BYTES;
+    if (blocks) {
+        sha256_compress(state->hash, data, blocks, bswap);
+        data += blocks * SHA256_BLOCK_SIZE_BYTES;
+        data_size_bytes -= blocks * SHA256_BLOCK_SIZE_BYTES;
+    }
+    memcpy(state->block.bytes, data, data_size_bytes);
+}
+
+void pico_sha256_update(pico_sha256_state_t *state, const uint8_t *data, size_t data_size_bytes) {
+    pico_sha256_update_blocking(state, data, data_size_bytes);
+}
+
+void pico_sha256_finish(pico_sha256_state_t *state, sha256_result_t *out) {
+    assert(state->locked);
+    // pass NULL to abandon the current hash in case of an error
+    if (out) {
+        bool bswap = state->endianness == SHA256_BIG_ENDIAN;
+        size_t used = state->total_data_size & (SHA256_BLOCK_SIZE_BYTES - 1);
+        // append a single '1' bit, then zeros up to 8 bytes short of a multiple of the block size
+        state->block.bytes[used++] = 0x80;
+        if (used > SHA256_BLOCK_SIZE_BYTES - sizeof(uint64_t)) {
+            memset(state->block.bytes + used, 0, SHA256_BLOCK_SIZE_BYTES - used);
+            sha256_compress(state->hash, state->block.bytes, 1, bswap);
+            used = 0;
+        }
+        memset(state->block.bytes + used, 0, SHA256_BLOCK_SIZE_BYTES - sizeof(uint64_t) - used);
+        // then the size in bits, big endian
+        uint64_t size = __builtin_bswap64((uint64_t)state->total_data_size * 8);
+        memcpy(state->block.bytes + SHA256_BLOCK_SIZE_BYTES - sizeof(uint64_t), &size, sizeof(uint64_t));
+        sha256_compress(state->hash, state->block.bytes, 1, bswap);
+        for (uint i = 0; i < count_of(out->words); i++) {
+            out->words[i] = bswap ? __builtin_bswap32(state->hash[i]) : state->hash[i];
+        }
+    }
+    state->locked = false;
+}
+
+int pico_sha256_queue_init(__unused uint dma_irq_index) {
+    return PICO_OK;
+}
+
+void pico_sha256_queue_deinit(void) {
+}
+
+int pico_sha256_queue_submit(pico_sha256_job_t *job) {
+    if (job->buffer_count > PICO_SHA256_QUEUE_MAX_BUFFERS) return PICO_ERROR_INVALID_ARG;
+    for (uint i = 0; i < job->buffer_count; i++) {
+        if (job->buffers[i].size > PICO_SHA256_QUEUE_MAX_BUFFER_SIZE) return PICO_ERROR_INVALID_ARG;
+    }
+    job->next = NULL;
+    job->done = false;
+    pico_sha256_state_t state;
+    pico_sha256_try_start(&state, job->endianness, false);
+    for (uint i = 0; i < job->buffer_count; i++) {
+        pico_sha256_update_blocking(&state, job->buffers[i].data, job->buffers[i].size);
+    }
+    pico_sha256_finish(&state, &job->result);
+    job->done = true;
+    if (job->callback) job->callback(job, job->user_data);
+    return PICO_OK;
+}
+
+#endif
@@ -10,11 +10,19 @@ include (${CMAKE_DIR}/no_hardware.cmake)
  pico_add_subdirectory(${COMMON_DIR}/boot_picoboot_headers)
  pico_add_subdirectory(${COMMON_DIR}/boot_uf2_headers)
  pico_add_subdirectory(${COMMON_DIR}/hardware_claim) 
+ pico_add_subdirectory(${COMMON_DIR}/hardware_pio_alloc)
  pico_add_subdirectory(${COMMON_DIR}/pico_base_headers)
  pico_add_subdirectory(${COMMON_DIR}/pico_usb_reset_interface_headers)
  pico_add_subdirectory(${COMMON_DIR}/pico_bit_ops_headers)
  pico_add_subdirectory(${COMMON_DIR}/pico_binary_info)
  pico_add_subdirectory(${COMMON_DIR}/pico_divider_headers)
+ pico_add_subdirectory(${COMMON_DIR}/pico_dma_crc)
+ pico_add_subdirectory(${COMMON_DIR}/pico_flash_page_buffer)
+ pico_add_subdirectory(${COMMON_DIR}/pico_hmac_sha256)
+ pico_add_subdirectory(${COMMON_DIR}/pico_kvstore)
+ pico_add_subdirectory(${COMMON_DIR}/pico_math_array)
+ pico_add_subdirectory(${COMMON_DIR}/pico_prng)
+ pico_add_subdirectory(${COMMON_DIR}/pico_sha256)
  pico_add_subdirectory(${COMMON_DIR}/pico_sync)
  pico_add_subdirectory(${COMMON_DIR}/pico_time)
  pico_add_subdirectory(${COMMON_DIR}/pico_util)
@@ -7,6 +7,7 @@
 #ifndef _PICO_RAND_H
 #define _PICO_RAND_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -56,6 +57,16 @@ extern "C" {
 #define PICO_RAND_SEED_ENTROPY_SRC_TIME PICO_RAND_ENTROPY_SRC_TIME
 #endif
 
+// PICO_CONFIG: PICO_RAND_BYTES_RESEED_INTERVAL, Number of bytes get_rand_bytes produces from each core's generator before reseeding it from the entropy sources, type=int, default=4096, min=8, group=pico_rand
+#ifndef PICO_RAND_BYTES_RESEED_INTERVAL
+#define PICO_RAND_BYTES_RESEED_INTERVAL 4096
+#endif
+
+// PICO_CONFIG: PICO_RAND_SECURE_RESEED_INTERVAL, Number of bytes get_secure_rand_bytes produces from each core's DRBG before reseeding it from the entropy sources, type=int, default=65536, min=64, group=pico_rand
+#ifndef PICO_RAND_SECURE_RESEED_INTERVAL
+#define PICO_RAND_SECURE_RESEED_INTERVAL 65536
+#endif
+
 // We provide a maximum of 128 bits entropy in one go
 typedef struct rng_128 {
     uint64_t r[2];
@@ -82,6 +93,29 @@ uint64_t get_rand_64(void);
  */
 uint32_t get_rand_32(void);
 
+/*! \brief Fill a buffer with random bytes
+ *  \ingroup pico_rand
+ *
+ * The bytes come from a per-core xoroshiro128** generator (see \ref pico_prng), which is reseeded from
+ * \ref get_rand_128 every \ref PICO_RAND_BYTES_RESEED_INTERVAL bytes.
+ *
+ * \param buf the buffer
+ * \param len the size of the buffer in bytes
+ */
+void get_rand_bytes(void *buf, size_t len);
+
+/*! \brief Fill a buffer with random bytes from a cryptographically secure generator
+ *  \ingroup pico_rand
+ *
+ * The bytes come from a per-core ChaCha20 DRBG (see \ref pico_prng), which is reseeded from \ref get_rand_128
+ * every \ref PICO_RAND_SECURE_RESEED_INTERVAL bytes. On the host, the only entropy source is the time, so the
+ * output is not actually unpredictable.
+ *
+ * \param buf the buffer
+ * \param len the size of the buffer in bytes
+ */
+void get_secure_rand_bytes(void *buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
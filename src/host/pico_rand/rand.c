@@ -29,6 +29,7 @@
 #include "hardware/timer.h"
 #endif
 #include "hardware/sync.h"
+#include "pico/prng.h"
 
 static bool rng_initialised = false;
 
@@ -159,3 +160,31 @@ void get_rand_128(rng_128_t *ptr128) {
 uint32_t get_rand_32(void) {
     return (uint32_t) get_rand_64();
 }
+
+static size_t rand_bytes_seed(void *seed, __unused size_t max_len) {
+    get_rand_128((rng_128_t *) seed);
+    return sizeof(rng_128_t);
+}
+
+static prng_xoroshiro_per_core_t rand_bytes_prng = {
+    .get_seed = rand_bytes_seed,
+    .reseed_interval = PICO_RAND_BYTES_RESEED_INTERVAL,
+};
+
+void get_rand_bytes(void *buf, size_t len) {
+    prng_xoroshiro_per_core_fill(&rand_bytes_prng, buf, len);
+}
+
+static size_t secure_rand_seed(void *seed, __unused size_t max_len) {
+    get_rand_128((rng_128_t *) seed);
+    return sizeof(rng_128_t);
+}
+
+static prng_chacha20_per_core_t secure_prng = {
+    .get_seed = secure_rand_seed,
+    .reseed_interval = PICO_RAND_SECURE_RESEED_INTERVAL,
+};
+
+void get_secure_rand_bytes(void *buf, size_t len) {
+    prng_chacha20_per_core_fill(&secure_prng, buf, len);
+}
@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include "hardware/dma.h"
 #include "hardware/claim.h"
+#include "hardware/irq.h"
 
 #define DMA_CHAN_STRIDE (DMA_CH1_CTRL_TRIG_OFFSET - DMA_CH0_CTRL_TRIG_OFFSET)
 check_hw_size(dma_channel_hw_t, DMA_CHAN_STRIDE);
@@ -20,6 +21,16 @@ static_assert(NUM_DMA_CHANNELS <= 16, "");
 static uint16_t _claimed;
 static uint8_t _timer_claimed;
 
+static struct {
+    dma_channel_irq_callback_t callback;
+    void *user_data;
+} channel_irq_callbacks[NUM_DMA_CHANNELS];
+// channels with a callback, for each DMA IRQ
+static uint16_t dispatch_channel_mask[NUM_DMA_IRQS];
+// DMA IRQs whose dispatcher is being (or has been) installed, and those whose dispatcher is ready to handle IRQs
+static uint8_t dispatch_installing;
+static volatile uint8_t dispatch_installed;
+
 void dma_channel_claim(uint channel) {
     check_dma_channel_param(channel);
     hw_claim_or_assert((uint8_t *) &_claimed, channel, "DMA channel %d is already claimed");
@@ -70,13 +81,65 @@ bool dma_timer_is_claimed(uint timer) {
     return hw_is_claimed(&_timer_claimed, timer);
 }
 
+static void __isr __not_in_flash_func(dma_irq_dispatch)(void) {
+    uint irq_index = __get_current_exception() - VTABLE_FIRST_IRQ - DMA_IRQ_0;
+    uint32_t pending = dma_hw->irq_ctrl[irq_index].ints & dispatch_channel_mask[irq_index];
+    while (pending) {
+        uint channel = 31u - (uint)__builtin_clz(pending);
+        pending &= ~(1u << channel);
+        // an earlier callback may have aborted this channel and cleared its IRQ, in which case it must not be
+        // reported as complete
+        if (!(dma_hw->irq_ctrl[irq_index].ints & (1u << channel))) continue;
+        // acknowledge first, so the callback may restart the channel
+        dma_hw->irq_ctrl[irq_index].ints = 1u << channel;
+        channel_irq_callbacks[channel].callback(channel, channel_irq_callbacks[channel].user_data);
+    }
+}
+
+void dma_irqn_set_channel_callback(uint irq_index, uint channel, dma_channel_irq_callback_t callback, void *user_data) {
+    invalid_params_if(HARDWARE_DMA, irq_index >= NUM_DMA_IRQS);
+    check_dma_channel_param(channel);
+    invalid_params_if(HARDWARE_DMA, !callback);
+    uint32_t save = hw_claim_lock();
+    channel_irq_callbacks[channel].callback = callback;
+    channel_irq_callbacks[channel].user_data = user_data;
+    dispatch_channel_mask[irq_index] |= (uint16_t)(1u << channel);
+    bool install = !(dispatch_installing & (1u << irq_index));
+    dispatch_installing |= (uint8_t)(1u << irq_index);
+    hw_claim_unlock(save);
+    if (install) {
+        uint irq_num = (uint)dma_get_irq_num(irq_index);
+        irq_add_shared_handler(irq_num, dma_irq_dispatch, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(irq_num, true);
+        save = hw_claim_lock();
+        dispatch_installed |= (uint8_t)(1u << irq_index);
+        hw_claim_unlock(save);
+    } else {
+        // the channel's IRQ must not be enabled until the dispatcher is there to handle it, which another caller
+        // may still be installing
+        while (!(dispatch_installed & (1u << irq_index))) {
+            tight_loop_contents();
+        }
+    }
+    dma_irqn_set_channel_enabled(irq_index, channel, true);
+}
+
+void dma_irqn_clear_channel_callback(uint irq_index, uint channel) {
+    invalid_params_if(HARDWARE_DMA, irq_index >= NUM_DMA_IRQS);
+    check_dma_channel_param(channel);
+    dma_irqn_set_channel_enabled(irq_index, channel, false);
+    uint32_t save = hw_claim_lock();
+    dispatch_channel_mask[irq_index] &= (uint16_t)~(1u << channel);
+    hw_claim_unlock(save);
+}
+
 void dma_channel_cleanup(uint channel) {
     check_dma_channel_param(channel);
     // Disable CHAIN_TO, and disable channel, so that it ignores any further triggers 
     hw_write_masked( &dma_hw->ch[channel].al1_ctrl, (channel << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB) | (0u << DMA_CH0_CTRL_TRIG_EN_LSB), DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS | DMA_CH0_CTRL_TRIG_EN_BITS );
     // disable IRQs first as abort can cause spurious IRQs
     for(uint i=0; i < NUM_DMA_IRQS; i++) {
-        dma_irqn_set_channel_enabled(i, channel, false);
+        dma_irqn_clear_channel_callback(i, channel);
     }
     dma_channel_abort(channel);
     // finally clear the IRQ status, which may have been set during abort
@@ -920,6 +920,40 @@ static inline void dma_irqn_acknowledge_channel(uint irq_index, uint channel) {
     dma_hw->irq_ctrl[irq_index].ints = 1u << channel;
 }
 
+/*! \brief Callback invoked by the DMA IRQ dispatcher for a channel
+ *  \ingroup hardware_dma
+ *
+ * \param channel the DMA channel which raised the IRQ
+ * \param user_data the user_data passed to \ref dma_irqn_set_channel_callback
+ */
+typedef void (*dma_channel_irq_callback_t)(uint channel, void *user_data);
+
+/*! \brief Register a per-channel callback with the DMA IRQ dispatcher
+ *  \ingroup hardware_dma
+ *
+ * Rather than each library installing its own shared handler on DMA_IRQ_N and scanning for its channels,
+ * a single dispatcher is installed (once per DMA IRQ, on the calling core) which acknowledges each pending
+ * channel and invokes the callback registered for it. The channel's IRQ is enabled on DMA_IRQ_N.
+ *
+ * A channel may only have one callback at a time. The dispatcher itself remains installed once added.
+ *
+ * \param irq_index the IRQ index; either 0 or 1 for DMA_IRQ_0 or DMA_IRQ_1
+ * \param channel DMA channel
+ * \param callback the callback, which is called from the IRQ handler after the channel's IRQ has been acknowledged
+ * \param user_data value passed to the callback
+ */
+void dma_irqn_set_channel_callback(uint irq_index, uint channel, dma_channel_irq_callback_t callback, void *user_data);
+
+/*! \brief Remove a per-channel callback from the DMA IRQ dispatcher
+ *  \ingroup hardware_dma
+ *
+ * The channel's IRQ is also disabled on DMA_IRQ_N.
+ *
+ * \param irq_index the IRQ index; either 0 or 1 for DMA_IRQ_0 or DMA_IRQ_1
+ * \param channel DMA channel
+ */
+void dma_irqn_clear_channel_callback(uint irq_index, uint channel);
+
 /*! \brief  Check if DMA channel is busy
  *  \ingroup hardware_dma
  *
@@ -1136,7 +1170,8 @@ static inline int dma_get_irq_num(uint irq_index) {
  *  \ingroup hardware_dma
  *
  * This can be used to cleanup dma channels when they're no longer needed, such that they are in a clean state for reuse.
- * IRQ's for the channel are disabled, any in flight-transfer is aborted and any outstanding interrupts are cleared.
+ * IRQ's for the channel are disabled, any callback registered via \ref dma_irqn_set_channel_callback is removed,
+ * any in flight-transfer is aborted and any outstanding interrupts are cleared.
  * The channel is then clear to be reused for other purposes.
  *
  * \code
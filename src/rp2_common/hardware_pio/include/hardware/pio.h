@@ -37,6 +37,16 @@
 #define PICO_PIO_CLKDIV_ROUND_NEAREST PICO_CLKDIV_ROUND_NEAREST
 #endif
 
+// PICO_CONFIG: PICO_PIO_SHARE_PROGRAMS, Share instruction memory between identical programs added to the same PIO instance (reference counting them so they are only removed by the last pio_remove_program), type=bool, default=0, group=hardware_pio
+#ifndef PICO_PIO_SHARE_PROGRAMS
+#define PICO_PIO_SHARE_PROGRAMS 0
+#endif
+
+// PICO_CONFIG: PICO_PIO_COMPACT_PROGRAMS, Provide pio_compact_programs() to move loaded programs together (this keeps a copy of each loaded program in RAM, as does PICO_PIO_SHARE_PROGRAMS), type=bool, default=0, group=hardware_pio
+#ifndef PICO_PIO_COMPACT_PROGRAMS
+#define PICO_PIO_COMPACT_PROGRAMS 0
+#endif
+
 /** \file hardware/pio.h
  *  \defgroup hardware_pio hardware_pio
  *
@@ -966,6 +976,11 @@ bool pio_can_add_program_at_offset(PIO pio, const pio_program_t *program, uint o
  *
  * See pio_can_add_program() if you need to check whether the program can be loaded
  *
+ * If PICO_PIO_SHARE_PROGRAMS is 1 (it is 0 by default), and an identical program (the same instructions, at an
+ * offset compatible with any origin) is already loaded in this PIO instance, its offset is returned and no further
+ * instruction memory is used, so that many state machines can share one copy. Each successful call should be
+ * matched by a call to pio_remove_program(); the instruction memory is freed by the last one.
+ *
  * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
  * \param program the program definition
  * \return the instruction memory offset the program is loaded at, or negative for error (for
@@ -978,6 +993,9 @@ int pio_add_program(PIO pio, const pio_program_t *program);
  *
  * See pio_can_add_program_at_offset() if you need to check whether the program can be loaded
  *
+ * As with pio_add_program(), if PICO_PIO_SHARE_PROGRAMS is 1, an identical program already loaded at this offset
+ * is shared rather than the call failing.
+ *
  * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
  * \param program the program definition
  * \param offset the instruction memory offset wanted for the start of the program
@@ -989,6 +1007,9 @@ int pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset
 /*! \brief Remove a program from a PIO instance's instruction memory
  *  \ingroup hardware_pio
  *
+ * If the program was added more than once (see pio_add_program()), this releases one reference, and the
+ * instruction memory is only freed when the last is released.
+ *
  * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
  * \param program the program definition
  * \param loaded_offset the loaded offset returned when the program was added
@@ -1002,6 +1023,42 @@ void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offse
  */
 void pio_clear_instruction_memory(PIO pio);
 
+#if PICO_PIO_COMPACT_PROGRAMS
+/*! \brief Callback made by pio_compact_programs() for each program it moves
+ *  \ingroup hardware_pio
+ *
+ * \param pio The PIO instance
+ * \param old_offset the offset the program was loaded at
+ * \param new_offset the offset the program is now loaded at
+ * \param length the program length
+ * \param user_data the user_data passed to pio_compact_programs()
+ */
+typedef void (*pio_program_moved_callback_t)(PIO pio, uint old_offset, uint new_offset, uint length, void *user_data);
+
+/*! \brief Move loaded programs together to make room for larger ones
+ *  \ingroup hardware_pio
+ *
+ * As programs are added and removed, the free instruction memory can become split into gaps too small for a
+ * new program. This moves programs up towards the top of instruction memory so that the free space collects
+ * in as few gaps as possible, relocating their JMPs as pio_add_program() does.
+ *
+ * Programs which are not moved are those loaded at a specific offset (with an origin, or via
+ * pio_add_program_at_offset()), and any which an enabled state machine is executing or wrapping within.
+ * The wrap configuration and program counter of each disabled state machine pointing into a moved program
+ * are updated to match, so it can be re-enabled as is; but the offsets in any saved \ref pio_sm_config, and
+ * the loaded offset to pass to pio_remove_program(), must be updated by the caller, which is what the callback
+ * is for. Note a program added more than once (see pio_add_program()) is reported once.
+ *
+ * This is only available if PICO_PIO_COMPACT_PROGRAMS is 1 (it is 0 by default).
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param callback function to call (after the programs have moved) for each program moved, or NULL
+ * \param user_data passed to the callback
+ * \return the number of programs moved
+ */
+int pio_compact_programs(PIO pio, pio_program_moved_callback_t callback, void *user_data);
+#endif
+
 /*! \brief Resets the state machine to a consistent state, and configures it
  *  \ingroup hardware_pio
  *
@@ -1026,6 +1083,31 @@ void pio_clear_instruction_memory(PIO pio);
  */
 int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config);
 
+/*! \brief Resets several state machines to a consistent state, and configures them
+ *  \ingroup hardware_pio
+ *
+ * This does the same as calling pio_sm_init() for each state machine in sm_mask, but the state machines are
+ * halted, and their internal state and clock dividers reset, all at the same time. Together with
+ * pio_enable_sm_mask_in_sync() this brings up multiple lanes phase aligned, e.g.:
+ *
+ * \code
+ * pio_sm_init_mask(pio, mask, initial_pcs, configs);
+ * pio_sm_set_pindirs_with_mask(pio, first_sm, pin_dirs, pin_mask); // any of the state machines will do
+ * pio_enable_sm_mask_in_sync(pio, mask);
+ * \endcode
+ *
+ * The state machines are left disabled on return from this call.
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm_mask Mask of state machine indexes to initialize
+ * \param initial_pc the initial program memory offset for each state machine, indexed by state machine number
+ * \param configs the configuration to apply to each state machine, indexed by state machine number (an entry, or
+ * configs itself, may be NULL to apply defaults)
+ * \return PICO_OK, or < 0 for an error (see \ref pico_error_codes), in which case some of the state machines may
+ * not have been configured
+ */
+int pio_sm_init_mask(PIO pio, uint32_t sm_mask, const uint initial_pc[], const pio_sm_config *const configs[]);
+
 /*! \brief Enable or disable a PIO state machine
  *  \ingroup hardware_pio
  *
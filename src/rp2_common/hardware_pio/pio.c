@@ -4,9 +4,11 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <string.h>
 #include "hardware/claim.h"
 #include "hardware/pio.h"
 #include "hardware/pio_instructions.h"
+#include "hardware/pio_alloc.h"
 
 // sanity check
 check_hw_layout(pio_hw_t, sm[0].clkdiv, PIO_SM0_CLKDIV_OFFSET);
@@ -63,22 +65,63 @@ bool pio_sm_is_claimed(PIO pio, uint sm) {
 static_assert(PIO_INSTRUCTION_COUNT <= 32, "");
 static uint32_t _used_instruction_space[NUM_PIOS];
 
+// Instruction memory is write only, so to share or move programs keep a copy of the (unrelocated) instructions
+// of each loaded program, along with the length and reference count of the program loaded at each offset (0
+// where no program starts), and which of the programs must stay where they are (i.e. those with an origin, or
+// added at a specific offset). This is 132 bytes per PIO instance, so is only kept when it is needed
+#define PIO_TRACK_LOADED_PROGRAMS (PICO_PIO_SHARE_PROGRAMS || PICO_PIO_COMPACT_PROGRAMS)
+
+#if PIO_TRACK_LOADED_PROGRAMS
+typedef struct {
+    uint16_t instr[PIO_INSTRUCTION_COUNT];
+    uint8_t length[PIO_INSTRUCTION_COUNT];
+    uint8_t refcount[PIO_INSTRUCTION_COUNT];
+    uint32_t fixed;
+} loaded_programs_t;
+static loaded_programs_t _loaded_programs[NUM_PIOS];
+#endif
+
+static uint16_t relocate_instruction(PIO pio, uint16_t instr, uint offset) {
+#if PICO_PIO_USE_GPIO_BASE
+    if (pio_instr_bits_wait == _pio_major_instr_bits(instr) && !((_pio_arg1(instr) & 3u))) {
+        // wait GPIO will include only the 5 lower bits of the GPIO number, so if the GPIO
+        // base is 16 we need to flip bit 4 (which is equivalent to subtracting 16 from
+        // the original number 16-47 stored as 16-31 and 0-15)
+        static_assert(PIO_GPIOBASE_BITS == 16, ""); // only works for gpio base being 0 or 16
+        instr ^= (uint16_t)pio_get_gpio_base(pio);
+    }
+#else
+    ((void)pio);
+#endif
+    return pio_instr_bits_jmp != _pio_major_instr_bits(instr) ? instr : (uint16_t)(instr + offset);
+}
+
+#if PICO_PIO_SHARE_PROGRAMS
+// is an identical copy of the program already loaded at offset (and able to take another reference)?
+static bool is_program_loaded_at(PIO pio, const pio_program_t *program, uint offset) {
+    const loaded_programs_t *loaded = &_loaded_programs[pio_get_index(pio)];
+    if (offset + program->length > PIO_INSTRUCTION_COUNT) return false;
+    if (loaded->length[offset] != program->length || !loaded->refcount[offset] || loaded->refcount[offset] == UINT8_MAX) {
+        return false;
+    }
+    // note the GPIO base can't change while programs are loaded, so comparing the unrelocated instructions is enough
+    return !memcmp(&loaded->instr[offset], program->instructions, program->length * sizeof(uint16_t));
+}
+#endif
+
 static int find_offset_for_program(PIO pio, const pio_program_t *program) {
     assert(program->length <= PIO_INSTRUCTION_COUNT);
-    uint32_t used_mask = _used_instruction_space[pio_get_index(pio)];
-    uint32_t program_mask = (1u << program->length) - 1;
+#if PICO_PIO_SHARE_PROGRAMS
     if (program->origin >= 0) {
-        if (program->origin > 32 - program->length) return PICO_ERROR_GENERIC;
-        return used_mask & (program_mask << program->origin) ? -1 : program->origin;
+        if (is_program_loaded_at(pio, program, (uint)program->origin)) return program->origin;
     } else {
-        // work down from the top always
-        for (int i = 32 - program->length; i >= 0; i--) {
-            if (!(used_mask & (program_mask << (uint) i))) {
-                return i;
-            }
+        for (uint i = 0; i + program->length <= PIO_INSTRUCTION_COUNT; i++) {
+            if (is_program_loaded_at(pio, program, i)) return (int)i;
         }
-        return PICO_ERROR_INSUFFICIENT_RESOURCES;
     }
+#endif
+    return pio_alloc_find_offset(_used_instruction_space[pio_get_index(pio)], program->length, program->origin,
+                                 PICO_PIO_BEST_FIT_PLACEMENT);
 }
 
 static int pio_set_gpio_base_unsafe(PIO pio, uint gpio_base) {
@@ -137,6 +180,9 @@ static int add_program_at_offset_check(PIO pio, const pio_program_t *program, ui
 #endif
     if (!is_program_gpio_compatible(pio, program)) return PICO_ERROR_BAD_ALIGNMENT; // todo better error?
     if (program->origin >= 0 && (uint)program->origin != offset) return PICO_ERROR_BAD_ALIGNMENT; // todo better error?
+#if PICO_PIO_SHARE_PROGRAMS
+    if (is_program_loaded_at(pio, program, offset)) return PICO_OK;
+#endif
     uint32_t used_mask = _used_instruction_space[pio_get_index(pio)];
     uint32_t program_mask = (1u << program->length) - 1;
     return (used_mask & (program_mask << offset)) ? PICO_ERROR_INSUFFICIENT_RESOURCES : PICO_OK;
@@ -157,21 +203,26 @@ bool pio_can_add_program_at_offset(PIO pio, const pio_program_t *program, uint o
     return rc;
 }
 
-static int add_program_at_offset(PIO pio, const pio_program_t *program, uint offset) {
+static int add_program_at_offset(PIO pio, const pio_program_t *program, uint offset, bool fixed) {
     int rc = add_program_at_offset_check(pio, program, offset);
     if (rc != 0) return rc;
-    for (uint i = 0; i < program->length; ++i) {
-        uint16_t instr = program->instructions[i];
-#if PICO_PIO_USE_GPIO_BASE
-        if (pio_instr_bits_wait == _pio_major_instr_bits(instr) && !((_pio_arg1(instr) & 3u))) {
-            // wait GPIO will include only the 5 lower bits of the GPIO number, so if the GPIO
-            // base is 16 we need to flip bit 4 (which is equivalent to subtracting 16 from
-            // the original number 16-47 stored as 16-31 and 0-15)
-            static_assert(PIO_GPIOBASE_BITS == 16, ""); // only works for gpio base being 0 or 16
-            instr ^= (uint16_t)pio_get_gpio_base(pio);
-        }
+#if PIO_TRACK_LOADED_PROGRAMS
+    loaded_programs_t *loaded = &_loaded_programs[pio_get_index(pio)];
+    if (fixed) loaded->fixed |= 1u << offset;
+#if PICO_PIO_SHARE_PROGRAMS
+    if (is_program_loaded_at(pio, program, offset)) {
+        loaded->refcount[offset]++;
+        return (int)offset;
+    }
 #endif
-        pio->instr_mem[offset + i] = pio_instr_bits_jmp != _pio_major_instr_bits(instr) ? instr : instr + offset;
+    memcpy(&loaded->instr[offset], program->instructions, program->length * sizeof(uint16_t));
+    loaded->length[offset] = (uint8_t)program->length;
+    loaded->refcount[offset] = 1;
+#else
+    ((void)fixed);
+#endif
+    for (uint i = 0; i < program->length; ++i) {
+        pio->instr_mem[offset + i] = relocate_instruction(pio, program->instructions[i], offset);
     }
     uint32_t program_mask = (1u << program->length) - 1;
     _used_instruction_space[pio_get_index(pio)] |= program_mask << offset;
@@ -183,7 +234,7 @@ int pio_add_program(PIO pio, const pio_program_t *program) {
     uint32_t save = hw_claim_lock();
     int offset = find_offset_for_program(pio, program);
     if (offset >= 0) {
-        offset = add_program_at_offset(pio, program, (uint) offset);
+        offset = add_program_at_offset(pio, program, (uint) offset, program->origin >= 0);
     }
     hw_claim_unlock(save);
     return offset;
@@ -191,7 +242,7 @@ int pio_add_program(PIO pio, const pio_program_t *program) {
 
 int pio_add_program_at_offset(PIO pio, const pio_program_t *program, uint offset) {
     uint32_t save = hw_claim_lock();
-    int rc = add_program_at_offset(pio, program, offset);
+    int rc = add_program_at_offset(pio, program, offset, true);
     hw_claim_unlock(save);
     return rc;
 }
@@ -201,6 +252,18 @@ void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offse
     program_mask <<= loaded_offset;
     uint32_t save = hw_claim_lock();
     assert(program_mask == (_used_instruction_space[pio_get_index(pio)] & program_mask));
+#if PIO_TRACK_LOADED_PROGRAMS
+    loaded_programs_t *loaded = &_loaded_programs[pio_get_index(pio)];
+    if (loaded->refcount[loaded_offset] > 1) {
+        // still in use by another user of the same program
+        loaded->refcount[loaded_offset]--;
+        hw_claim_unlock(save);
+        return;
+    }
+    loaded->refcount[loaded_offset] = 0;
+    loaded->length[loaded_offset] = 0;
+    loaded->fixed &= ~(1u << loaded_offset);
+#endif
     _used_instruction_space[pio_get_index(pio)] &= ~program_mask;
     hw_claim_unlock(save);
 }
@@ -208,12 +271,100 @@ void pio_remove_program(PIO pio, const pio_program_t *program, uint loaded_offse
 void pio_clear_instruction_memory(PIO pio) {
     uint32_t save = hw_claim_lock();
     _used_instruction_space[pio_get_index(pio)] = 0;
+#if PIO_TRACK_LOADED_PROGRAMS
+    memset(&_loaded_programs[pio_get_index(pio)], 0, sizeof(loaded_programs_t));
+#endif
     for(uint i=0;i<PIO_INSTRUCTION_COUNT;i++) {
         pio->instr_mem[i] = pio_encode_jmp(i);
     }
     hw_claim_unlock(save);
 }
 
+#if PICO_PIO_COMPACT_PROGRAMS
+// the start offset of the loaded program containing the given instruction offset, as a mask (0 if none)
+static uint32_t program_start_mask_containing(const loaded_programs_t *loaded, uint offset) {
+    for (uint start = offset + 1; start--; ) {
+        if (loaded->length[start]) return offset < start + loaded->length[start] ? 1u << start : 0;
+    }
+    return 0;
+}
+
+static uint relocate_offset(const uint8_t new_offsets[PIO_INSTRUCTION_COUNT], const loaded_programs_t *loaded, uint offset) {
+    uint32_t start_mask = program_start_mask_containing(loaded, offset);
+    if (!start_mask) return offset;
+    uint start = (uint)__builtin_ctz(start_mask);
+    return offset - start + new_offsets[start];
+}
+
+int pio_compact_programs(PIO pio, pio_program_moved_callback_t callback, void *user_data) {
+    check_pio_param(pio);
+    struct {
+        uint8_t from, to, length;
+    } moves[PIO_INSTRUCTION_COUNT];
+    uint move_count = 0;
+    uint32_t save = hw_claim_lock();
+    loaded_programs_t *loaded = &_loaded_programs[pio_get_index(pio)];
+    uint32_t fixed = loaded->fixed;
+    uint32_t enabled = (pio->ctrl & PIO_CTRL_SM_ENABLE_BITS) >> PIO_CTRL_SM_ENABLE_LSB;
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (!(enabled & (1u << sm))) continue;
+        // leave alone any program a running state machine may be executing or wrapping within
+        uint32_t execctrl = pio->sm[sm].execctrl;
+        fixed |= program_start_mask_containing(loaded, pio_sm_get_pc(pio, sm));
+        fixed |= program_start_mask_containing(loaded, (execctrl & PIO_SM0_EXECCTRL_WRAP_BOTTOM_BITS) >> PIO_SM0_EXECCTRL_WRAP_BOTTOM_LSB);
+        fixed |= program_start_mask_containing(loaded, (execctrl & PIO_SM0_EXECCTRL_WRAP_TOP_BITS) >> PIO_SM0_EXECCTRL_WRAP_TOP_LSB);
+    }
+    uint8_t new_offsets[PIO_INSTRUCTION_COUNT];
+    if (pio_alloc_plan_compaction(loaded->length, fixed, new_offsets)) {
+        // the moved programs only overlap free space or each other's old locations, so build the new state
+        // from a copy of the old
+        loaded_programs_t old = *loaded;
+        memset(loaded, 0, sizeof(loaded_programs_t));
+        uint32_t used_mask = 0;
+        for (uint from = 0; from < PIO_INSTRUCTION_COUNT; from++) {
+            uint length = old.length[from];
+            if (!length) continue;
+            uint to = new_offsets[from];
+            memcpy(&loaded->instr[to], &old.instr[from], length * sizeof(uint16_t));
+            loaded->length[to] = (uint8_t)length;
+            loaded->refcount[to] = old.refcount[from];
+            if (old.fixed & (1u << from)) loaded->fixed |= 1u << to;
+            used_mask |= ((1u << length) - 1) << to;
+            if (to != from) {
+                for (uint i = 0; i < length; i++) {
+                    pio->instr_mem[to + i] = relocate_instruction(pio, old.instr[from + i], to);
+                }
+                moves[move_count].from = (uint8_t)from;
+                moves[move_count].to = (uint8_t)to;
+                moves[move_count].length = (uint8_t)length;
+                move_count++;
+            }
+        }
+        _used_instruction_space[pio_get_index(pio)] = used_mask;
+        // point stopped state machines which were set up to run a moved program at its new location
+        for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+            if (enabled & (1u << sm)) continue;
+            uint32_t execctrl = pio->sm[sm].execctrl;
+            uint wrap_bottom = relocate_offset(new_offsets, &old, (execctrl & PIO_SM0_EXECCTRL_WRAP_BOTTOM_BITS) >> PIO_SM0_EXECCTRL_WRAP_BOTTOM_LSB);
+            uint wrap_top = relocate_offset(new_offsets, &old, (execctrl & PIO_SM0_EXECCTRL_WRAP_TOP_BITS) >> PIO_SM0_EXECCTRL_WRAP_TOP_LSB);
+            pio->sm[sm].execctrl = (execctrl & ~(PIO_SM0_EXECCTRL_WRAP_TOP_BITS | PIO_SM0_EXECCTRL_WRAP_BOTTOM_BITS)) |
+                                   (wrap_bottom << PIO_SM0_EXECCTRL_WRAP_BOTTOM_LSB) |
+                                   (wrap_top << PIO_SM0_EXECCTRL_WRAP_TOP_LSB);
+            uint pc = pio_sm_get_pc(pio, sm);
+            uint new_pc = relocate_offset(new_offsets, &old, pc);
+            if (new_pc != pc) pio_sm_exec(pio, sm, pio_encode_jmp(new_pc));
+        }
+    }
+    hw_claim_unlock(save);
+    if (callback) {
+        for (uint i = 0; i < move_count; i++) {
+            callback(pio, moves[i].from, moves[i].to, moves[i].length, user_data);
+        }
+    }
+    return (int)move_count;
+}
+#endif
+
 #if !PICO_PIO_USE_GPIO_BASE
 // the 32 pin APIs are the same as the internal method, so collapse them
 #define pio_sm_set_pins_internal pio_sm_set_pins
@@ -266,8 +417,11 @@ void pio_sm_set_pins64(PIO pio, uint sm, uint64_t pins) {
     pio_sm_set_pins_internal(pio, sm, (uint32_t)pins);
 }
 
+// Set the pins (or pin directions) selected by pin_mask, using a "victim" state machine as above. Each run of
+// consecutive selected pins is set 5 at a time, rather than one SET per pin.
+//
 // note pin values/mask bit 0 is relative to current GPIO_BASE
-void pio_sm_set_pins_with_mask_internal(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask) {
+static void set_pins_or_pindirs_with_mask(PIO pio, uint sm, enum pio_src_dest dest, uint32_t values, uint32_t pin_mask) {
     check_pio_param(pio);
     check_sm_param(sm);
     uint32_t pinctrl_saved = pio->sm[sm].pinctrl;
@@ -275,16 +429,25 @@ void pio_sm_set_pins_with_mask_internal(PIO pio, uint sm, uint32_t pin_values, u
     hw_clear_bits(&pio->sm[sm].execctrl, 1u << PIO_SM0_EXECCTRL_OUT_STICKY_LSB);
     while (pin_mask) {
         uint base = (uint)__builtin_ctz(pin_mask);
+        uint32_t run = pin_mask >> base;
+        uint count = ~run ? (uint)__builtin_ctz(~run) : 32;
+        if (count > 5) count = 5;
+        uint32_t count_mask = (1u << count) - 1;
         pio->sm[sm].pinctrl =
-                (1u << PIO_SM0_PINCTRL_SET_COUNT_LSB) |
+                (count << PIO_SM0_PINCTRL_SET_COUNT_LSB) |
                 (base << PIO_SM0_PINCTRL_SET_BASE_LSB);
-        pio_sm_exec(pio, sm, pio_encode_set(pio_pins, (pin_values >> base) & 0x1u));
-        pin_mask &= pin_mask - 1;
+        pio_sm_exec(pio, sm, pio_encode_set(dest, (values >> base) & count_mask));
+        pin_mask &= ~(count_mask << base);
     }
     pio->sm[sm].pinctrl = pinctrl_saved;
     pio->sm[sm].execctrl = execctrl_saved;
 }
 
+// note pin values/mask bit 0 is relative to current GPIO_BASE
+void pio_sm_set_pins_with_mask_internal(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask) {
+    set_pins_or_pindirs_with_mask(pio, sm, pio_pins, pin_values, pin_mask);
+}
+
 #ifndef pio_sm_set_pins_with_mask_internal
 void pio_sm_set_pins_with_mask(PIO pio, uint sm, uint32_t pin_values, uint32_t pin_mask) {
 #if PICO_PIO_USE_GPIO_BASE
@@ -305,21 +468,7 @@ void pio_sm_set_pins_with_mask64(PIO pio, uint sm, uint64_t pin_values, uint64_t
 }
 
 void pio_sm_set_pindirs_with_mask_internal(PIO pio, uint sm, uint32_t pindirs, uint32_t pin_mask) {
-    check_pio_param(pio);
-    check_sm_param(sm);
-    uint32_t pinctrl_saved = pio->sm[sm].pinctrl;
-    uint32_t execctrl_saved = pio->sm[sm].execctrl;
-    hw_clear_bits(&pio->sm[sm].execctrl, 1u << PIO_SM0_EXECCTRL_OUT_STICKY_LSB);
-    while (pin_mask) {
-        uint base = (uint)__builtin_ctz(pin_mask);
-        pio->sm[sm].pinctrl =
-                (1u << PIO_SM0_PINCTRL_SET_COUNT_LSB) |
-                (base << PIO_SM0_PINCTRL_SET_BASE_LSB);
-        pio_sm_exec(pio, sm, pio_encode_set(pio_pindirs, (pindirs >> base) & 0x1u));
-        pin_mask &= pin_mask - 1;
-    }
-    pio->sm[sm].pinctrl = pinctrl_saved;
-    pio->sm[sm].execctrl = execctrl_saved;
+    set_pins_or_pindirs_with_mask(pio, sm, pio_pindirs, pindirs, pin_mask);
 }
 
 #ifndef pio_sm_set_pindirs_with_mask_internal
@@ -362,29 +511,28 @@ int pio_sm_set_consecutive_pindirs(PIO pio, uint sm, uint pin, uint count, bool
     return PICO_OK;
 }
 
+// FIFO debug flags for state machine 0; shifted left by the state machine number for the others
+#define FDEBUG_SM0_BITS ((1u << PIO_FDEBUG_TXOVER_LSB) | (1u << PIO_FDEBUG_RXUNDER_LSB) | \
+                         (1u << PIO_FDEBUG_TXSTALL_LSB) | (1u << PIO_FDEBUG_RXSTALL_LSB))
+
+static int set_config_or_default(PIO pio, uint sm, const pio_sm_config *config) {
+    if (config) return pio_sm_set_config(pio, sm, config);
+    pio_sm_config c = pio_get_default_sm_config();
+    return pio_sm_set_config(pio, sm, &c);
+}
+
 int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config) {
     valid_params_if(HARDWARE_PIO, initial_pc < PIO_INSTRUCTION_COUNT);
     // Halt the machine, set some sensible defaults
     pio_sm_set_enabled(pio, sm, false);
 
-    int rc;
-    if (config) {
-        rc = pio_sm_set_config(pio, sm, config);
-    } else {
-        pio_sm_config c = pio_get_default_sm_config();
-        rc = pio_sm_set_config(pio, sm, &c);
-    }
+    int rc = set_config_or_default(pio, sm, config);
     if (rc) return rc;
 
     pio_sm_clear_fifos(pio, sm);
 
     // Clear FIFO debug flags
-    const uint32_t fdebug_sm_mask =
-            (1u << PIO_FDEBUG_TXOVER_LSB) |
-            (1u << PIO_FDEBUG_RXUNDER_LSB) |
-            (1u << PIO_FDEBUG_TXSTALL_LSB) |
-            (1u << PIO_FDEBUG_RXSTALL_LSB);
-    pio->fdebug = fdebug_sm_mask << sm;
+    pio->fdebug = FDEBUG_SM0_BITS << sm;
 
     // Finally, clear some internal SM state
     pio_sm_restart(pio, sm);
@@ -393,6 +541,29 @@ int pio_sm_init(PIO pio, uint sm, uint initial_pc, const pio_sm_config *config)
     return PICO_OK;
 }
 
+int pio_sm_init_mask(PIO pio, uint32_t sm_mask, const uint initial_pc[], const pio_sm_config *const configs[]) {
+    check_pio_param(pio);
+    valid_params_if(HARDWARE_PIO, sm_mask && sm_mask < (1u << NUM_PIO_STATE_MACHINES));
+    pio_set_sm_mask_enabled(pio, sm_mask, false);
+
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (!(sm_mask & (1u << sm))) continue;
+        valid_params_if(HARDWARE_PIO, initial_pc[sm] < PIO_INSTRUCTION_COUNT);
+        int rc = set_config_or_default(pio, sm, configs ? configs[sm] : NULL);
+        if (rc) return rc;
+        pio_sm_clear_fifos(pio, sm);
+    }
+
+    // the rest is done for all the state machines at once, so they start from the same state
+    pio->fdebug = FDEBUG_SM0_BITS * sm_mask;
+    pio_restart_sm_mask(pio, sm_mask);
+    pio_clkdiv_restart_sm_mask(pio, sm_mask);
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (sm_mask & (1u << sm)) pio_sm_exec(pio, sm, pio_encode_jmp(initial_pc[sm]));
+    }
+    return PICO_OK;
+}
+
 void pio_sm_drain_tx_fifo(PIO pio, uint sm) {
     uint instr = (pio->sm[sm].shiftctrl & PIO_SM0_SHIFTCTRL_AUTOPULL_BITS) ? pio_encode_out(pio_null, 32) :
                  pio_encode_pull(false, false);
@@ -440,7 +611,7 @@ bool pio_claim_free_sm_and_add_program_for_gpio_range(const pio_program_t *progr
                 }
                 int rc = is_gpio_compatible(*pio, required_gpio_ranges) ? PICO_OK : PICO_ERROR_BAD_ALIGNMENT;
                 if (rc == PICO_OK) rc = find_offset_for_program(*pio, program);
-                if (rc >= 0) rc = add_program_at_offset(*pio, program, (uint)rc);
+                if (rc >= 0) rc = add_program_at_offset(*pio, program, (uint)rc, program->origin >= 0);
                 if (rc >= 0) {
                     *sm = (uint) sm_index[0];
                     *offset = (uint) rc;
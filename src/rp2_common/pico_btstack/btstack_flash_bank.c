@@ -6,13 +6,16 @@
 
 #include "pico/btstack_flash_bank.h"
 #include "pico/flash.h"
+#include "pico/flash_page_buffer.h"
 #include "hardware/sync.h"
 #include "hardware/flash.h"
+#include "btstack_run_loop.h"
 #include <string.h>
 
 // Check sizes
 static_assert(PICO_FLASH_BANK_TOTAL_SIZE % (FLASH_SECTOR_SIZE * 2) == 0, "PICO_FLASH_BANK_TOTAL_SIZE invalid");
 static_assert(PICO_FLASH_BANK_TOTAL_SIZE <= PICO_FLASH_SIZE_BYTES, "PICO_FLASH_BANK_TOTAL_SIZE too big");
+static_assert(FLASH_PAGE_BUFFER_PAGE_SIZE == FLASH_PAGE_SIZE, "");
 
 // Size of one bank
 #define PICO_FLASH_BANK_SIZE (PICO_FLASH_BANK_TOTAL_SIZE / 2)
@@ -33,21 +36,50 @@ static uint32_t pico_flash_bank_get_alignment(void * context) {
     return 1;
 }
 
-typedef struct {
-    bool op_is_erase;
-    uintptr_t p0;
-    uintptr_t p1;
-} mutation_operation_t;
-
-static void pico_flash_bank_perform_flash_mutation_operation(void *param) {
-    const mutation_operation_t *mop = (const mutation_operation_t *)param;
-    if (mop->op_is_erase) {
-        flash_range_erase(mop->p0, PICO_FLASH_BANK_SIZE);
-    } else {
-        flash_range_program(mop->p0, (const uint8_t *)mop->p1, FLASH_PAGE_SIZE);
+static void pico_flash_bank_perform_erase(void *param) {
+    flash_range_erase((uint32_t)(uintptr_t)param, PICO_FLASH_BANK_SIZE);
+}
+
+static void pico_flash_bank_perform_program(void *param) {
+    const flash_page_buffer_batch_t *batch = (const flash_page_buffer_batch_t *)param;
+    uint8_t page_data[FLASH_PAGE_SIZE];
+    // XIP is re-enabled by flash_range_program, so the data for the next page can be read from flash
+    for (uint i = 0; i < flash_page_buffer_batch_get_page_count(batch); i++) {
+        uint32_t flash_offs = flash_page_buffer_batch_get_page(batch, i, page_data);
+        flash_range_program(flash_offs, page_data, FLASH_PAGE_SIZE);
     }
 }
 
+static void pico_flash_bank_program_pages(flash_page_buffer_t *buffer, const flash_page_buffer_batch_t *batch) {
+    (void)(buffer);
+    DEBUG_PRINT("program: %u pages\n", flash_page_buffer_batch_get_page_count(batch));
+    // todo choice of timeout and check return code... currently we have no way to return an error
+    //      to the caller anyway. flash_safe_execute asserts by default on problem other than timeout,
+    //      so that's fine for now, and UINT32_MAX is a timeout of 49 days which seems long enough
+    flash_safe_execute(pico_flash_bank_perform_program, (void *)batch, UINT32_MAX);
+}
+
+static flash_page_buffer_t page_buffer = {
+    .program = pico_flash_bank_program_pages,
+    .page_offset = FLASH_PAGE_BUFFER_EMPTY,
+};
+
+#if PICO_FLASH_BANK_WRITE_BACK_DELAY_MS
+static btstack_timer_source_t flush_timer;
+
+static void pico_flash_bank_flush_timer_handler(btstack_timer_source_t *ts) {
+    (void)(ts);
+    flash_page_buffer_flush(&page_buffer);
+}
+#endif
+
+void pico_flash_bank_flush(void) {
+#if PICO_FLASH_BANK_WRITE_BACK_DELAY_MS
+    btstack_run_loop_remove_timer(&flush_timer);
+#endif
+    flash_page_buffer_flush(&page_buffer);
+}
+
 #ifndef pico_flash_bank_get_storage_offset_func
 static inline uint32_t pico_flash_bank_get_fixed_storage_offset(void) {
     static_assert(PICO_FLASH_BANK_STORAGE_OFFSET + PICO_FLASH_BANK_TOTAL_SIZE <= PICO_FLASH_SIZE_BYTES, "PICO_FLASH_BANK_TOTAL_SIZE too big");
@@ -66,14 +98,13 @@ extern uint32_t pico_flash_bank_get_storage_offset_func(void);
 static void pico_flash_bank_erase(void * context, int bank) {
     (void)(context);
     DEBUG_PRINT("erase: bank %d\n", bank);
-    mutation_operation_t mop = {
-            .op_is_erase = true,
-            .p0 = pico_flash_bank_get_storage_offset_func() + (PICO_FLASH_BANK_SIZE * bank),
-    };
+    const uint32_t bank_start_pos = pico_flash_bank_get_storage_offset_func() + (PICO_FLASH_BANK_SIZE * bank);
+    // a buffered page in the bank is simply dropped; one in the other bank must be written before the erase
+    flash_page_buffer_erase(&page_buffer, bank_start_pos, PICO_FLASH_BANK_SIZE);
     // todo choice of timeout and check return code... currently we have no way to return an error
     //      to the caller anyway. flash_safe_execute asserts by default on problem other than timeout,
     //      so that's fine for now, and UINT32_MAX is a timeout of 49 days which seems long enough
-    flash_safe_execute(pico_flash_bank_perform_flash_mutation_operation, &mop, UINT32_MAX);
+    flash_safe_execute(pico_flash_bank_perform_erase, (void *)(uintptr_t)bank_start_pos, UINT32_MAX);
 }
 
 static void pico_flash_bank_read(void *context, int bank, uint32_t offset, uint8_t *buffer, uint32_t size) {
@@ -90,7 +121,10 @@ static void pico_flash_bank_read(void *context, int bank, uint32_t offset, uint8
     if ((offset + size) > PICO_FLASH_BANK_SIZE) return;
 
     // Flash is xip
-    memcpy(buffer, (void *)(XIP_BASE + pico_flash_bank_get_storage_offset_func() + (PICO_FLASH_BANK_SIZE * bank) + offset), size);
+    const uint32_t flash_offs = pico_flash_bank_get_storage_offset_func() + (PICO_FLASH_BANK_SIZE * bank) + offset;
+    memcpy(buffer, (void *)(XIP_BASE + flash_offs), size);
+    // include anything not yet written
+    flash_page_buffer_apply(&page_buffer, flash_offs, buffer, size);
 }
 
 static void pico_flash_bank_write(void * context, int bank, uint32_t offset, const uint8_t *data, uint32_t size) {
@@ -111,58 +145,17 @@ static void pico_flash_bank_write(void * context, int bank, uint32_t offset, con
     // calc bank start position
     const uint32_t bank_start_pos = pico_flash_bank_get_storage_offset_func() + (PICO_FLASH_BANK_SIZE * bank);
 
-    // Calculate first and last page in the bank
-    const uint32_t first_page = offset / FLASH_PAGE_SIZE;
-    const uint32_t last_page = (offset + size + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE;
-
-    // Now we only care about the offset in the first page
-    offset %= FLASH_PAGE_SIZE;
-
-    // Amount of data we've copied
-    uint32_t data_pos = 0;
-    uint32_t size_left = size;
-
-    // Write all the pages required
-    for(uint32_t page = first_page; page < last_page; page++) {
-        uint8_t page_data[FLASH_PAGE_SIZE];
-
-        assert(data_pos < size && size_left <= size);
-
-        // Copy data we're not going to overwrite in the first page
-        if (page == first_page && offset > 0) {
-            memcpy(page_data,
-                (void *)(XIP_BASE + bank_start_pos + (page * FLASH_PAGE_SIZE)),
-                offset);
-        }
-
-        // Copy the data we're not going to overwrite in the last page
-        if (page == last_page - 1 && (offset + size_left) < FLASH_PAGE_SIZE) {
-            memcpy(page_data + offset + size_left,
-                (void *)(XIP_BASE + bank_start_pos + (page * FLASH_PAGE_SIZE) + offset + size_left),
-                FLASH_PAGE_SIZE - offset - size_left);
-        }
-
-        // Now copy the new data into the page
-        const uint32_t size_to_copy = MIN(size_left, FLASH_PAGE_SIZE - offset);
-        memcpy(page_data + offset, data + data_pos, size_to_copy);
-
-        data_pos += size_to_copy;
-        size_left -= size_to_copy;
-
-        // zero offset for the following pages
-        offset = 0;
-
-        // Now program the entire page
-        mutation_operation_t mop = {
-                .op_is_erase = false,
-                .p0 = bank_start_pos + (page * FLASH_PAGE_SIZE),
-                .p1 = (uintptr_t)page_data
-        };
-        // todo choice of timeout and check return code... currently we have no way to return an error
-        //      to the caller anyway. flash_safe_execute asserts by default on problem other than timeout,
-        //      so that's fine for now, and UINT32_MAX is a timeout of 49 days which seems long enough
-        flash_safe_execute(pico_flash_bank_perform_flash_mutation_operation, &mop, UINT32_MAX);
-    }
+    // All the pages are programmed together, in one flash_safe_execute. BTstack often writes small amounts to the
+    // same page in quick succession, so the last page may optionally be held back for a while in case there are more.
+#if PICO_FLASH_BANK_WRITE_BACK_DELAY_MS
+    flash_page_buffer_write(&page_buffer, bank_start_pos + offset, data, size);
+    btstack_run_loop_remove_timer(&flush_timer);
+    btstack_run_loop_set_timer_handler(&flush_timer, pico_flash_bank_flush_timer_handler);
+    btstack_run_loop_set_timer(&flush_timer, PICO_FLASH_BANK_WRITE_BACK_DELAY_MS);
+    btstack_run_loop_add_timer(&flush_timer);
+#else
+    flash_page_buffer_write_through(&page_buffer, bank_start_pos + offset, data, size);
+#endif
 }
 
 static const hal_flash_bank_t pico_flash_bank_instance_obj = {
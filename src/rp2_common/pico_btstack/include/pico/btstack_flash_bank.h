@@ -29,6 +29,11 @@ extern "C" {
 #endif
 #endif
 
+// PICO_CONFIG: PICO_FLASH_BANK_WRITE_BACK_DELAY_MS, Time in milliseconds for which the last page written to is held in RAM so that further writes to it are merged (data written in this time is lost on a reset or power down unless pico_flash_bank_flush is called); 0 writes every page before the write returns, type=int, default=0, group=pico_btstack
+#ifndef PICO_FLASH_BANK_WRITE_BACK_DELAY_MS
+#define PICO_FLASH_BANK_WRITE_BACK_DELAY_MS 0
+#endif
+
 /**
  * \brief Return the singleton BTstack HAL flash instance, used for non-volatile storage
  * \ingroup pico_btstack
@@ -41,6 +46,17 @@ extern "C" {
  */
 const hal_flash_bank_t *pico_flash_bank_instance(void);
 
+/**
+ * \brief Write any data still held in RAM to flash
+ * \ingroup pico_btstack
+ *
+ * By default each write is in flash before it returns, and this does nothing. If \c PICO_FLASH_BANK_WRITE_BACK_DELAY_MS
+ * is non zero, writes to the same flash page are merged, and the page is only written once nothing more has been
+ * written to it for that time. This writes it immediately, e.g. before a reset or power down.
+ * It must be called from the BTstack context.
+ */
+void pico_flash_bank_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
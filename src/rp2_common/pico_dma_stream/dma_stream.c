@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include "pico/dma_stream.h"
+#include "hardware/sync.h"
+
+static inline uint32_t stream_channel_mask(const dma_stream_t *stream) {
+    return (1u << stream->channel[0]) | (1u << stream->channel[1]);
+}
+
+static void stream_arm(dma_stream_t *stream, uint buffer_index) {
+    uint channel = stream->channel[buffer_index];
+    if (stream->config.to_peripheral) {
+        dma_channel_set_read_addr(channel, stream->config.buffers[buffer_index], false);
+    } else {
+        dma_channel_set_write_addr(channel, stream->config.buffers[buffer_index], false);
+    }
+}
+
+// stop both channels such that neither can be re-triggered via CHAIN_TO, and clear any pending IRQ
+static void stream_halt(dma_stream_t *stream) {
+    uint32_t mask = stream_channel_mask(stream);
+    for (uint i = 0; i < 2; i++) {
+        hw_clear_bits(&dma_hw->ch[stream->channel[i]].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+    }
+    dma_hw->abort = mask;
+    while (dma_hw->abort & mask) tight_loop_contents();
+    // abort may cause spurious completion IRQs
+    dma_hw->intr = mask;
+}
+
+static void stream_restart(dma_stream_t *stream) {
+    stream_halt(stream);
+    for (uint i = 0; i < 2; i++) {
+        uint channel = stream->channel[i];
+        stream_arm(stream, i);
+        dma_channel_set_transfer_count(channel, dma_encode_transfer_count(stream->config.transfer_count), false);
+        hw_set_bits(&dma_hw->ch[channel].al1_ctrl, DMA_CH0_CTRL_TRIG_EN_BITS);
+    }
+    dma_channel_start(stream->channel[0]);
+}
+
+static inline uint32_t stream_channel_remaining(uint channel) {
+#if PICO_RP2040
+    return dma_hw->ch[channel].transfer_count;
+#else
+    return dma_hw->ch[channel].transfer_count & DMA_CH0_TRANS_COUNT_COUNT_BITS;
+#endif
+}
+
+static void __not_in_flash_func(stream_buffer_complete)(dma_stream_t *stream, uint buffer_index) {
+    uint channel = stream->channel[buffer_index];
+    uint other_channel = stream->channel[buffer_index ^ 1u];
+    // The partner channel chains back to this one when it completes, so if it has already done so, this
+    // channel was re-triggered with a stale address. The only safe thing to do is to start over.
+    if ((dma_hw->intr & (1u << other_channel)) || dma_channel_is_busy(channel)) {
+        stream->stats.late_rearms++;
+        stream_restart(stream);
+        return;
+    }
+    // a stale IRQ from before a restart; the channel has been re-armed but its buffer was never transferred
+    if (stream_channel_remaining(channel)) return;
+    stream_arm(stream, buffer_index);
+
+    dma_stream_buffer_t completed = {
+        .buffer = stream->config.buffers[buffer_index],
+        .buffer_index = buffer_index,
+        .sequence = stream->stats.buffers_completed++,
+    };
+    if (stream->held[buffer_index]) {
+        // the application was still using this buffer while the DMA transferred it
+        stream->stats.overruns++;
+        return;
+    }
+    if (stream->config.callback) {
+        stream->config.callback(stream, &completed);
+    }
+    if (stream->config.queue) {
+        if (queue_try_add(stream->config.queue, &completed)) {
+            stream->held[buffer_index] = true;
+        } else {
+            stream->stats.overruns++;
+        }
+    }
+}
+
+static void __not_in_flash_func(dma_stream_channel_irq)(uint channel, void *user_data) {
+    dma_stream_t *stream = (dma_stream_t *)user_data;
+    if (!stream->running) return;
+    stream_buffer_complete(stream, channel == stream->channel[0] ? 0 : 1);
+}
+
+dma_stream_config_t dma_stream_get_default_config(void) {
+    dma_stream_config_t config = {
+        .peripheral_addr = NULL,
+        .buffers = { NULL, NULL },
+        .transfer_count = 0,
+        .transfer_size = DMA_SIZE_32,
+        .dreq = DREQ_FORCE,
+        .to_peripheral = false,
+        .irq_index = 0,
+        .callback = NULL,
+        .queue = NULL,
+        .user_data = NULL,
+    };
+    return config;
+}
+
+int dma_stream_init(dma_stream_t *stream, const dma_stream_config_t *config) {
+    if (!config->buffers[0] || !config->buffers[1] || !config->transfer_count || config->irq_index >= NUM_DMA_IRQS) {
+        return PICO_ERROR_INVALID_ARG;
+    }
+    int channel0 = dma_claim_unused_channel(false);
+    int channel1 = channel0 >= 0 ? dma_claim_unused_channel(false) : -1;
+    if (channel1 < 0) {
+        if (channel0 >= 0) dma_channel_unclaim((uint)channel0);
+        return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    }
+    memset(stream, 0, sizeof(*stream));
+    stream->config = *config;
+    stream->channel[0] = (uint8_t)channel0;
+    stream->channel[1] = (uint8_t)channel1;
+
+    for (uint i = 0; i < 2; i++) {
+        uint channel = stream->channel[i];
+        dma_channel_config_t c = dma_channel_get_default_config(channel);
+        channel_config_set_transfer_data_size(&c, config->transfer_size);
+        channel_config_set_read_increment(&c, config->to_peripheral);
+        channel_config_set_write_increment(&c, !config->to_peripheral);
+        channel_config_set_dreq(&c, config->dreq);
+        channel_config_set_chain_to(&c, stream->channel[i ^ 1u]);
+        if (config->to_peripheral) {
+            dma_channel_configure(channel, &c, config->peripheral_addr, config->buffers[i], dma_encode_transfer_count(config->transfer_count), false);
+        } else {
+            dma_channel_configure(channel, &c, config->buffers[i], config->peripheral_addr, dma_encode_transfer_count(config->transfer_count), false);
+        }
+        dma_irqn_set_channel_callback(config->irq_index, channel, dma_stream_channel_irq, stream);
+    }
+    return PICO_OK;
+}
+
+void dma_stream_start(dma_stream_t *stream) {
+    stream->held[0] = stream->held[1] = false;
+    stream->running = true;
+    stream_restart(stream);
+}
+
+void dma_stream_stop(dma_stream_t *stream) {
+    stream->running = false;
+    stream_halt(stream);
+}
+
+void dma_stream_deinit(dma_stream_t *stream) {
+    dma_stream_stop(stream);
+    for (uint i = 0; i < 2; i++) {
+        dma_channel_cleanup(stream->channel[i]);
+        dma_channel_unclaim(stream->channel[i]);
+    }
+}
+
+void dma_stream_get_stats(dma_stream_t *stream, dma_stream_stats_t *stats) {
+    uint32_t save = save_and_disable_interrupts();
+    *stats = stream->stats;
+    restore_interrupts(save);
+}
+
+void dma_stream_reset_stats(dma_stream_t *stream) {
+    uint32_t save = save_and_disable_interrupts();
+    memset(&stream->stats, 0, sizeof(stream->stats));
+    restore_interrupts(save);
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_DMA_STREAM_H
+#define _PICO_DMA_STREAM_H
+
+#include "hardware/dma.h"
+#include "pico/util/queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \file pico/dma_stream.h
+ *  \defgroup pico_dma_stream pico_dma_stream
+ *
+ * \brief Double-buffered (ping-pong) streaming DMA helper
+ *
+ * A DMA stream owns two claimed DMA channels which are chained to each other, each one transferring
+ * into (or out of) its own buffer. While one channel is moving data, the other channel's buffer is handed to
+ * the application, so a peripheral (ADC, PIO, I2S etc.) can be serviced continuously without gaps.
+ *
+ * Completed buffers are delivered either to a callback (called from the DMA IRQ handler) or to a \ref queue_t
+ * of \ref dma_stream_buffer_t elements. In the latter case the application must call \ref dma_stream_release_buffer
+ * once it is done with a buffer.
+ *
+ * The completion IRQ must re-arm a channel before its partner channel finishes, so each buffer should be large
+ * enough to cover the worst case interrupt latency. Buffers that complete before the application released the
+ * previous contents, and channels which were re-triggered before they could be re-armed, are counted in
+ * \ref dma_stream_stats_t.
+ */
+
+typedef struct dma_stream dma_stream_t;
+
+/*! \brief A buffer completed by a DMA stream
+ *  \ingroup pico_dma_stream
+ */
+typedef struct {
+    void *buffer;          ///< The completed buffer
+    uint buffer_index;     ///< The index (0 or 1) of the completed buffer
+    uint32_t sequence;     ///< The number of buffers completed by the stream before this one
+} dma_stream_buffer_t;
+
+/*! \brief Callback invoked from the DMA IRQ handler when a buffer completes
+ *  \ingroup pico_dma_stream
+ *
+ * For a stream reading from a peripheral the buffer has been filled; for a stream writing to a peripheral the buffer
+ * has been consumed and may be refilled. The buffer is considered released when the callback returns.
+ */
+typedef void (*dma_stream_callback_t)(dma_stream_t *stream, const dma_stream_buffer_t *buffer);
+
+/*! \brief Configuration for a DMA stream
+ *  \ingroup pico_dma_stream
+ *
+ * \see dma_stream_get_default_config
+ */
+typedef struct {
+    volatile void *peripheral_addr;           ///< Fixed address of the peripheral data register (e.g. an ADC or PIO FIFO)
+    void *buffers[2];                         ///< The two ping-pong buffers
+    uint transfer_count;                      ///< Number of transfers (of transfer_size) in each buffer
+    dma_channel_transfer_size_t transfer_size;///< Size of each transfer
+    uint dreq;                                ///< DREQ used to pace the transfers
+    bool to_peripheral;                       ///< true to stream from the buffers to the peripheral, false to capture from the peripheral
+    uint irq_index;                           ///< DMA IRQ index (i.e. DMA_IRQ_<n>) used to signal buffer completion
+    dma_stream_callback_t callback;           ///< Callback for completed buffers, or NULL
+    queue_t *queue;                           ///< Queue (with element size sizeof(\ref dma_stream_buffer_t)) for completed buffers, or NULL
+    void *user_data;                          ///< Application data, see \ref dma_stream_get_user_data
+} dma_stream_config_t;
+
+/*! \brief Statistics gathered by a DMA stream
+ *  \ingroup pico_dma_stream
+ */
+typedef struct {
+    uint32_t buffers_completed;  ///< Total number of buffers completed
+    uint32_t overruns;           ///< Buffers that completed while their previous contents had not been released, or the queue was full
+    uint32_t late_rearms;        ///< Times a channel was re-triggered before the IRQ could re-arm it, forcing a restart of the stream
+} dma_stream_stats_t;
+
+struct dma_stream {
+    dma_stream_config_t config;
+    uint8_t channel[2];
+    volatile bool held[2];
+    volatile bool running;
+    dma_stream_stats_t stats;
+};
+
+/*! \brief Get a default DMA stream configuration
+ *  \ingroup pico_dma_stream
+ *
+ * The defaults are 32-bit transfers from the peripheral into memory, unpaced (DREQ_FORCE), signalled via DMA_IRQ_0
+ * with no callback or queue. The caller must at least fill in the peripheral address, buffers and transfer count.
+ *
+ * \return the default configuration
+ */
+dma_stream_config_t dma_stream_get_default_config(void);
+
+/*! \brief Initialize a DMA stream
+ *  \ingroup pico_dma_stream
+ *
+ * Claims two unused DMA channels, configures them to chain to each other, and registers them with the
+ * DMA IRQ dispatcher (see \ref dma_irqn_set_channel_callback) on the DMA IRQ given by the configuration.
+ * The stream is not started.
+ *
+ * \param stream the stream to initialize
+ * \param config the stream configuration, which is copied into the stream
+ * \return PICO_OK on success, PICO_ERROR_INVALID_ARG if the configuration is invalid, or
+ *         PICO_ERROR_INSUFFICIENT_RESOURCES if two DMA channels are not available
+ */
+int dma_stream_init(dma_stream_t *stream, const dma_stream_config_t *config);
+
+/*! \brief Start a DMA stream
+ *  \ingroup pico_dma_stream
+ *
+ * The stream starts with buffer 0. Any buffers still held by the application are treated as released.
+ *
+ * \param stream the stream
+ */
+void dma_stream_start(dma_stream_t *stream);
+
+/*! \brief Stop a DMA stream
+ *  \ingroup pico_dma_stream
+ *
+ * Aborts any in-flight transfer; the partially transferred buffer is not delivered.
+ *
+ * \param stream the stream
+ */
+void dma_stream_stop(dma_stream_t *stream);
+
+/*! \brief Stop a DMA stream and release its DMA channels
+ *  \ingroup pico_dma_stream
+ *
+ * \param stream the stream
+ */
+void dma_stream_deinit(dma_stream_t *stream);
+
+/*! \brief Return a buffer delivered via the stream's queue back to the stream
+ *  \ingroup pico_dma_stream
+ *
+ * This only needs to be called for buffers delivered via a \ref queue_t; buffers passed to a callback
+ * are released when the callback returns.
+ *
+ * \param stream the stream
+ * \param buffer_index the index of the buffer (\ref dma_stream_buffer_t::buffer_index)
+ */
+static inline void dma_stream_release_buffer(dma_stream_t *stream, uint buffer_index) {
+    valid_params_if(HARDWARE_DMA, buffer_index < 2);
+    stream->held[buffer_index] = false;
+}
+
+/*! \brief Get the statistics for a DMA stream
+ *  \ingroup pico_dma_stream
+ *
+ * \param stream the stream
+ * \param stats receives a copy of the statistics
+ */
+void dma_stream_get_stats(dma_stream_t *stream, dma_stream_stats_t *stats);
+
+/*! \brief Reset the statistics for a DMA stream
+ *  \ingroup pico_dma_stream
+ *
+ * \param stream the stream
+ */
+void dma_stream_reset_stats(dma_stream_t *stream);
+
+/*! \brief Get the application data for a DMA stream
+ *  \ingroup pico_dma_stream
+ *
+ * \param stream the stream
+ * \return the user_data from the stream's configuration
+ */
+static inline void *dma_stream_get_user_data(const dma_stream_t *stream) {
+    return stream->config.user_data;
+}
+
+/*! \brief Check if a DMA stream is running
+ *  \ingroup pico_dma_stream
+ *
+ * \param stream the stream
+ * \return true if the stream has been started and not stopped
+ */
+static inline bool dma_stream_is_running(const dma_stream_t *stream) {
+    return stream->running;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+
+static_assert(PICO_FLASH_ERASE_JOB_STEP_SIZE && !(PICO_FLASH_ERASE_JOB_STEP_SIZE % FLASH_SECTOR_SIZE),
+              "PICO_FLASH_ERASE_JOB_STEP_SIZE must be a multiple of FLASH_SECTOR_SIZE");
+
+typedef struct {
+    uint32_t flash_offs;
+    uint32_t count;
+} erase_step_t;
+
+static void erase_step(void *param) {
+    const erase_step_t *step = (const erase_step_t *)param;
+    flash_range_erase(step->flash_offs, step->count);
+}
+
+void flash_erase_job_init(flash_erase_job_t *job, uint32_t flash_offs, uint32_t count, flash_erase_callback_t callback,
+                          void *user_data) {
+    invalid_params_if(HARDWARE_FLASH, flash_offs & (FLASH_SECTOR_SIZE - 1));
+    invalid_params_if(HARDWARE_FLASH, count & (FLASH_SECTOR_SIZE - 1));
+    *job = (flash_erase_job_t) {
+        .flash_offs = flash_offs,
+        .count = count,
+        .callback = callback,
+        .user_data = user_data,
+        .status = PICO_OK,
+    };
+}
+
+int flash_erase_job_step(flash_erase_job_t *job) {
+    if (flash_erase_job_is_done(job)) return job->status;
+    erase_step_t step = {
+        .flash_offs = job->flash_offs + job->erased,
+        .count = MIN(job->count - job->erased, PICO_FLASH_ERASE_JOB_STEP_SIZE),
+    };
+    int rc = flash_safe_execute(erase_step, &step, PICO_FLASH_ERASE_JOB_TIMEOUT_MS);
+    if (rc == PICO_OK) {
+        job->erased += step.count;
+    } else {
+        job->status = rc;
+    }
+    if (job->callback) job->callback(job, job->erased, rc, job->user_data);
+    return rc;
+}
+
+// the FreeRTOS SMP flash safety helper creates a task to lock out the other core, which cannot be done from an IRQ
+#if !PICO_FLASH_SAFE_EXECUTE_SUPPORT_FREERTOS_SMP
+static int64_t erase_job_alarm_callback(__unused alarm_id_t id, void *user_data) {
+    flash_erase_job_t *job = (flash_erase_job_t *)user_data;
+    flash_erase_job_step(job);
+    if (flash_erase_job_is_done(job)) {
+        job->alarm_id = 0;
+        return 0;
+    }
+    // a negative value reschedules relative to now, i.e. after the step just taken
+    return -(int64_t)job->interval_us;
+}
+
+int flash_erase_job_start(flash_erase_job_t *job, uint32_t interval_us) {
+    job->interval_us = interval_us;
+    if (flash_erase_job_is_done(job)) return PICO_OK;
+    // the first step may be taken from within add_alarm_in_us, and may complete the job, in which case no alarm is added
+    alarm_id_t id = add_alarm_in_us(0, erase_job_alarm_callback, job, true);
+    if (id < 0 || (!id && !flash_erase_job_is_done(job))) return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    uint32_t save = save_and_disable_interrupts();
+    if (!flash_erase_job_is_done(job)) job->alarm_id = id;
+    restore_interrupts(save);
+    return PICO_OK;
+}
+
+void flash_erase_job_stop(flash_erase_job_t *job) {
+    if (job->alarm_id > 0) {
+        cancel_alarm(job->alarm_id);
+        job->alarm_id = 0;
+    }
+}
+#endif
+
+int flash_range_erase_sliced(uint32_t flash_offs, uint32_t count, flash_erase_callback_t callback, void *user_data) {
+    flash_erase_job_t job;
+    flash_erase_job_init(&job, flash_offs, count, callback, user_data);
+    while (!flash_erase_job_is_done(&job)) {
+        flash_erase_job_step(&job);
+    }
+    return job.status;
+}
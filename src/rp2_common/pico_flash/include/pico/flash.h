@@ -47,6 +47,12 @@
  *
  * * Set \ref PICO_FLASH_ASSUME_CORE0_SAFE=1 to explicitly say that core 0 is never using flash.
  * * Set \ref PICO_FLASH_ASSUME_CORE1_SAFE=1 to explicitly say that core 1 is never using flash.
+ *
+ * Erasing a large range of flash can take seconds, during which interrupts are disabled and the other core is locked
+ * out. A \ref flash_erase_job_t instead erases the range a step (by default one sector) at a time, each within its own
+ * \ref flash_safe_execute, so that interrupts and the other core run in between. The steps can be run from the
+ * application's own loop via \ref flash_erase_job_step, or in the background from an alarm via
+ * \ref flash_erase_job_start.
  */
 
 #ifdef __cplusplus
@@ -101,6 +107,16 @@ int flash_safe_execute(void (*func)(void *), void *param, uint32_t enter_exit_ti
 #define PICO_FLASH_ASSUME_CORE1_SAFE 0
 #endif
 
+// PICO_CONFIG: PICO_FLASH_ERASE_JOB_STEP_SIZE, Number of bytes erased by each step of a flash_erase_job_t; interrupts are disabled for the duration of a step, type=int, default=FLASH_SECTOR_SIZE (4096), group=pico_flash
+#ifndef PICO_FLASH_ERASE_JOB_STEP_SIZE
+#define PICO_FLASH_ERASE_JOB_STEP_SIZE 4096u
+#endif
+
+// PICO_CONFIG: PICO_FLASH_ERASE_JOB_TIMEOUT_MS, Timeout in milliseconds for the enter/exit phases of the flash_safe_execute for each step of a flash_erase_job_t, type=int, default=1000, group=pico_flash
+#ifndef PICO_FLASH_ERASE_JOB_TIMEOUT_MS
+#define PICO_FLASH_ERASE_JOB_TIMEOUT_MS 1000
+#endif
+
 // PICO_CONFIG: PICO_FLASH_SAFE_EXECUTE_SUPPORT_FREERTOS_SMP, Support using FreeRTOS SMP to make the other core safe during flash_safe_execute, type=bool, default=1 when using FreeRTOS SMP, group=pico_flash
 #ifndef PICO_FLASH_SAFE_EXECUTE_SUPPORT_FREERTOS_SMP
 #if LIB_FREERTOS_KERNEL && FREE_RTOS_KERNEL_SMP // set by RP2040 SMP port
@@ -132,6 +148,115 @@ typedef struct {
  */
 flash_safety_helper_t *get_flash_safety_helper(void);
 
+typedef struct flash_erase_job flash_erase_job_t;
+
+/*! \brief Callback made after each step of a \ref flash_erase_job_t
+ *  \ingroup pico_flash
+ *
+ * \param job the job
+ * \param erased the number of bytes erased so far; the job is complete when this is the number requested
+ * \param status PICO_OK, or the error from \ref flash_safe_execute with which the job has stopped
+ * \param user_data the user data passed when the job was initialized
+ */
+typedef void (*flash_erase_callback_t)(flash_erase_job_t *job, uint32_t erased, int status, void *user_data);
+
+/*! \brief An erase of a range of flash, performed a step at a time
+ *  \ingroup pico_flash
+ *
+ * The contents of this structure are private.
+ */
+struct flash_erase_job {
+    uint32_t flash_offs;
+    uint32_t count;
+    volatile uint32_t erased;
+    flash_erase_callback_t callback;
+    void *user_data;
+    int32_t alarm_id;       ///< alarm_id_t of the alarm running the job, or 0
+    uint32_t interval_us;
+    volatile int status;
+};
+
+/*! \brief Initialize a job to erase a range of flash
+ *  \ingroup pico_flash
+ *
+ * \param job the job
+ * \param flash_offs offset into flash of the range, in bytes; must be a multiple of FLASH_SECTOR_SIZE
+ * \param count number of bytes to erase; must be a multiple of FLASH_SECTOR_SIZE
+ * \param callback called after each step (may be NULL)
+ * \param user_data passed to the callback
+ */
+void flash_erase_job_init(flash_erase_job_t *job, uint32_t flash_offs, uint32_t count, flash_erase_callback_t callback,
+                          void *user_data);
+
+/*! \brief Erase the next step of a job
+ *  \ingroup pico_flash
+ *
+ * Erases up to \ref PICO_FLASH_ERASE_JOB_STEP_SIZE bytes within a \ref flash_safe_execute, then calls the job's callback.
+ *
+ * \param job the job
+ * \return PICO_OK (including if the job was already complete), or the error from \ref flash_safe_execute, which also
+ * stops the job
+ */
+int flash_erase_job_step(flash_erase_job_t *job);
+
+/*! \brief Check whether a job has finished, either by completing or with an error
+ *  \ingroup pico_flash
+ */
+static inline bool flash_erase_job_is_done(const flash_erase_job_t *job) {
+    return job->erased == job->count || job->status != PICO_OK;
+}
+
+/*! \brief Get the status of a job
+ *  \ingroup pico_flash
+ *
+ * \return PICO_OK if the job is complete or in progress, otherwise the error with which it stopped
+ */
+static inline int flash_erase_job_get_status(const flash_erase_job_t *job) {
+    return job->status;
+}
+
+#if !PICO_FLASH_SAFE_EXECUTE_SUPPORT_FREERTOS_SMP
+/*! \brief Run a job in the background, one step per alarm
+ *  \ingroup pico_flash
+ *
+ * The steps, and the job's callback, are run from an alarm on the default alarm pool (i.e. in IRQ context). The calling
+ * core must not otherwise write or erase flash until the job is done.
+ *
+ * \note This function is not available when \ref PICO_FLASH_SAFE_EXECUTE_SUPPORT_FREERTOS_SMP is set, as the FreeRTOS SMP
+ * flash safety helper must be called from a task; call \ref flash_erase_job_step from a task instead.
+ *
+ * \param job the job
+ * \param interval_us the time to leave between the end of one step and the start of the next
+ * \return PICO_OK, or PICO_ERROR_INSUFFICIENT_RESOURCES if no alarm was available
+ */
+int flash_erase_job_start(flash_erase_job_t *job, uint32_t interval_us);
+
+/*! \brief Stop a job started by \ref flash_erase_job_start
+ *  \ingroup pico_flash
+ *
+ * No further steps are started, though if this is called from a core other than the one running the default alarm pool,
+ * a step already in progress there will complete. The job can be resumed by calling \ref flash_erase_job_start or
+ * \ref flash_erase_job_step again.
+ *
+ * \param job the job
+ */
+void flash_erase_job_stop(flash_erase_job_t *job);
+#endif
+
+/*! \brief Erase a range of flash, a step at a time
+ *  \ingroup pico_flash
+ *
+ * This is equivalent to \ref flash_range_erase within \ref flash_safe_execute, except that interrupts and the other core
+ * run between each step, so their latency is bounded by the time taken to erase one step, not the whole range.
+ *
+ * \param flash_offs offset into flash of the range, in bytes; must be a multiple of FLASH_SECTOR_SIZE
+ * \param count number of bytes to erase; must be a multiple of FLASH_SECTOR_SIZE
+ * \param callback called after each step (may be NULL)
+ * \param user_data passed to the callback
+ * \return PICO_OK, or the error from \ref flash_safe_execute
+ */
+int flash_range_erase_sliced(uint32_t flash_offs, uint32_t count, flash_erase_callback_t callback, void *user_data);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <string.h>
+#include "pico/flash_stream.h"
+#include "hardware/dma.h"
+#include "hardware/structs/xip.h"
+
+// the largest number of words which can be streamed at once
+#define MAX_STREAM_WORDS XIP_STREAM_CTR_BITS
+
+static void stream_halt(void) {
+    // halt the stream, discarding any in-flight read, then drain the FIFO so that a new one can be started
+    xip_ctrl_hw->stream_ctr = 0;
+    while (!(xip_ctrl_hw->stat & XIP_STAT_FIFO_EMPTY_BITS)) {
+        (void) xip_ctrl_hw->stream_fifo;
+    }
+}
+
+static void stream_begin(uint32_t flash_offs, uint32_t words) {
+    xip_ctrl_hw->stream_addr = XIP_BASE + flash_offs;
+    xip_ctrl_hw->stream_ctr = words;
+}
+
+static void dma_begin(uint channel, uint32_t *dst, uint32_t words) {
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, DREQ_XIP_STREAM);
+    // the auxiliary bus port of the streaming FIFO is faster to read than STREAM_FIFO
+    dma_channel_configure(channel, &c, dst, (const void *) XIP_AUX_BASE, words, true);
+}
+
+static void fetch(flash_stream_t *stream) {
+    uint32_t len = MIN(stream->remaining, stream->chunk_size);
+    stream->fetch_len = len;
+    if (!len) return;
+    uint32_t words = (len + 3) / 4;
+    stream_begin(stream->flash_offs, words);
+    dma_begin(stream->dma_channel, stream->buffers[stream->fetch_index], words);
+    stream->flash_offs += len;
+    stream->remaining -= len;
+}
+
+int flash_stream_init(flash_stream_t *stream, void *buffer0, void *buffer1, uint32_t chunk_size) {
+    if (!chunk_size || (chunk_size & 3u) || chunk_size / 4 > MAX_STREAM_WORDS ||
+        ((uintptr_t) buffer0 & 3u) || ((uintptr_t) buffer1 & 3u)) {
+        return PICO_ERROR_INVALID_ARG;
+    }
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    *stream = (flash_stream_t) {
+        .buffers = { (uint32_t *) buffer0, (uint32_t *) buffer1 },
+        .chunk_size = chunk_size,
+        .dma_channel = (uint) channel,
+    };
+    return PICO_OK;
+}
+
+int flash_stream_start(flash_stream_t *stream, uint32_t flash_offs, uint32_t size) {
+    if (flash_offs & 3u) return PICO_ERROR_INVALID_ARG;
+    flash_stream_abort(stream);
+    stream->flash_offs = flash_offs;
+    stream->remaining = size;
+    stream->fetch_index = 0;
+    fetch(stream);
+    return PICO_OK;
+}
+
+const void *flash_stream_next(flash_stream_t *stream, uint32_t *len) {
+    uint32_t fetched = stream->fetch_len;
+    if (!fetched) {
+        *len = 0;
+        return NULL;
+    }
+    dma_channel_wait_for_finish_blocking(stream->dma_channel);
+    const void *chunk = stream->buffers[stream->fetch_index];
+    stream->fetch_index ^= 1;
+    fetch(stream);
+    *len = fetched;
+    return chunk;
+}
+
+bool flash_stream_is_chunk_ready(const flash_stream_t *stream) {
+    return !stream->fetch_len || !dma_channel_is_busy(stream->dma_channel);
+}
+
+void flash_stream_abort(flash_stream_t *stream) {
+    if (stream->fetch_len) {
+        dma_channel_abort(stream->dma_channel);
+        stream_halt();
+        stream->fetch_len = 0;
+    }
+    stream->remaining = 0;
+}
+
+void flash_stream_deinit(flash_stream_t *stream) {
+    flash_stream_abort(stream);
+    dma_channel_unclaim(stream->dma_channel);
+}
+
+int flash_stream_read(uint32_t flash_offs, void *dst, uint32_t size) {
+    if ((flash_offs & 3u) || ((uintptr_t) dst & 3u)) return PICO_ERROR_INVALID_ARG;
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    uint32_t *words_dst = (uint32_t *) dst;
+    uint32_t words = size / 4;
+    while (words) {
+        uint32_t n = MIN(words, MAX_STREAM_WORDS);
+        stream_begin(flash_offs, n);
+        dma_begin((uint) channel, words_dst, n);
+        dma_channel_wait_for_finish_blocking((uint) channel);
+        flash_offs += n * 4;
+        words_dst += n;
+        words -= n;
+    }
+    uint32_t tail = size & 3u;
+    if (tail) {
+        stream_begin(flash_offs, 1);
+        while (xip_ctrl_hw->stat & XIP_STAT_FIFO_EMPTY_BITS) {
+            tight_loop_contents();
+        }
+        uint32_t word = xip_ctrl_hw->stream_fifo;
+        memcpy(words_dst, &word, tail);
+    }
+    dma_channel_unclaim((uint) channel);
+    return PICO_OK;
+}
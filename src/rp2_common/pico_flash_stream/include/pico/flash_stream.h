@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_FLASH_STREAM_H
+#define _PICO_FLASH_STREAM_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \file pico/flash_stream.h
+ *  \defgroup pico_flash_stream pico_flash_stream
+ *
+ * \brief Bulk reads from flash via the XIP streaming FIFO and DMA
+ *
+ * Reading a large amount of data (e.g. an asset) from flash through the XIP cache (e.g. with memcpy) evicts
+ * everything else from the cache, including code which is executing from flash. The XIP block can instead stream
+ * a linear range of flash into a FIFO, using otherwise idle flash cycles, without allocating in the cache; this
+ * library drains the FIFO into RAM with DMA.
+ *
+ * A \ref flash_stream_t reads a range of flash a chunk at a time, into two buffers used alternately, so that the
+ * application can process one chunk while the next is fetched:
+ *
+ * \code
+ * static uint32_t buffers[2][256];
+ * flash_stream_t stream;
+ * flash_stream_init(&stream, buffers[0], buffers[1], sizeof(buffers[0]));
+ * flash_stream_start(&stream, ASSET_FLASH_OFFSET, asset_size);
+ * const void *chunk;
+ * uint32_t len;
+ * while ((chunk = flash_stream_next(&stream, &len))) {
+ *     process(chunk, len);
+ * }
+ * \endcode
+ *
+ * There is only one streaming FIFO, so only one stream (or \ref flash_stream_read) may be in progress at a time, and
+ * flash must not be written or erased meanwhile.
+ */
+
+/*! \brief A read of a range of flash, a chunk at a time
+ *  \ingroup pico_flash_stream
+ *
+ * The contents of this structure are private.
+ */
+typedef struct {
+    uint32_t *buffers[2];
+    uint32_t chunk_size;
+    uint32_t flash_offs;    ///< offset of the next chunk to fetch
+    uint32_t remaining;     ///< bytes not yet fetched
+    uint32_t fetch_len;     ///< size in bytes of the chunk being fetched, or 0 if none
+    uint fetch_index;       ///< index of the buffer the chunk is being fetched into
+    uint dma_channel;
+} flash_stream_t;
+
+/*! \brief Initialize a flash stream, claiming a DMA channel
+ *  \ingroup pico_flash_stream
+ *
+ * \param stream the stream
+ * \param buffer0 the first buffer, which must be word aligned
+ * \param buffer1 the second buffer, which must be word aligned
+ * \param chunk_size the size of each buffer in bytes, which must be a non-zero multiple of 4
+ * \return PICO_OK, PICO_ERROR_INVALID_ARG if the buffers are not valid, or PICO_ERROR_INSUFFICIENT_RESOURCES if
+ * no DMA channel was available
+ */
+int flash_stream_init(flash_stream_t *stream, void *buffer0, void *buffer1, uint32_t chunk_size);
+
+/*! \brief Start reading a range of flash, and fetch the first chunk
+ *  \ingroup pico_flash_stream
+ *
+ * Any read already in progress is aborted.
+ *
+ * \param stream the stream
+ * \param flash_offs the offset in flash of the range, which must be word aligned
+ * \param size the size of the range in bytes
+ * \return PICO_OK, or PICO_ERROR_INVALID_ARG if flash_offs is not word aligned
+ */
+int flash_stream_start(flash_stream_t *stream, uint32_t flash_offs, uint32_t size);
+
+/*! \brief Get the next chunk, and start fetching the one after it
+ *  \ingroup pico_flash_stream
+ *
+ * Waits for the chunk to be fetched if need be. The chunk remains valid until the next call, as it is then reused
+ * for the chunk after next.
+ *
+ * \param stream the stream
+ * \param len receives the size of the chunk in bytes, which is the stream's chunk size except for the last chunk
+ * \return the chunk, or NULL if the whole range has been returned
+ */
+const void *flash_stream_next(flash_stream_t *stream, uint32_t *len);
+
+/*! \brief Check whether \ref flash_stream_next would return without waiting
+ *  \ingroup pico_flash_stream
+ *
+ * \param stream the stream
+ * \return true if the next chunk has been fetched, or there are no more chunks
+ */
+bool flash_stream_is_chunk_ready(const flash_stream_t *stream);
+
+/*! \brief Stop the read in progress, if any
+ *  \ingroup pico_flash_stream
+ *
+ * \param stream the stream
+ */
+void flash_stream_abort(flash_stream_t *stream);
+
+/*! \brief Stop the read in progress, if any, and release the stream's DMA channel
+ *  \ingroup pico_flash_stream
+ *
+ * \param stream the stream
+ */
+void flash_stream_deinit(flash_stream_t *stream);
+
+/*! \brief Read a range of flash into RAM, without using the XIP cache
+ *  \ingroup pico_flash_stream
+ *
+ * This blocks until the read is complete. A DMA channel is claimed for the duration.
+ *
+ * \param flash_offs the offset in flash of the range, which must be word aligned
+ * \param dst the destination, which must be word aligned
+ * \param size the size of the range in bytes
+ * \return PICO_OK, PICO_ERROR_INVALID_ARG if flash_offs or dst is not word aligned, or
+ * PICO_ERROR_INSUFFICIENT_RESOURCES if no DMA channel was available
+ */
+int flash_stream_read(uint32_t flash_offs, void *dst, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -5,7 +5,9 @@
  *
  * Builds mbedtls for pico-sdk and implements functions to take advantage of hardware support, if enabled in mbedtls_config.h
  * 
- * * \c \b MBEDTLS_ENTROPY_HARDWARE_ALT, implementation of a hardware entropy collector that uses \ref get_rand_64
- * * \c \b MBEDTLS_SHA256_ALT, use SHA256 hardware acceleration. Only valid if LIB_PICO_SHA256 is defined (i.e. not available for rp2040)
+ * * \c \b MBEDTLS_ENTROPY_HARDWARE_ALT, implementation of a hardware entropy collector that uses \ref get_rand_64, and so the entropy sources of \ref pico_rand
+ * * \c \b MBEDTLS_SHA256_ALT, use SHA256 hardware acceleration. Only valid if LIB_PICO_SHA256 is defined, and only useful where there is SHA256 hardware (i.e. not on rp2040)
  *
+ * \ref pico_mbedtls_rng (in pico/mbedtls.h) may also be passed to mbedtls wherever it takes a random number generator
+ * callback, in place of an mbedtls CTR_DRBG context.
  */
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_MBEDTLS_H
+#define _PICO_MBEDTLS_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! \brief Random number generator callback for mbedtls, from \ref get_secure_rand_bytes
+ *  \ingroup pico_mbedtls
+ *
+ * This has the signature of the f_rng argument taken by mbedtls, so can be used instead of an mbedtls CTR_DRBG
+ * context, e.g. `mbedtls_ssl_conf_rng(&conf, pico_mbedtls_rng, NULL)`, and is much quicker.
+ *
+ * \param p_rng unused
+ * \param output the buffer to fill
+ * \param output_len the size of the buffer in bytes
+ * \return 0
+ */
+int pico_mbedtls_rng(void *p_rng, unsigned char *output, size_t output_len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
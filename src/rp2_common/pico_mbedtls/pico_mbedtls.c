@@ -7,6 +7,7 @@
 #include <string.h>
 #include "pico.h"
 #include "pico/rand.h"
+#include "pico/mbedtls.h"
 #include "mbedtls/sha256.h"
 #include "mbedtls/version.h"
 
@@ -16,15 +17,21 @@
 #define mbedtls_sha256_finish mbedtls_sha256_finish_ret
 #endif
 
-/* Function to feed mbedtls entropy. */
+/* Function to feed mbedtls entropy, registered by mbedtls as a strong source. Each 8 bytes come from get_rand_64,
+ * which mixes fresh samples from pico_rand's run-time entropy sources (the TRNG on RP2350, otherwise the ROSC, see
+ * PICO_RAND_ENTROPY_SRC_xxx) into its state, so the output is only as strong as those sources. The output of
+ * get_secure_rand_bytes is not used, as that of a DRBG is not new entropy. */
 int mbedtls_hardware_poll(void *data __unused, unsigned char *output, size_t len, size_t *olen) {
-    *olen = 0;
-    while(*olen < len) {
-        uint64_t rand_data = get_rand_64();
-        size_t to_copy = MIN(len, sizeof(rand_data));
-        memcpy(output + *olen, &rand_data, to_copy);
-        *olen += to_copy;
+    for (size_t i = 0; i < len; i += sizeof(uint64_t)) {
+        uint64_t r = get_rand_64();
+        memcpy(output + i, &r, MIN(sizeof(r), len - i));
     }
+    *olen = len;
+    return 0;
+}
+
+int pico_mbedtls_rng(__unused void *p_rng, unsigned char *output, size_t output_len) {
+    get_secure_rand_bytes(output, output_len);
     return 0;
 }
 
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_PIO_BLOB_H
+#define _PICO_PIO_BLOB_H
+
+#include "hardware/pio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Loading PIO programs from binary blobs at runtime
+ *  \defgroup pico_pio_blob pico_pio_blob
+ *
+ * pioasm can output programs as self-describing binary blobs (`-o bin` writes the blobs for each program in a
+ * file one after another; `-o c-blob` writes each as a C array) which can be stored anywhere, e.g. in a flash
+ * partition, and loaded without rebuilding the firmware. A blob holds everything the c-sdk output's
+ * `pio_program_t` and `<name>_program_get_default_config()` do:
+ *
+ * | Offset | Size | Contents |
+ * |--------|------|----------|
+ * | 0      | 4    | "PIOB" |
+ * | 4      | 1    | Format version (1) |
+ * | 5      | 1    | Header size; the instructions start at this offset (24) |
+ * | 6      | 1    | Number of instructions (1-32) |
+ * | 7      | 1    | Origin (signed; -1 for relocatable) |
+ * | 8      | 1    | PIO version required |
+ * | 9      | 1    | .wrap_target |
+ * | 10     | 1    | .wrap |
+ * | 11     | 1    | Side-set: bit 7 set if specified, bit 6 pindirs, bit 5 optional, bits 2:0 bit count (including the enable bit) |
+ * | 12     | 1    | Used GPIO ranges (one bit per 16 pins) |
+ * | 13     | 1    | FIFO join (\ref pio_fifo_join) |
+ * | 14     | 1    | IN pin count (0xff if not specified) |
+ * | 15     | 1    | IN shift: bit 0 shift right, bit 1 autopush, bits 7:2 threshold |
+ * | 16     | 1    | OUT pin count (0xff if not specified) |
+ * | 17     | 1    | OUT shift: bit 0 shift right, bit 1 autopull, bits 7:2 threshold |
+ * | 18     | 1    | SET pin count (0xff if not specified) |
+ * | 19     | 1    | MOV STATUS type (\ref pio_mov_status_type; 0xff if not specified) |
+ * | 20     | 1    | MOV STATUS n |
+ * | 21     | 1    | Clock divider fractional part |
+ * | 22     | 2    | Clock divider integer part |
+ * | 24     | 2*n  | Instructions (unrelocated) |
+ *
+ * All multi-byte values are little-endian. Later versions of the format may add fields before the instructions,
+ * updating the header size.
+ */
+
+#define PIO_BLOB_MAGIC 0x424f4950u // "PIOB"
+#define PIO_BLOB_VERSION 1
+#define PIO_BLOB_MIN_HEADER_SIZE 24
+
+/*! \brief A program described by a blob
+ *  \ingroup pico_pio_blob
+ */
+typedef struct pio_blob_program {
+    pio_program_t program;  ///< The program, whose instructions point into the blob
+    const uint8_t *header;  ///< The blob's header
+} pio_blob_program_t;
+
+/*! \brief Validate a blob and describe the program in it
+ *  \ingroup pico_pio_blob
+ *
+ * \param blob the blob, which must be at least 2 byte aligned
+ * \param size the number of bytes available at blob
+ * \param program receives the program; the blob must remain valid for as long as this is used
+ * \return the size of the blob, so that the next program in a file with several can be found, or
+ * PICO_ERROR_INVALID_DATA if it is not a valid blob, PICO_ERROR_VERSION_MISMATCH if it is a later version of the
+ * format, or PICO_ERROR_BAD_ALIGNMENT if it is not aligned
+ */
+int pio_blob_parse(const void *blob, uint size, pio_blob_program_t *program);
+
+/*! \brief Get the default state machine configuration for a program from a blob
+ *  \ingroup pico_pio_blob
+ *
+ * This is equivalent to the `<name>_program_get_default_config()` function in the c-sdk output.
+ *
+ * \param program the program returned by \ref pio_blob_parse
+ * \param offset the instruction memory offset the program is loaded at
+ * \return the configuration
+ */
+pio_sm_config pio_blob_get_default_config(const pio_blob_program_t *program, uint offset);
+
+/*! \brief Load the program from a blob into a PIO instance's instruction memory
+ *  \ingroup pico_pio_blob
+ *
+ * The program is loaded as by \ref pio_add_program; it may be removed again with \ref pio_remove_program,
+ * passing program->program, so that another can be loaded in its place.
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param blob the blob, which must be at least 2 byte aligned
+ * \param size the number of bytes available at blob
+ * \param program receives the program; the blob must remain valid for as long as this is used
+ * \param config if not NULL, receives the program's default state machine configuration
+ * \return the instruction memory offset the program is loaded at, or a negative PICO_ERROR_ value if the blob is
+ * not valid (see \ref pio_blob_parse) or the program cannot be loaded
+ */
+int pio_add_program_from_blob(PIO pio, const void *blob, uint size, pio_blob_program_t *program, pio_sm_config *config);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
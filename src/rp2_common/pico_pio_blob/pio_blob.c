@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pico/pio_blob.h"
+
+#define BLOB_NOT_SET 0xffu
+
+// header offsets
+#define BLOB_VERSION 4
+#define BLOB_HEADER_SIZE 5
+#define BLOB_LENGTH 6
+#define BLOB_ORIGIN 7
+#define BLOB_PIO_VERSION 8
+#define BLOB_WRAP_TARGET 9
+#define BLOB_WRAP 10
+#define BLOB_SIDESET 11
+#define BLOB_USED_GPIO_RANGES 12
+#define BLOB_FIFO_JOIN 13
+#define BLOB_IN_PIN_COUNT 14
+#define BLOB_IN_SHIFT 15
+#define BLOB_OUT_PIN_COUNT 16
+#define BLOB_OUT_SHIFT 17
+#define BLOB_SET_PIN_COUNT 18
+#define BLOB_MOV_STATUS_TYPE 19
+#define BLOB_MOV_STATUS_N 20
+#define BLOB_CLKDIV_FRAC 21
+#define BLOB_CLKDIV_INT 22
+
+#define BLOB_SIDESET_SPECIFIED 0x80u
+#define BLOB_SIDESET_PINDIRS 0x40u
+#define BLOB_SIDESET_OPTIONAL 0x20u
+#define BLOB_SIDESET_BIT_COUNT 0x07u
+
+int pio_blob_parse(const void *blob, uint size, pio_blob_program_t *program) {
+    const uint8_t *b = (const uint8_t *)blob;
+    if ((uintptr_t)b & 1) return PICO_ERROR_BAD_ALIGNMENT;
+    if (size < PIO_BLOB_MIN_HEADER_SIZE ||
+        (b[0] | (b[1] << 8) | (b[2] << 16) | ((uint32_t)b[3] << 24)) != PIO_BLOB_MAGIC) {
+        return PICO_ERROR_INVALID_DATA;
+    }
+    if (b[BLOB_VERSION] > PIO_BLOB_VERSION) return PICO_ERROR_VERSION_MISMATCH;
+    uint header_size = b[BLOB_HEADER_SIZE];
+    uint length = b[BLOB_LENGTH];
+    int origin = (int8_t)b[BLOB_ORIGIN];
+    if (!b[BLOB_VERSION] || header_size < PIO_BLOB_MIN_HEADER_SIZE || (header_size & 1) ||
+        !length || length > PIO_INSTRUCTION_COUNT || header_size + 2 * length > size ||
+        origin < -1 || (origin >= 0 && (uint)origin + length > PIO_INSTRUCTION_COUNT) ||
+        b[BLOB_WRAP_TARGET] >= length || b[BLOB_WRAP] >= length ||
+        (b[BLOB_SIDESET] & BLOB_SIDESET_BIT_COUNT) > 5) {
+        return PICO_ERROR_INVALID_DATA;
+    }
+    program->header = b;
+    program->program = (pio_program_t) {
+        .instructions = (const uint16_t *)(b + header_size),
+        .length = (uint8_t)length,
+        .origin = (int8_t)origin,
+        .pio_version = b[BLOB_PIO_VERSION],
+#if PICO_PIO_VERSION > 0
+        .used_gpio_ranges = b[BLOB_USED_GPIO_RANGES],
+#endif
+    };
+    return (int)(header_size + 2 * length);
+}
+
+static void apply_shift(pio_sm_config *c, uint pin_count, uint shift, bool is_in) {
+    if (pin_count == BLOB_NOT_SET) return;
+    bool right = shift & 1;
+    bool autop = shift & 2;
+    uint threshold = shift >> 2;
+    if (is_in) {
+        sm_config_set_in_pin_count(c, pin_count);
+        sm_config_set_in_shift(c, right, autop, threshold);
+    } else {
+        sm_config_set_out_pin_count(c, pin_count);
+        sm_config_set_out_shift(c, right, autop, threshold);
+    }
+}
+
+pio_sm_config pio_blob_get_default_config(const pio_blob_program_t *program, uint offset) {
+    const uint8_t *b = program->header;
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + b[BLOB_WRAP_TARGET], offset + b[BLOB_WRAP]);
+    apply_shift(&c, b[BLOB_IN_PIN_COUNT], b[BLOB_IN_SHIFT], true);
+    apply_shift(&c, b[BLOB_OUT_PIN_COUNT], b[BLOB_OUT_SHIFT], false);
+    if (b[BLOB_SET_PIN_COUNT] != BLOB_NOT_SET) {
+        sm_config_set_set_pin_count(&c, b[BLOB_SET_PIN_COUNT]);
+    }
+    uint sideset = b[BLOB_SIDESET];
+    if (sideset & BLOB_SIDESET_SPECIFIED) {
+        sm_config_set_sideset(&c, sideset & BLOB_SIDESET_BIT_COUNT, sideset & BLOB_SIDESET_OPTIONAL,
+                              sideset & BLOB_SIDESET_PINDIRS);
+    }
+    if (b[BLOB_MOV_STATUS_TYPE] != BLOB_NOT_SET) {
+        sm_config_set_mov_status(&c, (enum pio_mov_status_type)b[BLOB_MOV_STATUS_TYPE], b[BLOB_MOV_STATUS_N]);
+    }
+    if (b[BLOB_FIFO_JOIN] != PIO_FIFO_JOIN_NONE) {
+        sm_config_set_fifo_join(&c, (enum pio_fifo_join)b[BLOB_FIFO_JOIN]);
+    }
+    uint16_t div_int = (uint16_t)(b[BLOB_CLKDIV_INT] | (b[BLOB_CLKDIV_INT + 1] << 8));
+    if (div_int != 1 || b[BLOB_CLKDIV_FRAC]) {
+        sm_config_set_clkdiv_int_frac(&c, div_int, b[BLOB_CLKDIV_FRAC]);
+    }
+    return c;
+}
+
+int pio_add_program_from_blob(PIO pio, const void *blob, uint size, pio_blob_program_t *program, pio_sm_config *config) {
+    int rc = pio_blob_parse(blob, size, program);
+    if (rc < 0) return rc;
+    int offset = pio_add_program(pio, &program->program);
+    if (offset >= 0 && config) {
+        *config = pio_blob_get_default_config(program, (uint)offset);
+    }
+    return offset;
+}
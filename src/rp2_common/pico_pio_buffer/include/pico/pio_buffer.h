@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_PIO_BUFFER_H
+#define _PICO_PIO_BUFFER_H
+
+#include "hardware/pio.h"
+
+// PICO_CONFIG: PICO_PIO_BUFFER_DMA_THRESHOLD, Number of words from which pio_sm_put_buffer and pio_sm_get_buffer use a DMA channel rather than the CPU, type=int, default=32, group=pico_pio_buffer
+#ifndef PICO_PIO_BUFFER_DMA_THRESHOLD
+#define PICO_PIO_BUFFER_DMA_THRESHOLD 32
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Bulk transfers to and from state machine FIFOs
+ *  \defgroup pico_pio_buffer pico_pio_buffer
+ *
+ * These move a whole buffer of words to a state machine's TX FIFO or from its RX FIFO.
+ *
+ * The blocking functions use the CPU for short buffers, filling (or emptying) as much of the FIFO as is
+ * available each time they check its level rather than testing FSTAT for every word. From
+ * PICO_PIO_BUFFER_DMA_THRESHOLD words they instead claim an unused DMA channel paced by the state machine's
+ * DREQ, falling back to the CPU if there is none.
+ *
+ * The asynchronous functions always use a DMA channel, which is claimed for the duration of the transfer, and
+ * call a callback from the DMA IRQ handler (via \ref dma_irqn_set_channel_callback) when it is complete. Only
+ * one asynchronous transfer may be in progress in each direction for each state machine.
+ */
+
+/*! \brief Callback made when an asynchronous buffer transfer completes
+ *  \ingroup pico_pio_buffer
+ *
+ * This is called from the DMA IRQ handler; the DMA channel has already been released, so a new transfer may be
+ * started from the callback.
+ *
+ * \param pio the PIO instance
+ * \param sm the state machine
+ * \param is_tx true for a transfer to the TX FIFO, false for one from the RX FIFO
+ * \param user_data the user_data passed when the transfer was started
+ */
+typedef void (*pio_sm_buffer_callback_t)(PIO pio, uint sm, bool is_tx, void *user_data);
+
+/*! \brief Write a buffer of words to a state machine's TX FIFO, blocking until they are all in the FIFO
+ *  \ingroup pico_pio_buffer
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm State machine index (0..3)
+ * \param src the words to write
+ * \param count the number of words
+ */
+void pio_sm_put_buffer(PIO pio, uint sm, const uint32_t *src, uint count);
+
+/*! \brief Read a buffer of words from a state machine's RX FIFO, blocking until they have all been read
+ *  \ingroup pico_pio_buffer
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm State machine index (0..3)
+ * \param dst where to store the words
+ * \param count the number of words
+ */
+void pio_sm_get_buffer(PIO pio, uint sm, uint32_t *dst, uint count);
+
+/*! \brief Start writing a buffer of words to a state machine's TX FIFO using DMA
+ *  \ingroup pico_pio_buffer
+ *
+ * The buffer must remain valid until the callback has been called. The callback is called once the last
+ * word has been written to the FIFO (not when the state machine has consumed it).
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm State machine index (0..3)
+ * \param src the words to write
+ * \param count the number of words
+ * \param irq_index the DMA IRQ index (0 or 1) to signal completion on
+ * \param callback function to call on completion, or NULL
+ * \param user_data passed to the callback
+ * \return PICO_OK if the transfer was started, PICO_ERROR_RESOURCE_IN_USE if a transfer to this state
+ * machine is already in progress, or PICO_ERROR_INSUFFICIENT_RESOURCES if no DMA channel is available
+ */
+int pio_sm_put_buffer_async(PIO pio, uint sm, const uint32_t *src, uint count, uint irq_index,
+                            pio_sm_buffer_callback_t callback, void *user_data);
+
+/*! \brief Start reading a buffer of words from a state machine's RX FIFO using DMA
+ *  \ingroup pico_pio_buffer
+ *
+ * The callback is called once the last word has been stored in the buffer.
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm State machine index (0..3)
+ * \param dst where to store the words
+ * \param count the number of words
+ * \param irq_index the DMA IRQ index (0 or 1) to signal completion on
+ * \param callback function to call on completion, or NULL
+ * \param user_data passed to the callback
+ * \return PICO_OK if the transfer was started, PICO_ERROR_RESOURCE_IN_USE if a transfer from this state
+ * machine is already in progress, or PICO_ERROR_INSUFFICIENT_RESOURCES if no DMA channel is available
+ */
+int pio_sm_get_buffer_async(PIO pio, uint sm, uint32_t *dst, uint count, uint irq_index,
+                            pio_sm_buffer_callback_t callback, void *user_data);
+
+/*! \brief Check whether an asynchronous buffer transfer is in progress
+ *  \ingroup pico_pio_buffer
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm State machine index (0..3)
+ * \param is_tx true for the transfer to the TX FIFO, false for the one from the RX FIFO
+ * \return true if the transfer has not yet completed
+ */
+bool pio_sm_is_buffer_busy(PIO pio, uint sm, bool is_tx);
+
+/*! \brief Abort an asynchronous buffer transfer
+ *  \ingroup pico_pio_buffer
+ *
+ * The callback is not called. It is not known how many words were transferred. If the transfer completes at the
+ * same time (e.g. its DMA IRQ is being handled on the other core), exactly one of the two releases the DMA channel;
+ * the callback may then still be called.
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm State machine index (0..3)
+ * \param is_tx true for the transfer to the TX FIFO, false for the one from the RX FIFO
+ */
+void pio_sm_abort_buffer(PIO pio, uint sm, bool is_tx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
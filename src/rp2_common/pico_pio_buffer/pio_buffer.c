@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pico/pio_buffer.h"
+#include "hardware/claim.h"
+#include "hardware/dma.h"
+
+typedef struct {
+    pio_sm_buffer_callback_t callback;
+    void *user_data;
+    uint8_t channel;
+    uint8_t irq_index;
+    volatile bool busy;     // reserved by transfer_async, until the transfer completes or is aborted
+    volatile bool active;   // channel is running the transfer; cleared (under the claim lock) by whichever of the
+                            // completion callback or pio_sm_abort_buffer takes ownership of the channel first
+} pio_buffer_transfer_t;
+
+static pio_buffer_transfer_t transfers[NUM_PIOS][NUM_PIO_STATE_MACHINES][2];
+
+static inline pio_buffer_transfer_t *get_transfer(PIO pio, uint sm, bool is_tx) {
+    check_sm_param(sm);
+    return &transfers[pio_get_index(pio)][sm][is_tx];
+}
+
+static inline uint fifo_depth(PIO pio, uint sm, bool is_tx) {
+    // a joined FIFO has double the depth
+    return pio->sm[sm].shiftctrl & (is_tx ? PIO_SM0_SHIFTCTRL_FJOIN_TX_BITS : PIO_SM0_SHIFTCTRL_FJOIN_RX_BITS) ? 8 : 4;
+}
+
+// claims and configures (but does not start) a channel
+static int configure_dma(PIO pio, uint sm, bool is_tx, volatile void *buffer, uint count) {
+    int channel = dma_claim_unused_channel(false);
+    if (channel < 0) return PICO_ERROR_INSUFFICIENT_RESOURCES;
+    dma_channel_config c = dma_channel_get_default_config((uint)channel);
+    channel_config_set_dreq(&c, pio_get_dreq(pio, sm, is_tx));
+    channel_config_set_read_increment(&c, is_tx);
+    channel_config_set_write_increment(&c, !is_tx);
+    dma_channel_configure((uint)channel, &c,
+                          is_tx ? (volatile void *)&pio->txf[sm] : buffer,
+                          is_tx ? buffer : (volatile void *)&pio->rxf[sm],
+                          count, false);
+    return channel;
+}
+
+static void cpu_put(PIO pio, uint sm, const uint32_t *src, uint count) {
+    uint depth = fifo_depth(pio, sm, true);
+    while (count) {
+        // fill whatever space there is, rather than checking FSTAT for every word
+        uint n = depth - pio_sm_get_tx_fifo_level(pio, sm);
+        if (n > count) n = count;
+        count -= n;
+        while (n >= 4) {
+            pio->txf[sm] = src[0];
+            pio->txf[sm] = src[1];
+            pio->txf[sm] = src[2];
+            pio->txf[sm] = src[3];
+            src += 4;
+            n -= 4;
+        }
+        while (n--) {
+            pio->txf[sm] = *src++;
+        }
+    }
+}
+
+static void cpu_get(PIO pio, uint sm, uint32_t *dst, uint count) {
+    while (count) {
+        uint n = pio_sm_get_rx_fifo_level(pio, sm);
+        if (n > count) n = count;
+        count -= n;
+        while (n >= 4) {
+            dst[0] = pio->rxf[sm];
+            dst[1] = pio->rxf[sm];
+            dst[2] = pio->rxf[sm];
+            dst[3] = pio->rxf[sm];
+            dst += 4;
+            n -= 4;
+        }
+        while (n--) {
+            *dst++ = pio->rxf[sm];
+        }
+    }
+}
+
+static bool transfer_blocking(PIO pio, uint sm, bool is_tx, volatile void *buffer, uint count) {
+    if (count < PICO_PIO_BUFFER_DMA_THRESHOLD) return false;
+    int channel = configure_dma(pio, sm, is_tx, buffer, count);
+    if (channel < 0) return false;
+    dma_channel_start((uint)channel);
+    dma_channel_wait_for_finish_blocking((uint)channel);
+    dma_channel_unclaim((uint)channel);
+    return true;
+}
+
+void pio_sm_put_buffer(PIO pio, uint sm, const uint32_t *src, uint count) {
+    check_pio_param(pio);
+    check_sm_param(sm);
+    if (!transfer_blocking(pio, sm, true, (volatile void *)src, count)) {
+        cpu_put(pio, sm, src, count);
+    }
+}
+
+void pio_sm_get_buffer(PIO pio, uint sm, uint32_t *dst, uint count) {
+    check_pio_param(pio);
+    check_sm_param(sm);
+    if (!transfer_blocking(pio, sm, false, dst, count)) {
+        cpu_get(pio, sm, dst, count);
+    }
+}
+
+static void pio_buffer_dma_callback(uint channel, void *user_data) {
+    pio_buffer_transfer_t *t = (pio_buffer_transfer_t *)user_data;
+    uint index = (uint)(t - &transfers[0][0][0]);
+    bool is_tx = index & 1;
+    uint sm = (index >> 1) % NUM_PIO_STATE_MACHINES;
+    PIO pio = pio_get_instance(index / (2 * NUM_PIO_STATE_MACHINES));
+    uint32_t save = hw_claim_lock();
+    bool owned = t->active && t->channel == channel;
+    t->active = false;
+    hw_claim_unlock(save);
+    // otherwise pio_sm_abort_buffer got there first, and is releasing the channel
+    if (!owned) return;
+    pio_sm_buffer_callback_t callback = t->callback;
+    void *callback_data = t->user_data;
+    dma_irqn_clear_channel_callback(t->irq_index, channel);
+    dma_channel_unclaim(channel);
+    t->busy = false;
+    if (callback) callback(pio, sm, is_tx, callback_data);
+}
+
+static int transfer_async(PIO pio, uint sm, bool is_tx, volatile void *buffer, uint count, uint irq_index,
+                          pio_sm_buffer_callback_t callback, void *user_data) {
+    check_pio_param(pio);
+    check_sm_param(sm);
+    invalid_params_if(HARDWARE_PIO, irq_index >= NUM_DMA_IRQS);
+    pio_buffer_transfer_t *t = get_transfer(pio, sm, is_tx);
+    uint32_t save = hw_claim_lock();
+    bool busy = t->busy;
+    t->busy = true;
+    hw_claim_unlock(save);
+    if (busy) return PICO_ERROR_RESOURCE_IN_USE;
+    int channel = configure_dma(pio, sm, is_tx, buffer, count);
+    if (channel < 0) {
+        t->busy = false;
+        return channel;
+    }
+    t->callback = callback;
+    t->user_data = user_data;
+    t->irq_index = (uint8_t)irq_index;
+    t->channel = (uint8_t)channel;
+    dma_irqn_set_channel_callback(irq_index, (uint)channel, pio_buffer_dma_callback, t);
+    // the completion callback (on either core) cannot take ownership of the channel until it is released
+    save = hw_claim_lock();
+    t->active = true;
+    dma_channel_start((uint)channel);
+    hw_claim_unlock(save);
+    return PICO_OK;
+}
+
+int pio_sm_put_buffer_async(PIO pio, uint sm, const uint32_t *src, uint count, uint irq_index,
+                            pio_sm_buffer_callback_t callback, void *user_data) {
+    return transfer_async(pio, sm, true, (volatile void *)src, count, irq_index, callback, user_data);
+}
+
+int pio_sm_get_buffer_async(PIO pio, uint sm, uint32_t *dst, uint count, uint irq_index,
+                            pio_sm_buffer_callback_t callback, void *user_data) {
+    return transfer_async(pio, sm, false, dst, count, irq_index, callback, user_data);
+}
+
+bool pio_sm_is_buffer_busy(PIO pio, uint sm, bool is_tx) {
+    check_pio_param(pio);
+    return get_transfer(pio, sm, is_tx)->busy;
+}
+
+void pio_sm_abort_buffer(PIO pio, uint sm, bool is_tx) {
+    check_pio_param(pio);
+    pio_buffer_transfer_t *t = get_transfer(pio, sm, is_tx);
+    uint32_t save = hw_claim_lock();
+    bool owned = t->active;
+    t->active = false;
+    hw_claim_unlock(save);
+    // otherwise there is no transfer, or its completion callback got there first and has released (or is releasing)
+    // the channel
+    if (!owned) return;
+    uint channel = t->channel;
+    // removes the callback before aborting, so it is not called
+    dma_channel_cleanup(channel);
+    dma_channel_unclaim(channel);
+    t->busy = false;
+}
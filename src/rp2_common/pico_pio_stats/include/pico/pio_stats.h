@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_PIO_STATS_H
+#define _PICO_PIO_STATS_H
+
+#include "hardware/pio.h"
+
+// PICO_CONFIG: PICO_PIO_STATS_RUN_BUCKETS, Number of buckets in the stall run length histograms of pio_sm_stats_t, type=int, default=8, min=1, max=32, group=pico_pio_stats
+#ifndef PICO_PIO_STATS_RUN_BUCKETS
+#define PICO_PIO_STATS_RUN_BUCKETS 8
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Sampling of state machine FIFO stalls and levels
+ *  \defgroup pico_pio_stats pico_pio_stats
+ *
+ * A diagnostic aid for sizing FIFOs, DMA buffers and clock dividers. Each sample reads the FDEBUG register,
+ * clearing the stall and over/underflow flags it reports for the state machines being sampled, and the FIFO
+ * levels, and adds them to per state machine counts and histograms.
+ *
+ * Samples are taken periodically from a hardware alarm by \ref pio_stats_start, or by calling
+ * \ref pio_stats_sample directly, e.g. from a DMA completion handler to see the FIFO state at the end of each
+ * transfer.
+ *
+ * \note The FDEBUG flags are sticky, so a stall of a single cycle at any point between two samples counts the
+ * same as one lasting the whole interval.
+ */
+
+/*! \brief Statistics for a state machine
+ *  \ingroup pico_pio_stats
+ *
+ * The run histograms count runs of consecutive samples in which the state machine had stalled; bucket n counts
+ * runs of 2^n to 2^(n+1)-1 samples, and the last bucket any longer run. A run is only counted when it ends.
+ */
+typedef struct pio_sm_stats {
+    uint32_t samples;
+    uint32_t tx_stalls;                                 ///< samples in which the state machine had stalled on an empty TX FIFO
+    uint32_t rx_stalls;                                 ///< samples in which the state machine had stalled on a full RX FIFO
+    uint32_t tx_overflows;                              ///< samples in which a write to the full TX FIFO had been lost
+    uint32_t rx_underflows;                             ///< samples in which the empty RX FIFO had been read
+    uint32_t tx_level[9];                               ///< samples with each TX FIFO level (0 to 8)
+    uint32_t rx_level[9];                               ///< samples with each RX FIFO level (0 to 8)
+    uint32_t tx_stall_runs[PICO_PIO_STATS_RUN_BUCKETS]; ///< histogram of TX stall run lengths
+    uint32_t rx_stall_runs[PICO_PIO_STATS_RUN_BUCKETS]; ///< histogram of RX stall run lengths
+} pio_sm_stats_t;
+
+/*! \brief Take one sample for some state machines
+ *  \ingroup pico_pio_stats
+ *
+ * This may be called from an IRQ handler.
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm_mask bit mask of state machines to sample
+ */
+void pio_stats_sample(PIO pio, uint32_t sm_mask);
+
+/*! \brief Start sampling some state machines periodically
+ *  \ingroup pico_pio_stats
+ *
+ * One hardware alarm is claimed for sampling, shared by all the PIO instances being sampled; the period used is
+ * that of the most recent call. This adds to the set of state machines already being sampled.
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm_mask bit mask of state machines to sample
+ * \param period_us the time between samples in microseconds
+ * \return PICO_OK, or PICO_ERROR_INSUFFICIENT_RESOURCES if no hardware alarm is available
+ */
+int pio_stats_start(PIO pio, uint32_t sm_mask, uint32_t period_us);
+
+/*! \brief Stop sampling some state machines periodically
+ *  \ingroup pico_pio_stats
+ *
+ * The hardware alarm is released when no state machines are left to sample. Their statistics are kept.
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm_mask bit mask of state machines to stop sampling
+ */
+void pio_stats_stop(PIO pio, uint32_t sm_mask);
+
+/*! \brief Get a copy of the statistics for a state machine
+ *  \ingroup pico_pio_stats
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm State machine index (0..3)
+ * \param stats receives the statistics
+ */
+void pio_sm_get_stats(PIO pio, uint sm, pio_sm_stats_t *stats);
+
+/*! \brief Clear the statistics for some state machines
+ *  \ingroup pico_pio_stats
+ *
+ * \param pio The PIO instance; e.g. \ref pio0 or \ref pio1
+ * \param sm_mask bit mask of state machines whose statistics are to be cleared
+ */
+void pio_stats_clear(PIO pio, uint32_t sm_mask);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
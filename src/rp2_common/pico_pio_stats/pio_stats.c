@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include "pico/pio_stats.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+
+typedef struct {
+    pio_sm_stats_t stats;
+    uint32_t tx_run;
+    uint32_t rx_run;
+} sm_state_t;
+
+static sm_state_t sm_states[NUM_PIOS][NUM_PIO_STATE_MACHINES];
+static uint32_t sampled_sm_masks[NUM_PIOS];
+static int alarm_num = -1;
+static uint32_t sample_period_us;
+static uint64_t next_sample_time;
+
+// FDEBUG flags for state machine 0; shifted left by the state machine number for the others
+#define FDEBUG_SM0_BITS ((1u << PIO_FDEBUG_TXSTALL_LSB) | (1u << PIO_FDEBUG_TXOVER_LSB) | \
+                         (1u << PIO_FDEBUG_RXUNDER_LSB) | (1u << PIO_FDEBUG_RXSTALL_LSB))
+
+static_assert(PICO_PIO_STATS_RUN_BUCKETS >= 1 && PICO_PIO_STATS_RUN_BUCKETS <= 32, "");
+
+// the striped spin locks are intended for short critical sections like these
+static inline spin_lock_t *stats_lock(PIO pio) {
+    return spin_lock_instance(PICO_SPINLOCK_ID_STRIPED_FIRST + pio_get_index(pio) % (PICO_SPINLOCK_ID_STRIPED_LAST - PICO_SPINLOCK_ID_STRIPED_FIRST + 1));
+}
+
+static void end_run(uint32_t *run, uint32_t *histogram) {
+    if (!*run) return;
+    uint bucket = 31u - (uint)__builtin_clz(*run);
+    histogram[bucket < PICO_PIO_STATS_RUN_BUCKETS ? bucket : PICO_PIO_STATS_RUN_BUCKETS - 1]++;
+    *run = 0;
+}
+
+static void update_run(uint32_t *run, uint32_t *histogram, bool stalled) {
+    if (stalled) {
+        if (*run != UINT32_MAX) (*run)++;
+    } else {
+        end_run(run, histogram);
+    }
+}
+
+void pio_stats_sample(PIO pio, uint32_t sm_mask) {
+    check_pio_param(pio);
+    sm_mask &= (1u << NUM_PIO_STATE_MACHINES) - 1;
+    uint32_t save = spin_lock_blocking(stats_lock(pio));
+    uint32_t fdebug = pio->fdebug;
+    uint32_t flevel = pio->flevel;
+    // clear only the flags we have seen, for the state machines we sampled
+    pio->fdebug = fdebug & (sm_mask * FDEBUG_SM0_BITS);
+    for (uint sm = 0; sm_mask; sm++, sm_mask >>= 1) {
+        if (!(sm_mask & 1u)) continue;
+        sm_state_t *s = &sm_states[pio_get_index(pio)][sm];
+        bool tx_stall = fdebug & (1u << (PIO_FDEBUG_TXSTALL_LSB + sm));
+        bool rx_stall = fdebug & (1u << (PIO_FDEBUG_RXSTALL_LSB + sm));
+        s->stats.samples++;
+        s->stats.tx_stalls += tx_stall;
+        s->stats.rx_stalls += rx_stall;
+        s->stats.tx_overflows += !!(fdebug & (1u << (PIO_FDEBUG_TXOVER_LSB + sm)));
+        s->stats.rx_underflows += !!(fdebug & (1u << (PIO_FDEBUG_RXUNDER_LSB + sm)));
+        uint levels = flevel >> (sm * PIO_FLEVEL_TX1_LSB);
+        s->stats.tx_level[(levels >> PIO_FLEVEL_TX0_LSB) & 0xfu]++;
+        s->stats.rx_level[(levels >> PIO_FLEVEL_RX0_LSB) & 0xfu]++;
+        update_run(&s->tx_run, s->stats.tx_stall_runs, tx_stall);
+        update_run(&s->rx_run, s->stats.rx_stall_runs, rx_stall);
+    }
+    spin_unlock(stats_lock(pio), save);
+}
+
+static void stats_alarm_callback(uint alarm) {
+    for (uint i = 0; i < NUM_PIOS; i++) {
+        if (sampled_sm_masks[i]) pio_stats_sample(pio_get_instance(i), sampled_sm_masks[i]);
+    }
+    next_sample_time += sample_period_us;
+    if (hardware_alarm_set_target(alarm, from_us_since_boot(next_sample_time))) {
+        // we have fallen behind; carry on from now rather than trying to catch up
+        next_sample_time = time_us_64() + sample_period_us;
+        hardware_alarm_set_target(alarm, from_us_since_boot(next_sample_time));
+    }
+}
+
+int pio_stats_start(PIO pio, uint32_t sm_mask, uint32_t period_us) {
+    check_pio_param(pio);
+    invalid_params_if(HARDWARE_PIO, !period_us);
+    if (alarm_num < 0) {
+        alarm_num = hardware_alarm_claim_unused(false);
+        if (alarm_num < 0) return PICO_ERROR_INSUFFICIENT_RESOURCES;
+        hardware_alarm_set_callback((uint)alarm_num, stats_alarm_callback);
+    }
+    sm_mask &= (1u << NUM_PIO_STATE_MACHINES) - 1;
+    // discard anything which happened before we started
+    pio->fdebug = sm_mask * FDEBUG_SM0_BITS;
+    sampled_sm_masks[pio_get_index(pio)] |= sm_mask;
+    sample_period_us = period_us;
+    next_sample_time = time_us_64() + period_us;
+    hardware_alarm_set_target((uint)alarm_num, from_us_since_boot(next_sample_time));
+    return PICO_OK;
+}
+
+void pio_stats_stop(PIO pio, uint32_t sm_mask) {
+    check_pio_param(pio);
+    sampled_sm_masks[pio_get_index(pio)] &= ~sm_mask;
+    for (uint i = 0; i < NUM_PIOS; i++) {
+        if (sampled_sm_masks[i]) return;
+    }
+    if (alarm_num >= 0) {
+        hardware_alarm_cancel((uint)alarm_num);
+        hardware_alarm_set_callback((uint)alarm_num, NULL);
+        hardware_alarm_unclaim((uint)alarm_num);
+        alarm_num = -1;
+    }
+}
+
+void pio_sm_get_stats(PIO pio, uint sm, pio_sm_stats_t *stats) {
+    check_pio_param(pio);
+    check_sm_param(sm);
+    uint32_t save = spin_lock_blocking(stats_lock(pio));
+    *stats = sm_states[pio_get_index(pio)][sm].stats;
+    spin_unlock(stats_lock(pio), save);
+}
+
+void pio_stats_clear(PIO pio, uint32_t sm_mask) {
+    check_pio_param(pio);
+    uint32_t save = spin_lock_blocking(stats_lock(pio));
+    for (uint sm = 0; sm < NUM_PIO_STATE_MACHINES; sm++) {
+        if (sm_mask & (1u << sm)) {
+            sm_states[pio_get_index(pio)][sm] = (sm_state_t){0};
+        }
+    }
+    spin_unlock(stats_lock(pio), save);
+}
@@ -175,6 +175,21 @@ extern "C" {
 #define PICO_RAND_RAM_HASH_START   (PICO_RAND_RAM_HASH_END - 1024u)
 #endif
 
+// PICO_CONFIG: PICO_RAND_BYTES_RESEED_INTERVAL, Number of bytes get_rand_bytes produces from each core's generator before reseeding it from the entropy sources, type=int, default=4096, min=8, group=pico_rand
+#ifndef PICO_RAND_BYTES_RESEED_INTERVAL
+#define PICO_RAND_BYTES_RESEED_INTERVAL 4096
+#endif
+
+// PICO_CONFIG: PICO_RAND_SECURE_RESEED_INTERVAL, Number of bytes get_secure_rand_bytes produces from each core's DRBG before reseeding it from the entropy sources, type=int, default=65536, min=64, group=pico_rand
+#ifndef PICO_RAND_SECURE_RESEED_INTERVAL
+#define PICO_RAND_SECURE_RESEED_INTERVAL 65536
+#endif
+
+// PICO_CONFIG: PICO_RAND_SECURE_SEED_BITS, Number of raw bits sampled from the TRNG (or the ROSC if there is no TRNG) each time get_secure_rand_bytes reseeds a DRBG, type=int, default=512, min=64, max=1920, group=pico_rand
+#ifndef PICO_RAND_SECURE_SEED_BITS
+#define PICO_RAND_SECURE_SEED_BITS 512
+#endif
+
 // We provide a maximum of 128 bits entropy in one go
 typedef struct rng_128 {
     uint64_t r[2];
@@ -210,6 +225,43 @@ uint64_t get_rand_64(void);
  */
 uint32_t get_rand_32(void);
 
+/*! \brief Fill a buffer with random bytes
+ *  \ingroup pico_rand
+ *
+ * This is much quicker than calling \ref get_rand_64 repeatedly. The bytes come from a per-core xoroshiro128**
+ * generator (see \ref pico_prng), which is reseeded from \ref get_rand_128, and so from the entropy sources, every
+ * \ref PICO_RAND_BYTES_RESEED_INTERVAL bytes. Only the reseed takes the pico_rand spin lock; otherwise interrupts
+ * are just disabled on the calling core for a few microseconds at a time, while up to 64 bytes are generated.
+ *
+ * This method may be safely called from either core or from an IRQ, but be careful in the latter case as
+ * a reseed may block for a number of microseconds waiting on more entropy.
+ *
+ * \param buf the buffer
+ * \param len the size of the buffer in bytes
+ */
+void get_rand_bytes(void *buf, size_t len);
+
+/*! \brief Fill a buffer with random bytes from a cryptographically secure generator
+ *  \ingroup pico_rand
+ *
+ * Unlike the other functions here, this is suitable for generating keys and nonces. The bytes come from a per-core
+ * ChaCha20 DRBG (see \ref pico_prng), whose key is replaced after every call, so that a later compromise of
+ * its state does not reveal earlier output. The DRBG is seeded on first use, and reseeded every
+ * \ref PICO_RAND_SECURE_RESEED_INTERVAL bytes, from \ref PICO_RAND_SECURE_SEED_BITS raw bits sampled from the TRNG
+ * (or the ROSC on RP2040, which takes around 10us per bit), along with \ref get_rand_128. The output is only as
+ * unpredictable as these sources.
+ *
+ * Interrupts are disabled on the calling core only while a single ChaCha20 block is computed; the output is then
+ * generated with interrupts enabled, at roughly the cost of one ChaCha20 block per 64 bytes.
+ *
+ * This method may be safely called from either core or from an IRQ, but be careful in the latter case as
+ * a reseed may block for some time waiting on more entropy.
+ *
+ * \param buf the buffer
+ * \param len the size of the buffer in bytes
+ */
+void get_secure_rand_bytes(void *buf, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
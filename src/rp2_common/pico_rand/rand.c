@@ -39,6 +39,7 @@
 #include "hardware/structs/busctrl.h"
 #endif
 #include "hardware/sync.h"
+#include "pico/prng.h"
 
 static bool rng_initialised = false;
 
@@ -387,3 +388,49 @@ void get_rand_128(rng_128_t *ptr128) {
 uint32_t get_rand_32(void) {
     return (uint32_t) get_rand_64();
 }
+
+static size_t rand_bytes_seed(void *seed, __unused size_t max_len) {
+    get_rand_128((rng_128_t *) seed);
+    return sizeof(rng_128_t);
+}
+
+static prng_xoroshiro_per_core_t rand_bytes_prng = {
+    .get_seed = rand_bytes_seed,
+    .reseed_interval = PICO_RAND_BYTES_RESEED_INTERVAL,
+};
+
+void get_rand_bytes(void *buf, size_t len) {
+    prng_xoroshiro_per_core_fill(&rand_bytes_prng, buf, len);
+}
+
+static_assert(PICO_RAND_SECURE_SEED_BITS / 64 * sizeof(uint64_t) + sizeof(rng_128_t) <= PICO_PRNG_MAX_SEED_BYTES,
+              "PICO_RAND_SECURE_SEED_BITS is too large for PICO_PRNG_MAX_SEED_BYTES");
+
+static size_t secure_rand_seed(void *buf, __unused size_t max_len) {
+    uint64_t *seed = (uint64_t *) buf;
+    uint n = 0;
+    // raw samples from the best available source, hashed into the DRBG by the reseed
+#if PICO_RAND_SEED_ENTROPY_SRC_TRNG | PICO_RAND_ENTROPY_SRC_TRNG
+    while (n < PICO_RAND_SECURE_SEED_BITS / 64) {
+        seed[n++] = capture_additional_trng_samples();
+    }
+#elif PICO_RAND_SEED_ENTROPY_SRC_ROSC | PICO_RAND_ENTROPY_SRC_ROSC
+    while (n < PICO_RAND_SECURE_SEED_BITS / 64) {
+        // 32 new bits each time, the rest having been returned last time
+        uint64_t low = (uint32_t) capture_additional_rosc_samples(32);
+        seed[n++] = low | (capture_additional_rosc_samples(32) << 32);
+    }
+#endif
+    // along with everything else pico_rand gathers
+    get_rand_128((rng_128_t *) (seed + n));
+    return (n + 2) * sizeof(uint64_t);
+}
+
+static prng_chacha20_per_core_t secure_prng = {
+    .get_seed = secure_rand_seed,
+    .reseed_interval = PICO_RAND_SECURE_RESEED_INTERVAL,
+};
+
+void get_secure_rand_bytes(void *buf, size_t len) {
+    prng_chacha20_per_core_fill(&secure_prng, buf, len);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PICO_XIP_PROFILE_H
+#define _PICO_XIP_PROFILE_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \file pico/xip_profile.h
+ *  \defgroup pico_xip_profile pico_xip_profile
+ *
+ * \brief Statistical profiling of code executing from flash
+ *
+ * The program counter is sampled from a periodic timer interrupt, and counted in a histogram of buckets covering
+ * the flash binary (from `__flash_binary_start` to `__flash_binary_end`). Samples elsewhere (e.g. in RAM or ROM) are
+ * only counted in total.
+ *
+ * The histogram is printed by \ref xip_profile_dump, and the output, together with the ELF file, can be passed to
+ * `tools/xip_profile.py` on the host, which attributes the samples to functions. It can then list the hottest
+ * functions, or generate code to pin them in the XIP cache (see \ref xip_cache_pin_range), or a linker script
+ * fragment to place them in RAM, within a given budget of bytes.
+ *
+ * Only the core which calls \ref xip_profile_start is sampled. The timer interrupt runs at the highest priority, so
+ * that time spent in other interrupt handlers is sampled too.
+ */
+
+// PICO_CONFIG: PICO_XIP_PROFILE_MIN_BUCKET_SHIFT, Log2 of the smallest bucket size in bytes used by the pico_xip_profile histogram, type=int, default=2, min=1, max=12, group=pico_xip_profile
+#ifndef PICO_XIP_PROFILE_MIN_BUCKET_SHIFT
+#define PICO_XIP_PROFILE_MIN_BUCKET_SHIFT 2
+#endif
+
+/*! \brief Initialize the profiler with storage for the histogram
+ *  \ingroup pico_xip_profile
+ *
+ * The bucket size is the smallest power of 2 (at least 2^PICO_XIP_PROFILE_MIN_BUCKET_SHIFT bytes) for which the
+ * buckets cover the flash binary; a bucket size of a few bytes makes the attribution to functions precise.
+ *
+ * \param counts the histogram storage, which is cleared
+ * \param bucket_count the number of buckets in counts
+ */
+void xip_profile_init(uint32_t *counts, uint bucket_count);
+
+/*! \brief Start sampling on the calling core
+ *  \ingroup pico_xip_profile
+ *
+ * A hardware alarm on the default timer is claimed for the duration of the profile.
+ *
+ * \param interval_us the interval between samples in microseconds; at least 10
+ * \return true if sampling was started, false if no hardware alarm was available
+ */
+bool xip_profile_start(uint32_t interval_us);
+
+/*! \brief Stop sampling, and release the hardware alarm
+ *  \ingroup pico_xip_profile
+ *
+ * This must be called from the same core as \ref xip_profile_start.
+ */
+void xip_profile_stop(void);
+
+/*! \brief Clear the histogram
+ *  \ingroup pico_xip_profile
+ */
+void xip_profile_clear(void);
+
+/*! \brief Get the total number of samples taken
+ *  \ingroup pico_xip_profile
+ */
+uint32_t xip_profile_get_sample_count(void);
+
+/*! \brief Get the number of samples of code which was not in the flash binary
+ *  \ingroup pico_xip_profile
+ */
+uint32_t xip_profile_get_other_sample_count(void);
+
+/*! \brief Print the histogram using printf
+ *  \ingroup pico_xip_profile
+ *
+ * The output starts with a line `xip_profile: base=<addr> shift=<n> samples=<n> other=<n>`, followed by a line
+ * `<addr> <count>` for each non-empty bucket, and ends with the line `xip_profile: end`. This is the format read by
+ * `tools/xip_profile.py`, which ignores any other output around it.
+ */
+void xip_profile_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/xip_profile.h"
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#ifdef __riscv
+#include "hardware/riscv.h"
+#endif
+
+#define MIN_INTERVAL_US 10
+
+static struct {
+    uint32_t *counts;
+    uint bucket_count;
+    uintptr_t base;
+    uint shift;
+    timer_hw_t *timer;
+    int alarm_num;
+    uint32_t interval_us;
+    volatile uint32_t samples;
+    volatile uint32_t other_samples;
+} profile = {
+    .alarm_num = -1,
+};
+
+// called from the timer interrupt, with the interrupted PC
+static void __attribute__((used)) __not_in_flash_func(xip_profile_sample)(uintptr_t pc) {
+    timer_hw_t *timer = profile.timer;
+    uint alarm_num = (uint)profile.alarm_num;
+    timer->intr = 1u << alarm_num;
+    timer->alarm[alarm_num] = timer->timerawl + profile.interval_us;
+    profile.samples++;
+    uintptr_t offset = pc - profile.base;
+    if ((offset >> profile.shift) < profile.bucket_count) {
+        profile.counts[offset >> profile.shift]++;
+    } else {
+        profile.other_samples++;
+    }
+}
+
+#ifdef __riscv
+static void __not_in_flash_func(xip_profile_irq_handler)(void) {
+    // the timer interrupt is of the highest priority, so mepc has not been changed by a nested interrupt
+    xip_profile_sample(riscv_read_csr(RVCSR_MEPC_OFFSET));
+}
+#else
+// installed directly in the vector table, so the interrupted PC is in the exception frame, on whichever stack
+// EXC_RETURN (in lr) says was in use; xip_profile_sample is tail-called to return from the exception
+static void __attribute__((naked)) __not_in_flash_func(xip_profile_irq_handler)(void) {
+    pico_default_asm(
+        "movs r1, #4\n"
+        "mov r2, lr\n"
+        "mrs r0, msp\n"
+        "tst r1, r2\n"
+        "beq 1f\n"
+        "mrs r0, psp\n"
+        "1:\n"
+        "ldr r0, [r0, #24]\n"
+        "ldr r1, =xip_profile_sample\n"
+        "bx r1\n"
+    );
+}
+#endif
+
+void xip_profile_init(uint32_t *counts, uint bucket_count) {
+#if PICO_NO_FLASH
+    uintptr_t start = XIP_BASE, end = XIP_BASE;
+#else
+    extern char __flash_binary_start;
+    extern char __flash_binary_end;
+    uintptr_t start = (uintptr_t)&__flash_binary_start, end = (uintptr_t)&__flash_binary_end;
+#endif
+    uint shift = PICO_XIP_PROFILE_MIN_BUCKET_SHIFT;
+    while (((end - start + (1u << shift) - 1) >> shift) > bucket_count) shift++;
+    profile.counts = counts;
+    profile.bucket_count = bucket_count;
+    profile.base = start;
+    profile.shift = shift;
+    xip_profile_clear();
+}
+
+bool xip_profile_start(uint32_t interval_us) {
+    if (profile.alarm_num >= 0) return true;
+    timer_hw_t *timer = PICO_DEFAULT_TIMER_INSTANCE();
+    int alarm_num = timer_hardware_alarm_claim_unused(timer, false);
+    if (alarm_num < 0) return false;
+    profile.timer = timer;
+    profile.alarm_num = alarm_num;
+    profile.interval_us = MAX(interval_us, MIN_INTERVAL_US);
+    uint irq_num = timer_hardware_alarm_get_irq_num(timer, (uint)alarm_num);
+    irq_set_exclusive_handler(irq_num, xip_profile_irq_handler);
+    irq_set_priority(irq_num, PICO_HIGHEST_IRQ_PRIORITY);
+    hw_set_bits(&timer->inte, 1u << alarm_num);
+    irq_set_enabled(irq_num, true);
+    timer->alarm[alarm_num] = timer->timerawl + profile.interval_us;
+    return true;
+}
+
+void xip_profile_stop(void) {
+    if (profile.alarm_num < 0) return;
+    timer_hw_t *timer = profile.timer;
+    uint alarm_num = (uint)profile.alarm_num;
+    uint irq_num = timer_hardware_alarm_get_irq_num(timer, alarm_num);
+    irq_set_enabled(irq_num, false);
+    hw_clear_bits(&timer->inte, 1u << alarm_num);
+    timer->armed = 1u << alarm_num;
+    timer->intr = 1u << alarm_num;
+    irq_remove_handler(irq_num, xip_profile_irq_handler);
+    irq_set_priority(irq_num, PICO_DEFAULT_IRQ_PRIORITY);
+    timer_hardware_alarm_unclaim(timer, alarm_num);
+    profile.alarm_num = -1;
+}
+
+void xip_profile_clear(void) {
+    if (profile.counts) memset(profile.counts, 0, profile.bucket_count * sizeof(uint32_t));
+    profile.samples = 0;
+    profile.other_samples = 0;
+}
+
+uint32_t xip_profile_get_sample_count(void) {
+    return profile.samples;
+}
+
+uint32_t xip_profile_get_other_sample_count(void) {
+    return profile.other_samples;
+}
+
+void xip_profile_dump(void) {
+    printf("xip_profile: base=0x%08x shift=%u samples=%u other=%u\n", (uint)profile.base, profile.shift,
+           (uint)profile.samples, (uint)profile.other_samples);
+    for (uint i = 0; i < profile.bucket_count; i++) {
+        if (profile.counts[i]) {
+            printf("0x%08x %u\n", (uint)(profile.base + (i << profile.shift)), (uint)profile.counts[i]);
+        }
+    }
+    printf("xip_profile: end\n");
+}
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+PICOTEST_MODULE_NAME("DMA_CALLBACK", "hardware_dma per-channel callback test");
+
+#define WORDS 64
+#define TIMEOUT_MS 100
+
+static uint32_t src[WORDS];
+static uint32_t dst[WORDS];
+
+typedef struct {
+    volatile uint count;
+    volatile uint channel;
+    volatile bool irq_acknowledged;
+} callback_record_t;
+
+static callback_record_t records[2];
+
+static void record_callback(uint channel, void *user_data) {
+    callback_record_t *record = (callback_record_t *)user_data;
+    record->count++;
+    record->channel = channel;
+    // the dispatcher acknowledges the channel's IRQ before calling back
+    record->irq_acknowledged = !(dma_hw->ints0 & (1u << channel));
+}
+
+// a handler of the application's own, added alongside the dispatcher, which handles only its channel
+static uint user_channel;
+static volatile uint user_handler_count;
+
+static void __isr user_handler(void) {
+    if (dma_channel_get_irq0_status(user_channel)) {
+        dma_channel_acknowledge_irq0(user_channel);
+        user_handler_count++;
+    }
+}
+
+static void start_copy(uint channel) {
+    dma_channel_config c = dma_channel_get_default_config(channel);
+    dma_channel_configure(channel, &c, dst, src, WORDS, true);
+}
+
+static bool wait_for_count(volatile uint *count, uint expected) {
+    absolute_time_t timeout = make_timeout_time_ms(TIMEOUT_MS);
+    while (*count < expected) {
+        if (time_reached(timeout)) return false;
+    }
+    return true;
+}
+
+static void reset_records(void) {
+    for (uint i = 0; i < count_of(records); i++) {
+        records[i].count = 0;
+        records[i].channel = NUM_DMA_CHANNELS;
+        records[i].irq_acknowledged = false;
+    }
+    user_handler_count = 0;
+}
+
+int main() {
+    setup_default_uart();
+
+    PICOTEST_START();
+
+    for (uint i = 0; i < WORDS; i++) src[i] = i * 0x01010101u;
+    uint channels[2];
+    for (uint i = 0; i < count_of(channels); i++) channels[i] = (uint)dma_claim_unused_channel(true);
+    uint irq_num = (uint)dma_get_irq_num(0);
+
+    PICOTEST_START_SECTION("Per-channel callbacks");
+        reset_records();
+        for (uint i = 0; i < count_of(channels); i++) {
+            dma_irqn_set_channel_callback(0, channels[i], record_callback, &records[i]);
+        }
+        PICOTEST_CHECK(irq_is_enabled(irq_num), "DMA IRQ not enabled");
+        for (uint i = 0; i < count_of(channels); i++) {
+            start_copy(channels[i]);
+            PICOTEST_CHECK_CHANNEL(channels[i], wait_for_count(&records[i].count, 1), "Callback not called");
+            dma_channel_wait_for_finish_blocking(channels[i]);
+        }
+        // give any spurious extra calls a chance to happen
+        busy_wait_ms(1);
+        for (uint i = 0; i < count_of(channels); i++) {
+            PICOTEST_CHECK_CHANNEL(channels[i], records[i].count == 1, "Callback called more than once");
+            PICOTEST_CHECK_CHANNEL(channels[i], records[i].channel == channels[i], "Callback passed the wrong channel");
+            PICOTEST_CHECK_CHANNEL(channels[i], records[i].irq_acknowledged, "IRQ not acknowledged before the callback");
+        }
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Both channels completing together");
+        reset_records();
+        dma_start_channel_mask((1u << channels[0]) | (1u << channels[1]));
+        PICOTEST_CHECK(wait_for_count(&records[0].count, 1), "First callback not called");
+        PICOTEST_CHECK(wait_for_count(&records[1].count, 1), "Second callback not called");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Clearing a callback");
+        reset_records();
+        dma_irqn_clear_channel_callback(0, channels[1]);
+        PICOTEST_CHECK(!(dma_hw->inte0 & (1u << channels[1])), "Cleared channel's IRQ still enabled");
+        start_copy(channels[1]);
+        dma_channel_wait_for_finish_blocking(channels[1]);
+        start_copy(channels[0]);
+        PICOTEST_CHECK(wait_for_count(&records[0].count, 1), "Remaining callback not called");
+        busy_wait_ms(1);
+        PICOTEST_CHECK(!records[1].count, "Cleared callback was called");
+        // the raw status of the channel is left for its owner
+        PICOTEST_CHECK(dma_hw->intr & (1u << channels[1]), "Cleared channel's raw IRQ status was acknowledged");
+        dma_hw->intr = 1u << channels[1];
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Coexistence with a user shared handler");
+        reset_records();
+        user_channel = channels[1];
+        irq_add_shared_handler(irq_num, user_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        dma_channel_set_irq0_enabled(user_channel, true);
+        start_copy(user_channel);
+        PICOTEST_CHECK(wait_for_count(&user_handler_count, 1), "User handler not called for its channel");
+        dma_channel_wait_for_finish_blocking(user_channel);
+        start_copy(channels[0]);
+        PICOTEST_CHECK(wait_for_count(&records[0].count, 1), "Callback not called alongside the user handler");
+        dma_channel_wait_for_finish_blocking(channels[0]);
+        dma_start_channel_mask((1u << channels[0]) | (1u << user_channel));
+        PICOTEST_CHECK(wait_for_count(&records[0].count, 2), "Callback not called when both channels complete");
+        PICOTEST_CHECK(wait_for_count(&user_handler_count, 2), "User handler not called when both channels complete");
+        busy_wait_ms(1);
+        PICOTEST_CHECK(records[0].count == 2, "Callback called for the user handler's channel");
+        PICOTEST_CHECK(!records[1].count, "Cleared callback called for the user handler's channel");
+        dma_channel_set_irq0_enabled(user_channel, false);
+        irq_remove_handler(irq_num, user_handler);
+    PICOTEST_END_SECTION();
+
+    for (uint i = 0; i < count_of(channels); i++) {
+        dma_channel_cleanup(channels[i]);
+        dma_channel_unclaim(channels[i]);
+    }
+
+    PICOTEST_END_TEST();
+}
@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "hardware/pio_alloc.h"
+
+PICOTEST_MODULE_NAME("hardware_pio_alloc_test", "PIO instruction memory allocator test harness");
+
+#define ITERATIONS 20000
+
+// model of one PIO instance's instruction memory
+typedef struct {
+    uint8_t lengths[PIO_ALLOC_INSTRUCTION_COUNT];
+    uint32_t fixed;
+    uint32_t used;
+} instr_mem_t;
+
+static uint32_t rand_state = 0x2545f491;
+
+static uint32_t next_rand(void) {
+    // xorshift32
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+static uint32_t range_mask(uint offset, uint length) {
+    return (length >= 32 ? ~0u : (1u << length) - 1) << offset;
+}
+
+// size of the largest free gap
+static uint largest_gap(uint32_t used) {
+    uint largest = 0, run = 0;
+    for (uint i = 0; i < PIO_ALLOC_INSTRUCTION_COUNT; i++) {
+        run = used & (1u << i) ? 0 : run + 1;
+        if (run > largest) largest = run;
+    }
+    return largest;
+}
+
+// size of the free gap containing [offset, offset + length) in used
+static uint gap_size(uint32_t used, uint offset, uint length) {
+    uint bottom = offset, top = offset + length;
+    while (bottom > 0 && !(used & (1u << (bottom - 1)))) bottom--;
+    while (top < PIO_ALLOC_INSTRUCTION_COUNT && !(used & (1u << top))) top++;
+    return top - bottom;
+}
+
+static uint32_t used_from_lengths(const uint8_t *lengths) {
+    uint32_t used = 0;
+    for (uint i = 0; i < PIO_ALLOC_INSTRUCTION_COUNT; i++) {
+        if (lengths[i]) used |= range_mask(i, lengths[i]);
+    }
+    return used;
+}
+
+static int check_add(instr_mem_t *mem, bool best_fit) {
+    uint length = 1 + next_rand() % 12;
+    int origin = next_rand() % 4 ? -1 : (int)(next_rand() % (PIO_ALLOC_INSTRUCTION_COUNT - length + 1));
+    int offset = pio_alloc_find_offset(mem->used, length, origin, best_fit);
+    if (origin >= 0) {
+        bool free = !(mem->used & range_mask((uint)origin, length));
+        PICOTEST_CHECK_AND_ABORT(free ? offset == origin : offset == PICO_ERROR_GENERIC, "wrong result for program with origin");
+    } else if (offset < 0) {
+        PICOTEST_CHECK_AND_ABORT(offset == PICO_ERROR_INSUFFICIENT_RESOURCES, "wrong error");
+        PICOTEST_CHECK_AND_ABORT(largest_gap(mem->used) < length, "space was available");
+    } else {
+        PICOTEST_CHECK_AND_ABORT(offset + length <= PIO_ALLOC_INSTRUCTION_COUNT, "program placed past the end");
+        PICOTEST_CHECK_AND_ABORT(!(mem->used & range_mask((uint)offset, length)), "program placed over another");
+        // always at the top of its gap
+        PICOTEST_CHECK_AND_ABORT(offset + length == PIO_ALLOC_INSTRUCTION_COUNT || (mem->used & (1u << (offset + length))),
+                                 "program not placed at the top of a gap");
+        if (best_fit) {
+            uint gap = gap_size(mem->used, (uint)offset, length);
+            for (uint i = 0; i + length <= PIO_ALLOC_INSTRUCTION_COUNT; i++) {
+                if (!(mem->used & range_mask(i, length))) {
+                    PICOTEST_CHECK_AND_ABORT(gap_size(mem->used, i, length) >= gap, "a smaller gap would fit");
+                }
+            }
+        } else {
+            for (uint i = (uint)offset + 1; i + length <= PIO_ALLOC_INSTRUCTION_COUNT; i++) {
+                PICOTEST_CHECK_AND_ABORT(mem->used & range_mask(i, length), "a higher position was free");
+            }
+        }
+    }
+    if (offset >= 0) {
+        mem->lengths[offset] = (uint8_t)length;
+        mem->used |= range_mask((uint)offset, length);
+        if (origin >= 0) mem->fixed |= 1u << offset;
+    }
+    return 0;
+}
+
+static void remove_random(instr_mem_t *mem) {
+    uint start = next_rand() % PIO_ALLOC_INSTRUCTION_COUNT;
+    for (uint i = 0; i < PIO_ALLOC_INSTRUCTION_COUNT; i++) {
+        uint offset = (start + i) % PIO_ALLOC_INSTRUCTION_COUNT;
+        if (mem->lengths[offset]) {
+            mem->used &= ~range_mask(offset, mem->lengths[offset]);
+            mem->lengths[offset] = 0;
+            mem->fixed &= ~(1u << offset);
+            return;
+        }
+    }
+}
+
+static int check_compact(instr_mem_t *mem) {
+    // as if some other programs were in use by running state machines
+    uint32_t fixed = mem->fixed | (next_rand() & next_rand() & next_rand());
+    uint8_t new_offsets[PIO_ALLOC_INSTRUCTION_COUNT];
+    uint moved = pio_alloc_plan_compaction(mem->lengths, fixed, new_offsets);
+    uint8_t lengths[PIO_ALLOC_INSTRUCTION_COUNT] = {0};
+    uint32_t new_fixed = 0, new_used = 0;
+    uint count = 0;
+    for (uint i = 0; i < PIO_ALLOC_INSTRUCTION_COUNT; i++) {
+        if (!mem->lengths[i]) continue;
+        uint to = new_offsets[i];
+        PICOTEST_CHECK_AND_ABORT(to >= i, "program moved down");
+        PICOTEST_CHECK_AND_ABORT(to + mem->lengths[i] <= PIO_ALLOC_INSTRUCTION_COUNT, "program moved past the end");
+        PICOTEST_CHECK_AND_ABORT(!(fixed & (1u << i)) || to == i, "fixed program moved");
+        PICOTEST_CHECK_AND_ABORT(!(new_used & range_mask(to, mem->lengths[i])), "programs overlap after compaction");
+        if (to != i) count++;
+        lengths[to] = mem->lengths[i];
+        new_used |= range_mask(to, mem->lengths[i]);
+        if (mem->fixed & (1u << i)) new_fixed |= 1u << to;
+    }
+    PICOTEST_CHECK_AND_ABORT(moved == count, "wrong count of moved programs");
+    PICOTEST_CHECK_AND_ABORT(__builtin_popcount(new_used) == __builtin_popcount(mem->used), "instruction count changed");
+    PICOTEST_CHECK_AND_ABORT(largest_gap(new_used) >= largest_gap(mem->used), "largest gap got smaller");
+    // each program not fixed is directly below the next program, or the top
+    for (uint i = 0; i < PIO_ALLOC_INSTRUCTION_COUNT; i++) {
+        if (lengths[i] && !(fixed & (1u << i)) && i != new_offsets[i]) {
+            uint end = i + lengths[i];
+            PICOTEST_CHECK_AND_ABORT(end == PIO_ALLOC_INSTRUCTION_COUNT || (new_used & (1u << end)), "gap left above a moved program");
+        }
+    }
+    // compacting again changes nothing
+    uint8_t again[PIO_ALLOC_INSTRUCTION_COUNT];
+    uint32_t fixed_after = 0;
+    for (uint i = 0; i < PIO_ALLOC_INSTRUCTION_COUNT; i++) {
+        if (mem->lengths[i] && (fixed & (1u << i))) fixed_after |= 1u << new_offsets[i];
+    }
+    PICOTEST_CHECK_AND_ABORT(!pio_alloc_plan_compaction(lengths, fixed_after, again), "second compaction moved programs");
+    memcpy(mem->lengths, lengths, sizeof(lengths));
+    mem->fixed = new_fixed;
+    mem->used = new_used;
+    PICOTEST_CHECK_AND_ABORT(used_from_lengths(mem->lengths) == mem->used, "model inconsistent");
+    return 0;
+}
+
+static int run_random_sequence(bool best_fit, uint *added, uint *failed) {
+    instr_mem_t mem;
+    memset(&mem, 0, sizeof(mem));
+    for (uint i = 0; i < ITERATIONS; i++) {
+        uint op = next_rand() % 16;
+        if (op < 8) {
+            uint32_t used_before = mem.used;
+            if (check_add(&mem, best_fit)) return -1;
+            if (mem.used != used_before) (*added)++; else (*failed)++;
+        } else if (op < 15) {
+            remove_random(&mem);
+        } else {
+            if (check_compact(&mem)) return -1;
+        }
+    }
+    return 0;
+}
+
+int main(void) {
+    stdio_init_all();
+
+    PICOTEST_START();
+
+    PICOTEST_START_SECTION("fixed cases");
+        PICOTEST_CHECK(pio_alloc_find_offset(0, 32, -1, false) == 0, "full size program");
+        PICOTEST_CHECK(pio_alloc_find_offset(0, 4, -1, false) == 28, "first program goes at the top");
+        PICOTEST_CHECK(pio_alloc_find_offset(0, 4, -1, true) == 28, "first program goes at the top (best fit)");
+        // gaps of 6 at 26..31, and 3 at 10..12
+        uint32_t used = ~(range_mask(26, 6) | range_mask(10, 3));
+        PICOTEST_CHECK(pio_alloc_find_offset(used, 3, -1, false) == 29, "highest gap");
+        PICOTEST_CHECK(pio_alloc_find_offset(used, 3, -1, true) == 10, "smallest gap");
+        PICOTEST_CHECK(pio_alloc_find_offset(used, 7, -1, true) == PICO_ERROR_INSUFFICIENT_RESOURCES, "no room");
+        PICOTEST_CHECK(pio_alloc_find_offset(used, 2, 10, true) == 10, "free origin");
+        PICOTEST_CHECK(pio_alloc_find_offset(used, 2, 12, true) == PICO_ERROR_GENERIC, "used origin");
+        PICOTEST_CHECK(pio_alloc_find_offset(0, 4, 29, true) == PICO_ERROR_GENERIC, "origin past the end");
+
+        uint8_t lengths[PIO_ALLOC_INSTRUCTION_COUNT] = {0};
+        uint8_t new_offsets[PIO_ALLOC_INSTRUCTION_COUNT];
+        lengths[0] = 4;
+        lengths[10] = 2;
+        lengths[20] = 5;
+        PICOTEST_CHECK(pio_alloc_plan_compaction(lengths, 1u << 10, new_offsets) == 2, "two programs move");
+        PICOTEST_CHECK(new_offsets[20] == 27 && new_offsets[10] == 10 && new_offsets[0] == 6, "compacted below fixed program");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("random first fit");
+        uint added = 0, failed = 0;
+        PICOTEST_CHECK(!run_random_sequence(false, &added, &failed), "random add/remove/compact sequence failed");
+        printf("%u programs added, %u did not fit\n", added, failed);
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("random best fit");
+        uint added = 0, failed = 0;
+        PICOTEST_CHECK(!run_random_sequence(true, &added, &failed), "random add/remove/compact sequence failed");
+        printf("%u programs added, %u did not fit\n", added, failed);
+    PICOTEST_END_SECTION();
+
+    PICOTEST_END_TEST();
+}
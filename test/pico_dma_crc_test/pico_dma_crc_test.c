@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/dma_crc.h"
+#if !PICO_NO_HARDWARE
+#include "hardware/dma.h"
+#endif
+
+PICOTEST_MODULE_NAME("pico_dma_crc_test", "pico_dma_crc test harness");
+
+#define BUFFER_SIZE 4096
+static uint8_t buffer[BUFFER_SIZE + 4];
+
+static const char check_string[] = "123456789";
+
+int main(void) {
+    stdio_init_all();
+    PICOTEST_START();
+
+    PICOTEST_START_SECTION("check values");
+        // standard "check" values for the input "123456789"
+        PICOTEST_CHECK(dma_crc32_sw(DMA_CRC32_INIT, check_string, 9) == 0xcbf43926, "Wrong software CRC-32");
+        PICOTEST_CHECK(dma_crc16_ccitt_sw(DMA_CRC16_CCITT_INIT, check_string, 9) == 0x29b1, "Wrong software CRC-16-CCITT");
+        PICOTEST_CHECK(dma_sum32_sw(DMA_SUM32_INIT, check_string, 9) == 0x1dd, "Wrong software sum");
+        PICOTEST_CHECK(dma_crc32(DMA_CRC32_INIT, check_string, 9) == 0xcbf43926, "Wrong CRC-32");
+        PICOTEST_CHECK(dma_crc16_ccitt(DMA_CRC16_CCITT_INIT, check_string, 9) == 0x29b1, "Wrong CRC-16-CCITT");
+        PICOTEST_CHECK(dma_sum32(DMA_SUM32_INIT, check_string, 9) == 0x1dd, "Wrong sum");
+        PICOTEST_CHECK(dma_crc32_sw(DMA_CRC32_INIT, NULL, 0) == 0, "Wrong CRC-32 of nothing");
+    PICOTEST_END_SECTION();
+
+    for (uint i = 0; i < count_of(buffer); i++) {
+        buffer[i] = (uint8_t)(i * 251u + (i >> 8) * 17u);
+    }
+
+    PICOTEST_START_SECTION("dma matches software");
+        for (uint offset = 0; offset < 4; offset++) {
+            for (uint len = 0; len <= BUFFER_SIZE; len = len * 3 + 1) {
+                const uint8_t *data = buffer + offset;
+                PICOTEST_CHECK(dma_crc32(DMA_CRC32_INIT, data, len) == dma_crc32_sw(DMA_CRC32_INIT, data, len), "CRC-32 mismatch");
+                PICOTEST_CHECK(dma_crc16_ccitt(DMA_CRC16_CCITT_INIT, data, len) == dma_crc16_ccitt_sw(DMA_CRC16_CCITT_INIT, data, len), "CRC-16-CCITT mismatch");
+                PICOTEST_CHECK(dma_sum32(DMA_SUM32_INIT, data, len) == dma_sum32_sw(DMA_SUM32_INIT, data, len), "Sum mismatch");
+            }
+        }
+    PICOTEST_END_SECTION();
+
+    uint32_t whole32 = dma_crc32(DMA_CRC32_INIT, buffer, BUFFER_SIZE);
+    uint16_t whole16 = dma_crc16_ccitt(DMA_CRC16_CCITT_INIT, buffer, BUFFER_SIZE);
+    uint32_t wholesum = dma_sum32(DMA_SUM32_INIT, buffer, BUFFER_SIZE);
+
+    PICOTEST_START_SECTION("piecewise");
+        for (uint split = 0; split <= BUFFER_SIZE; split += 509) {
+            uint32_t crc32 = dma_crc32(dma_crc32(DMA_CRC32_INIT, buffer, split), buffer + split, BUFFER_SIZE - split);
+            uint16_t crc16 = dma_crc16_ccitt(dma_crc16_ccitt(DMA_CRC16_CCITT_INIT, buffer, split), buffer + split, BUFFER_SIZE - split);
+            uint32_t sum = dma_sum32(dma_sum32(DMA_SUM32_INIT, buffer, split), buffer + split, BUFFER_SIZE - split);
+            PICOTEST_CHECK(crc32 == whole32, "Piecewise CRC-32 mismatch");
+            PICOTEST_CHECK(crc16 == whole16, "Piecewise CRC-16-CCITT mismatch");
+            PICOTEST_CHECK(sum == wholesum, "Piecewise sum mismatch");
+        }
+    PICOTEST_END_SECTION();
+
+#if !PICO_NO_HARDWARE
+    PICOTEST_START_SECTION("sniff during copy");
+        static uint8_t copy[BUFFER_SIZE];
+        uint channel = (uint)dma_claim_unused_channel(true);
+        dma_channel_config_t c = dma_channel_get_default_config(channel);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+        channel_config_set_sniff_enable(&c, true);
+        dma_channel_configure(channel, &c, copy, buffer, BUFFER_SIZE, false);
+        PICOTEST_CHECK_AND_ABORT(dma_crc_sniff_start(channel, DMA_CRC_TYPE_CRC32, DMA_CRC32_INIT), "Sniffer unavailable");
+        dma_channel_start(channel);
+        dma_channel_wait_for_finish_blocking(channel);
+        PICOTEST_CHECK(dma_crc_sniff_finish(DMA_CRC_TYPE_CRC32) == whole32, "Sniffed CRC-32 mismatch");
+        PICOTEST_CHECK(!memcmp(copy, buffer, BUFFER_SIZE), "Copy mismatch");
+        dma_channel_cleanup(channel);
+        dma_channel_unclaim(channel);
+    PICOTEST_END_SECTION();
+#endif
+
+    PICOTEST_END_TEST();
+}
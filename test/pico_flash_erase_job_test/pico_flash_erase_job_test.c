@@ -0,0 +1,194 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+PICOTEST_MODULE_NAME("FLASH_ERASE_JOB", "pico_flash erase job test");
+
+#define TEST_SECTORS 3
+#define TEST_OFFSET (PICO_FLASH_SIZE_BYTES - TEST_SECTORS * FLASH_SECTOR_SIZE)
+#define TEST_SIZE (TEST_SECTORS * FLASH_SECTOR_SIZE)
+
+// a flash safety helper which only disables interrupts (this test does not use core 1), and which can be made to fail
+static uint enter_count;
+static uint fail_enter_count;
+static uint32_t irq_save;
+
+static bool test_core_init_deinit(__unused bool init) {
+    return true;
+}
+
+static int test_enter_safe_zone_timeout_ms(__unused uint32_t timeout_ms) {
+    if (++enter_count == fail_enter_count) return PICO_ERROR_TIMEOUT;
+    irq_save = save_and_disable_interrupts();
+    return PICO_OK;
+}
+
+static int test_exit_safe_zone_timeout_ms(__unused uint32_t timeout_ms) {
+    restore_interrupts(irq_save);
+    return PICO_OK;
+}
+
+static flash_safety_helper_t test_flash_safety_helper = {
+    .core_init_deinit = test_core_init_deinit,
+    .enter_safe_zone_timeout_ms = test_enter_safe_zone_timeout_ms,
+    .exit_safe_zone_timeout_ms = test_exit_safe_zone_timeout_ms,
+};
+
+flash_safety_helper_t *get_flash_safety_helper(void) {
+    return &test_flash_safety_helper;
+}
+
+static uint callback_count;
+static uint32_t callback_erased;
+static int callback_status;
+static void *callback_user_data;
+
+static void erase_callback(__unused flash_erase_job_t *job, uint32_t erased, int status, void *user_data) {
+    callback_count++;
+    callback_erased = erased;
+    callback_status = status;
+    callback_user_data = user_data;
+}
+
+// fill the test range with zeros, which programming can always do without an erase
+static void fill_range(void) {
+    static uint8_t zeros[FLASH_PAGE_SIZE];
+    uint32_t save = save_and_disable_interrupts();
+    for (uint32_t offs = 0; offs < TEST_SIZE; offs += FLASH_PAGE_SIZE) {
+        flash_range_program(TEST_OFFSET + offs, zeros, FLASH_PAGE_SIZE);
+    }
+    restore_interrupts(save);
+    enter_count = 0;
+    callback_count = 0;
+}
+
+static bool sector_is_erased(uint sector) {
+    const uint32_t *p = (const uint32_t *)(XIP_BASE + TEST_OFFSET + sector * FLASH_SECTOR_SIZE);
+    for (uint i = 0; i < FLASH_SECTOR_SIZE / 4; i++) {
+        if (p[i] != 0xffffffff) return false;
+    }
+    return true;
+}
+
+static uint erased_sector_count(void) {
+    uint n = 0;
+    for (uint sector = 0; sector < TEST_SECTORS; sector++) {
+        if (sector_is_erased(sector)) n++;
+    }
+    return n;
+}
+
+static bool wait_until_done(flash_erase_job_t *job, uint32_t timeout_ms) {
+    absolute_time_t until = make_timeout_time_ms(timeout_ms);
+    while (!flash_erase_job_is_done(job) && !time_reached(until)) {
+        tight_loop_contents();
+    }
+    return flash_erase_job_is_done(job);
+}
+
+int main() {
+    setup_default_uart();
+
+    PICOTEST_START();
+
+    flash_erase_job_t job;
+    int rc;
+    static_assert(PICO_FLASH_ERASE_JOB_STEP_SIZE == FLASH_SECTOR_SIZE, "test expects one sector per step");
+
+    PICOTEST_START_SECTION("Stepping");
+        fill_range();
+        flash_erase_job_init(&job, TEST_OFFSET, TEST_SIZE, erase_callback, &job);
+        PICOTEST_CHECK(!flash_erase_job_is_done(&job), "New job is done");
+        PICOTEST_CHECK(flash_erase_job_get_status(&job) == PICO_OK, "New job has an error");
+        PICOTEST_CHECK(erased_sector_count() == 0, "Range not filled");
+        for (uint step = 1; step <= TEST_SECTORS; step++) {
+            rc = flash_erase_job_step(&job);
+            PICOTEST_CHECK(rc == PICO_OK, "Step failed");
+            PICOTEST_CHECK(enter_count == step, "Step not taken in a single flash_safe_execute");
+            PICOTEST_CHECK(callback_count == step, "Callback not called once per step");
+            PICOTEST_CHECK(callback_erased == step * FLASH_SECTOR_SIZE && callback_status == PICO_OK &&
+                           callback_user_data == &job, "Wrong callback arguments");
+            PICOTEST_CHECK(erased_sector_count() == step && sector_is_erased(step - 1), "Wrong sectors erased");
+            PICOTEST_CHECK(flash_erase_job_is_done(&job) == (step == TEST_SECTORS), "Wrong done state");
+        }
+        rc = flash_erase_job_step(&job);
+        PICOTEST_CHECK(rc == PICO_OK, "Step of a completed job failed");
+        PICOTEST_CHECK(enter_count == TEST_SECTORS && callback_count == TEST_SECTORS, "Completed job stepped again");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Empty job");
+        flash_erase_job_init(&job, TEST_OFFSET, 0, erase_callback, NULL);
+        PICOTEST_CHECK(flash_erase_job_is_done(&job), "Empty job not done");
+        callback_count = 0;
+        PICOTEST_CHECK(flash_erase_job_step(&job) == PICO_OK && !callback_count, "Empty job stepped");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("An error stops the job");
+        fill_range();
+        fail_enter_count = 2;
+        flash_erase_job_init(&job, TEST_OFFSET, TEST_SIZE, erase_callback, NULL);
+        PICOTEST_CHECK(flash_erase_job_step(&job) == PICO_OK, "First step failed");
+        rc = flash_erase_job_step(&job);
+        PICOTEST_CHECK(rc == PICO_ERROR_TIMEOUT, "Error not returned");
+        PICOTEST_CHECK(callback_count == 2 && callback_erased == FLASH_SECTOR_SIZE && callback_status == PICO_ERROR_TIMEOUT,
+                       "Error not reported to the callback");
+        PICOTEST_CHECK(flash_erase_job_is_done(&job), "Failed job not done");
+        PICOTEST_CHECK(flash_erase_job_get_status(&job) == PICO_ERROR_TIMEOUT, "Failed job has no error");
+        PICOTEST_CHECK(erased_sector_count() == 1, "Wrong sectors erased");
+        rc = flash_erase_job_step(&job);
+        PICOTEST_CHECK(rc == PICO_ERROR_TIMEOUT, "Step of a failed job did not return the error");
+        PICOTEST_CHECK(enter_count == 2 && callback_count == 2, "Failed job stepped again");
+        fail_enter_count = 0;
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Background job");
+        fill_range();
+        flash_erase_job_init(&job, TEST_OFFSET, TEST_SIZE, erase_callback, NULL);
+        PICOTEST_CHECK(flash_erase_job_start(&job, 1000) == PICO_OK, "Failed to start job");
+        PICOTEST_CHECK(wait_until_done(&job, 1000), "Job did not complete");
+        PICOTEST_CHECK(flash_erase_job_get_status(&job) == PICO_OK, "Job failed");
+        PICOTEST_CHECK(callback_count == TEST_SECTORS && erased_sector_count() == TEST_SECTORS, "Job incomplete");
+        PICOTEST_CHECK(job.alarm_id == 0, "Alarm not released");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Stopping and resuming a background job");
+        fill_range();
+        flash_erase_job_init(&job, TEST_OFFSET, TEST_SIZE, erase_callback, NULL);
+        // the first step is due immediately, the next not for a long time
+        PICOTEST_CHECK(flash_erase_job_start(&job, 100000) == PICO_OK, "Failed to start job");
+        absolute_time_t until = make_timeout_time_ms(50);
+        while (!callback_count && !time_reached(until)) tight_loop_contents();
+        flash_erase_job_stop(&job);
+        PICOTEST_CHECK(callback_count == 1 && !flash_erase_job_is_done(&job), "First step not taken");
+        sleep_ms(200);
+        PICOTEST_CHECK(callback_count == 1 && erased_sector_count() == 1, "Stopped job continued");
+        PICOTEST_CHECK(flash_erase_job_start(&job, 0) == PICO_OK, "Failed to resume job");
+        PICOTEST_CHECK(wait_until_done(&job, 1000), "Resumed job did not complete");
+        PICOTEST_CHECK(callback_count == TEST_SECTORS && erased_sector_count() == TEST_SECTORS, "Resumed job incomplete");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Blocking sliced erase");
+        fill_range();
+        rc = flash_range_erase_sliced(TEST_OFFSET, TEST_SIZE, erase_callback, NULL);
+        PICOTEST_CHECK(rc == PICO_OK, "Sliced erase failed");
+        PICOTEST_CHECK(enter_count == TEST_SECTORS && callback_count == TEST_SECTORS, "Not erased a sector per step");
+        PICOTEST_CHECK(erased_sector_count() == TEST_SECTORS, "Range not erased");
+        fill_range();
+        fail_enter_count = 3;
+        rc = flash_range_erase_sliced(TEST_OFFSET, TEST_SIZE, NULL, NULL);
+        PICOTEST_CHECK(rc == PICO_ERROR_TIMEOUT, "Sliced erase did not return the error");
+        PICOTEST_CHECK(erased_sector_count() == 2, "Wrong sectors erased");
+        fail_enter_count = 0;
+    PICOTEST_END_SECTION();
+
+    PICOTEST_END_TEST();
+}
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/flash_page_buffer.h"
+
+PICOTEST_MODULE_NAME("pico_flash_page_buffer_test", "pico_flash_page_buffer test harness");
+
+// two banks, as used by the BTstack flash bank
+#define BANK_SIZE 4096
+#define FLASH_SIZE (BANK_SIZE * 2)
+
+// simulated NOR flash, and what it should hold once everything buffered has been written
+static uint8_t flash[FLASH_SIZE];
+static uint8_t expected[FLASH_SIZE];
+
+static flash_page_buffer_t buffer;
+static uint batches;
+static uint pages_programmed;
+static bool bad_program;
+
+static void program_pages(__unused flash_page_buffer_t *b, const flash_page_buffer_batch_t *batch) {
+    uint8_t page[FLASH_PAGE_BUFFER_PAGE_SIZE];
+    batches++;
+    for (uint i = 0; i < flash_page_buffer_batch_get_page_count(batch); i++) {
+        uint32_t offset = flash_page_buffer_batch_get_page(batch, i, page);
+        if (offset % FLASH_PAGE_BUFFER_PAGE_SIZE || offset >= FLASH_SIZE) {
+            bad_program = true;
+            continue;
+        }
+        for (uint j = 0; j < FLASH_PAGE_BUFFER_PAGE_SIZE; j++) {
+            flash[offset + j] &= page[j];
+        }
+        pages_programmed++;
+    }
+}
+
+static void write(uint32_t offset, const uint8_t *data, uint32_t size, bool through) {
+    if (through) {
+        flash_page_buffer_write_through(&buffer, offset, data, size);
+    } else {
+        flash_page_buffer_write(&buffer, offset, data, size);
+    }
+    for (uint32_t i = 0; i < size; i++) {
+        expected[offset + i] &= data[i];
+    }
+}
+
+static void erase_bank(uint bank) {
+    flash_page_buffer_erase(&buffer, bank * BANK_SIZE, BANK_SIZE);
+    memset(flash + bank * BANK_SIZE, 0xff, BANK_SIZE);
+    memset(expected + bank * BANK_SIZE, 0xff, BANK_SIZE);
+}
+
+static bool read_matches(uint32_t offset, uint32_t size) {
+    static uint8_t data[FLASH_SIZE];
+    memcpy(data, flash + offset, size);
+    flash_page_buffer_apply(&buffer, offset, data, size);
+    return !memcmp(data, expected + offset, size);
+}
+
+static uint32_t rand_state = 0x2468ace1;
+
+static uint32_t next_rand(void) {
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+int main(void) {
+    stdio_init_all();
+    PICOTEST_START();
+
+    memset(flash, 0xff, sizeof(flash));
+    memset(expected, 0xff, sizeof(expected));
+    flash_page_buffer_init(&buffer, program_pages, NULL);
+
+    static uint8_t data[1024];
+    for (uint i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 7 + 3);
+
+    PICOTEST_START_SECTION("coalescing");
+        // small writes to the same page, like BTstack TLV entries
+        for (uint i = 0; i < 24; i++) {
+            write(0x40 + i * 8, data + i * 8, 8, false);
+        }
+        PICOTEST_CHECK(batches == 0, "small writes to one page were not buffered");
+        PICOTEST_CHECK(read_matches(0, FLASH_SIZE), "buffered data not read back");
+        flash_page_buffer_flush(&buffer);
+        PICOTEST_CHECK(batches == 1 && pages_programmed == 1, "buffered page not programmed once");
+        PICOTEST_CHECK(!memcmp(flash, expected, FLASH_SIZE), "flash contents wrong after flush");
+        flash_page_buffer_flush(&buffer);
+        PICOTEST_CHECK(batches == 1, "empty buffer flushed");
+        // overwriting a byte clears bits, as it would in flash
+        static const uint8_t ones = 0xf0, twos = 0x3c;
+        write(0x200, &ones, 1, false);
+        write(0x200, &twos, 1, false);
+        flash_page_buffer_flush(&buffer);
+        PICOTEST_CHECK(flash[0x200] == 0x30, "repeated write not ANDed");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("batching");
+        batches = pages_programmed = 0;
+        write(0x300 + 5, data, 8, false);
+        // spans pages 0x400 to 0x800, so with the buffered page at 0x300 there are 5 to program now
+        write(0x400 + 17, data, 1024, false);
+        PICOTEST_CHECK(batches == 1 && pages_programmed == 5, "multi-page write not batched");
+        PICOTEST_CHECK(read_matches(0, FLASH_SIZE), "wrong contents after multi-page write");
+        // ends in the buffered page, so it is merged rather than written
+        write(0x800 + 100, data, 4, false);
+        PICOTEST_CHECK(batches == 1, "write to buffered page not merged");
+        // the buffered page is inside this write, so it is merged into it
+        write(0x700 + 200, data, 512, true);
+        PICOTEST_CHECK(batches == 2 && pages_programmed == 5 + 3, "write through not batched");
+        PICOTEST_CHECK(buffer.page_offset == FLASH_PAGE_BUFFER_EMPTY, "write through left data buffered");
+        PICOTEST_CHECK(!memcmp(flash, expected, FLASH_SIZE), "flash contents wrong after write through");
+        write(0xa00, data, 0, false);
+        PICOTEST_CHECK(batches == 2 && buffer.page_offset == FLASH_PAGE_BUFFER_EMPTY, "empty write did something");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("erase");
+        batches = pages_programmed = 0;
+        write(BANK_SIZE + 0x10, data, 16, false);
+        erase_bank(1);
+        PICOTEST_CHECK(batches == 0, "page in erased bank programmed");
+        PICOTEST_CHECK(buffer.page_offset == FLASH_PAGE_BUFFER_EMPTY, "page in erased bank still buffered");
+        write(0x10, data, 16, false);
+        erase_bank(1);
+        PICOTEST_CHECK(batches == 1 && pages_programmed == 1, "page in other bank not programmed before erase");
+        PICOTEST_CHECK(!memcmp(flash, expected, FLASH_SIZE), "flash contents wrong after erase");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("random");
+        for (uint i = 0; i < 20000; i++) {
+            uint op = next_rand() % 16;
+            if (op == 0) {
+                erase_bank(next_rand() % 2);
+            } else if (op == 1) {
+                flash_page_buffer_flush(&buffer);
+                PICOTEST_CHECK_AND_ABORT(!memcmp(flash, expected, FLASH_SIZE), "flash contents wrong after flush");
+            } else {
+                uint32_t size = next_rand() % (op < 12 ? 32 : sizeof(data));
+                uint32_t offset = next_rand() % (FLASH_SIZE - size);
+                write(offset, data + next_rand() % (sizeof(data) - size), size, op == 15);
+                uint32_t read_size = next_rand() % 600;
+                uint32_t read_offset = next_rand() % (FLASH_SIZE - read_size);
+                PICOTEST_CHECK_AND_ABORT(read_matches(read_offset, read_size), "wrong contents read");
+            }
+        }
+        flash_page_buffer_flush(&buffer);
+        PICOTEST_CHECK(!memcmp(flash, expected, FLASH_SIZE), "flash contents wrong at end");
+        PICOTEST_CHECK(!bad_program, "bad page programmed");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_END_TEST();
+}
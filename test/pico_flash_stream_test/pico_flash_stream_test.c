@@ -0,0 +1,155 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/flash_stream.h"
+
+PICOTEST_MODULE_NAME("FLASH_STREAM", "pico_flash_stream test");
+
+// Everything is read from the start of flash, i.e. this program's own image, and compared with the same range
+// read through XIP
+#define CHUNK_SIZE 1024
+#define MAX_READ 8192
+#define GUARD 8
+#define GUARD_BYTE 0xa5
+
+static uint32_t chunk_buffers[2][CHUNK_SIZE / 4];
+static uint32_t read_buffer[(MAX_READ + GUARD) / 4];
+
+static const uint8_t *xip_ptr(uint32_t flash_offs) {
+    return (const uint8_t *)(XIP_BASE + flash_offs);
+}
+
+typedef struct {
+    uint32_t flash_offs;
+    uint32_t size;
+} flash_range_t;
+
+static const flash_range_t stream_ranges[] = {
+    {0, MAX_READ},                  // whole chunks
+    {4, 3 * CHUNK_SIZE + 4},        // a short last chunk
+    {256, CHUNK_SIZE / 2},          // a single short chunk
+    {0, 2 * CHUNK_SIZE + 3},        // a last chunk which is not a whole number of words
+    {8, 1},
+    {0, 0},
+};
+
+// sizes whose tail is (mostly) not a multiple of 4, to exercise the single word read of the tail
+static const flash_range_t read_ranges[] = {
+    {0, 1},
+    {0, 2},
+    {0, 3},
+    {0, 4},
+    {4, 5},
+    {8, 6},
+    {12, 7},
+    {64, 1023},
+    {128, CHUNK_SIZE + 1},
+    {0, MAX_READ},
+};
+
+// read a whole range through the stream, checking each chunk against XIP
+static bool stream_matches_xip(flash_stream_t *stream, uint32_t flash_offs, uint32_t size) {
+    if (flash_stream_start(stream, flash_offs, size) != PICO_OK) return false;
+    uint32_t pos = 0;
+    uint index = 0;
+    const void *chunk;
+    uint32_t len;
+    while ((chunk = flash_stream_next(stream, &len))) {
+        if (chunk != chunk_buffers[index]) return false;
+        if (len != MIN(size - pos, CHUNK_SIZE)) return false;
+        if (memcmp(chunk, xip_ptr(flash_offs + pos), len)) return false;
+        pos += len;
+        index ^= 1;
+    }
+    return pos == size && !len && flash_stream_is_chunk_ready(stream);
+}
+
+int main() {
+    setup_default_uart();
+
+    PICOTEST_START();
+
+    flash_stream_t stream;
+    PICOTEST_CHECK_AND_ABORT(flash_stream_init(&stream, chunk_buffers[0], chunk_buffers[1], CHUNK_SIZE) == PICO_OK,
+                             "Stream init failed");
+
+    PICOTEST_START_SECTION("Invalid arguments");
+        flash_stream_t bad_stream;
+        PICOTEST_CHECK(flash_stream_init(&bad_stream, chunk_buffers[0], chunk_buffers[1], CHUNK_SIZE - 1) == PICO_ERROR_INVALID_ARG,
+                       "Chunk size which is not a multiple of 4 accepted");
+        PICOTEST_CHECK(flash_stream_init(&bad_stream, (uint8_t *)chunk_buffers[0] + 1, chunk_buffers[1], CHUNK_SIZE) == PICO_ERROR_INVALID_ARG,
+                       "Unaligned buffer accepted");
+        PICOTEST_CHECK(flash_stream_start(&stream, 2, CHUNK_SIZE) == PICO_ERROR_INVALID_ARG, "Unaligned flash offset accepted");
+        PICOTEST_CHECK(flash_stream_read(2, read_buffer, 4) == PICO_ERROR_INVALID_ARG, "Unaligned flash offset accepted by read");
+        PICOTEST_CHECK(flash_stream_read(0, (uint8_t *)read_buffer + 2, 4) == PICO_ERROR_INVALID_ARG, "Unaligned destination accepted by read");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Chunked read matches XIP");
+        for (uint i = 0; i < count_of(stream_ranges); i++) {
+            if (!stream_matches_xip(&stream, stream_ranges[i].flash_offs, stream_ranges[i].size)) {
+                printf("  offset %u size %u\n", (uint)stream_ranges[i].flash_offs, (uint)stream_ranges[i].size);
+                PICOTEST_CHECK(false, "Streamed data does not match XIP");
+            }
+        }
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Abort");
+        const void *chunk;
+        uint32_t len;
+        // abort straight after the first fetch is started, and while the second is in flight
+        for (uint chunks_taken = 0; chunks_taken < 2; chunks_taken++) {
+            PICOTEST_CHECK(flash_stream_start(&stream, 0, MAX_READ) == PICO_OK, "Stream start failed");
+            for (uint i = 0; i < chunks_taken; i++) {
+                PICOTEST_CHECK(flash_stream_next(&stream, &len) != NULL, "Chunk not returned before abort");
+            }
+            flash_stream_abort(&stream);
+            PICOTEST_CHECK(flash_stream_is_chunk_ready(&stream), "Aborted stream still fetching");
+            chunk = flash_stream_next(&stream, &len);
+            PICOTEST_CHECK(!chunk && !len, "Chunk returned after abort");
+            // words left in the FIFO by the aborted fetch must not turn up in the next read
+            PICOTEST_CHECK(stream_matches_xip(&stream, CHUNK_SIZE, 2 * CHUNK_SIZE), "Stream after abort does not match XIP");
+        }
+        // a new start aborts the read in progress
+        PICOTEST_CHECK(flash_stream_start(&stream, 0, MAX_READ) == PICO_OK, "Stream start failed");
+        PICOTEST_CHECK(flash_stream_next(&stream, &len) != NULL, "First chunk not returned");
+        PICOTEST_CHECK(stream_matches_xip(&stream, 4, CHUNK_SIZE + 4), "Restarted stream does not match XIP");
+        // as must the one shot read
+        PICOTEST_CHECK(flash_stream_start(&stream, 0, MAX_READ) == PICO_OK, "Stream start failed");
+        flash_stream_abort(&stream);
+        PICOTEST_CHECK(flash_stream_read(CHUNK_SIZE, read_buffer, CHUNK_SIZE) == PICO_OK, "Read after abort failed");
+        PICOTEST_CHECK(!memcmp(read_buffer, xip_ptr(CHUNK_SIZE), CHUNK_SIZE), "Read after abort does not match XIP");
+        // aborting with nothing in progress is harmless
+        flash_stream_abort(&stream);
+        PICOTEST_CHECK(stream_matches_xip(&stream, 0, CHUNK_SIZE), "Stream after idle abort does not match XIP");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("One shot read matches XIP");
+        for (uint i = 0; i < count_of(read_ranges); i++) {
+            uint32_t flash_offs = read_ranges[i].flash_offs;
+            uint32_t size = read_ranges[i].size;
+            memset(read_buffer, GUARD_BYTE, sizeof(read_buffer));
+            bool ok = flash_stream_read(flash_offs, read_buffer, size) == PICO_OK &&
+                      !memcmp(read_buffer, xip_ptr(flash_offs), size);
+            // the tail must not be written beyond size
+            const uint8_t *bytes = (const uint8_t *)read_buffer;
+            for (uint j = size; j < size + GUARD; j++) {
+                if (bytes[j] != GUARD_BYTE) ok = false;
+            }
+            if (!ok) {
+                printf("  offset %u size %u\n", (uint)flash_offs, (uint)size);
+                PICOTEST_CHECK(false, "Read does not match XIP");
+            }
+        }
+    PICOTEST_END_SECTION();
+
+    flash_stream_deinit(&stream);
+
+    PICOTEST_END_TEST();
+}
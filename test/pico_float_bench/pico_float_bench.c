@@ -0,0 +1,350 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+// Reports the cost per operation and the maximum error in ULPs of the single and double-precision functions
+// wrapped by pico_float/pico_double. Build one binary per implementation (see CMakeLists.txt) to compare them;
+// on host the same harness measures the C library, which gives a reference for the error figures.
+//
+// The error of a float result is measured against the same function computed in double. There is no wider type
+// than double on device, so double results are instead checked against a table of inputs and reference results
+// (pico_float_bench_ref.h) computed in long double on the host, by a build with BENCH_GENERATE_REFERENCE=1
+// (pico_float_bench_reference in the host build). It must be regenerated whenever double_benches changes:
+//
+//   pico_float_bench_reference > pico_float_bench_ref.h
+
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+#include "pico/stdlib.h"
+#if !PICO_NO_HARDWARE
+#include "hardware/clocks.h"
+#endif
+
+#define INPUT_COUNT 256
+#ifndef BENCH_REPEAT
+#if PICO_ON_DEVICE
+#define BENCH_REPEAT 20
+#else
+#define BENCH_REPEAT 2000
+#endif
+#endif
+
+// the number of inputs per function in the double reference table
+#define REFERENCE_COUNT 32
+
+// the double reference functions are only compiled where long double is wider (i.e. to generate the table)
+#if LDBL_MANT_DIG > DBL_MANT_DIG
+#define DOUBLE_REFERENCE 1
+#elif BENCH_GENERATE_REFERENCE
+#error Generating the double reference table requires a long double which is wider than double
+#endif
+
+typedef struct {
+    const char *name;
+    float (*func)(float a, float b);
+    double (*ref)(double a, double b);
+    float a_min, a_max;
+    float b_min, b_max;
+} float_bench_t;
+
+typedef struct {
+    const char *name;
+    double (*func)(double a, double b);
+    long double (*ref)(long double a, long double b);
+    double a_min, a_max;
+    double b_min, b_max;
+} double_bench_t;
+
+typedef struct {
+    double a, b;
+    double ref, ref_lo;     // the reference result, as the unevaluated sum ref + ref_lo
+} double_reference_t;
+
+typedef struct {
+    const char *name;
+    double_reference_t samples[REFERENCE_COUNT];
+} double_reference_table_t;
+
+#define FLOAT_BINARY_OP(name, op) \
+    static float bench_ ## name(float a, float b) { return a op b; } \
+    static double ref_ ## name(double a, double b) { return a op b; }
+#define FLOAT_UNARY_FUNC(func, ref) \
+    static float bench_ ## func(float a, __unused float b) { return func(a); } \
+    static double ref_ ## func(double a, __unused double b) { return ref(a); }
+#define FLOAT_BINARY_FUNC(func, ref) \
+    static float bench_ ## func(float a, float b) { return func(a, b); } \
+    static double ref_ ## func(double a, double b) { return ref(a, b); }
+
+#if DOUBLE_REFERENCE
+#define DOUBLE_BINARY_OP(name, op) \
+    static double bench_ ## name(double a, double b) { return a op b; } \
+    static long double ref_ ## name(long double a, long double b) { return a op b; }
+#define DOUBLE_UNARY_FUNC(func, ref) \
+    static double bench_ ## func(double a, __unused double b) { return func(a); } \
+    static long double ref_ ## func(long double a, __unused long double b) { return ref(a); }
+#define DOUBLE_BINARY_FUNC(func, ref) \
+    static double bench_ ## func(double a, double b) { return func(a, b); } \
+    static long double ref_ ## func(long double a, long double b) { return ref(a, b); }
+#define DOUBLE_REF(func) ref_ ## func
+#else
+#define DOUBLE_BINARY_OP(name, op) \
+    static double bench_ ## name(double a, double b) { return a op b; }
+#define DOUBLE_UNARY_FUNC(func, ref) \
+    static double bench_ ## func(double a, __unused double b) { return func(a); }
+#define DOUBLE_BINARY_FUNC(func, ref) \
+    static double bench_ ## func(double a, double b) { return func(a, b); }
+#define DOUBLE_REF(func) NULL
+#endif
+
+static float bench_fbaseline(float a, __unused float b) { return a; }
+static double bench_dbaseline(double a, __unused double b) { return a; }
+
+// float -> int -> float exercises __aeabi_f2iz and __aeabi_i2f
+static float bench_f2iz(float a, __unused float b) { return (float)(int32_t)a; }
+static double ref_f2iz(double a, __unused double b) { return (double)(int32_t)a; }
+static float bench_f2d(float a, float b) { return (float)((double)a * (double)b); }
+static double ref_f2d(double a, double b) { return (double)(float)(a * b); }
+// likewise for __aeabi_d2iz/__aeabi_i2d and __aeabi_d2f/__aeabi_f2d (the product of two floats is exact in double)
+static double bench_d2iz(double a, __unused double b) { return (double)(int32_t)a; }
+static double bench_d2f(double a, double b) { return (double)(float)a * (double)(float)b; }
+#if DOUBLE_REFERENCE
+static long double ref_d2iz(long double a, __unused long double b) { return (long double)(int32_t)a; }
+static long double ref_d2f(long double a, long double b) { return (long double)(float)a * (long double)(float)b; }
+#endif
+
+FLOAT_BINARY_OP(fadd, +)
+FLOAT_BINARY_OP(fsub, -)
+FLOAT_BINARY_OP(fmul, *)
+FLOAT_BINARY_OP(fdiv, /)
+FLOAT_UNARY_FUNC(sqrtf, sqrt)
+FLOAT_UNARY_FUNC(sinf, sin)
+FLOAT_UNARY_FUNC(cosf, cos)
+FLOAT_UNARY_FUNC(tanf, tan)
+FLOAT_UNARY_FUNC(atanf, atan)
+FLOAT_UNARY_FUNC(expf, exp)
+FLOAT_UNARY_FUNC(logf, log)
+FLOAT_UNARY_FUNC(exp2f, exp2)
+FLOAT_UNARY_FUNC(log2f, log2)
+FLOAT_UNARY_FUNC(log10f, log10)
+FLOAT_UNARY_FUNC(cbrtf, cbrt)
+FLOAT_UNARY_FUNC(tanhf, tanh)
+FLOAT_BINARY_FUNC(atan2f, atan2)
+FLOAT_BINARY_FUNC(powf, pow)
+FLOAT_BINARY_FUNC(hypotf, hypot)
+FLOAT_BINARY_FUNC(fmodf, fmod)
+
+static const float_bench_t float_benches[] = {
+    { "fadd", bench_fadd, ref_fadd, -1e6f, 1e6f, -1e6f, 1e6f },
+    { "fsub", bench_fsub, ref_fsub, -1e6f, 1e6f, -1e6f, 1e6f },
+    { "fmul", bench_fmul, ref_fmul, -1e6f, 1e6f, -1e6f, 1e6f },
+    { "fdiv", bench_fdiv, ref_fdiv, -1e6f, 1e6f, 1e-3f, 1e6f },
+    { "f2iz+i2f", bench_f2iz, ref_f2iz, -1e6f, 1e6f, 0, 0 },
+    { "f2d+d2f", bench_f2d, ref_f2d, -1e3f, 1e3f, -1e3f, 1e3f },
+    { "sqrtf", bench_sqrtf, ref_sqrtf, 0, 1e6f, 0, 0 },
+    { "sinf", bench_sinf, ref_sinf, -10, 10, 0, 0 },
+    { "cosf", bench_cosf, ref_cosf, -10, 10, 0, 0 },
+    { "tanf", bench_tanf, ref_tanf, -1.5f, 1.5f, 0, 0 },
+    { "atanf", bench_atanf, ref_atanf, -100, 100, 0, 0 },
+    { "expf", bench_expf, ref_expf, -80, 80, 0, 0 },
+    { "logf", bench_logf, ref_logf, 1e-6f, 1e6f, 0, 0 },
+    { "exp2f", bench_exp2f, ref_exp2f, -100, 100, 0, 0 },
+    { "log2f", bench_log2f, ref_log2f, 1e-6f, 1e6f, 0, 0 },
+    { "log10f", bench_log10f, ref_log10f, 1e-6f, 1e6f, 0, 0 },
+    { "cbrtf", bench_cbrtf, ref_cbrtf, -1e6f, 1e6f, 0, 0 },
+    { "tanhf", bench_tanhf, ref_tanhf, -5, 5, 0, 0 },
+    { "atan2f", bench_atan2f, ref_atan2f, -100, 100, -100, 100 },
+    { "powf", bench_powf, ref_powf, 0.01f, 10, -10, 10 },
+    { "hypotf", bench_hypotf, ref_hypotf, -1e6f, 1e6f, -1e6f, 1e6f },
+    { "fmodf", bench_fmodf, ref_fmodf, -1e3f, 1e3f, 0.5f, 10 },
+};
+
+DOUBLE_BINARY_OP(dadd, +)
+DOUBLE_BINARY_OP(dsub, -)
+DOUBLE_BINARY_OP(dmul, *)
+DOUBLE_BINARY_OP(ddiv, /)
+DOUBLE_UNARY_FUNC(sqrt, sqrtl)
+DOUBLE_UNARY_FUNC(sin, sinl)
+DOUBLE_UNARY_FUNC(cos, cosl)
+DOUBLE_UNARY_FUNC(tan, tanl)
+DOUBLE_UNARY_FUNC(atan, atanl)
+DOUBLE_UNARY_FUNC(exp, expl)
+DOUBLE_UNARY_FUNC(log, logl)
+DOUBLE_UNARY_FUNC(exp2, exp2l)
+DOUBLE_UNARY_FUNC(log2, log2l)
+DOUBLE_UNARY_FUNC(log10, log10l)
+DOUBLE_UNARY_FUNC(cbrt, cbrtl)
+DOUBLE_UNARY_FUNC(tanh, tanhl)
+DOUBLE_BINARY_FUNC(atan2, atan2l)
+DOUBLE_BINARY_FUNC(pow, powl)
+DOUBLE_BINARY_FUNC(hypot, hypotl)
+DOUBLE_BINARY_FUNC(fmod, fmodl)
+
+static const double_bench_t double_benches[] = {
+    { "dadd", bench_dadd, DOUBLE_REF(dadd), -1e12, 1e12, -1e12, 1e12 },
+    { "dsub", bench_dsub, DOUBLE_REF(dsub), -1e12, 1e12, -1e12, 1e12 },
+    { "dmul", bench_dmul, DOUBLE_REF(dmul), -1e12, 1e12, -1e12, 1e12 },
+    { "ddiv", bench_ddiv, DOUBLE_REF(ddiv), -1e12, 1e12, 1e-3, 1e12 },
+    { "d2iz+i2d", bench_d2iz, DOUBLE_REF(d2iz), -1e6, 1e6, 0, 0 },
+    { "d2f+f2d", bench_d2f, DOUBLE_REF(d2f), -1e3, 1e3, -1e3, 1e3 },
+    { "sqrt", bench_sqrt, DOUBLE_REF(sqrt), 0, 1e12, 0, 0 },
+    { "sin", bench_sin, DOUBLE_REF(sin), -10, 10, 0, 0 },
+    { "cos", bench_cos, DOUBLE_REF(cos), -10, 10, 0, 0 },
+    { "tan", bench_tan, DOUBLE_REF(tan), -1.5, 1.5, 0, 0 },
+    { "atan", bench_atan, DOUBLE_REF(atan), -100, 100, 0, 0 },
+    { "exp", bench_exp, DOUBLE_REF(exp), -700, 700, 0, 0 },
+    { "log", bench_log, DOUBLE_REF(log), 1e-12, 1e12, 0, 0 },
+    { "exp2", bench_exp2, DOUBLE_REF(exp2), -1000, 1000, 0, 0 },
+    { "log2", bench_log2, DOUBLE_REF(log2), 1e-12, 1e12, 0, 0 },
+    { "log10", bench_log10, DOUBLE_REF(log10), 1e-12, 1e12, 0, 0 },
+    { "cbrt", bench_cbrt, DOUBLE_REF(cbrt), -1e12, 1e12, 0, 0 },
+    { "tanh", bench_tanh, DOUBLE_REF(tanh), -10, 10, 0, 0 },
+    { "atan2", bench_atan2, DOUBLE_REF(atan2), -100, 100, -100, 100 },
+    { "pow", bench_pow, DOUBLE_REF(pow), 0.01, 10, -100, 100 },
+    { "hypot", bench_hypot, DOUBLE_REF(hypot), -1e12, 1e12, -1e12, 1e12 },
+    { "fmod", bench_fmod, DOUBLE_REF(fmod), -1e6, 1e6, 0.5, 10 },
+};
+
+static float fa[INPUT_COUNT], fb[INPUT_COUNT], fresult[INPUT_COUNT];
+static double da[INPUT_COUNT], db[INPUT_COUNT], dresult[INPUT_COUNT];
+
+static uint32_t rand_state = 1;
+
+// deterministic across platforms, unlike rand()
+static double rand_unit(void) {
+    rand_state = rand_state * 1664525u + 1013904223u;
+    return (rand_state >> 8) / (double)(1u << 24);
+}
+
+// the reference is ref + ref_lo, where ref_lo carries any precision beyond that of the type of ref
+static double ulp_error(long double value, long double ref, long double ref_lo, int mant_dig, long double min_normal) {
+    if (isnan(ref) || isinf(ref)) return value == ref || (isnan(value) && isnan(ref)) ? 0 : INFINITY;
+    long double scale = fabsl(ref);
+    if (scale < min_normal) scale = min_normal;
+    int e;
+    frexpl(scale, &e);
+    return (double)(fabsl((value - ref) - ref_lo) / ldexpl(1, e - mant_dig));
+}
+
+#if BENCH_GENERATE_REFERENCE
+static void print_reference_table(void) {
+    printf("// Reference results for the double-precision functions in pico_float_bench.c, computed in long double\n");
+    printf("// Generated by pico_float_bench_reference; do not edit\n\n");
+    printf("static const double_reference_table_t double_references[] = {\n");
+    for (uint n = 0; n < count_of(double_benches); n++) {
+        const double_bench_t *b = &double_benches[n];
+        printf("    { \"%s\", {\n", b->name);
+        for (uint i = 0; i < REFERENCE_COUNT; i++) {
+            double a_in = b->a_min + (b->a_max - b->a_min) * rand_unit();
+            double b_in = b->b_min + (b->b_max - b->b_min) * rand_unit();
+            long double ref = b->ref(a_in, b_in);
+            double ref_hi = (double)ref;
+            printf("        { %a, %a, %a, %a },\n", a_in, b_in, ref_hi, (double)(ref - ref_hi));
+        }
+        printf("    } },\n");
+    }
+    printf("};\n");
+}
+#endif
+
+// included when generating a new table too, but only used to check the results
+#include "pico_float_bench_ref.h"
+
+static double double_max_ulp(const double_bench_t *b, const double_reference_table_t *table) {
+    double max_ulp = 0;
+    for (uint i = 0; i < REFERENCE_COUNT; i++) {
+        const double_reference_t *r = &table->samples[i];
+        double err = ulp_error(b->func(r->a, r->b), r->ref, r->ref_lo, DBL_MANT_DIG, DBL_MIN);
+        if (err > max_ulp) max_ulp = err;
+    }
+    return max_ulp;
+}
+
+static uint64_t time_float(float (*func)(float, float)) {
+    float (*volatile f)(float, float) = func;
+    uint64_t t0 = time_us_64();
+    for (uint r = 0; r < BENCH_REPEAT; r++) {
+        for (uint i = 0; i < INPUT_COUNT; i++) {
+            fresult[i] = f(fa[i], fb[i]);
+        }
+    }
+    return time_us_64() - t0;
+}
+
+static uint64_t time_double(double (*func)(double, double)) {
+    double (*volatile f)(double, double) = func;
+    uint64_t t0 = time_us_64();
+    for (uint r = 0; r < BENCH_REPEAT; r++) {
+        for (uint i = 0; i < INPUT_COUNT; i++) {
+            dresult[i] = f(da[i], db[i]);
+        }
+    }
+    return time_us_64() - t0;
+}
+
+static double cost_per_op(uint64_t us, uint64_t baseline_us) {
+    double ops = (double)INPUT_COUNT * BENCH_REPEAT;
+    double net = us > baseline_us ? (double)(us - baseline_us) : 0;
+#if PICO_NO_HARDWARE
+    return net * 1000 / ops;
+#else
+    return net * (clock_get_hz(clk_sys) / 1e6) / ops;
+#endif
+}
+
+#if PICO_NO_HARDWARE
+#define COST_UNIT "ns/op"
+#else
+#define COST_UNIT "cycles/op"
+#endif
+
+static void print_result(const char *name, double cost, double max_ulp, bool has_ref) {
+    if (has_ref) {
+        printf("%-10s %12.1f %12.2f\n", name, cost, max_ulp);
+    } else {
+        printf("%-10s %12.1f %12s\n", name, cost, "-");
+    }
+}
+
+int main(void) {
+    stdio_init_all();
+
+#if BENCH_GENERATE_REFERENCE
+    print_reference_table();
+    return 0;
+#endif
+
+    printf("%-10s %12s %12s\n", "function", COST_UNIT, "max ulp");
+    uint64_t baseline = time_float(bench_fbaseline);
+    for (uint n = 0; n < count_of(float_benches); n++) {
+        const float_bench_t *b = &float_benches[n];
+        for (uint i = 0; i < INPUT_COUNT; i++) {
+            fa[i] = (float)(b->a_min + (b->a_max - b->a_min) * rand_unit());
+            fb[i] = (float)(b->b_min + (b->b_max - b->b_min) * rand_unit());
+        }
+        double cost = cost_per_op(time_float(b->func), baseline);
+        double max_ulp = 0;
+        for (uint i = 0; i < INPUT_COUNT; i++) {
+            double err = ulp_error(fresult[i], b->ref(fa[i], fb[i]), 0, FLT_MANT_DIG, FLT_MIN);
+            if (err > max_ulp) max_ulp = err;
+        }
+        print_result(b->name, cost, max_ulp, true);
+    }
+
+    baseline = time_double(bench_dbaseline);
+    for (uint n = 0; n < count_of(double_benches); n++) {
+        const double_bench_t *b = &double_benches[n];
+        for (uint i = 0; i < INPUT_COUNT; i++) {
+            da[i] = b->a_min + (b->a_max - b->a_min) * rand_unit();
+            db[i] = b->b_min + (b->b_max - b->b_min) * rand_unit();
+        }
+        double cost = cost_per_op(time_double(b->func), baseline);
+        // the table is for a different list of functions if it is out of date
+        bool has_ref = n < count_of(double_references) && !strcmp(double_references[n].name, b->name);
+        print_result(b->name, cost, has_ref ? double_max_ulp(b, &double_references[n]) : 0, has_ref);
+    }
+    return 0;
+}
@@ -0,0 +1,753 @@
+// Reference results for the double-precision functions in pico_float_bench.c, computed in long double
+// Generated by pico_float_bench_reference; do not edit
+
+static const double_reference_table_t double_references[] = {
+    { "dadd", {
+        { -0x1.eae3cf7510eb8p+38, -0x1.e7013fdf5bebp+37, -0x1.6f3237b25f708p+39, 0x0p+0 },
+        { 0x1.f9afa8280a2p+32, 0x1.7d9fee6c9cadp+38, 0x1.8586ad0d3cd58p+38, 0x0p+0 },
+        { -0x1.a296c137dae0cp+39, -0x1.e615021ce0efp+37, -0x1.0e0e00df898e4p+40, 0x0p+0 },
+        { 0x1.ffc92c8b2ef68p+38, 0x1.a2a31a9f2c1ep+36, 0x1.3438f9997cffp+39, 0x0p+0 },
+        { -0x1.c24d010260ce8p+39, 0x1.035da923d3dp+38, -0x1.409e2c7076e68p+39, 0x0p+0 },
+        { -0x1.d0d231ad82b8p+38, -0x1.212a54ec551dp+37, -0x1.30b3ae11d6a34p+39, 0x0p+0 },
+        { 0x1.51d8e9068749p+37, 0x1.39cb3bb45df2p+39, 0x1.8e4175f5ffc44p+39, 0x0p+0 },
+        { -0x1.ed75a8c5b0b08p+38, 0x1.bfd29a5c008ep+39, 0x1.922f8bf2506b8p+38, 0x0p+0 },
+        { 0x1.501a2d8612a6p+39, -0x1.42783822e892p+38, 0x1.5dbc22e93cbap+38, 0x0p+0 },
+        { 0x1.541fc1169a8e8p+38, 0x1.d4c6ea9977dp+35, 0x1.8eb89e69c9888p+38, 0x0p+0 },
+        { -0x1.088cb683d00dcp+39, -0x1.704e645be5bbcp+39, -0x1.3c6d8d6fdae4cp+40, 0x0p+0 },
+        { -0x1.8ff6084ed0588p+39, -0x1.515c6c54c65bp+38, -0x1.1c521f3c99c3p+40, 0x0p+0 },
+        { -0x1.58c2f8c074704p+39, 0x1.8206c450d7f48p+38, -0x1.2f7f2d3010ecp+38, 0x0p+0 },
+        { 0x1.34c7410b1af6p+37, -0x1.c198ab0ee802p+37, -0x1.19a2d4079a18p+36, 0x0p+0 },
+        { -0x1.b98b369396608p+38, 0x1.d358ac9c1335p+38, 0x1.9cd76087cd48p+34, 0x0p+0 },
+        { 0x1.911f189de9e28p+39, -0x1.2c8fdce2de66cp+39, 0x1.923ceeec2defp+37, 0x0p+0 },
+        { -0x1.34eaf3a569aap+38, 0x1.c20dc05d9939cp+39, 0x1.2798468ae464cp+39, 0x0p+0 },
+        { -0x1.9f0db5430ba3p+37, 0x1.65fa9e6b7042p+36, -0x1.d820cc1aa704p+36, 0x0p+0 },
+        { -0x1.f8cda5bdd018p+35, 0x1.cc63aba3c4254p+39, 0x1.acd6d147e723cp+39, 0x0p+0 },
+        { 0x1.5d4a26aeddc0cp+39, 0x1.89c74181192cp+38, 0x1.1116e3b7b52b6p+40, 0x0p+0 },
+        { 0x1.aa4b5d0e6ff74p+39, 0x1.ba5ef8194591cp+39, 0x1.b2552a93dac48p+40, 0x0p+0 },
+        { -0x1.41587a576aecp+39, -0x1.dbcfd460b432p+37, -0x1.b84c6f6f97f88p+39, 0x0p+0 },
+        { 0x1.5ac21f3624248p+38, -0x1.39593490073cp+39, -0x1.17f049e9ea538p+38, 0x0p+0 },
+        { -0x1.d0e3ede0157p+33, -0x1.2fb5acd623c6cp+39, -0x1.36f93c8da41c8p+39, 0x0p+0 },
+        { 0x1.57275ab214c3p+37, 0x1.5a4b81009c61cp+39, 0x1.b01557ad21928p+39, 0x0p+0 },
+        { -0x1.3b75ac2c2fap+38, -0x1.bfca42dda69f4p+39, -0x1.2ec28c79df37ap+40, 0x0p+0 },
+        { 0x1.a4167d8f565b8p+39, -0x1.f557e285bcb18p+38, 0x1.52d51898f0058p+38, 0x0p+0 },
+        { 0x1.34c3ac45d107p+39, -0x1.b98a1e73bfc94p+39, -0x1.098ce45bdd848p+38, 0x0p+0 },
+        { -0x1.b0a8328c9e02p+37, -0x1.a620001b2e3ap+39, -0x1.0925065f2add4p+40, 0x0p+0 },
+        { -0x1.1fbc0861a631p+38, -0x1.57871f08e953cp+39, -0x1.e7652339bc6c4p+39, 0x0p+0 },
+        { 0x1.205ea5c5ded9cp+39, -0x1.572fb5d3c146p+37, 0x1.952570a1dd108p+38, 0x0p+0 },
+        { -0x1.4877675952554p+39, 0x1.9d6f605a0f5ap+37, -0x1.c2371e859cfd8p+38, 0x0p+0 },
+    } },
+    { "dsub", {
+        { 0x1.121159466c8b8p+39, 0x1.9392dff7f8468p+39, -0x1.03030d631776p+38, 0x0p+0 },
+        { -0x1.c74472f92106p+39, -0x1.b50e233f86cdcp+39, -0x1.2364fb99a384p+35, 0x0p+0 },
+        { 0x1.cf56caeb69dd8p+39, 0x1.1af16c3d9f0a4p+39, 0x1.68cabd5b95a68p+38, 0x0p+0 },
+        { -0x1.4cc02eea4edp+36, -0x1.948faf9c927ep+37, 0x1.dc5f304ed62cp+36, 0x0p+0 },
+        { 0x1.3fd46fb131f98p+38, 0x1.b14c3476736b4p+39, -0x1.1161fc9dda6e8p+39, 0x0p+0 },
+        { 0x1.b3308db1c2fp+38, -0x1.5c1f1cb1edb8p+34, 0x1.c8f27f7ce1cb8p+38, 0x0p+0 },
+        { -0x1.3a2f81487416p+37, -0x1.49aa28c26ad1cp+39, 0x1.f63c90e09b988p+38, 0x0p+0 },
+        { 0x1.767a744f004c8p+39, 0x1.cc05119d6311p+38, 0x1.20efd7009d88p+38, 0x0p+0 },
+        { 0x1.fba92a56a9edp+37, 0x1.23300fc45ef1p+37, 0x1.b0f2352495f8p+36, 0x0p+0 },
+        { 0x1.2280047c5108p+36, -0x1.a100d25a82d78p+39, 0x1.c550d2ea0cf88p+39, 0x0p+0 },
+        { -0x1.24a954d414eep+37, 0x1.d7f5eff5c472p+36, -0x1.085226677b938p+38, 0x0p+0 },
+        { 0x1.9fb6d4d901864p+39, -0x1.30c9aa05dc82p+38, 0x1.1c0dd4edf7e3ap+40, 0x0p+0 },
+        { 0x1.02203454d5434p+39, -0x1.a48d43c96a7dp+38, 0x1.d466d6398a81cp+39, 0x0p+0 },
+        { 0x1.7ed443a683714p+39, 0x1.9af5a10c85bdp+39, -0x1.c215d66024bcp+35, 0x0p+0 },
+        { -0x1.fa39e66a0bap+36, -0x1.fcc035b0bd2ap+36, 0x1.4327a358c5p+29, 0x0p+0 },
+        { -0x1.1105d7f647898p+38, -0x1.be2209ec27484p+39, 0x1.359f1df103838p+39, 0x0p+0 },
+        { 0x1.2e6f7e4f15a88p+38, 0x1.cfbcaf3a4606p+38, -0x1.429a61d660bbp+37, 0x0p+0 },
+        { -0x1.b0c4bb9c58d8p+36, -0x1.2795f58d5p+29, -0x1.ae758fb13e38p+36, 0x0p+0 },
+        { 0x1.3d39478048e4cp+39, -0x1.9545c8ac0b198p+38, 0x1.03ee15eb2738cp+40, 0x0p+0 },
+        { -0x1.d02b8ebd002c8p+39, -0x1.153631d7c28a8p+38, -0x1.459075d11ee74p+39, 0x0p+0 },
+        { 0x1.2bdd466812d5p+38, -0x1.865e8d9677f74p+39, 0x1.0e26986540b0ep+40, 0x0p+0 },
+        { -0x1.7e59aacea9888p+38, -0x1.097528ef2a6bp+39, 0x1.29214e1f569bp+37, 0x0p+0 },
+        { -0x1.dba769f74d3bp+38, 0x1.fc16f55ce0108p+38, -0x1.ebdf2faa16a5cp+39, 0x0p+0 },
+        { 0x1.64eb79c8b7p+31, 0x1.ad4ba51ac9efp+37, -0x1.a7b7f733a713p+37, 0x0p+0 },
+        { 0x1.226ceb0ac6b8p+37, 0x1.c1edf9d8525acp+39, -0x1.7952bf15a0accp+39, 0x0p+0 },
+        { -0x1.36751aa057ap+35, -0x1.78baca2d56578p+38, 0x1.51ec26d94b638p+38, 0x0p+0 },
+        { 0x1.c5993323ec55cp+39, 0x1.98924e7a01f28p+38, 0x1.f2a017cdd6b9p+38, 0x0p+0 },
+        { 0x1.db44f60c8137p+37, -0x1.700c5aabe4a6p+36, 0x1.49a591b139c5p+38, 0x0p+0 },
+        { 0x1.7988fd3fe51bp+37, -0x1.637ce47b947fp+39, 0x1.c1df23cb8dc5cp+39, 0x0p+0 },
+        { 0x1.991dbaafc9834p+39, 0x1.2e2c7d3d2531cp+39, 0x1.abc4f5ca9146p+37, 0x0p+0 },
+        { -0x1.c89a2d7314adcp+39, -0x1.1d51d163af894p+39, -0x1.5690b81eca49p+38, 0x0p+0 },
+        { 0x1.d07220f0e7fep+36, -0x1.c12aad1a2dc3p+39, 0x1.fb38f1384ac2cp+39, 0x0p+0 },
+    } },
+    { "dmul", {
+        { 0x1.ce89467856e6p+36, -0x1.71c84d211fc8p+35, -0x1.4e0ee296d34adp+72, -0x1.84p+18 },
+        { -0x1.5753dcd86282p+36, -0x1.ad2bfbb017b2p+36, 0x1.1fc942dc0c31dp+73, 0x1.16p+18 },
+        { -0x1.bf7ff7833b144p+39, 0x1.4fd61b9af0c08p+38, -0x1.25875d0f7c789p+78, 0x1.2cp+24 },
+        { 0x1.a5d09714a235p+39, 0x1.b83df7f93672p+38, 0x1.6ab24f7b2d09cp+78, -0x1.e18p+24 },
+        { 0x1.753cc8ee2b1p+33, 0x1.1f0e9e20456a4p+39, 0x1.a2847520901dbp+72, 0x1.dcp+16 },
+        { -0x1.183282e51cf08p+38, 0x1.ff7db6e04fefp+37, -0x1.17eb360d55b0ep+76, -0x1.31p+22 },
+        { 0x1.b29d995b0472cp+39, -0x1.7890b9c284338p+38, -0x1.3fa696a108b66p+78, 0x1.9fp+23 },
+        { 0x1.05080eb1adc14p+39, 0x1.3ab76ae98e9dp+37, 0x1.40e6e7cbebf7cp+76, -0x1.4dp+21 },
+        { 0x1.29a02dff48d3p+37, -0x1.4fb9d063b1c2cp+39, -0x1.8650a3385ac32p+76, 0x1.9cp+21 },
+        { -0x1.b9a272abff354p+39, 0x1.d88be3e9932p+36, -0x1.979a6be7b0231p+76, 0x1.0cp+20 },
+        { 0x1.38eceb2a027bp+39, -0x1.857c9272e317cp+39, -0x1.dc18471c4b53ep+78, -0x1.4dp+24 },
+        { -0x1.aba73b23bdcbp+39, 0x1.abfb6340073b8p+39, -0x1.6579f1341dafap+79, -0x1.2ep+23 },
+        { -0x1.fe10c794989bp+38, -0x1.493973f313f7p+38, 0x1.47fb04a021c8ep+77, 0x1.2p+20 },
+        { -0x1.815a7975f2ed8p+38, -0x1.dc007cd1330ap+36, 0x1.66427add051cp+75, -0x1.d4p+20 },
+        { 0x1.d2340412f9308p+38, -0x1.3bbd35c206d28p+38, -0x1.1f7f49a83ba82p+77, 0x1.77p+22 },
+        { -0x1.e36164f5d138p+38, -0x1.72616c59dd99cp+39, 0x1.5dad5c34a7b43p+78, 0x1.f6p+23 },
+        { 0x1.6b947e7b379bp+38, 0x1.41985eb1b69p+38, 0x1.c8bd994085472p+76, 0x1.86p+22 },
+        { 0x1.5c3f2bf9a82cp+35, -0x1.86b77fb2769p+34, -0x1.09c0edee70d85p+70, -0x1.e9p+16 },
+        { -0x1.a771fdcb4b94p+37, -0x1.c55f80f2452ecp+39, 0x1.76f55757d3224p+77, 0x1.ab8p+23 },
+        { 0x1.77568d53096c8p+38, -0x1.842db51dbd24cp+39, -0x1.1c9118fa3ef5dp+78, 0x1.76p+23 },
+        { 0x1.552e837f9e2dcp+39, 0x1.166811b2db1f8p+38, 0x1.730b354876b9ap+77, -0x1.ecp+20 },
+        { 0x1.a3a48c3eef1fp+37, -0x1.1aa17c9c2398p+35, -0x1.cf4bf93d2d892p+72, -0x1.c6p+17 },
+        { 0x1.7af6c6d2f72ep+38, -0x1.e2b8332f3e6f8p+38, -0x1.654aa7be9b2edp+77, 0x1.5p+18 },
+        { 0x1.51f3a7b39d278p+38, -0x1.1553c81d5c3bp+38, -0x1.6e1b3ea1d5a77p+76, -0x1.b68p+22 },
+        { -0x1.b42ad5c6f213p+37, 0x1.afa95e50358fp+37, -0x1.6fba5770ba831p+75, -0x1.19p+21 },
+        { 0x1.de0b4e0eb82f8p+38, 0x1.1534e6c967d7cp+39, 0x1.02d2825c0499ep+78, 0x1.4p+20 },
+        { 0x1.c34232b214ap+39, 0x1.16ae16052e5b4p+39, 0x1.eb3cc0dca9ccdp+78, -0x1.8cp+22 },
+        { -0x1.6b83e5527337p+38, 0x1.4114b4d20f2fcp+39, -0x1.c7edc99d51e99p+77, -0x1.8fp+23 },
+        { -0x1.7501c467840dcp+39, 0x1.157543315898p+38, -0x1.9445c53a2206p+77, 0x1.08p+21 },
+        { -0x1.adb8e5e2be11p+39, -0x1.8e5f42cd70248p+39, 0x1.4e5aae932b9adp+79, 0x1.6ap+25 },
+        { -0x1.2129ad937e798p+39, 0x1.c7d74dd89d758p+38, -0x1.017222b811722p+78, -0x1.07p+23 },
+        { -0x1.66b141b92adfp+38, 0x1.3617d2eef667p+38, -0x1.b27c070f5b809p+76, 0x1.8bp+22 },
+    } },
+    { "ddiv", {
+        { 0x1.3e28c9fef5124p+39, 0x1.84fd0edd6cd11p+38, 0x1.a2c5afb4f183ep+0, -0x1.24p-54 },
+        { 0x1.32f436deb0c9cp+39, 0x1.763eecd0bc71ep+38, 0x1.a3f06605eb38bp+0, 0x1.07p-54 },
+        { 0x1.c448a4e36379p+37, 0x1.d177618b1e39bp+35, 0x1.f17fe224ccc98p+1, -0x1.dbp-54 },
+        { 0x1.5957602a19ffp+37, 0x1.28b4149e07a23p+38, 0x1.29f7281df7aa9p-1, 0x1.73p-56 },
+        { -0x1.455f9e156e88p+35, 0x1.c781541309e8ap+36, -0x1.6dba7fc348fecp-2, 0x1.c6p-58 },
+        { -0x1.d03555aaee988p+39, 0x1.a310a42993d8bp+36, -0x1.1b93cbd002cdp+3, -0x1.ep-56 },
+        { 0x1.7907d74c563bp+39, 0x1.687feb663aaeep+38, 0x1.0bbd31f3e294bp+1, -0x1.b5p-53 },
+        { 0x1.789095614a69p+37, 0x1.d3ad4cc601c24p+38, 0x1.9c40bc3be9d36p-2, -0x1.b88p-56 },
+        { -0x1.6959636396acp+38, 0x1.ce331d6791cecp+38, -0x1.904881dc10f96p-1, -0x1.de8p-55 },
+        { 0x1.a583b940d3d8cp+39, 0x1.4d11124a6712cp+36, 0x1.43fb7a8bcc587p+3, -0x1.058p-51 },
+        { -0x1.9f59cb001c258p+38, 0x1.6df0a3dfd4f36p+39, -0x1.2290f20d372dcp-1, -0x1.34p-57 },
+        { -0x1.f6d63dfaeep+33, 0x1.bd954b615fdccp+38, -0x1.20e4d38c4c36ep-5, 0x1.62p-59 },
+        { 0x1.ccad033f92e38p+38, 0x1.95904351a82bdp+39, 0x1.22c9bb4ba4a42p-1, 0x1.198p-55 },
+        { -0x1.9aba3a4c2918p+36, 0x1.37c4f129163e5p+39, -0x1.5141aaa6bc78cp-3, 0x1.308p-57 },
+        { -0x1.1f82dccaee774p+39, 0x1.1977d1afd4719p+39, -0x1.057f0ffaaef19p+0, 0x1.cfp-54 },
+        { -0x1.5326205a420fp+39, 0x1.ce349992c7526p+39, -0x1.77afb002f895p-1, 0x1.acp-58 },
+        { -0x1.05e88bd863d28p+38, 0x1.1967fecc249dbp+38, -0x1.dc86639b35dc1p-1, 0x1.fp-56 },
+        { -0x1.c84e887d041fp+38, 0x1.67b7054afdefcp+36, -0x1.44bdf1bbcf975p+2, -0x1.f6p-53 },
+        { -0x1.f10a4267c0bd8p+38, 0x1.5d5f740367d42p+38, -0x1.6c33af713e46cp+0, 0x1.cep-56 },
+        { 0x1.8bc721803c69p+39, 0x1.61e92068edc6p+39, 0x1.1e48d4773c13cp+0, 0x1.ebp-55 },
+        { -0x1.3fa245a081bfp+39, 0x1.61e312a183138p+39, -0x1.ce71641e19de7p-1, -0x1.f4p-57 },
+        { 0x1.fe80d167c63ep+37, 0x1.f5a51b4c9b887p+38, 0x1.048542cd42f7cp-1, -0x1.f4p-56 },
+        { -0x1.19b6ec21b8f18p+38, 0x1.6eb0b4fa16cc4p+39, -0x1.8959c2c826382p-2, 0x1.24p-57 },
+        { -0x1.9f80edfe7afep+37, 0x1.dfe98e98a5458p+38, -0x1.bb48eaffa1aa9p-2, -0x1.bf8p-56 },
+        { -0x1.d8a8e8aa45a68p+38, 0x1.62590b4fdd7d6p+38, -0x1.557996a38a622p+0, 0x1.2cp-55 },
+        { 0x1.6bcc9938bde6p+37, 0x1.373538763a7ffp+39, 0x1.2b42fdd15a5b3p-2, -0x1.22p-57 },
+        { -0x1.a903313638c6p+37, 0x1.4ff4d1470630ep+39, -0x1.43dc72e3a4531p-2, 0x1.4b8p-56 },
+        { 0x1.d56b5d4a4d2dp+37, 0x1.224c30c6e30c7p+39, 0x1.9df58cd114de5p-2, 0x1.1ep-58 },
+        { 0x1.fdfc50e416b3p+38, 0x1.6b5edcbfd213ap+39, 0x1.674ae16073953p-1, 0x1.52p-57 },
+        { 0x1.c2ffbf81b8bfp+39, 0x1.76f1d354a0c0ap+39, 0x1.33ed6e0f7c05bp+0, -0x1.62p-54 },
+        { 0x1.a0e2c407440acp+39, 0x1.3fc8af156d0f7p+38, 0x1.4dbbe71b8d323p+1, -0x1.0b8p-53 },
+        { 0x1.7ff1a92dc78ap+36, 0x1.d852d910c29e1p+37, 0x1.a0323d7cc2f52p-2, -0x1.618p-56 },
+    } },
+    { "d2iz+i2d", {
+        { -0x1.33f3c16e2p+19, 0x0p+0, -0x1.33f3cp+19, 0x0p+0 },
+        { -0x1.c047907c8p+17, 0x0p+0, -0x1.c0478p+17, 0x0p+0 },
+        { 0x1.c6045791p+16, 0x0p+0, 0x1.c604p+16, 0x0p+0 },
+        { 0x1.b755d279ap+19, 0x0p+0, 0x1.b755cp+19, 0x0p+0 },
+        { 0x1.207fcd6b3p+19, 0x0p+0, 0x1.207fcp+19, 0x0p+0 },
+        { 0x1.4ee4a75b5p+19, 0x0p+0, 0x1.4ee4ap+19, 0x0p+0 },
+        { -0x1.5e4afabd2p+19, 0x0p+0, -0x1.5e4aep+19, 0x0p+0 },
+        { -0x1.2ce27c848p+18, 0x0p+0, -0x1.2ce24p+18, 0x0p+0 },
+        { 0x1.5d554a02ap+18, 0x0p+0, 0x1.5d554p+18, 0x0p+0 },
+        { -0x1.d8d1a7d18p+17, 0x0p+0, -0x1.d8d18p+17, 0x0p+0 },
+        { 0x1.308a5e64ep+19, 0x0p+0, 0x1.308a4p+19, 0x0p+0 },
+        { 0x1.6be9e9286p+18, 0x0p+0, 0x1.6be9cp+18, 0x0p+0 },
+        { 0x1.60b12cee4p+19, 0x0p+0, 0x1.60b12p+19, 0x0p+0 },
+        { -0x1.47d2c60aap+18, 0x0p+0, -0x1.47d2cp+18, 0x0p+0 },
+        { 0x1.d37542334p+19, 0x0p+0, 0x1.d3754p+19, 0x0p+0 },
+        { 0x1.459dad46fp+19, 0x0p+0, 0x1.459dap+19, 0x0p+0 },
+        { 0x1.43eec3dc9p+19, 0x0p+0, 0x1.43eecp+19, 0x0p+0 },
+        { 0x1.1762b674p+14, 0x0p+0, 0x1.176p+14, 0x0p+0 },
+        { 0x1.fdb1b0aeep+18, 0x0p+0, 0x1.fdb18p+18, 0x0p+0 },
+        { 0x1.6b70776p+19, 0x0p+0, 0x1.6b706p+19, 0x0p+0 },
+        { -0x1.06f7cf75cp+18, 0x0p+0, -0x1.06f7cp+18, 0x0p+0 },
+        { -0x1.597d7840bp+19, 0x0p+0, -0x1.597d6p+19, 0x0p+0 },
+        { 0x1.a72f6f75cp+18, 0x0p+0, 0x1.a72f4p+18, 0x0p+0 },
+        { -0x1.089fb056ap+19, 0x0p+0, -0x1.089fap+19, 0x0p+0 },
+        { 0x1.33054ea5p+18, 0x0p+0, 0x1.33054p+18, 0x0p+0 },
+        { 0x1.6cc4d6b0ap+18, 0x0p+0, 0x1.6cc4cp+18, 0x0p+0 },
+        { 0x1.7691d9f8bp+19, 0x0p+0, 0x1.7691cp+19, 0x0p+0 },
+        { 0x1.956730b44p+17, 0x0p+0, 0x1.9567p+17, 0x0p+0 },
+        { 0x1.0775159ebp+19, 0x0p+0, 0x1.0775p+19, 0x0p+0 },
+        { -0x1.038e740dap+18, 0x0p+0, -0x1.038e4p+18, 0x0p+0 },
+        { -0x1.66b097564p+19, 0x0p+0, -0x1.66b08p+19, 0x0p+0 },
+        { 0x1.a12c80c9p+18, 0x0p+0, 0x1.a12c8p+18, 0x0p+0 },
+    } },
+    { "d2f+f2d", {
+        { -0x1.ac36dd2p+7, -0x1.b037184p+6, 0x1.697c5f476b68p+14, 0x0p+0 },
+        { 0x1.d7c5be2p+7, -0x1.b65132bp+9, -0x1.93e0fa64de8ep+17, 0x0p+0 },
+        { 0x1.4e7fc278p+9, 0x1.5bc43a9p+9, 0x1.c667918f79f4p+18, 0x0p+0 },
+        { 0x1.5da5d788p+9, -0x1.21ef4c1p+8, -0x1.8bff0e79e42p+17, 0x0p+0 },
+        { 0x1.a00bb0cp+9, -0x1.0e00e15p+9, -0x1.b6cdc2ea516p+18, 0x0p+0 },
+        { -0x1.bdfee57p+8, -0x1.d7b5436p+8, 0x1.9ae5e26d298cp+17, 0x0p+0 },
+        { 0x1.51327e98p+9, -0x1.ed2e3dfp+9, -0x1.44cd92b16f42p+19, 0x0p+0 },
+        { -0x1.fb5dc5dp+8, 0x1.6b351ff8p+9, -0x1.67eba0cbdb6p+18, 0x0p+0 },
+        { 0x1.38b86d5p+9, 0x1.1f769b5p+9, 0x1.5f27a6e51708p+18, 0x0p+0 },
+        { 0x1.c9cd53ap+7, 0x1.0b8b93cp+6, 0x1.de72c1c3509p+13, 0x0p+0 },
+        { 0x1.01e6cfd8p+9, 0x1.2d4ec4p+3, 0x1.2f8bbc58174p+12, 0x0p+0 },
+        { -0x1.da6d6e2p+8, 0x1.c6492e2p+7, -0x1.a4f2d7c403e2p+16, 0x0p+0 },
+        { -0x1.43a9d96p+8, 0x1.16b6efd8p+9, -0x1.6061bcec386p+17, 0x0p+0 },
+        { -0x1.49387cbp+9, 0x1.44ab6ec8p+9, -0x1.a187f3211948p+18, 0x0p+0 },
+        { 0x1.585f7c2p+7, -0x1.572aa5ap+9, -0x1.cda14e1c4268p+16, 0x0p+0 },
+        { -0x1.eb336fcp+7, 0x1.d6281b8p+8, -0x1.c30eb2b1902p+16, 0x0p+0 },
+        { 0x1.37425f8p+6, -0x1.7bfce6b8p+9, -0x1.ce02c11c224p+15, 0x0p+0 },
+        { -0x1.73382a6p+7, 0x1.18f85c28p+9, -0x1.976d91c0df18p+16, 0x0p+0 },
+        { 0x1.8e93a5p+7, 0x1.f06e653p+9, 0x1.8274f7ffa5acp+17, 0x0p+0 },
+        { 0x1.ed4c9778p+9, 0x1.b0d4ee8p+7, 0x1.a105c7458aa8p+17, 0x0p+0 },
+        { 0x1.2c2bb06p+7, -0x1.47024b6p+9, -0x1.7f6e7f44584p+16, 0x0p+0 },
+        { -0x1.4b7d63ap+9, 0x1.f63baf9p+8, -0x1.452a95f2206p+18, 0x0p+0 },
+        { 0x1.75552e6p+7, -0x1.fd735f6p+8, -0x1.73794edccdap+16, 0x0p+0 },
+        { -0x1.b86f53d8p+9, 0x1.9dcb464p+9, -0x1.63f4a99d067cp+19, 0x0p+0 },
+        { -0x1.21f0367p+8, 0x1.f09cfeep+9, -0x1.19399b569ecap+18, 0x0p+0 },
+        { 0x1.ca889908p+9, -0x1.04d3aaep+8, -0x1.d32ddb7da444p+17, 0x0p+0 },
+        { -0x1.408dc48p+7, -0x1.323ebe2p+8, 0x1.7f780486af78p+15, 0x0p+0 },
+        { 0x1.b7164p+0, -0x1.ff4b6b2p+8, -0x1.b67b6341118p+9, 0x0p+0 },
+        { -0x1.10db9p+5, 0x1.433daa1p+8, -0x1.5886c0331dap+13, 0x0p+0 },
+        { -0x1.d809e37p+9, 0x1.8e4873p+8, -0x1.6f327c924da8p+18, 0x0p+0 },
+        { 0x1.575e503p+9, -0x1.b5cd742p+9, -0x1.259bc856662p+19, 0x0p+0 },
+        { -0x1.2b8c15p+6, -0x1.bc2e0d7p+8, 0x1.03de6b1ea08cp+15, 0x0p+0 },
+    } },
+    { "sqrt", {
+        { 0x1.e2a7be67b3d6p+38, 0x0p+0, 0x1.5f82ba95656bdp+19, -0x1.dcp-35 },
+        { 0x1.ffcb6b582676p+37, 0x0p+0, 0x1.ffe5b4ff3eb2dp+18, 0x1.62p-37 },
+        { 0x1.487fc61e516c8p+39, 0x0p+0, 0x1.9a1c93aed41b9p+19, 0x1.62p-35 },
+        { 0x1.55fbf96566d44p+38, 0x0p+0, 0x1.27e293e5f01e9p+19, -0x1.53p-36 },
+        { 0x1.fe66de74c0cd8p+38, 0x0p+0, 0x1.69792326791fcp+19, -0x1.fcp-35 },
+        { 0x1.bdae9a9ee13d8p+39, 0x0p+0, 0x1.ddb108ce3e84dp+19, 0x1.488p-35 },
+        { 0x1.77ef8bcde008p+38, 0x0p+0, 0x1.3639991f844c2p+19, 0x1.c5p-36 },
+        { 0x1.6ce8f18a23244p+39, 0x0p+0, 0x1.b03e2bd898414p+19, 0x1.09p-35 },
+        { 0x1.0ba53cf479f8p+36, 0x0p+0, 0x1.05c20aba77209p+18, -0x1.7a8p-36 },
+        { 0x1.9741e0f7604cp+37, 0x0p+0, 0x1.c8a2a02ccf9fcp+18, 0x1.4bp-36 },
+        { 0x1.3dd63ecbc85c2p+39, 0x0p+0, 0x1.9366b1fddabc5p+19, 0x1.91p-36 },
+        { 0x1.94bd54ccae91p+36, 0x0p+0, 0x1.41e3e73db785ap+18, -0x1.d4p-39 },
+        { 0x1.726a9e1f92478p+37, 0x0p+0, 0x1.b37df0323a4dap+18, 0x1.a8p-37 },
+        { 0x1.8d45c5b7e14c8p+38, 0x0p+0, 0x1.3ee83b3085807p+19, 0x1.068p-35 },
+        { 0x1.57455a78093ecp+39, 0x0p+0, 0x1.a33b28b628573p+19, 0x1.69p-35 },
+        { 0x1.c72fc21375dap+35, 0x0p+0, 0x1.e2c21be04ecacp+17, 0x1.34p-39 },
+        { 0x1.25d4126b3ecd8p+37, 0x0p+0, 0x1.83ddbb76d5628p+18, -0x1.27p-36 },
+        { 0x1.2bc0aecb0daep+38, 0x0p+0, 0x1.15038cd1ffacbp+19, -0x1.b68p-35 },
+        { 0x1.24f00d3adfd42p+39, 0x0p+0, 0x1.83471ea940dc5p+19, 0x1.638p-35 },
+        { 0x1.cc56cba1837acp+39, 0x0p+0, 0x1.e57b9b99a2c55p+19, 0x1.d7p-36 },
+        { 0x1.bac0a3ed53bcp+36, 0x0p+0, 0x1.50aabdbbba95ep+18, 0x1.dcp-37 },
+        { 0x1.c96363976a2d8p+39, 0x0p+0, 0x1.e3eca24e39913p+19, -0x1.8fp-35 },
+        { 0x1.bb52d773f988p+33, 0x0p+0, 0x1.dc6d0ae1425c4p+16, 0x1.14p-38 },
+        { 0x1.cb636f3e6c5d8p+39, 0x0p+0, 0x1.e4fb36fffc8bdp+19, 0x1.e7p-35 },
+        { 0x1.3269e66c12648p+38, 0x0p+0, 0x1.181326da2f97cp+19, -0x1.0ep-36 },
+        { 0x1.16409eab63898p+39, 0x0p+0, 0x1.797217eed69e9p+19, 0x1.2p-35 },
+        { 0x1.5cb0518ffefa8p+37, 0x0p+0, 0x1.a686c83d3221p+18, 0x1.e5p-37 },
+        { 0x1.82770dce2ab9ep+39, 0x0p+0, 0x1.bcd3702341373p+19, -0x1.edp-36 },
+        { 0x1.04367281b401cp+39, 0x0p+0, 0x1.6d015da28e8d5p+19, -0x1.ee8p-35 },
+        { 0x1.ad72ec7a6292p+35, 0x0p+0, 0x1.d4e94dc4687ap+17, 0x1.32p-39 },
+        { 0x1.8ed95167080bcp+38, 0x0p+0, 0x1.3f8a0ad200794p+19, -0x1.dp-37 },
+        { 0x1.4e0cf0020dc3ep+39, 0x0p+0, 0x1.9d8ffabe4d467p+19, -0x1.bdp-35 },
+    } },
+    { "sin", {
+        { 0x1.cfc406p+2, 0x0p+0, 0x1.a459a33b0f60ap-1, 0x1.88p-58 },
+        { -0x1.78df38p+1, 0x0p+0, -0x1.916a365b78f24p-3, -0x1.cp-58 },
+        { 0x1.c2260cp+1, 0x0p+0, -0x1.773f549b80ddap-2, -0x1.37p-56 },
+        { 0x1.a381acp+2, 0x0p+0, 0x1.12b742b734f18p-2, -0x1.2p-59 },
+        { 0x1.7e7f7ep+1, 0x0p+0, 0x1.38c8d9d45c46ep-3, 0x1.2fp-58 },
+        { 0x1.6ec1e7p+2, 0x0p+0, -0x1.0cc00207c8795p-1, 0x1.fp-56 },
+        { 0x1.295a8p-5, 0x0p+0, 0x1.2949c9073de19p-5, 0x1.32p-59 },
+        { 0x1.e4c07cp+1, 0x0p+0, -0x1.3407f0a73e5f4p-1, -0x1.ab8p-55 },
+        { -0x1.12e2a78p+3, 0x0p+0, -0x1.7b68ead2b0824p-1, -0x1.acp-58 },
+        { -0x1.3f49f8p+3, 0x0p+0, 0x1.0cecbcb89f362p-1, 0x1.808p-55 },
+        { -0x1.efbd38p+0, 0x0p+0, -0x1.de2568668e78p-1, 0x1.0d8p-55 },
+        { -0x1.624dfep+1, 0x0p+0, -0x1.75b78228417fap-2, -0x1p-65 },
+        { 0x1.119bfcp+2, 0x0p+0, -0x1.cfd50dd1d4e1ep-1, 0x1.cf8p-55 },
+        { 0x1.93a2f5p+2, 0x0p+0, 0x1.833680d3da1a4p-6, -0x1.9dp-60 },
+        { -0x1.e3a7ap+0, 0x0p+0, -0x1.e640b4602e95bp-1, 0x1p-55 },
+        { -0x1.6b37acp+0, 0x0p+0, -0x1.fa19343a785aap-1, 0x1.e7p-56 },
+        { 0x1.265d8p+1, 0x0p+0, 0x1.7de4ca158c868p-1, -0x1.3dp-56 },
+        { 0x1.dffebbp+2, 0x0p+0, 0x1.e03e031722fccp-1, -0x1.7b8p-55 },
+        { 0x1.32a801p+3, 0x0p+0, -0x1.42b486df6dd06p-3, -0x1.1cp-59 },
+        { 0x1.8a7595p+2, 0x0p+0, -0x1.e95c1c3b1e9e7p-4, 0x1.7a8p-58 },
+        { 0x1.988874p+0, 0x0p+0, 0x1.ffd6ecc0487bfp-1, -0x1.49p-56 },
+        { -0x1.ebe479p+2, 0x0p+0, -0x1.f8c71c7594585p-1, -0x1.8b8p-55 },
+        { -0x1.29b066p+2, 0x0p+0, 0x1.ff0c3c80567a9p-1, 0x1.fap-57 },
+        { -0x1.561caap+1, 0x0p+0, -0x1.ceb2e7c9f328p-2, 0x1.aap-58 },
+        { 0x1.978938p+2, 0x0p+0, 0x1.59f708ed8cf8dp-4, -0x1.708p-58 },
+        { -0x1.2773488p+3, 0x0p+0, -0x1.86b6f4e8fb161p-3, 0x1.7ap-57 },
+        { 0x1.4793f6p+1, 0x0p+0, 0x1.199c645e28ed3p-1, -0x1.68p-57 },
+        { -0x1.768f1cp+1, 0x0p+0, -0x1.b5a2eb98372e3p-3, -0x1.4p-64 },
+        { 0x1.f6db27p+2, 0x0p+0, 0x1.ffff5a1f99068p-1, -0x1.a1p-56 },
+        { 0x1.7c1c9dp+2, 0x0p+0, -0x1.594a683f0dc12p-2, 0x1.9cp-56 },
+        { -0x1.1e7cp-2, 0x0p+0, -0x1.1ac3009a63845p-2, -0x1.71p-57 },
+        { 0x1.784014p+1, 0x0p+0, 0x1.9b29da01214d5p-3, -0x1.49p-58 },
+    } },
+    { "cos", {
+        { 0x1.3139878p+3, 0x0p+0, -0x1.fcb4bbed2d956p-1, 0x1.28p-57 },
+        { -0x1.00996c8p+3, 0x0p+0, -0x1.4fe09ba3b8a0cp-3, -0x1.26p-57 },
+        { 0x1.6f26p-7, 0x0p+0, 0x1.fff7c5cdbd7e2p-1, -0x1.79p-55 },
+        { 0x1.884293p+2, 0x0p+0, 0x1.f9ee5d6b0a603p-1, -0x1.0cp-58 },
+        { -0x1.6fbfcp+0, 0x0p+0, 0x1.122c4d2e773c7p-3, 0x1.1p-57 },
+        { 0x1.0beb99p+3, 0x0p+0, -0x1.fb7f19a1ef84fp-2, 0x1.85p-57 },
+        { -0x1.249b788p+3, 0x0p+0, -0x1.ebf2745b42ed9p-1, 0x1.ba8p-55 },
+        { 0x1.1cbf168p+3, 0x0p+0, -0x1.baac3e79c336p-1, 0x1.78p-59 },
+        { 0x1.baaa94p+1, 0x0p+0, -0x1.e68804bf0b69bp-1, -0x1.73p-56 },
+        { -0x1.324a8e8p+3, 0x0p+0, -0x1.fa7dc5f65debdp-1, 0x1.24p-56 },
+        { 0x1.37c8e78p+3, 0x0p+0, -0x1.e64008fd0b8b3p-1, -0x1.418p-55 },
+        { -0x1.d02c2p+0, 0x0p+0, -0x1.eb8ac71b5d6d1p-3, 0x1.be8p-57 },
+        { -0x1.eed88cp+0, 0x0p+0, -0x1.6ad4f9fac0419p-2, 0x1.98p-57 },
+        { -0x1.f8876p+1, 0x0p+0, -0x1.64b31b3c37eabp-1, 0x1.f28p-55 },
+        { 0x1.92fafdp+2, 0x0p+0, 0x1.fff442ce86f33p-1, 0x1.c3p-55 },
+        { -0x1.1ff2ecp+2, 0x0p+0, -0x1.b14ec4e9e2f16p-3, 0x1.86p-59 },
+        { -0x1.081389p+3, 0x0p+0, -0x1.8d41f65327853p-2, -0x1.26p-56 },
+        { 0x1.18c1d18p+3, 0x0p+0, -0x1.973f8217ca5adp-1, 0x1.c2p-56 },
+        { -0x1.2cf726p+3, 0x0p+0, -0x1.ffe6cd7f4cad2p-1, 0x1.47p-55 },
+        { 0x1.85e142p+1, 0x0p+0, -0x1.fda8ccdad28dcp-1, 0x1.e88p-55 },
+        { 0x1.745193p+2, 0x0p+0, 0x1.c9796e61bd35fp-1, -0x1.dcp-55 },
+        { -0x1.87061cp+1, 0x0p+0, -0x1.fe13781f30c64p-1, 0x1.0ep-55 },
+        { 0x1.ef870fp+2, 0x0p+0, 0x1.c733ae1594fd3p-4, 0x1.59p-58 },
+        { 0x1.870dbfp+2, 0x0p+0, 0x1.f85c1b7bb3d9cp-1, -0x1.ep-60 },
+        { -0x1.e0321ep+1, 0x0p+0, -0x1.a3ada67058b38p-1, 0x1.1cp-57 },
+        { 0x1.29f431p+3, 0x0p+0, -0x1.fcb164e61482ep-1, -0x1.7c8p-55 },
+        { -0x1.4f3f2p+0, 0x0p+0, 0x1.087a0b85d88bp-2, 0x1.d9p-57 },
+        { -0x1.09b4b9p+3, 0x0p+0, -0x1.bcc93f76d8488p-2, -0x1.68p-60 },
+        { 0x1.4e605p+1, 0x0p+0, -0x1.b9f1a18ee2ce1p-1, 0x1.79p-55 },
+        { 0x1.af0a18p+2, 0x0p+0, 0x1.cca0429e8b3dfp-1, 0x1.28p-57 },
+        { 0x1.d38645p+2, 0x0p+0, 0x1.0b23fc4b60c02p-1, -0x1.6bp-56 },
+        { 0x1.b40252p+1, 0x0p+0, -0x1.ee29ee83fb6c3p-1, 0x1p-59 },
+    } },
+    { "tan", {
+        { 0x1.f72dap-2, 0x0p+0, 0x1.12019a4b8c50dp-1, -0x1.56p-56 },
+        { -0x1.77cd1ap+0, 0x0p+0, -0x1.361defbefe7f8p+3, -0x1p-58 },
+        { -0x1.e49ecp-1, 0x0p+0, -0x1.635e5343194c7p+0, -0x1.b3p-54 },
+        { -0x1.1d482ap+0, 0x0p+0, -0x1.04b29558dee51p+1, -0x1.22p-53 },
+        { -0x1.e45ce4p-2, 0x0p+0, -0x1.06054b0092a29p-1, -0x1.efp-55 },
+        { 0x1.8a4c1cp-1, 0x0p+0, 0x1.f094d5205353cp-1, -0x1.998p-55 },
+        { -0x1.df9e08p-1, 0x0p+0, -0x1.5c250773e5f26p+0, 0x1.4p-54 },
+        { 0x1.b0ca08p-1, 0x0p+0, 0x1.20a9189aa1726p+0, -0x1.068p-54 },
+        { 0x1.7aea15p+0, 0x0p+0, 0x1.5ffddeb9bb80ep+3, -0x1.c1p-51 },
+        { 0x1.11d7e8p-2, 0x0p+0, 0x1.189053c4a0233p-2, 0x1.f08p-56 },
+        { 0x1.82e968p-1, 0x0p+0, 0x1.e271f731f12f9p-1, -0x1.38p-59 },
+        { 0x1.2b2fe9p+0, 0x0p+0, 0x1.2cfcd2adc02f1p+1, -0x1p-62 },
+        { -0x1.62b2cbp+0, 0x0p+0, -0x1.5581e057b6737p+2, -0x1.98p-55 },
+        { -0x1.2f4473p+0, 0x0p+0, -0x1.3ad404c16dfc9p+1, 0x1.378p-53 },
+        { -0x1.78c29p-3, 0x0p+0, -0x1.7d118eab49d3ep-3, -0x1.138p-57 },
+        { 0x1.b73d94p-2, 0x0p+0, 0x1.d45272009ba23p-2, 0x1.f7p-57 },
+        { -0x1.7eb3ffp+0, 0x0p+0, -0x1.a501e2a15d45ep+3, 0x1.28p-51 },
+        { 0x1.9eaea8p-2, 0x0p+0, 0x1.b6f1918753bdbp-2, 0x1.15p-57 },
+        { -0x1.1238e4p-2, 0x0p+0, -0x1.18f89a4cbcac2p-2, -0x1.ec8p-56 },
+        { 0x1.69d658p+0, 0x0p+0, 0x1.9352d2f3dd642p+2, -0x1.798p-52 },
+        { 0x1.015c5cp+0, 0x0p+0, 0x1.93658e924f1ebp+0, 0x1.788p-54 },
+        { 0x1.3b2e56p-1, 0x0p+0, 0x1.6a1f2bc652337p-1, -0x1.fep-55 },
+        { 0x1.ebdb7p-2, 0x0p+0, 0x1.0ac45ecb219d9p-1, 0x1.bp-56 },
+        { -0x1.04cc5ep+0, 0x0p+0, -0x1.9fa11d316b7c6p+0, -0x1.9a8p-54 },
+        { 0x1.35813p-3, 0x0p+0, 0x1.37e1f2b16b761p-3, 0x1.68p-59 },
+        { -0x1.1e2a14p-1, 0x0p+0, -0x1.403983072159dp-1, 0x1.298p-55 },
+        { 0x1.2eb698p-3, 0x0p+0, 0x1.30efecf7578abp-3, 0x1.6ep-59 },
+        { -0x1.489bbap-1, 0x0p+0, -0x1.7ea6bb8240d19p-1, 0x1.a8p-55 },
+        { -0x1.fe9582p-1, 0x0p+0, -0x1.8c481264dc996p+0, -0x1.acp-56 },
+        { -0x1.72501bp+0, 0x0p+0, -0x1.0031d0477ebd4p+3, -0x1.4fp-52 },
+        { 0x1.f9b624p-2, 0x0p+0, 0x1.13a3489500e02p-1, 0x1.32p-55 },
+        { -0x1.0c3a28p-3, 0x0p+0, -0x1.0dc57bf0baab7p-3, 0x1.8ap-59 },
+    } },
+    { "atan", {
+        { 0x1.7bc66cap+6, 0x0p+0, 0x1.8f6d78f122bafp+0, 0x1.938p-54 },
+        { 0x1.0bc0a42p+6, 0x0p+0, 0x1.8e4cba3d3a484p+0, -0x1.46p-55 },
+        { 0x1.8203a42p+6, 0x0p+0, 0x1.8f78a0bbefa78p+0, 0x1.1ap-54 },
+        { 0x1.275ab7cp+6, 0x0p+0, 0x1.8ea8346bfd2d2p+0, -0x1.14p-57 },
+        { -0x1.4016d5ap+6, 0x0p+0, -0x1.8eecc76b4b7a7p+0, 0x1.c68p-54 },
+        { 0x1.6b44982p+6, 0x0p+0, 0x1.8f4e1c30daacdp+0, 0x1.06p-54 },
+        { -0x1.e710d18p+4, 0x0p+0, -0x1.89b7a38f4c291p+0, -0x1.18p-58 },
+        { 0x1.22267dcp+5, 0x0p+0, 0x1.8b113683be4f6p+0, -0x1.4ap-55 },
+        { -0x1.4c5edd8p+4, 0x0p+0, -0x1.85cf4d321aea5p+0, -0x1.01p-54 },
+        { -0x1.79d864cp+5, 0x0p+0, -0x1.8cb45796c04d2p+0, -0x1.06p-56 },
+        { -0x1.78647e8p+5, 0x0p+0, -0x1.8caefd3243985p+0, 0x1.22p-56 },
+        { 0x1.2ff40f8p+5, 0x0p+0, 0x1.8b6335c283651p+0, 0x1.ap-59 },
+        { 0x1.bbc0fap+4, 0x0p+0, 0x1.88e5c36e40fe8p+0, -0x1.f68p-54 },
+        { 0x1.2c6dbdcp+5, 0x0p+0, 0x1.8b4efcc45cb1ap+0, 0x1.9p-59 },
+        { -0x1.8f6ccbap+6, 0x0p+0, -0x1.8f8f6d3218f47p+0, -0x1.f78p-54 },
+        { 0x1.0576e34p+6, 0x0p+0, 0x1.8e352fe53bf9fp+0, -0x1.9b8p-54 },
+        { -0x1.7444p+6, 0x0p+0, -0x1.8f5f8cc10269fp+0, 0x1.f58p-54 },
+        { -0x1.066e4ccp+5, 0x0p+0, -0x1.8a52834301701p+0, 0x1.55p-54 },
+        { -0x1.8e639f4p+6, 0x0p+0, -0x1.8f8db8651a0ep+0, 0x1.78p-54 },
+        { -0x1.c13daap+2, 0x0p+0, -0x1.6de5afe143a3bp+0, 0x1.95p-55 },
+        { -0x1.6b9afeep+6, 0x0p+0, -0x1.8f4ec7a55da83p+0, -0x1.388p-54 },
+        { -0x1.9b8a7ep+2, 0x0p+0, -0x1.6aa0fddd40087p+0, -0x1.65p-55 },
+        { 0x1.87ffdbp+4, 0x0p+0, 0x1.87ae3fda65f28p+0, -0x1.4e8p-54 },
+        { 0x1.e06a22p+2, 0x0p+0, 0x1.7038384f2555p+0, -0x1.8ep-54 },
+        { 0x1.13335ep+2, 0x0p+0, 0x1.57a0fc93f4114p+0, -0x1.d2p-56 },
+        { -0x1.743b2fcp+5, 0x0p+0, -0x1.8c9f6c85b1a13p+0, 0x1.6a8p-54 },
+        { -0x1.0c54d8cp+6, 0x0p+0, -0x1.8e4ed6df4deadp+0, -0x1.a4p-56 },
+        { -0x1.7f2528p+2, 0x0p+0, -0x1.67c0d070152e6p+0, -0x1.adp-55 },
+        { -0x1.1892eaap+6, 0x0p+0, -0x1.8e797530e2023p+0, -0x1.cp-56 },
+        { -0x1.b99afap+3, 0x0p+0, -0x1.7f9b10f9337b1p+0, -0x1.fep-55 },
+        { -0x1.ab9ca7p+5, 0x0p+0, -0x1.8d55c4750b63cp+0, -0x1.acp-57 },
+        { 0x1.53331b8p+6, 0x0p+0, 0x1.8f1ae9b2933b2p+0, 0x1.9ep-54 },
+    } },
+    { "exp", {
+        { -0x1.93fac898p+8, 0x0p+0, 0x1.22239aba4486p-583, 0x1.618p-637 },
+        { 0x1.7dcdafep+6, 0x0p+0, 0x1.a1bfa75ea46eap+137, -0x1.8p+77 },
+        { -0x1.1957fe3p+7, 0x0p+0, 0x1.09a75ee614b96p-203, 0x1.48p-261 },
+        { -0x1.99e49f9p+7, 0x0p+0, 0x1.409b2449adc5p-296, -0x1.3p-350 },
+        { 0x1.bccd498p+7, 0x0p+0, 0x1.cf9aa93346db6p+320, 0x1.02p+264 },
+        { -0x1.e11a67p+6, 0x0p+0, 0x1.64bd1569c784ap-174, -0x1.378p-228 },
+        { -0x1.ba500cbp+8, 0x0p+0, 0x1.d6603cf5802cbp-639, -0x1.cep-695 },
+        { -0x1.5db6ba3p+7, 0x0p+0, 0x1.aa09540342d2fp-253, -0x1.7bp-308 },
+        { -0x1.9859e4p+2, 0x0p+0, 0x1.bc2672950d55fp-10, -0x1.eb8p-64 },
+        { 0x1.f125b618p+8, 0x0p+0, 0x1.2ca7522a41b7fp+717, -0x1.f5p+662 },
+        { -0x1.b74129fp+7, 0x0p+0, 0x1.1b083ce87932dp-317, 0x1.2p-375 },
+        { 0x1.39c64d98p+9, 0x0p+0, 0x1.490dd5f6aa9b7p+905, -0x1.928p+851 },
+        { -0x1.1351144p+5, 0x0p+0, 0x1.4657a60a2c247p-50, -0x1.28p-108 },
+        { 0x1.755a539p+8, 0x0p+0, 0x1.8d5b0f9588d87p+538, 0x1.88p+484 },
+        { -0x1.1cad134p+5, 0x0p+0, 0x1.952d0c3811543p-52, 0x1.fp-107 },
+        { -0x1.6a8367ep+7, 0x0p+0, 0x1.6a85ca6f8c2e9p-262, -0x1.cap-316 },
+        { -0x1.0ed8b094p+9, 0x0p+0, 0x1.6aa15c7920cd3p-782, 0x1.81p-836 },
+        { 0x1.ca734e4p+7, 0x0p+0, 0x1.a0784c9659635p+330, -0x1.978p+276 },
+        { 0x1.2f6c1044p+9, 0x0p+0, 0x1.67d552854108dp+875, -0x1.78p+819 },
+        { -0x1.235b9e78p+9, 0x0p+0, 0x1.3f5104de1f266p-841, -0x1.ae8p-895 },
+        { -0x1.5a77cc38p+9, 0x0p+0, 0x1.3c385358f9d08p-1000, 0x0.00000000b38p-1022 },
+        { -0x1.d70d86cp+8, 0x0p+0, 0x1.552f2f77dc2a1p-680, -0x1.9ap-734 },
+        { -0x1.33b2431cp+9, 0x0p+0, 0x1.21394aa38feb3p-888, 0x1.74p-943 },
+        { -0x1.216281ep+8, 0x0p+0, 0x1.6b8bab2ec19b4p-418, 0x1.8ap-473 },
+        { -0x1.875ebf4p+5, 0x0p+0, 0x1.56dfd53d5308bp-71, -0x1.23p-126 },
+        { -0x1.4e741ep+8, 0x0p+0, 0x1.66697274e3f41p-483, 0x1.278p-537 },
+        { 0x1.37fe7eep+8, 0x0p+0, 0x1.14bcd14bd8a07p+450, 0x1.bep+396 },
+        { -0x1.19476a7p+7, 0x0p+0, 0x1.12654b97eb386p-203, 0x1.d4p-259 },
+        { -0x1.427efcp+5, 0x0p+0, 0x1.cae94cd9b3c98p-59, -0x1.49p-113 },
+        { -0x1.d03a42cp+6, 0x0p+0, 0x1.7accd0cd3bf6dp-168, 0x1.78p-225 },
+        { -0x1.d0715aa8p+8, 0x0p+0, 0x1.eecbd684e57afp-671, 0x1.2p-731 },
+        { -0x1.68e0a3f8p+8, 0x0p+0, 0x1.496d76160ae64p-521, 0x1.63p-575 },
+    } },
+    { "log", {
+        { 0x1.af13130ca8fbp+39, 0x0p+0, 0x1.b8dc8b0d6a86dp+4, -0x1.5p-54 },
+        { 0x1.aabe1dbc3a36p+38, 0x0p+0, 0x1.ad9c0b1ca07f8p+4, -0x1.f8p-53 },
+        { 0x1.629d1997accep+37, 0x0p+0, 0x1.9f8e877e1c23ap+4, 0x1.7p-55 },
+        { 0x1.2468133ad1b2p+37, 0x0p+0, 0x1.9c787a1fec6a2p+4, 0x1.99p-50 },
+        { 0x1.a74728ed0e2a8p+37, 0x0p+0, 0x1.a263859a23115p+4, 0x1.6p-56 },
+        { 0x1.0e1de4222cfdcp+38, 0x0p+0, 0x1.a64ad534b629fp+4, -0x1.608p-50 },
+        { 0x1.1afaac909e09p+39, 0x0p+0, 0x1.b220817a0ad6dp+4, -0x1.54p-51 },
+        { 0x1.893e4e4d725ecp+39, 0x0p+0, 0x1.b764510037e84p+4, -0x1.fp-50 },
+        { 0x1.21c138fb6e038p+37, 0x0p+0, 0x1.9c532972e69afp+4, 0x1.adp-51 },
+        { 0x1.8978de69c6d9p+38, 0x0p+0, 0x1.ac4f91504596dp+4, 0x1.d1p-50 },
+        { 0x1.95329966915p+35, 0x0p+0, 0x1.8b8273f220726p+4, -0x1.efp-51 },
+        { 0x1.842852527baap+35, 0x0p+0, 0x1.8ad279285037dp+4, 0x1.1ap-50 },
+        { 0x1.00a88315ed8ep+36, 0x0p+0, 0x1.8f4b3aa91916ap+4, 0x1.bcp-52 },
+        { 0x1.1e8c63b032874p+38, 0x0p+0, 0x1.a73cb6e556cf1p+4, -0x1.1p-53 },
+        { 0x1.388f694377fep+36, 0x0p+0, 0x1.92725a4c4914fp+4, -0x1.02p-52 },
+        { 0x1.fada15b61b42p+35, 0x0p+0, 0x1.8f17513e19335p+4, -0x1.b7p-51 },
+        { 0x1.81432042f576cp+38, 0x0p+0, 0x1.abf932ee3d876p+4, 0x1.9p-51 },
+        { 0x1.c8a3af41e219p+38, 0x0p+0, 0x1.aeb165385f585p+4, -0x1.1ep-50 },
+        { 0x1.10646310d9132p+39, 0x0p+0, 0x1.b1845291105cap+4, 0x1.57p-51 },
+        { 0x1.a083cb6a7fe8p+34, 0x0p+0, 0x1.80dc27a4a0b56p+4, -0x1.3ep-52 },
+        { 0x1.fd3851e323bbp+38, 0x0p+0, 0x1.b06fcd77d58e7p+4, 0x1.3p-55 },
+        { 0x1.09b1853fcd26ep+39, 0x0p+0, 0x1.b11e55801d65fp+4, 0x1.b5p-50 },
+        { 0x1.db041a504632p+38, 0x0p+0, 0x1.af53004d6bd7cp+4, 0x1.2e8p-50 },
+        { 0x1.fcf9d9551ap+34, 0x0p+0, 0x1.841150dc237a4p+4, -0x1.dap-51 },
+        { 0x1.954401ecb8b64p+39, 0x0p+0, 0x1.b7dfa9e5bad4fp+4, -0x1.afp-51 },
+        { 0x1.c81f0144aa50ep+39, 0x0p+0, 0x1.b9c3dfec06c33p+4, -0x1.9dp-50 },
+        { 0x1.aac1d8b46739ap+39, 0x0p+0, 0x1.b8b3506a089adp+4, -0x1.198p-50 },
+        { 0x1.44cbfec286d3p+36, 0x0p+0, 0x1.930fa697ad658p+4, -0x1.b8p-52 },
+        { 0x1.03b6bfa10c334p+38, 0x0p+0, 0x1.a5a9f79d4ec95p+4, -0x1.69p-50 },
+        { 0x1.0801d65df3c8ap+39, 0x0p+0, 0x1.b104415a009c4p+4, -0x1.6fp-50 },
+        { 0x1.29d3ef8419e98p+38, 0x0p+0, 0x1.a7dada99eaa29p+4, -0x1.1d8p-50 },
+        { 0x1.827d7113aa084p+39, 0x0p+0, 0x1.b71d5cd4d8967p+4, 0x1.b7p-50 },
+    } },
+    { "exp2", {
+        { 0x1.a352e0c8p+9, 0x0p+0, 0x1.9101e00b96c2fp+838, 0x1.e88p+784 },
+        { -0x1.f2246de8p+9, 0x0p+0, 0x1.a455c55fd5847p-997, -0x0.00000001ccp-1022 },
+        { -0x1.180758fp+8, 0x0p+0, 0x1.f5ea3b991a79bp-281, 0x1.5cp-335 },
+        { -0x1.8b7ca4e8p+9, 0x0p+0, 0x1.04b1d812d4a26p-791, 0x1.99p-846 },
+        { -0x1.d9e16a6p+8, 0x0p+0, 0x1.161a204aaa949p-474, -0x1.9p-530 },
+        { 0x1.e53f01d8p+9, 0x0p+0, 0x1.6818f5a721747p+970, 0x1.e4p+915 },
+        { 0x1.17d131a8p+9, 0x0p+0, 0x1.8d5ded126d0e9p+559, -0x1.dbp+505 },
+        { -0x1.6621dabp+8, 0x0p+0, 0x1.d327a02b4f4e4p-359, -0x1.76p-413 },
+        { -0x1.2816d4p+4, 0x0p+0, 0x1.68a48d29b3d55p-19, -0x1.53p-74 },
+        { -0x1.c0df491p+8, 0x0p+0, 0x1.17b5ed8824bd3p-449, 0x1.68p-504 },
+        { 0x1.afd7c9dp+8, 0x0p+0, 0x1.cb2eaa04d0e9bp+431, 0x1.58p+376 },
+        { 0x1.166be1p+8, 0x0p+0, 0x1.56d7ab5cd3cdbp+278, 0x0p+0 },
+        { -0x1.36628eap+9, 0x0p+0, 0x1.2c401b34cfc39p-621, -0x1.0ep-676 },
+        { 0x1.a955bep+5, 0x0p+0, 0x1.1f63da4d98a6dp+53, -0x1.268p-1 },
+        { -0x1.8b60d3dp+8, 0x0p+0, 0x1.89ec28b141243p-396, -0x1.52p-451 },
+        { 0x1.cf44bdap+9, 0x0p+0, 0x1.73740927c32bp+926, -0x1.5dp+871 },
+        { -0x1.119328p+8, 0x0p+0, 0x1.57bd41400a39fp-274, -0x1.f9p-328 },
+        { 0x1.b5cadff8p+9, 0x0p+0, 0x1.7fffd418a52a3p+875, -0x1.eap+820 },
+        { 0x1.598e094p+7, 0x0p+0, 0x1.b6cc614a169a2p+172, -0x1.ep+116 },
+        { 0x1.ef42c61p+8, 0x0p+0, 0x1.32bb61d6ce829p+495, -0x1.d48p+441 },
+        { 0x1.fb5a1c5p+8, 0x0p+0, 0x1.46bd2a05c9508p+507, -0x1.11p+453 },
+        { 0x1.b291b1ep+8, 0x0p+0, 0x1.7bce70406a91cp+434, 0x1.61p+380 },
+        { 0x1.017706a8p+9, 0x0p+0, 0x1.e7b6b3ced848ap+514, -0x1.4e8p+460 },
+        { 0x1.d23ba6ep+7, 0x0p+0, 0x1.15880e0667d49p+233, 0x1.efp+178 },
+        { -0x1.781b728p+5, 0x0p+0, 0x1.fb4409d07fa5fp-48, 0x1.cdp-102 },
+        { -0x1.1db330dp+8, 0x0p+0, 0x1.3b2e51552cb85p-286, 0x1.3bp-340 },
+        { 0x1.778b57ep+8, 0x0p+0, 0x1.75549c7a52d0bp+375, 0x1.56p+321 },
+        { 0x1.27b17abp+9, 0x0p+0, 0x1.4ea9374d83b1dp+591, 0x1.7ap+536 },
+        { 0x1.d3c52d1p+9, 0x0p+0, 0x1.745474ddd99d9p+935, 0x1.1a8p+881 },
+        { 0x1.babb7a4p+8, 0x0p+0, 0x1.a94c949f664eep+442, 0x1.a9p+387 },
+        { 0x1.1dfb0f4p+9, 0x0p+0, 0x1.f27bdc3491ffbp+571, -0x1.68p+517 },
+        { -0x1.1f9b422p+8, 0x0p+0, 0x1.5047dd5a4275cp-288, -0x1.d6p-343 },
+    } },
+    { "log2", {
+        { 0x1.c67a41cf8991p+37, 0x0p+0, 0x1.2e9fe0afa8046p+5, 0x1.ab8p-49 },
+        { 0x1.b89a704d34a8cp+39, 0x0p+0, 0x1.3e4445e178aeep+5, 0x1.3p-54 },
+        { 0x1.3002c4df1b67p+37, 0x0p+0, 0x1.29fbdc551c55cp+5, 0x1.afp-49 },
+        { 0x1.f9812169ee258p+37, 0x0p+0, 0x1.2fda468e1158bp+5, 0x1.28p-50 },
+        { 0x1.b9bbd7bd701p+38, 0x0p+0, 0x1.364bd81bcce49p+5, -0x1.3p-51 },
+        { 0x1.1d0f4c02b6c3p+37, 0x0p+0, 0x1.293dafd87ccc3p+5, -0x1.92p-49 },
+        { 0x1.9f9eb73298cap+36, 0x0p+0, 0x1.2597ccdc66f15p+5, 0x1.74p-50 },
+        { 0x1.0a4363485e57p+38, 0x0p+0, 0x1.30742411a4ef8p+5, -0x1.f6p-50 },
+        { 0x1.92eaf1f91b084p+39, 0x0p+0, 0x1.3d3c176ecca7cp+5, -0x1.1p-52 },
+        { 0x1.c5827da672ee4p+39, 0x0p+0, 0x1.3e99943237563p+5, -0x1.998p-49 },
+        { 0x1.a0d233f6ce196p+39, 0x0p+0, 0x1.3da053a24610fp+5, 0x1.66p-49 },
+        { 0x1.1621cdb662c16p+39, 0x0p+0, 0x1.38f4fe9017b4ep+5, 0x1.11p-50 },
+        { 0x1.8f93634729832p+39, 0x0p+0, 0x1.3d237b5fa1949p+5, 0x1.1cp-51 },
+        { 0x1.9e129a2d26e98p+39, 0x0p+0, 0x1.3d8cc7a3999c5p+5, 0x1.478p-49 },
+        { 0x1.8d6a1fab06a4p+39, 0x0p+0, 0x1.3d137530cfd01p+5, -0x1.52p-50 },
+        { 0x1.46254e01c469cp+38, 0x0p+0, 0x1.32cb8403e54bep+5, -0x1.6ap-49 },
+        { 0x1.294dd95df2ccap+39, 0x0p+0, 0x1.39b9f302f8b3bp+5, 0x1.3ep-51 },
+        { 0x1.6043d6b58b048p+38, 0x0p+0, 0x1.33af23b2f133ep+5, 0x1.8dp-50 },
+        { 0x1.7cbdd45cc9e16p+39, 0x0p+0, 0x1.3c94d3036686p+5, 0x1.bdp-50 },
+        { 0x1.b71f05e7c93ap+39, 0x0p+0, 0x1.3e3a51453f61cp+5, -0x1.64p-51 },
+        { 0x1.be76320870b8cp+39, 0x0p+0, 0x1.3e6b4cd135388p+5, 0x1.e7p-49 },
+        { 0x1.9ab57ed9be40cp+39, 0x0p+0, 0x1.3d74ae11a7398p+5, 0x1.5ap-51 },
+        { 0x1.869c10943b9b6p+39, 0x0p+0, 0x1.3ce06d6b37b29p+5, 0x1.98p-52 },
+        { 0x1.11b5761aa813p+37, 0x0p+0, 0x1.28c5a0d72b7fp+5, -0x1.5bp-49 },
+        { 0x1.fc4c05935e6ep+37, 0x0p+0, 0x1.2fea8d8c16c33p+5, 0x1.09p-49 },
+        { 0x1.0d6cf0057a04cp+39, 0x0p+0, 0x1.3897067613072p+5, 0x1.f8p-51 },
+        { 0x1.aae6381c886f8p+37, 0x0p+0, 0x1.2de6ea80a029cp+5, -0x1.ep-54 },
+        { 0x1.1950a1f5d492p+35, 0x0p+0, 0x1.19169d7664eb2p+5, 0x1.cf8p-49 },
+        { 0x1.55a8f7f63e4cp+37, 0x0p+0, 0x1.2b54d2cb9895ap+5, 0x1.42p-49 },
+        { 0x1.c43c3779cc0c6p+39, 0x0p+0, 0x1.3e914382c25d7p+5, -0x1.dd8p-49 },
+        { 0x1.aa4b3e22320b2p+39, 0x0p+0, 0x1.3de2b91fb14eap+5, 0x1.5ep-50 },
+        { 0x1.5881c3e2d23b2p+39, 0x0p+0, 0x1.3b6d573cc0fefp+5, 0x1.d8p-52 },
+    } },
+    { "log10", {
+        { 0x1.77526e4f7d7cp+37, 0x0p+0, 0x1.69bc9c9976bbfp+3, 0x1.07p-51 },
+        { 0x1.0c79cdd78c2b8p+38, 0x0p+0, 0x1.6eb6b8ff4f67bp+3, -0x1.e9p-52 },
+        { 0x1.86f96feb3598p+36, 0x0p+0, 0x1.60abef5cd5abep+3, 0x1.74p-52 },
+        { 0x1.c9a85ab3de8ecp+39, 0x0p+0, 0x1.7fc251a79d742p+3, 0x1.dbp-52 },
+        { 0x1.7d603045341dap+39, 0x0p+0, 0x1.7d399d1cd97bep+3, 0x1.a2p-52 },
+        { 0x1.4471b4dc8c80ap+39, 0x0p+0, 0x1.7afa6d971c98fp+3, 0x1.24p-51 },
+        { 0x1.ebe137e537758p+37, 0x0p+0, 0x1.6d7ecd7369488p+3, -0x1.8ep-52 },
+        { 0x1.b67c90881cfp+38, 0x0p+0, 0x1.758809ad1f5a5p+3, 0x1.78p-54 },
+        { 0x1.a00031e9cc22ep+39, 0x0p+0, 0x1.7e6ec9dd8dac8p+3, -0x1.748p-51 },
+        { 0x1.309e096d8eaa8p+38, 0x0p+0, 0x1.70780cab85814p+3, 0x1.6f8p-51 },
+        { 0x1.7d3d404ca765p+38, 0x0p+0, 0x1.73964d79f8aecp+3, -0x1.77p-52 },
+        { 0x1.dcef00a74aaep+35, 0x0p+0, 0x1.59ccf22444fccp+3, -0x1.118p-51 },
+        { 0x1.41202cab60858p+38, 0x0p+0, 0x1.7133d04ba9f9bp+3, -0x1p-53 },
+        { 0x1.9ef76ce93f9bp+36, 0x0p+0, 0x1.617fd1b318748p+3, -0x1.cep-51 },
+        { 0x1.4b0d01171afc4p+39, 0x0p+0, 0x1.7b4225769b4e2p+3, -0x1.448p-51 },
+        { 0x1.67d7d7347a5b6p+39, 0x0p+0, 0x1.7c6ad9515653ep+3, -0x1.cp-51 },
+        { 0x1.357eea480f45p+37, 0x0p+0, 0x1.670e89910d6e4p+3, 0x1.d2p-53 },
+        { 0x1.93f172b7b4324p+38, 0x0p+0, 0x1.74641b75a1fd8p+3, -0x1.d88p-51 },
+        { 0x1.7c85c2b79209p+38, 0x0p+0, 0x1.738f9b85fc878p+3, -0x1.44p-52 },
+        { 0x1.06c2889f05f36p+39, 0x0p+0, 0x1.780c328d5070ep+3, 0x1.dep-53 },
+        { 0x1.5af1dd0054a26p+39, 0x0p+0, 0x1.7be8fb778c6b8p+3, -0x1.3p-52 },
+        { 0x1.142471a35804ap+39, 0x0p+0, 0x1.78bcee6613b0ep+3, 0x1.2b8p-51 },
+        { 0x1.2c00ea751738p+35, 0x0p+0, 0x1.535ba36802cdcp+3, 0x1.7p-51 },
+        { 0x1.c92ba941f03b2p+39, 0x0p+0, 0x1.7fbe87cc6f859p+3, 0x1.d9p-52 },
+        { 0x1.d07f00f328a88p+38, 0x0p+0, 0x1.76550c86b9383p+3, 0x1.86p-51 },
+        { 0x1.240a1ce9f4adp+36, 0x0p+0, 0x1.5c9df431e92eep+3, -0x1.1ep-51 },
+        { 0x1.c9c9755fce932p+39, 0x0p+0, 0x1.7fc352f6bd385p+3, 0x1.66p-52 },
+        { 0x1.0c4178e4dc9c8p+39, 0x0p+0, 0x1.7855d7dc4799bp+3, 0x1.cp-55 },
+        { 0x1.7e77ea3ec326ap+39, 0x0p+0, 0x1.7d43caddc4202p+3, 0x1.ba8p-51 },
+        { 0x1.320581ebbe546p+39, 0x0p+0, 0x1.7a2a7312e1e39p+3, -0x1.6fp-51 },
+        { 0x1.1dc8ce2f9a5a8p+38, 0x0p+0, 0x1.6f94ffcd81084p+3, 0x1.54p-51 },
+        { 0x1.1708827ab92ep+37, 0x0p+0, 0x1.659de851d26a9p+3, -0x1.34p-51 },
+    } },
+    { "cbrt", {
+        { -0x1.2354ecaf21218p+38, 0x0p+0, -0x1.a8452eab86d23p+12, 0x1.84p-44 },
+        { -0x1.a2c0a2577b7d8p+38, 0x0p+0, -0x1.ded01500a55d2p+12, -0x1.fdp-43 },
+        { 0x1.99daf60330d44p+39, 0x0p+0, 0x1.2b7b4b2e89c22p+13, 0x1.f7p-42 },
+        { 0x1.24691ccd5df84p+39, 0x0p+0, 0x1.0b9a5f971a508p+13, -0x1.ep-47 },
+        { 0x1.32404324edap+33, 0x0p+0, 0x1.0fc29b6145a35p+11, -0x1.2cp-45 },
+        { 0x1.f6487980ece2p+38, 0x0p+0, 0x1.fcbd85fe47718p+12, 0x1.66p-44 },
+        { -0x1.4761c084dbd8cp+39, 0x0p+0, -0x1.15df3da177115p+13, 0x1.62p-43 },
+        { 0x1.4c9f0782bdc4cp+39, 0x0p+0, 0x1.1758b6891ff34p+13, -0x1.08p-44 },
+        { -0x1.c44fdcfb41a8p+36, 0x0p+0, -0x1.357c1c680b3f3p+12, -0x1.ap-46 },
+        { -0x1.886b1706052fp+37, 0x0p+0, -0x1.73e4fcb6d0c6cp+12, 0x1.dp-43 },
+        { -0x1.4413bcba06318p+38, 0x0p+0, -0x1.b79ae9fc5f35bp+12, -0x1.aap-43 },
+        { -0x1.0f99d8c5da6ep+37, 0x0p+0, -0x1.48f6885e433c7p+12, -0x1.818p-42 },
+        { -0x1.33100a084aab4p+39, 0x0p+0, -0x1.100002f65790cp+13, -0x1.f7p-42 },
+        { -0x1.3da3f5ceda358p+39, 0x0p+0, -0x1.1316928c1bf01p+13, -0x1.a1p-42 },
+        { -0x1.7605492c5f9b4p+39, 0x0p+0, -0x1.227c68e1f3fe1p+13, -0x1.38p-41 },
+        { -0x1.ba79803484c08p+39, 0x0p+0, -0x1.3339846bd905ap+13, -0x1.0ap-43 },
+        { -0x1.5f087168527p+39, 0x0p+0, -0x1.1c6895690703p+13, -0x1.66p-43 },
+        { 0x1.bb9de39e7dc44p+39, 0x0p+0, 0x1.337d21783a656p+13, 0x1.c2p-41 },
+        { 0x1.bd6161d80267p+38, 0x0p+0, 0x1.e8c107531f9c4p+12, -0x1.e4p-44 },
+        { 0x1.2239a1939abdcp+39, 0x0p+0, 0x1.0aef46410068bp+13, -0x1.24p-44 },
+        { 0x1.9ef3a1921efc4p+39, 0x0p+0, 0x1.2cb7c29555d49p+13, -0x1.548p-41 },
+        { 0x1.df519d53ad84p+37, 0x0p+0, 0x1.8d899b620a9a7p+12, -0x1.4d8p-42 },
+        { 0x1.729593bbb6e74p+39, 0x0p+0, 0x1.2197f6e827edfp+13, 0x1.ebp-41 },
+        { 0x1.a7af11d3b88e8p+38, 0x0p+0, 0x1.e0af5f7f68716p+12, -0x1.27p-43 },
+        { 0x1.0af82da629ab8p+38, 0x0p+0, 0x1.9c1915c1377d8p+12, -0x1.94p-43 },
+        { 0x1.3285d6b040e8p+36, 0x0p+0, 0x1.0fd72e577e345p+12, 0x1.c38p-42 },
+        { 0x1.0839e8032ba1p+38, 0x0p+0, 0x1.9aae7e8ed0ba6p+12, 0x1.5e8p-42 },
+        { -0x1.1d93e9a0fafp+37, 0x0p+0, -0x1.4e8305a20478bp+12, 0x1.74p-43 },
+        { -0x1.b87ccf1da33b8p+39, 0x0p+0, -0x1.32c39b56244dfp+13, -0x1.cbp-42 },
+        { -0x1.e37fbfaed62ep+37, 0x0p+0, -0x1.8eb099b5dec6p+12, -0x1.818p-42 },
+        { 0x1.1f9a7b1d0ceecp+39, 0x0p+0, 0x1.0a20e35ebc554p+13, -0x1.12p-43 },
+        { -0x1.ccec43e45a784p+39, 0x0p+0, -0x1.376fb9b5c81d7p+13, 0x1.4ep-41 },
+    } },
+    { "tanh", {
+        { -0x1.1e62bp-1, 0x0p+0, -0x1.03d60fab017bbp-1, 0x1.6ep-56 },
+        { -0x1.eb92dp+0, 0x0p+0, -0x1.ea76649eb604cp-1, 0x1.4d8p-55 },
+        { 0x1.bc1ba4p+1, 0x0p+0, 0x1.ff0236a3c72bp-1, 0x1.bb8p-55 },
+        { 0x1.cd27fp+0, 0x0p+0, 0x1.e4d69be675bdbp-1, 0x1.9e8p-55 },
+        { 0x1.3a12198p+3, 0x0p+0, 0x1.ffffffccb495cp-1, 0x1.03p-56 },
+        { 0x1.602a24p+2, 0x0p+0, 0x1.fffba4efefaebp-1, 0x1.7a8p-55 },
+        { 0x1.1093abp+3, 0x0p+0, 0x1.fffffd51f2e09p-1, 0x1.3a8p-55 },
+        { 0x1.c365bcp+1, 0x0p+0, 0x1.ff1d829388cb1p-1, 0x1.ffp-55 },
+        { 0x1.2c5beap+1, 0x0p+0, 0x1.f6b507c0607c3p-1, 0x1.ebp-56 },
+        { -0x1.1a468p-2, 0x0p+0, -0x1.13561bdb62d9bp-2, 0x1.298p-56 },
+        { 0x1.27fc8fp+3, 0x0p+0, 0x1.ffffff612b1e6p-1, 0x1.178p-55 },
+        { -0x1.c2001ep+1, 0x0p+0, -0x1.ff18843843992p-1, -0x1.ep-55 },
+        { -0x1.f987ebp+2, 0x0p+0, -0x1.fffff6c182f78p-1, 0x1.9e8p-55 },
+        { -0x1.42fc33p+2, 0x0p+0, -0x1.fff528bdbbe72p-1, -0x1.72p-57 },
+        { -0x1.ae758p-3, 0x0p+0, -0x1.a83ae9ac7ae96p-3, -0x1.56p-58 },
+        { -0x1.bf48abp+2, 0x0p+0, -0x1.ffffc6ef26c78p-1, 0x1.3c8p-55 },
+        { 0x1.1706d48p+3, 0x0p+0, 0x1.fffffe358e842p-1, -0x1.478p-55 },
+        { -0x1.dc0518p+2, 0x0p+0, -0x1.ffffe8c0993f2p-1, 0x1.cap-57 },
+        { -0x1.37c7b4p+0, 0x0p+0, -0x1.ad95770457552p-1, 0x1.73p-55 },
+        { -0x1.d2dcd6p+2, 0x0p+0, -0x1.ffffe10cd57ap-1, 0x1.fp-57 },
+        { 0x1.6ebbacp+1, 0x0p+0, 0x1.fcafb9e5599cap-1, 0x1.e78p-55 },
+        { -0x1.34f1808p+3, 0x0p+0, -0x1.ffffffb954128p-1, 0x1.988p-55 },
+        { -0x1.82b08ap+2, 0x0p+0, -0x1.fffe84e93abefp-1, -0x1.1cp-57 },
+        { -0x1.4c2e7p+2, 0x0p+0, -0x1.fff7dde932d2ep-1, 0x1.8d8p-55 },
+        { -0x1.15111p+0, 0x0p+0, -0x1.968d602c15a61p-1, -0x1.afp-55 },
+        { 0x1.00e51ep+3, 0x0p+0, 0x1.fffff8dbd6216p-1, -0x1.dfp-56 },
+        { -0x1.c2ba59p+2, 0x0p+0, -0x1.ffffccc1cccc1p-1, 0x1.d4p-58 },
+        { 0x1.b614a7p+2, 0x0p+0, 0x1.ffffb3eb25dd4p-1, -0x1.eb8p-55 },
+        { -0x1.852185p+2, 0x0p+0, -0x1.fffea0c1a9d9ap-1, -0x1.08p-56 },
+        { 0x1.20b35a8p+3, 0x0p+0, 0x1.ffffff058f88ep-1, 0x1.7ep-55 },
+        { 0x1.989c1p-2, 0x0p+0, 0x1.843853168560dp-2, -0x1.08p-59 },
+        { 0x1.2fc1478p+3, 0x0p+0, 0x1.ffffff9e42698p-1, -0x1.14p-55 },
+    } },
+    { "atan2", {
+        { 0x1.bb72ff8p+4, -0x1.0770cbcp+6, 0x1.5f23454286b96p+1, -0x1.e3p-54 },
+        { -0x1.f4bb35p+3, 0x1.959bb18p+4, -0x1.1b24a62ffa9c1p-1, 0x1.5p-58 },
+        { 0x1.803c5bp+3, 0x1.c260568p+4, 0x1.9ce0cd988f5dap-2, -0x1.888p-56 },
+        { -0x1.6bda7cp+4, -0x1.8ce15ep+5, -0x1.5b1bac15f423cp+1, 0x1.be8p-53 },
+        { 0x1.8309e5ap+6, -0x1.1753756p+6, 0x1.191482b24d72dp+1, -0x1.1b8p-53 },
+        { -0x1.ab532a8p+4, 0x1.7aa0facp+5, -0x1.070b91f97568bp-1, 0x1.38p-58 },
+        { -0x1.8a03652p+6, 0x1.a9b9028p+4, -0x1.4e95c9ee63b1bp+0, -0x1.44p-56 },
+        { -0x1.20a3bf8p+4, 0x1.23d5f92p+6, -0x1.f06f718fc16b2p-3, -0x1.8c8p-57 },
+        { 0x1.d2c0d7cp+5, -0x1.05949fcp+5, 0x1.0a72275ee862dp+1, -0x1.fp-53 },
+        { -0x1.0ef1ed2p+6, -0x1.c8aad6p+4, -0x1.f836adb51c715p+0, 0x1.2cp-55 },
+        { 0x1.34e878p+6, -0x1.594acccp+5, 0x1.0a4bdeb5c53f3p+1, 0x1.bbp-54 },
+        { 0x1.c9e004p+4, 0x1.7c6a8c4p+6, 0x1.2b4d031e822ebp-2, -0x1.f8p-57 },
+        { -0x1.0853364p+6, -0x1.c876ee8p+5, -0x1.243af2c8e47c3p+1, 0x1.6e8p-53 },
+        { 0x1.12b9cc2p+6, 0x1.ddf36b8p+4, 0x1.29193b48c51d8p+0, -0x1.fep-55 },
+        { 0x1.59134e8p+4, 0x1.e10d2b8p+4, 0x1.3e99ad6ff7849p-1, -0x1.dc8p-55 },
+        { -0x1.685fdcp+3, 0x1.3c2ad4ap+6, -0x1.21d7fabc3400cp-3, 0x1.65p-57 },
+        { -0x1.5d6c198p+5, 0x1.812f788p+6, -0x1.b40b4a2bb69adp-2, -0x1.9dp-56 },
+        { -0x1.7e2d224p+5, -0x1.7040d3cp+6, -0x1.54db18c789dd2p+1, -0x1p-60 },
+        { -0x1.64f86p+4, 0x1.4da5e44p+5, -0x1.f7012978564f8p-2, 0x1.d4p-57 },
+        { -0x1.a76522cp+5, -0x1.8452ecep+6, -0x1.523ca0deeebd6p+1, -0x1.a8p-53 },
+        { -0x1.070ea3ap+6, -0x1.adcd394p+5, -0x1.20bd5dbb0342dp+1, 0x1.6fp-54 },
+        { -0x1.72456aap+6, 0x1.7e298b8p+5, -0x1.1829a68001794p+0, 0x1.ep-59 },
+        { 0x1.7d1666p+6, 0x1.0608b9ap+6, 0x1.efd7e6aecac56p-1, -0x1.9ap-57 },
+        { 0x1.97444d8p+4, -0x1.d6bfd1p+4, 0x1.36d4dd0140076p+1, 0x1p-61 },
+        { 0x1.3c8af92p+6, 0x1.4f035acp+5, 0x1.15866764f7bbap+0, 0x1.4ap-56 },
+        { -0x1.f40aca8p+4, 0x1.0106ab6p+6, -0x1.cf8d1b6acb938p-2, -0x1.24p-59 },
+        { 0x1.359efdp+5, -0x1.3e6f81cp+5, 0x1.2f63a301eea19p+1, 0x1.f28p-53 },
+        { -0x1.ee66e5p+4, 0x1.0e95fecp+5, -0x1.7b04163f38d92p-1, -0x1.818p-55 },
+        { 0x1.7afd40ap+6, -0x1.2babc58p+6, 0x1.1eb352dba127dp+1, 0x1.6fp-54 },
+        { -0x1.def48p+0, 0x1.263e644p+6, -0x1.a09d339d7fc82p-6, 0x1.b58p-60 },
+        { 0x1.ce41d78p+5, 0x1.6269acep+6, 0x1.27e01ef0f72ddp-1, 0x1.b8p-58 },
+        { 0x1.7ddedccp+6, -0x1.234247cp+6, 0x1.1c7727c64f259p+1, -0x1.9cp-55 },
+    } },
+    { "pow", {
+        { 0x1.755a598cccccdp+0, -0x1.7706914p+6, 0x1.f1c76389898e9p-52, -0x1.cp-111 },
+        { 0x1.a19716770a3d7p+1, -0x1.076a11ep+6, 0x1.93cb23988fb3cp-113, 0x1.f3p-167 },
+        { 0x1.0e272ba147ae1p+0, 0x1.8a93414p+5, 0x1.c6c604b835b76p+3, -0x1.a5p-51 },
+        { 0x1.521fe30333333p+2, 0x1.e603bap+3, 0x1.633558eecd7e7p+36, -0x1.61p-19 },
+        { 0x1.1b736b31eb852p+2, 0x1.9fcc5c4p+5, 0x1.80ae186b1dfa1p+111, -0x1.28p+54 },
+        { 0x1.1e6b98651eb85p+2, 0x1.27d02p-2, 0x1.8aaf2f1572df8p+0, 0x1.bp-54 },
+        { 0x1.1b2479999999ap-1, 0x1.4d65128p+4, 0x1.247c756fb18e7p-18, 0x1.5dp-73 },
+        { 0x1.f91a91e851eb8p+2, -0x1.7f17ff4p+5, 0x1.361fbc58c6c49p-143, 0x1.b2p-199 },
+        { 0x1.71608f4a3d70ap+2, -0x1.cea11bp+3, 0x1.5af03b6d06985p-37, 0x1.5cp-93 },
+        { 0x1.26cafa2a3d70ap+1, -0x1.7d0775p+3, 0x1.970b73d0c29f5p-15, 0x1.77p-70 },
+        { 0x1.249fab2dc28f6p+3, -0x1.4751c64p+6, 0x1.a7349e4ba258cp-262, -0x1.b1p-316 },
+        { 0x1.4dfefc5999999p+2, -0x1.6ddcd0cp+5, 0x1.fb7fede649ffep-110, 0x1.96p-164 },
+        { 0x1.964370fe147aep+2, 0x1.8f085e4p+6, 0x1.f9ca45092442cp+265, 0x1.92p+210 },
+        { 0x1.a7e145d1eb852p+2, -0x1.6ff1a0cp+5, 0x1.77bd517005bcbp-126, 0x1.bdp-180 },
+        { 0x1.11b0900ae147bp+2, -0x1.2fdabe4p+5, 0x1.4bfffafc43f24p-80, -0x1.078p-134 },
+        { 0x1.1f39b2947ae14p+2, -0x1.e82811p+3, 0x1.f111e0fe3d5f8p-34, -0x1.6p-92 },
+        { 0x1.c0c1f4fae147bp-1, -0x1.1a27a4p+4, 0x1.473fb5c507c77p+3, 0x1.adp-52 },
+        { 0x1.3f32b01cccccdp+3, -0x1.c51e7p+3, 0x1.024b85e4aeac8p-47, 0x1.68p-103 },
+        { 0x1.cb12b398f5c29p+2, 0x1.e32a488p+5, 0x1.99fdf567e908ap+171, -0x1.d48p+117 },
+        { 0x1.43171cf5c28f6p-1, 0x1.9594facp+5, 0x1.40f4c34666167p-34, -0x1.fdp-89 },
+        { 0x1.21d5ae7ae147bp+0, 0x1.af77d5cp+5, 0x1.9427936b9c76ap+9, -0x1.48p-48 },
+        { 0x1.164dcadeb851ep+1, 0x1.91a9c8p+2, 0x1.05ce3aaef9301p+7, -0x1.3cp-50 },
+        { 0x1.4cbd8f37ae148p+2, 0x1.631c34p+1, 0x1.837b5209c6d7p+6, 0x1.c38p-48 },
+        { 0x1.39a291170a3d7p+1, 0x1.a316b8p+3, 0x1.e8c8fc30c915dp+16, -0x1.e8p-38 },
+        { 0x1.29e61e67ae147p+1, 0x1.23f4f78p+4, 0x1.2dd55d83b944p+22, 0x1.a68p-32 },
+        { 0x1.8461dd8ccccccp+1, 0x1.638f764p+6, 0x1.44a429b580618p+142, 0x1.9bp+87 },
+        { 0x1.cdba61ecccccdp+2, 0x1.0ae5834p+6, 0x1.2af58dfcc44adp+190, 0x1.91p+136 },
+        { 0x1.bd7ee24c28f5cp+2, -0x1.6c00b14p+6, 0x1.33918fb7afde8p-255, -0x1.46p-310 },
+        { 0x1.4857a0451eb85p+1, -0x1.2b360cp+6, 0x1.43c2402f91348p-102, -0x1.b6p-156 },
+        { 0x1.a6da9628f5c29p+1, 0x1.5aa83dp+6, 0x1.54474e00f7c9ap+149, 0x1.9ap+94 },
+        { 0x1.13567e71eb852p+1, 0x1.286e4dcp+5, 0x1.ed6eb9932eaacp+40, -0x1.6bp-14 },
+        { 0x1.d4840eb5c28f6p+0, -0x1.b5e2bbp+3, 0x1.0c66926480979p-12, -0x1.68p-66 },
+    } },
+    { "hypot", {
+        { 0x1.407bece90f44p+36, 0x1.adfeb3a33a9dp+38, 0x1.b5654df55d0a4p+38, 0x1.658p-16 },
+        { -0x1.00260e70b167p+38, -0x1.f6dc35ee6939p+37, 0x1.66ed8a23f3474p+38, -0x1.958p-16 },
+        { -0x1.97c743090fbe8p+39, 0x1.5ccba1c1fc03p+38, 0x1.bb8197240c89bp+39, 0x1.b5p-15 },
+        { 0x1.4efa52a0005ep+37, 0x1.dbaac4876de6p+38, 0x1.f84b12de70bacp+38, -0x1.07p-16 },
+        { 0x1.14fae0eb555fp+37, -0x1.6273b085b14d8p+38, 0x1.7c8be751be39dp+38, -0x1.48p-17 },
+        { -0x1.3355a4da431bcp+39, 0x1.bb88baab2d7cp+39, 0x1.0dcdd9d0d221p+40, -0x1.91p-15 },
+        { 0x1.bcd8d0de113c8p+39, -0x1.d8a2cc5590a3p+37, 0x1.cc45a3d40008p+39, -0x1.5c8p-15 },
+        { 0x1.131ff3aae3ccp+39, -0x1.53121a70c01acp+39, 0x1.b4a6389f64112p+39, 0x1.dbp-16 },
+        { 0x1.397dd3a24d944p+39, 0x1.25a6fb1cb7504p+39, 0x1.ad8b6c5a54d9bp+39, -0x1.d18p-15 },
+        { 0x1.d27b5373a71fp+38, -0x1.1427b0ea8d57cp+39, 0x1.69792709daeb5p+39, -0x1.8ep-15 },
+        { -0x1.66fb2e7d335b8p+39, -0x1.78aae6eab2e8p+35, 0x1.67c0950ffd0e5p+39, 0x1.308p-15 },
+        { -0x1.1d4ed1c69f588p+38, 0x1.0b5d96440e238p+38, 0x1.87014a4fbc20fp+38, -0x1.558p-16 },
+        { -0x1.befe769c9bbap+39, 0x1.2436235f4abb8p+39, 0x1.0b0437619db26p+40, -0x1.1p-15 },
+        { 0x1.3b240458ac1b8p+38, 0x1.197afb231a4bp+37, 0x1.5923c7bd9c79fp+38, 0x1.efp-16 },
+        { -0x1.32935e0b5836p+39, -0x1.b055cd8c54608p+38, 0x1.771f6aa3e84eap+39, -0x1.c6p-15 },
+        { 0x1.aaae03e7c016cp+39, 0x1.9f8949202781p+38, 0x1.da93adb5c04e7p+39, 0x1.86p-15 },
+        { 0x1.a2d74947aa94p+35, -0x1.69da97e46fddp+39, 0x1.6accada9df95fp+39, 0x1.88p-15 },
+        { -0x1.0ecbfd0309908p+39, 0x1.3a47356e8207p+38, 0x1.391654a84067fp+39, -0x1.09p-15 },
+        { 0x1.1bc7119d3540cp+39, 0x1.bfaeef0857028p+39, 0x1.09060cbbf4675p+40, -0x1.cc8p-14 },
+        { 0x1.2621ce29ba7dp+39, -0x1.29b3f26cfc5acp+39, 0x1.a27f85f5aa812p+39, 0x1.c4p-16 },
+        { -0x1.750f98286185p+38, -0x1.9d0c20b532e8p+36, 0x1.8316a38c42f78p+38, -0x1.228p-16 },
+        { -0x1.3520ecb08d178p+38, 0x1.ced08005155bp+37, 0x1.8225bb090cd15p+38, -0x1.b7p-16 },
+        { -0x1.fd7f6e554d8ep+37, -0x1.b76211e3b16d8p+38, 0x1.fbe4678ec249fp+38, 0x1.e8p-17 },
+        { 0x1.70acd2ba67ddp+38, 0x1.ade919e8ea61p+38, 0x1.1b2be7be6750ap+39, -0x1.5dp-15 },
+        { 0x1.9d82c28e0d3fp+39, -0x1.f539e6631acap+38, 0x1.e386d6d99043cp+39, -0x1.d2p-15 },
+        { -0x1.142345813b3ep+36, -0x1.f9dbc4714fa8p+38, 0x1.fe8c1ba730e25p+38, 0x1.acp-16 },
+        { 0x1.8a28e60e822dcp+39, 0x1.a37eeae0c1a9p+38, 0x1.be7e3c16fcd1ep+39, 0x1.3cp-17 },
+        { 0x1.79ed46774dd34p+39, -0x1.6a404944c7eap+39, 0x1.05c048f6b0aa9p+40, -0x1.e4p-15 },
+        { -0x1.22efc9305daa4p+39, -0x1.ae45fbbd4363p+37, 0x1.362f81d159d3ep+39, 0x1.48p-15 },
+        { -0x1.9aaf19c295a84p+39, 0x1.9bc97c0976fcp+36, 0x1.9de5ab3e5429p+39, -0x1.46p-17 },
+        { 0x1.0dbebfdd89e8p+38, 0x1.559981d7483cp+35, 0x1.111a95f5a918cp+38, 0x1.aap-16 },
+        { -0x1.ca1564e9fc01p+39, 0x1.d646033b6f3b8p+38, 0x1.01742c8b3fcaep+40, -0x1.edp-14 },
+    } },
+    { "fmod", {
+        { 0x1.068ae205ep+18, 0x1.2a05a74p+1, 0x1.0027d04p+1, 0x0p+0 },
+        { -0x1.cb673893fp+19, 0x1.108f988p+1, -0x1.c93136p-1, 0x0p+0 },
+        { -0x1.e87b9e1c8p+16, 0x1.7f441ap-1, -0x1.323a94p-1, 0x0p+0 },
+        { -0x1.8f93863fcp+17, 0x1.56819dp-1, -0x1.b078fap-2, 0x0p+0 },
+        { 0x1.49f04082cp+19, 0x1.7565658p+1, 0x1.4ce37ap+0, 0x0p+0 },
+        { 0x1.ac90daa19p+19, 0x1.22e03c2p+3, 0x1.772e89p+1, 0x0p+0 },
+        { 0x1.ac39625bbp+19, 0x1.6507f54p+2, 0x1.ae071p-1, 0x0p+0 },
+        { 0x1.395dbe0d6p+18, 0x1.3fe5a5dp+3, 0x1.d04024p-3, 0x0p+0 },
+        { 0x1.6a89db1ecp+18, 0x1.46a9784p+2, 0x1.b10a418p+1, 0x0p+0 },
+        { -0x1.c777b9443p+19, 0x1.0fa3734p+1, -0x1.de8b808p+0, 0x0p+0 },
+        { 0x1.28f1111c3p+19, 0x1.164205p+0, 0x1.50d7e2p-1, 0x0p+0 },
+        { 0x1.f6211aff4p+18, 0x1.1c2e50bp+3, 0x1.0aab032p+3, 0x0p+0 },
+        { -0x1.8995826cap+19, 0x1.1647e04p+1, -0x1.164c6ep-2, 0x0p+0 },
+        { -0x1.994d89caap+19, 0x1.18f71e3p+3, -0x1.19bd898p+0, 0x0p+0 },
+        { -0x1.6dc9034dep+18, 0x1.1c0b7p+1, -0x1.ad16p-4, 0x0p+0 },
+        { -0x1.d75549db2p+19, 0x1.16d5cf4p+3, -0x1.9be1788p+2, 0x0p+0 },
+        { -0x1.c88de2386p+19, 0x1.b7e1998p+0, -0x1.f65e4p-2, 0x0p+0 },
+        { -0x1.d64657373p+19, 0x1.10ef177p+3, -0x1.c2da1bp+2, 0x0p+0 },
+        { -0x1.aafb68888p+18, 0x1.2bae506p+3, -0x1.22e058cp+2, 0x0p+0 },
+        { 0x1.b4136e807p+19, 0x1.a9cd2fp+2, 0x1.2eaa5ap+2, 0x0p+0 },
+        { 0x1.34eda216bp+19, 0x1.0de3538p+3, 0x1.1aa5p-3, 0x0p+0 },
+        { -0x1.4199c004p+17, 0x1.1d379c3p+3, -0x1.e7c04p-6, 0x0p+0 },
+        { -0x1.92846ba4ap+18, 0x1.0295e62p+3, -0x1.a179c4p-2, 0x0p+0 },
+        { 0x1.509d7d5c5p+19, 0x1.4573bc8p+2, 0x1.068dd48p+2, 0x0p+0 },
+        { 0x1.08b2ddda9p+19, 0x1.e127fep+2, 0x1.515874p+2, 0x0p+0 },
+        { 0x1.f9be23c62p+18, 0x1.c8490e8p+1, 0x1.c308e8p-3, 0x0p+0 },
+        { -0x1.f7ca256cp+18, 0x1.d9db41cp+2, -0x1.97bbf4cp+2, 0x0p+0 },
+        { -0x1.ff42fa7bp+18, 0x1.fb9f37cp+2, -0x1.c809dd4p+2, 0x0p+0 },
+        { -0x1.4763f052cp+19, 0x1.69df376p+2, -0x1.acd2638p+1, 0x0p+0 },
+        { 0x1.30cd27dep+15, 0x1.07cd8fp+1, 0x1.2f7d48p-1, 0x0p+0 },
+        { -0x1.3971e385ep+19, 0x1.61a924p+1, -0x1.1fb988p+1, 0x0p+0 },
+        { -0x1.6f15e003p+19, 0x1.a69a14cp+1, -0x1.088f5c8p+1, 0x0p+0 },
+    } },
+};
@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+// Include sys/types.h before inttypes.h to work around issue with
+// certain versions of GCC and newlib which causes omission of PRIu64
+#include <sys/types.h>
+#include <inttypes.h>
+
+#include "pico/stdlib.h"
+#include "pico/hmac_sha256.h"
+
+#define PACKETS 1000
+#define PACKET_SIZE 64
+
+// RFC 4231 test cases
+static void run_hmac_test(void) {
+    pico_hmac_sha256_key_t key;
+    sha256_result_t result;
+
+    // test case 1
+    uint8_t key_1[20];
+    memset(key_1, 0x0b, sizeof(key_1));
+    const char *data_1 = "Hi There";
+    const uint8_t expected_1[] = { \
+        0xb0, 0x34, 0x4c, 0x61, 0xd8, 0xdb, 0x38, 0x53, 0x5c, 0xa8, \
+        0xaf, 0xce, 0xaf, 0x0b, 0xf1, 0x2b, 0x88, 0x1d, 0xc2, 0x00, \
+        0xc9, 0x83, 0x3d, 0xa7, 0x26, 0xe9, 0x37, 0x6c, 0x2e, 0x32, \
+        0xcf, 0xf7 };
+
+    int rc = pico_hmac_sha256_key_init(&key, key_1, sizeof(key_1));
+    hard_assert(rc == PICO_OK);
+    rc = pico_hmac_sha256(&key, (const uint8_t *)data_1, strlen(data_1), &result);
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(expected_1, result.bytes, SHA256_RESULT_BYTES) == 0);
+
+    // test case 2, with the message added in pieces
+    const char *key_2 = "Jefe";
+    const char *data_2 = "what do ya want for nothing?";
+    const uint8_t expected_2[] = { \
+        0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e, 0x6a, 0x04, \
+        0x24, 0x26, 0x08, 0x95, 0x75, 0xc7, 0x5a, 0x00, 0x3f, 0x08, \
+        0x9d, 0x27, 0x39, 0x83, 0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, \
+        0x38, 0x43 };
+
+    rc = pico_hmac_sha256_key_init(&key, (const uint8_t *)key_2, strlen(key_2));
+    hard_assert(rc == PICO_OK);
+    pico_hmac_sha256_state_t state;
+    rc = pico_hmac_sha256_start_blocking(&state, &key, false);
+    hard_assert(rc == PICO_OK);
+    pico_hmac_sha256_update(&state, (const uint8_t *)data_2, 10);
+    pico_hmac_sha256_update(&state, (const uint8_t *)data_2 + 10, strlen(data_2) - 10);
+    rc = pico_hmac_sha256_finish(&state, &result);
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(expected_2, result.bytes, SHA256_RESULT_BYTES) == 0);
+
+    // the key can be reused
+    rc = pico_hmac_sha256(&key, (const uint8_t *)data_2, strlen(data_2), &result);
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(expected_2, result.bytes, SHA256_RESULT_BYTES) == 0);
+
+    // test case 4
+    uint8_t key_4[25];
+    for (uint i = 0; i < sizeof(key_4); i++) key_4[i] = (uint8_t)(i + 1);
+    uint8_t data_4[50];
+    memset(data_4, 0xcd, sizeof(data_4));
+    const uint8_t expected_4[] = { \
+        0x82, 0x55, 0x8a, 0x38, 0x9a, 0x44, 0x3c, 0x0e, 0xa4, 0xcc, \
+        0x81, 0x98, 0x99, 0xf2, 0x08, 0x3a, 0x85, 0xf0, 0xfa, 0xa3, \
+        0xe5, 0x78, 0xf8, 0x07, 0x7a, 0x2e, 0x3f, 0xf4, 0x67, 0x29, \
+        0x66, 0x5b };
+
+    rc = pico_hmac_sha256_key_init(&key, key_4, sizeof(key_4));
+    hard_assert(rc == PICO_OK);
+    rc = pico_hmac_sha256(&key, data_4, sizeof(data_4), &result);
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(expected_4, result.bytes, SHA256_RESULT_BYTES) == 0);
+
+    // test case 6, a key longer than the block size
+    uint8_t key_6[131];
+    memset(key_6, 0xaa, sizeof(key_6));
+    const char *data_6 = "Test Using Larger Than Block-Size Key - Hash Key First";
+    const uint8_t expected_6[] = { \
+        0x60, 0xe4, 0x31, 0x59, 0x1e, 0xe0, 0xb6, 0x7f, 0x0d, 0x8a, \
+        0x26, 0xaa, 0xcb, 0xf5, 0xb7, 0x7f, 0x8e, 0x0b, 0xc6, 0x21, \
+        0x37, 0x28, 0xc5, 0x14, 0x05, 0x46, 0x04, 0x0f, 0x0e, 0xe3, \
+        0x7f, 0x54 };
+
+    rc = pico_hmac_sha256_key_init(&key, key_6, sizeof(key_6));
+    hard_assert(rc == PICO_OK);
+    rc = pico_hmac_sha256(&key, (const uint8_t *)data_6, strlen(data_6), &result);
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(expected_6, result.bytes, SHA256_RESULT_BYTES) == 0);
+}
+
+// RFC 5869 test cases 1 and 3
+static void run_hkdf_test(void) {
+    uint8_t ikm[22];
+    memset(ikm, 0x0b, sizeof(ikm));
+    uint8_t salt[13];
+    for (uint i = 0; i < sizeof(salt); i++) salt[i] = (uint8_t)i;
+    uint8_t info[10];
+    for (uint i = 0; i < sizeof(info); i++) info[i] = (uint8_t)(0xf0 + i);
+
+    const uint8_t prk_1_expected[] = { \
+        0x07, 0x77, 0x09, 0x36, 0x2c, 0x2e, 0x32, 0xdf, 0x0d, 0xdc, \
+        0x3f, 0x0d, 0xc4, 0x7b, 0xba, 0x63, 0x90, 0xb6, 0xc7, 0x3b, \
+        0xb5, 0x0f, 0x9c, 0x31, 0x22, 0xec, 0x84, 0x4a, 0xd7, 0xc2, \
+        0xb3, 0xe5 };
+    const uint8_t okm_1_expected[] = { \
+        0x3c, 0xb2, 0x5f, 0x25, 0xfa, 0xac, 0xd5, 0x7a, 0x90, 0x43, \
+        0x4f, 0x64, 0xd0, 0x36, 0x2f, 0x2a, 0x2d, 0x2d, 0x0a, 0x90, \
+        0xcf, 0x1a, 0x5a, 0x4c, 0x5d, 0xb0, 0x2d, 0x56, 0xec, 0xc4, \
+        0xc5, 0xbf, 0x34, 0x00, 0x72, 0x08, 0xd5, 0xb8, 0x87, 0x18, \
+        0x58, 0x65 };
+
+    sha256_result_t prk;
+    int rc = pico_hkdf_sha256_extract(salt, sizeof(salt), ikm, sizeof(ikm), &prk);
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(prk_1_expected, prk.bytes, SHA256_RESULT_BYTES) == 0);
+    pico_hmac_sha256_key_t prk_key;
+    rc = pico_hmac_sha256_key_init(&prk_key, prk.bytes, sizeof(prk.bytes));
+    hard_assert(rc == PICO_OK);
+    uint8_t okm[sizeof(okm_1_expected)];
+    rc = pico_hkdf_sha256_expand(&prk_key, info, sizeof(info), okm, sizeof(okm));
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(okm_1_expected, okm, sizeof(okm)) == 0);
+
+    // a shorter output is a prefix of a longer one
+    rc = pico_hkdf_sha256_expand(&prk_key, info, sizeof(info), okm, 7);
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(okm_1_expected, okm, 7) == 0);
+
+    rc = pico_hkdf_sha256_expand(&prk_key, info, sizeof(info), okm, 255 * SHA256_RESULT_BYTES + 1);
+    hard_assert(rc == PICO_ERROR_INVALID_ARG);
+
+    const uint8_t prk_3_expected[] = { \
+        0x19, 0xef, 0x24, 0xa3, 0x2c, 0x71, 0x7b, 0x16, 0x7f, 0x33, \
+        0xa9, 0x1d, 0x6f, 0x64, 0x8b, 0xdf, 0x96, 0x59, 0x67, 0x76, \
+        0xaf, 0xdb, 0x63, 0x77, 0xac, 0x43, 0x4c, 0x1c, 0x29, 0x3c, \
+        0xcb, 0x04 };
+    const uint8_t okm_3_expected[] = { \
+        0x8d, 0xa4, 0xe7, 0x75, 0xa5, 0x63, 0xc1, 0x8f, 0x71, 0x5f, \
+        0x80, 0x2a, 0x06, 0x3c, 0x5a, 0x31, 0xb8, 0xa1, 0x1f, 0x5c, \
+        0x5e, 0xe1, 0x87, 0x9e, 0xc3, 0x45, 0x4e, 0x5f, 0x3c, 0x73, \
+        0x8d, 0x2d, 0x9d, 0x20, 0x13, 0x95, 0xfa, 0xa4, 0xb6, 0x1a, \
+        0x96, 0xc8 };
+
+    rc = pico_hkdf_sha256_extract(NULL, 0, ikm, sizeof(ikm), &prk);
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(prk_3_expected, prk.bytes, SHA256_RESULT_BYTES) == 0);
+    rc = pico_hmac_sha256_key_init(&prk_key, prk.bytes, sizeof(prk.bytes));
+    hard_assert(rc == PICO_OK);
+    rc = pico_hkdf_sha256_expand(&prk_key, NULL, 0, okm, sizeof(okm));
+    hard_assert(rc == PICO_OK);
+    hard_assert(memcmp(okm_3_expected, okm, sizeof(okm)) == 0);
+}
+
+// authenticating many small packets with a prepared key, and preparing the key for each one
+static void run_benchmark(void) {
+    static uint8_t packet[PACKET_SIZE];
+    const char *secret = "telemetry link key";
+    pico_hmac_sha256_key_t key;
+    sha256_result_t prepared, result;
+
+    uint64_t start = time_us_64();
+    pico_hmac_sha256_key_init(&key, (const uint8_t *)secret, strlen(secret));
+    for (uint i = 0; i < PACKETS; i++) {
+        packet[0] = (uint8_t)i;
+        pico_hmac_sha256(&key, packet, sizeof(packet), &prepared);
+    }
+    printf("Pico time for HMAC-SHA256 of %d %d byte packets with a prepared key %"PRIu64"us\n", PACKETS, PACKET_SIZE, time_us_64() - start);
+
+    start = time_us_64();
+    for (uint i = 0; i < PACKETS; i++) {
+        packet[0] = (uint8_t)i;
+        pico_hmac_sha256_key_init(&key, (const uint8_t *)secret, strlen(secret));
+        pico_hmac_sha256(&key, packet, sizeof(packet), &result);
+    }
+    printf("Pico time for HMAC-SHA256 of %d %d byte packets preparing the key each time %"PRIu64"us\n", PACKETS, PACKET_SIZE, time_us_64() - start);
+    hard_assert(memcmp(prepared.bytes, result.bytes, SHA256_RESULT_BYTES) == 0);
+}
+
+int main() {
+    stdio_init_all();
+
+    run_hmac_test();
+    run_hkdf_test();
+    run_benchmark();
+
+    printf("Test passed\n");
+}
@@ -0,0 +1,202 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/kvstore.h"
+
+PICOTEST_MODULE_NAME("pico_kvstore_test", "pico_kvstore test harness");
+
+#define SECTOR_SIZE 1024
+#define SECTOR_COUNT 6
+#define NUM_KEYS 16
+#define MAX_VALUE 100
+
+static uint8_t flash_buffer[SECTOR_SIZE * SECTOR_COUNT] __attribute__((aligned(4)));
+static kvstore_ram_flash_t ram;
+static kvstore_index_entry_t index_entries[32];
+static kvstore_t kv;
+
+// what the store should hold; a length of -1 means the key is not present
+static uint8_t model[NUM_KEYS][MAX_VALUE];
+static int model_len[NUM_KEYS];
+
+static uint32_t rand_state = 0x12345678;
+
+static uint32_t next_rand(void) {
+    rand_state ^= rand_state << 13;
+    rand_state ^= rand_state >> 17;
+    rand_state ^= rand_state << 5;
+    return rand_state;
+}
+
+static void key_name(char *key, uint k) {
+    sprintf(key, "key%u", k);
+}
+
+static bool value_is(uint k, const uint8_t *value, int len) {
+    char key[8];
+    uint8_t buf[MAX_VALUE];
+    key_name(key, k);
+    int rc = kvstore_get(&kv, key, buf, sizeof(buf));
+    if (len < 0) return rc == PICO_ERROR_NOT_FOUND;
+    return rc == len && !memcmp(buf, value, (size_t)len);
+}
+
+static bool matches_model(void) {
+    uint count = 0;
+    for (uint k = 0; k < NUM_KEYS; k++) {
+        if (!value_is(k, model[k], model_len[k])) {
+            printf("key%u does not match\n", k);
+            return false;
+        }
+        count += model_len[k] >= 0;
+    }
+    return kvstore_get_key_count(&kv) == count;
+}
+
+static bool count_key(__unused const char *key, __unused uint key_len, __unused const void *value, __unused size_t len,
+                      void *user_data) {
+    (*(uint *)user_data)++;
+    return true;
+}
+
+int main(void) {
+    stdio_init_all();
+    PICOTEST_START();
+
+    kvstore_ram_flash_init(&ram, flash_buffer, SECTOR_SIZE, SECTOR_COUNT);
+
+    PICOTEST_START_SECTION("basic");
+        PICOTEST_CHECK_AND_ABORT(kvstore_init(&kv, &ram.flash, index_entries, count_of(index_entries)) == PICO_OK, "init failed");
+        PICOTEST_CHECK(kvstore_get_key_count(&kv) == 0, "blank store not empty");
+        char buf[16];
+        PICOTEST_CHECK(kvstore_set(&kv, "hello", "world", 5) == PICO_OK, "set failed");
+        PICOTEST_CHECK(kvstore_get(&kv, "hello", buf, sizeof(buf)) == 5 && !memcmp(buf, "world", 5), "get failed");
+        size_t len;
+        const char *p = (const char *)kvstore_get_pointer(&kv, "hello", &len);
+        PICOTEST_CHECK(p && len == 5 && !memcmp(p, "world", 5), "get_pointer failed");
+        PICOTEST_CHECK(p >= (const char *)flash_buffer && p < (const char *)flash_buffer + sizeof(flash_buffer), "value not read from flash");
+        uint32_t programs = ram.program_count;
+        PICOTEST_CHECK(kvstore_set(&kv, "hello", "world", 5) == PICO_OK, "set of same value failed");
+        PICOTEST_CHECK(ram.program_count == programs, "same value written again");
+        // a record is programmed with one operation for each 256 byte page it touches
+        static uint8_t long_value[200];
+        uint32_t start = kv.head_offset;
+        programs = ram.program_count;
+        PICOTEST_CHECK(kvstore_set(&kv, "long", long_value, sizeof(long_value)) == PICO_OK, "set failed");
+        PICOTEST_CHECK(ram.program_count - programs == (kv.head_offset - 1) / 256 - start / 256 + 1, "record programmed in pieces");
+        PICOTEST_CHECK(kvstore_delete(&kv, "long") == PICO_OK, "delete failed");
+        PICOTEST_CHECK(kvstore_set(&kv, "hello", "there", 5) == PICO_OK, "update failed");
+        PICOTEST_CHECK(kvstore_set(&kv, "empty", NULL, 0) == PICO_OK, "set of empty value failed");
+        PICOTEST_CHECK(kvstore_get(&kv, "empty", buf, sizeof(buf)) == 0, "get of empty value failed");
+        PICOTEST_CHECK(kvstore_set(&kv, "", "x", 1) == PICO_ERROR_INVALID_ARG, "empty key accepted");
+        PICOTEST_CHECK(kvstore_set(&kv, "a_key_which_is_much_too_long_to_be_stored", "x", 1) == PICO_ERROR_INVALID_ARG, "long key accepted");
+        PICOTEST_CHECK(kvstore_set(&kv, "big", flash_buffer, SECTOR_SIZE) == PICO_ERROR_INVALID_ARG, "oversized value accepted");
+        PICOTEST_CHECK(kvstore_get(&kv, "missing", buf, sizeof(buf)) == PICO_ERROR_NOT_FOUND, "missing key found");
+        PICOTEST_CHECK(kvstore_get(&kv, "hello", buf, 2) == 5 && !memcmp(buf, "th", 2), "truncated get failed");
+        uint count = 0;
+        kvstore_for_each(&kv, count_key, &count);
+        PICOTEST_CHECK(count == 2, "wrong number of keys iterated");
+
+        PICOTEST_CHECK_AND_ABORT(kvstore_init(&kv, &ram.flash, index_entries, count_of(index_entries)) == PICO_OK, "reopen failed");
+        PICOTEST_CHECK(kvstore_get(&kv, "hello", buf, sizeof(buf)) == 5 && !memcmp(buf, "there", 5), "value not kept");
+        PICOTEST_CHECK(kvstore_delete(&kv, "hello") == PICO_OK, "delete failed");
+        PICOTEST_CHECK(kvstore_delete(&kv, "hello") == PICO_ERROR_NOT_FOUND, "deleted key deleted again");
+        PICOTEST_CHECK(kvstore_get(&kv, "hello", buf, sizeof(buf)) == PICO_ERROR_NOT_FOUND, "deleted key found");
+        PICOTEST_CHECK_AND_ABORT(kvstore_init(&kv, &ram.flash, index_entries, count_of(index_entries)) == PICO_OK, "reopen failed");
+        PICOTEST_CHECK(kvstore_get(&kv, "hello", buf, sizeof(buf)) == PICO_ERROR_NOT_FOUND, "deleted key found after reopen");
+        PICOTEST_CHECK(kvstore_get_key_count(&kv) == 1, "wrong key count after reopen");
+        PICOTEST_CHECK(kvstore_init(&kv, &ram.flash, index_entries, 0) == PICO_ERROR_BUFFER_TOO_SMALL, "index overflow not detected");
+        PICOTEST_CHECK(kvstore_format(&kv) == PICO_OK, "format failed");
+        PICOTEST_CHECK_AND_ABORT(kvstore_init(&kv, &ram.flash, index_entries, count_of(index_entries)) == PICO_OK, "reopen failed");
+        PICOTEST_CHECK(kvstore_get_key_count(&kv) == 0, "formatted store not empty");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("garbage collection");
+        static uint8_t value[200];
+        PICOTEST_CHECK(kvstore_set(&kv, "fixed", "constant", 8) == PICO_OK, "set failed");
+        uint32_t erases = ram.erase_count;
+        for (uint i = 0; i < 1000; i++) {
+            for (uint j = 0; j < sizeof(value); j++) value[j] = (uint8_t)(i + j);
+            PICOTEST_CHECK_AND_ABORT(kvstore_set(&kv, "churn", value, sizeof(value)) == PICO_OK, "set failed");
+        }
+        uint8_t readback[sizeof(value)];
+        PICOTEST_CHECK(kvstore_get(&kv, "churn", readback, sizeof(readback)) == sizeof(value) && !memcmp(readback, value, sizeof(value)), "wrong value after churn");
+        // each sector holds 4 of the values, so should have been erased about 1000 / 4 / SECTOR_COUNT times
+        PICOTEST_CHECK(ram.erase_count - erases >= 1000 / 4 - SECTOR_COUNT, "too few erases");
+        PICOTEST_CHECK_AND_ABORT(kvstore_init(&kv, &ram.flash, index_entries, count_of(index_entries)) == PICO_OK, "reopen failed");
+        PICOTEST_CHECK(kvstore_get(&kv, "churn", readback, sizeof(readback)) == sizeof(value) && !memcmp(readback, value, sizeof(value)), "wrong value after reopen");
+        char buf[16];
+        PICOTEST_CHECK(kvstore_get(&kv, "fixed", buf, sizeof(buf)) == 8 && !memcmp(buf, "constant", 8), "value lost by garbage collection");
+
+        // fill the store
+        int rc = PICO_OK;
+        uint n;
+        for (n = 0; n < count_of(index_entries) && rc == PICO_OK; n++) {
+            char key[8];
+            key_name(key, n);
+            rc = kvstore_set(&kv, key, value, sizeof(value));
+        }
+        PICOTEST_CHECK(rc == PICO_ERROR_INSUFFICIENT_RESOURCES, "full store not detected");
+        PICOTEST_CHECK_AND_ABORT(kvstore_init(&kv, &ram.flash, index_entries, count_of(index_entries)) == PICO_OK, "reopen failed");
+        PICOTEST_CHECK(kvstore_get_key_count(&kv) == n + 1, "wrong key count when full");
+        PICOTEST_CHECK(kvstore_delete(&kv, "churn") == PICO_OK, "delete from full store failed");
+        PICOTEST_CHECK(kvstore_format(&kv) == PICO_OK, "format failed");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("power loss");
+        for (uint k = 0; k < NUM_KEYS; k++) model_len[k] = -1;
+        uint cuts = 0;
+        for (uint i = 0; i < 5000; i++) {
+            uint k = next_rand() % NUM_KEYS;
+            char key[8];
+            key_name(key, k);
+            bool del = !(next_rand() % 5);
+            uint8_t new_value[MAX_VALUE];
+            int new_len = del ? -1 : (int)(next_rand() % MAX_VALUE);
+            for (int j = 0; j < new_len; j++) new_value[j] = (uint8_t)next_rand();
+            if (!(next_rand() % 4)) kvstore_ram_flash_cut_power_after(&ram, (int32_t)(next_rand() % 256));
+            int rc = del ? kvstore_delete(&kv, key) : kvstore_set(&kv, key, new_value, (size_t)new_len);
+            kvstore_ram_flash_cut_power_after(&ram, -1);
+            if (ram.powered_off) {
+                cuts++;
+                // power may be lost again while recovering
+                do {
+                    kvstore_ram_flash_power_on(&ram);
+                    if (next_rand() % 2) kvstore_ram_flash_cut_power_after(&ram, (int32_t)(next_rand() % 3000));
+                    rc = kvstore_init(&kv, &ram.flash, index_entries, count_of(index_entries));
+                } while (ram.powered_off);
+                kvstore_ram_flash_cut_power_after(&ram, -1);
+                PICOTEST_CHECK_AND_ABORT(rc == PICO_OK, "reopen after power loss failed");
+                if (value_is(k, new_value, new_len)) {
+                    model_len[k] = new_len;
+                    if (new_len > 0) memcpy(model[k], new_value, (size_t)new_len);
+                }
+                PICOTEST_CHECK_AND_ABORT(matches_model(), "store corrupted by power loss");
+            } else {
+                if (del && model_len[k] < 0) {
+                    PICOTEST_CHECK_AND_ABORT(rc == PICO_ERROR_NOT_FOUND, "delete of missing key did not fail");
+                } else {
+                    PICOTEST_CHECK_AND_ABORT(rc == PICO_OK, "operation failed");
+                }
+                model_len[k] = new_len;
+                if (new_len > 0) memcpy(model[k], new_value, (size_t)new_len);
+            }
+            if (!(i % 256)) {
+                PICOTEST_CHECK_AND_ABORT(kvstore_init(&kv, &ram.flash, index_entries, count_of(index_entries)) == PICO_OK, "reopen failed");
+                PICOTEST_CHECK_AND_ABORT(matches_model(), "store does not match after reopen");
+            }
+        }
+        PICOTEST_CHECK(matches_model(), "store does not match");
+        PICOTEST_CHECK(cuts > 250, "too few power cuts");
+        printf("survived %u power cuts\n", cuts);
+    PICOTEST_END_SECTION();
+
+    PICOTEST_END_TEST();
+}
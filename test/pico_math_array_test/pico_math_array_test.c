@@ -0,0 +1,164 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/math_array.h"
+
+PICOTEST_MODULE_NAME("pico_math_array_test", "pico_math_array test harness");
+
+// the reference expressions must not be contracted into fused multiply-adds either
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#define COUNT 257
+
+static float fin[COUNT], fpos[COUNT], fa[COUNT], fb[COUNT], fout[COUNT], fout2[COUNT];
+static double din[COUNT], dpos[COUNT], da[COUNT], db[COUNT], dout[COUNT], dout2[COUNT];
+
+// error of f in units of the last place of the (more precise) reference; values of the reference smaller in magnitude
+// than floor are treated as floor, to turn the error near zero crossings into an absolute error
+static double float_ulp_error(float f, double ref, double floor) {
+    double scale = fmax(fabs(ref), floor);
+    int e;
+    frexp(scale, &e);
+    return fabs((double)f - ref) / ldexp(1.0, e - 24);
+}
+
+static bool float_array_equal(const float *a, const float *b, size_t count) {
+    return !memcmp(a, b, count * sizeof(float));
+}
+
+static bool double_array_equal(const double *a, const double *b, size_t count) {
+    return !memcmp(a, b, count * sizeof(double));
+}
+
+#define MAX_FLOAT_ULP_ERROR 4.0
+
+int main(void) {
+    stdio_init_all();
+    PICOTEST_START();
+
+    for (uint i = 0; i < COUNT; i++) {
+        // -4pi..4pi, plus strictly positive values spanning a few orders of magnitude
+        din[i] = (i - COUNT / 2.0) * (4 * M_PI / (COUNT / 2.0)) + 0.001;
+        dpos[i] = ldexp(1.0 + i / (double)COUNT, (int)(i % 41) - 20);
+        da[i] = (i * 37 % 101) / 7.0 - 5.0;
+        db[i] = (i * 53 % 97) / 11.0 - 3.0;
+        fin[i] = (float)din[i];
+        fpos[i] = (float)dpos[i];
+        fa[i] = (float)da[i];
+        fb[i] = (float)db[i];
+    }
+
+    PICOTEST_START_SECTION("float arrays match scalar functions");
+        for (uint i = 0; i < COUNT; i++) fout2[i] = sinf(fin[i]);
+        float_sin_array(fout, fin, COUNT);
+        PICOTEST_CHECK(float_array_equal(fout, fout2, COUNT), "float_sin_array mismatch");
+        for (uint i = 0; i < COUNT; i++) fout2[i] = cosf(fin[i]);
+        float_cos_array(fout, fin, COUNT);
+        PICOTEST_CHECK(float_array_equal(fout, fout2, COUNT), "float_cos_array mismatch");
+        for (uint i = 0; i < COUNT; i++) fout2[i] = expf(fin[i]);
+        float_exp_array(fout, fin, COUNT);
+        PICOTEST_CHECK(float_array_equal(fout, fout2, COUNT), "float_exp_array mismatch");
+        for (uint i = 0; i < COUNT; i++) fout2[i] = logf(fpos[i]);
+        float_log_array(fout, fpos, COUNT);
+        PICOTEST_CHECK(float_array_equal(fout, fout2, COUNT), "float_log_array mismatch");
+        for (uint i = 0; i < COUNT; i++) fout2[i] = sqrtf(fpos[i]);
+        float_sqrt_array(fout, fpos, COUNT);
+        PICOTEST_CHECK(float_array_equal(fout, fout2, COUNT), "float_sqrt_array mismatch");
+        for (uint i = 0; i < COUNT; i++) fout2[i] = fa[i] * 1.5f - 0.25f;
+        float_scale_array(fout, fa, 1.5f, -0.25f, COUNT);
+        PICOTEST_CHECK(float_array_equal(fout, fout2, COUNT), "float_scale_array mismatch");
+        for (uint i = 0; i < COUNT; i++) fout2[i] = fa[i] * fb[i] + fin[i];
+        float_mul_add_array(fout, fa, fb, fin, COUNT);
+        PICOTEST_CHECK(float_array_equal(fout, fout2, COUNT), "float_mul_add_array mismatch");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("float accuracy");
+        double max_sin = 0, max_cos = 0, max_exp = 0, max_log = 0;
+        float_sincos_array(fout, fout2, fin, COUNT);
+        for (uint i = 0; i < COUNT; i++) {
+            max_sin = fmax(max_sin, float_ulp_error(fout[i], sin((double)fin[i]), 0.5));
+            max_cos = fmax(max_cos, float_ulp_error(fout2[i], cos((double)fin[i]), 0.5));
+        }
+        float_exp_array(fout, fin, COUNT);
+        float_log_array(fout2, fpos, COUNT);
+        for (uint i = 0; i < COUNT; i++) {
+            max_exp = fmax(max_exp, float_ulp_error(fout[i], exp((double)fin[i]), 0));
+            max_log = fmax(max_log, float_ulp_error(fout2[i], log((double)fpos[i]), 0.5));
+        }
+        printf("max ulp error: sin %g cos %g exp %g log %g\n", max_sin, max_cos, max_exp, max_log);
+        PICOTEST_CHECK(max_sin <= MAX_FLOAT_ULP_ERROR, "float_sincos_array sine inaccurate");
+        PICOTEST_CHECK(max_cos <= MAX_FLOAT_ULP_ERROR, "float_sincos_array cosine inaccurate");
+        PICOTEST_CHECK(max_exp <= MAX_FLOAT_ULP_ERROR, "float_exp_array inaccurate");
+        PICOTEST_CHECK(max_log <= MAX_FLOAT_ULP_ERROR, "float_log_array inaccurate");
+        // square root is correctly rounded
+        float_sqrt_array(fout, fpos, COUNT);
+        for (uint i = 0; i < COUNT; i++) {
+            PICOTEST_CHECK_AND_ABORT(fout[i] == (float)sqrt((double)fpos[i]), "float_sqrt_array not correctly rounded");
+        }
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("double arrays match scalar functions");
+        for (uint i = 0; i < COUNT; i++) dout2[i] = sin(din[i]);
+        double_sin_array(dout, din, COUNT);
+        PICOTEST_CHECK(double_array_equal(dout, dout2, COUNT), "double_sin_array mismatch");
+        for (uint i = 0; i < COUNT; i++) dout2[i] = cos(din[i]);
+        double_cos_array(dout, din, COUNT);
+        PICOTEST_CHECK(double_array_equal(dout, dout2, COUNT), "double_cos_array mismatch");
+        for (uint i = 0; i < COUNT; i++) dout2[i] = exp(din[i]);
+        double_exp_array(dout, din, COUNT);
+        PICOTEST_CHECK(double_array_equal(dout, dout2, COUNT), "double_exp_array mismatch");
+        for (uint i = 0; i < COUNT; i++) dout2[i] = log(dpos[i]);
+        double_log_array(dout, dpos, COUNT);
+        PICOTEST_CHECK(double_array_equal(dout, dout2, COUNT), "double_log_array mismatch");
+        for (uint i = 0; i < COUNT; i++) dout2[i] = sqrt(dpos[i]);
+        double_sqrt_array(dout, dpos, COUNT);
+        PICOTEST_CHECK(double_array_equal(dout, dout2, COUNT), "double_sqrt_array mismatch");
+        for (uint i = 0; i < COUNT; i++) dout2[i] = da[i] * 1.5 - 0.25;
+        double_scale_array(dout, da, 1.5, -0.25, COUNT);
+        PICOTEST_CHECK(double_array_equal(dout, dout2, COUNT), "double_scale_array mismatch");
+        for (uint i = 0; i < COUNT; i++) dout2[i] = da[i] * db[i] + din[i];
+        double_mul_add_array(dout, da, db, din, COUNT);
+        PICOTEST_CHECK(double_array_equal(dout, dout2, COUNT), "double_mul_add_array mismatch");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("double accuracy");
+        // no more precise reference is available on device, so check identities instead
+        double_sincos_array(dout, dout2, din, COUNT);
+        for (uint i = 0; i < COUNT; i++) {
+            PICOTEST_CHECK_AND_ABORT(fabs(dout[i] * dout[i] + dout2[i] * dout2[i] - 1.0) < 1e-15, "double_sincos_array inaccurate");
+        }
+        double_log_array(dout, dpos, COUNT);
+        double_exp_array(dout2, dout, COUNT);
+        for (uint i = 0; i < COUNT; i++) {
+            PICOTEST_CHECK_AND_ABORT(fabs(dout2[i] - dpos[i]) <= 1e-14 * dpos[i], "double_exp_array/double_log_array inaccurate");
+        }
+        double_sqrt_array(dout, dpos, COUNT);
+        for (uint i = 0; i < COUNT; i++) {
+            PICOTEST_CHECK_AND_ABORT(fabs(dout[i] * dout[i] - dpos[i]) <= 2.5e-16 * dpos[i], "double_sqrt_array inaccurate");
+        }
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("in place");
+        memcpy(fout, fa, sizeof(fout));
+        float_mul_add_array(fout, fout, fout, fout, COUNT);
+        for (uint i = 0; i < COUNT; i++) fout2[i] = fa[i] * fa[i] + fa[i];
+        PICOTEST_CHECK(float_array_equal(fout, fout2, COUNT), "in place float_mul_add_array mismatch");
+        memcpy(dout, din, sizeof(dout));
+        double_sin_array(dout, dout, COUNT);
+        for (uint i = 0; i < COUNT; i++) dout2[i] = sin(din[i]);
+        PICOTEST_CHECK(double_array_equal(dout, dout2, COUNT), "in place double_sin_array mismatch");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_END_TEST();
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/pio_blob.h"
+#include "blob_test.pio.h"
+#include "blob_test.blob.h"
+
+PICOTEST_MODULE_NAME("PIO_BLOB", "pico_pio_blob test");
+
+// room for both blobs one after another, as in pioasm's "bin" output, plus a spare header's worth for the tests
+// which grow one
+static uint8_t __attribute__((aligned(4))) buffer[sizeof(blob_test_program_blob) + sizeof(blob_fixed_program_blob) + 32];
+
+// a one instruction program (a nop) at blob_fixed's origin, to check whether that instruction memory is in use
+static const uint16_t probe_instructions[] = {0xa042};
+static const pio_program_t probe_program = {
+    .instructions = probe_instructions,
+    .length = 1,
+    .origin = 4,
+};
+
+static bool same_program(const pio_program_t *a, const pio_program_t *b) {
+    return a->length == b->length && a->origin == b->origin && a->pio_version == b->pio_version &&
+#if PICO_PIO_VERSION > 0
+           a->used_gpio_ranges == b->used_gpio_ranges &&
+#endif
+           !memcmp(a->instructions, b->instructions, a->length * sizeof(uint16_t));
+}
+
+static bool same_config(const pio_sm_config *a, const pio_sm_config *b) {
+    return !memcmp(a, b, sizeof(pio_sm_config));
+}
+
+// parse a copy of blob_test_program_blob with one header byte changed
+static int parse_corrupted(uint index, uint8_t value) {
+    pio_blob_program_t program;
+    memcpy(buffer, blob_test_program_blob, sizeof(blob_test_program_blob));
+    buffer[index] = value;
+    return pio_blob_parse(buffer, sizeof(blob_test_program_blob), &program);
+}
+
+int main() {
+    setup_default_uart();
+
+    PICOTEST_START();
+
+    pio_blob_program_t program;
+    int rc;
+
+    PICOTEST_START_SECTION("Blobs match the c-sdk output");
+        rc = pio_blob_parse(blob_test_program_blob, sizeof(blob_test_program_blob), &program);
+        PICOTEST_CHECK(rc == (int)sizeof(blob_test_program_blob), "Failed to parse blob_test");
+        PICOTEST_CHECK(same_program(&program.program, &blob_test_program), "blob_test program differs");
+        for (uint offset = 0; offset < 4; offset++) {
+            pio_sm_config blob_config = pio_blob_get_default_config(&program, offset);
+            pio_sm_config c = blob_test_program_get_default_config(offset);
+            PICOTEST_CHECK(same_config(&blob_config, &c), "blob_test config differs");
+        }
+        rc = pio_blob_parse(blob_fixed_program_blob, sizeof(blob_fixed_program_blob), &program);
+        PICOTEST_CHECK(rc == (int)sizeof(blob_fixed_program_blob), "Failed to parse blob_fixed");
+        PICOTEST_CHECK(same_program(&program.program, &blob_fixed_program), "blob_fixed program differs");
+        pio_sm_config blob_config = pio_blob_get_default_config(&program, 4);
+        pio_sm_config c = blob_fixed_program_get_default_config(4);
+        PICOTEST_CHECK(same_config(&blob_config, &c), "blob_fixed config differs");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Consecutive blobs");
+        memcpy(buffer, blob_test_program_blob, sizeof(blob_test_program_blob));
+        memcpy(buffer + sizeof(blob_test_program_blob), blob_fixed_program_blob, sizeof(blob_fixed_program_blob));
+        uint size = sizeof(blob_test_program_blob) + sizeof(blob_fixed_program_blob);
+        rc = pio_blob_parse(buffer, size, &program);
+        PICOTEST_CHECK_AND_ABORT(rc > 0 && (uint)rc < size, "Failed to parse the first blob");
+        PICOTEST_CHECK(same_program(&program.program, &blob_test_program), "First program differs");
+        uint next = (uint)rc;
+        rc = pio_blob_parse(buffer + next, size - next, &program);
+        PICOTEST_CHECK(rc > 0 && next + (uint)rc == size, "Failed to parse the second blob");
+        PICOTEST_CHECK(same_program(&program.program, &blob_fixed_program), "Second program differs");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Corrupt blobs are rejected");
+        PICOTEST_CHECK(parse_corrupted(0, 'X') == PICO_ERROR_INVALID_DATA, "Bad magic accepted");
+        PICOTEST_CHECK(parse_corrupted(4, 0) == PICO_ERROR_INVALID_DATA, "Format version 0 accepted");
+        PICOTEST_CHECK(parse_corrupted(4, PIO_BLOB_VERSION + 1) == PICO_ERROR_VERSION_MISMATCH, "Later format version accepted");
+        PICOTEST_CHECK(parse_corrupted(5, PIO_BLOB_MIN_HEADER_SIZE - 2) == PICO_ERROR_INVALID_DATA, "Short header accepted");
+        PICOTEST_CHECK(parse_corrupted(5, PIO_BLOB_MIN_HEADER_SIZE + 1) == PICO_ERROR_INVALID_DATA, "Odd header size accepted");
+        PICOTEST_CHECK(parse_corrupted(6, 0) == PICO_ERROR_INVALID_DATA, "Empty program accepted");
+        PICOTEST_CHECK(parse_corrupted(6, PIO_INSTRUCTION_COUNT + 1) == PICO_ERROR_INVALID_DATA, "Over long program accepted");
+        PICOTEST_CHECK(parse_corrupted(6, blob_test_program.length + 1) == PICO_ERROR_INVALID_DATA, "Truncated blob accepted");
+        PICOTEST_CHECK(parse_corrupted(7, PIO_INSTRUCTION_COUNT - 1) == PICO_ERROR_INVALID_DATA, "Origin past the end accepted");
+        PICOTEST_CHECK(parse_corrupted(7, (uint8_t)-2) == PICO_ERROR_INVALID_DATA, "Negative origin accepted");
+        PICOTEST_CHECK(parse_corrupted(9, blob_test_program.length) == PICO_ERROR_INVALID_DATA, "Bad .wrap_target accepted");
+        PICOTEST_CHECK(parse_corrupted(10, blob_test_program.length) == PICO_ERROR_INVALID_DATA, "Bad .wrap accepted");
+        PICOTEST_CHECK(parse_corrupted(11, 0x86) == PICO_ERROR_INVALID_DATA, "Bad side-set bit count accepted");
+        PICOTEST_CHECK(pio_blob_parse(blob_test_program_blob, PIO_BLOB_MIN_HEADER_SIZE - 1, &program) == PICO_ERROR_INVALID_DATA,
+                       "Truncated header accepted");
+        memcpy(buffer + 2, blob_test_program_blob, sizeof(blob_test_program_blob));
+        PICOTEST_CHECK(pio_blob_parse(buffer + 1, sizeof(blob_test_program_blob), &program) == PICO_ERROR_BAD_ALIGNMENT,
+                       "Misaligned blob accepted");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Later format versions may add header fields");
+        // a larger header with the same fields is still understood, as long as the version is not newer
+        memcpy(buffer, blob_test_program_blob, PIO_BLOB_MIN_HEADER_SIZE);
+        memset(buffer + PIO_BLOB_MIN_HEADER_SIZE, 0xee, 4);
+        memcpy(buffer + PIO_BLOB_MIN_HEADER_SIZE + 4, blob_test_program_blob + PIO_BLOB_MIN_HEADER_SIZE,
+               sizeof(blob_test_program_blob) - PIO_BLOB_MIN_HEADER_SIZE);
+        buffer[5] = PIO_BLOB_MIN_HEADER_SIZE + 4;
+        rc = pio_blob_parse(buffer, sizeof(blob_test_program_blob) + 4, &program);
+        PICOTEST_CHECK(rc == (int)sizeof(blob_test_program_blob) + 4, "Failed to parse a larger header");
+        PICOTEST_CHECK(same_program(&program.program, &blob_test_program), "Program differs");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Loading");
+        PIO pio = pio0;
+        pio_sm_config blob_config;
+        int offset = pio_add_program_from_blob(pio, blob_fixed_program_blob, sizeof(blob_fixed_program_blob), &program,
+                                               &blob_config);
+        PICOTEST_CHECK_AND_ABORT(offset == 4, "blob_fixed not loaded at its origin");
+        pio_sm_config c = blob_fixed_program_get_default_config(4);
+        PICOTEST_CHECK(same_config(&blob_config, &c), "blob_fixed config differs");
+        PICOTEST_CHECK(!pio_can_add_program(pio, &probe_program), "blob_fixed instruction memory not used");
+        pio_remove_program(pio, &program.program, (uint)offset);
+        PICOTEST_CHECK(pio_can_add_program(pio, &probe_program), "blob_fixed instruction memory not freed");
+        offset = pio_add_program_from_blob(pio, blob_test_program_blob, sizeof(blob_test_program_blob), &program,
+                                           &blob_config);
+        PICOTEST_CHECK_AND_ABORT(offset >= 0, "blob_test not loaded");
+        c = blob_test_program_get_default_config((uint)offset);
+        PICOTEST_CHECK(same_config(&blob_config, &c), "blob_test config differs");
+        pio_remove_program(pio, &program.program, (uint)offset);
+        memcpy(buffer, blob_test_program_blob, sizeof(blob_test_program_blob));
+        buffer[0] = 'X';
+        PICOTEST_CHECK(pio_add_program_from_blob(pio, buffer, sizeof(blob_test_program_blob), &program, NULL) ==
+                       PICO_ERROR_INVALID_DATA, "Corrupt blob loaded");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_END_TEST();
+}
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/pio_buffer.h"
+#include "hardware/dma.h"
+#include "loopback.pio.h"
+
+PICOTEST_MODULE_NAME("PIO_BUFFER", "pico_pio_buffer test");
+
+#define WORDS 256
+
+static uint32_t src[WORDS];
+static uint32_t dst[WORDS];
+
+typedef struct {
+    volatile uint count;
+    PIO pio;
+    uint sm;
+    bool is_tx;
+} callback_record_t;
+
+static void record_callback(PIO pio, uint sm, bool is_tx, void *user_data) {
+    callback_record_t *r = (callback_record_t *)user_data;
+    r->pio = pio;
+    r->sm = sm;
+    r->is_tx = is_tx;
+    r->count++;
+}
+
+static void fill(uint count, uint32_t seed) {
+    for (uint i = 0; i < count; i++) src[i] = seed + i * 0x01010101u;
+    memset(dst, 0, sizeof(dst));
+}
+
+static uint free_dma_channels(void) {
+    uint n = 0;
+    for (uint i = 0; i < NUM_DMA_CHANNELS; i++) {
+        if (!dma_channel_is_claimed(i)) n++;
+    }
+    return n;
+}
+
+static bool wait_not_busy(PIO pio, uint sm, bool is_tx) {
+    absolute_time_t timeout = make_timeout_time_ms(100);
+    while (pio_sm_is_buffer_busy(pio, sm, is_tx)) {
+        if (time_reached(timeout)) return false;
+    }
+    return true;
+}
+
+int main() {
+    setup_default_uart();
+
+    PICOTEST_START();
+
+    PIO pio;
+    uint sm, offset;
+    PICOTEST_CHECK_AND_ABORT(pio_claim_free_sm_and_add_program(&loopback_program, &pio, &sm, &offset),
+                             "Failed to claim a state machine");
+    // a state machine which copies each word from its TX FIFO to its RX FIFO
+    pio_sm_config c = loopback_program_get_default_config(offset);
+    pio_sm_init(pio, sm, offset, &c);
+    pio_sm_set_enabled(pio, sm, true);
+    uint channels = free_dma_channels();
+
+    PICOTEST_START_SECTION("Blocking transfer using the CPU");
+        // below the DMA threshold, and few enough words to fit in the FIFOs and the state machine
+        uint count = 8;
+        fill(count, 0x12345678);
+        pio_sm_put_buffer(pio, sm, src, count);
+        pio_sm_get_buffer(pio, sm, dst, count);
+        PICOTEST_CHECK(!memcmp(src, dst, count * sizeof(uint32_t)), "Data mismatch");
+        PICOTEST_CHECK(pio_sm_is_rx_fifo_empty(pio, sm), "RX FIFO not empty");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Blocking transfer using DMA");
+        // the read must already be running, as the state machine stalls once its RX FIFO is full
+        callback_record_t rx = {0};
+        fill(WORDS, 0xa5a50000);
+        PICOTEST_CHECK(!pio_sm_get_buffer_async(pio, sm, dst, WORDS, 0, record_callback, &rx), "Failed to start read");
+        pio_sm_put_buffer(pio, sm, src, WORDS);
+        PICOTEST_CHECK(wait_not_busy(pio, sm, false), "Read did not complete");
+        PICOTEST_CHECK(!memcmp(src, dst, sizeof(dst)), "Data mismatch");
+        PICOTEST_CHECK(rx.count == 1, "Read callback not called once");
+        PICOTEST_CHECK(rx.pio == pio && rx.sm == sm && !rx.is_tx, "Wrong read callback arguments");
+        PICOTEST_CHECK(free_dma_channels() == channels, "DMA channel not released");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Asynchronous transfers in both directions");
+        callback_record_t rx = {0}, tx = {0};
+        fill(WORDS, 0x5a5a0000);
+        PICOTEST_CHECK(!pio_sm_get_buffer_async(pio, sm, dst, WORDS, 1, record_callback, &rx), "Failed to start read");
+        PICOTEST_CHECK(pio_sm_get_buffer_async(pio, sm, dst, WORDS, 1, record_callback, &rx) == PICO_ERROR_RESOURCE_IN_USE,
+                       "Second read was not rejected");
+        PICOTEST_CHECK(!pio_sm_put_buffer_async(pio, sm, src, WORDS, 0, record_callback, &tx), "Failed to start write");
+        PICOTEST_CHECK(wait_not_busy(pio, sm, true), "Write did not complete");
+        PICOTEST_CHECK(wait_not_busy(pio, sm, false), "Read did not complete");
+        PICOTEST_CHECK(!memcmp(src, dst, sizeof(dst)), "Data mismatch");
+        PICOTEST_CHECK(tx.count == 1 && tx.is_tx, "Write callback not called once");
+        PICOTEST_CHECK(rx.count == 1 && !rx.is_tx, "Read callback not called once");
+        PICOTEST_CHECK(free_dma_channels() == channels, "DMA channel not released");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Abort");
+        callback_record_t rx = {0};
+        PICOTEST_CHECK(!pio_sm_get_buffer_async(pio, sm, dst, WORDS, 0, record_callback, &rx), "Failed to start read");
+        busy_wait_us(100);
+        PICOTEST_CHECK(pio_sm_is_buffer_busy(pio, sm, false), "Read completed without any data");
+        pio_sm_abort_buffer(pio, sm, false);
+        PICOTEST_CHECK(!pio_sm_is_buffer_busy(pio, sm, false), "Read still busy after abort");
+        PICOTEST_CHECK(free_dma_channels() == channels, "DMA channel not released");
+        // a new transfer may be started once the old one is aborted
+        fill(count_of(src), 0x0f0f0000);
+        PICOTEST_CHECK(!pio_sm_get_buffer_async(pio, sm, dst, WORDS, 0, record_callback, &rx), "Failed to restart read");
+        pio_sm_put_buffer(pio, sm, src, WORDS);
+        PICOTEST_CHECK(wait_not_busy(pio, sm, false), "Read did not complete");
+        PICOTEST_CHECK(!memcmp(src, dst, sizeof(dst)), "Data mismatch");
+        PICOTEST_CHECK(rx.count == 1, "Aborted read called its callback");
+    PICOTEST_END_SECTION();
+
+    pio_sm_set_enabled(pio, sm, false);
+    pio_remove_program_and_unclaim_sm(&loopback_program, pio, sm, offset);
+
+    PICOTEST_END_TEST();
+}
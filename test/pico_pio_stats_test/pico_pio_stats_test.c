@@ -0,0 +1,117 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/pio_stats.h"
+#include "loopback.pio.h"
+
+PICOTEST_MODULE_NAME("PIO_STATS", "pico_pio_stats test");
+
+static uint32_t sum(const uint32_t *histogram, uint n) {
+    uint32_t total = 0;
+    for (uint i = 0; i < n; i++) total += histogram[i];
+    return total;
+}
+
+static pio_sm_stats_t sample(PIO pio, uint sm) {
+    pio_sm_stats_t stats;
+    // give the state machine time to react to anything just done to its FIFOs
+    busy_wait_us(10);
+    pio_stats_sample(pio, 1u << sm);
+    pio_sm_get_stats(pio, sm, &stats);
+    return stats;
+}
+
+int main() {
+    setup_default_uart();
+
+    PICOTEST_START();
+
+    PIO pio;
+    uint sm, offset;
+    PICOTEST_CHECK_AND_ABORT(pio_claim_free_sm_and_add_program(&loopback_program, &pio, &sm, &offset),
+                             "Failed to claim a state machine");
+    // a state machine which copies each word from its TX FIFO to its RX FIFO
+    pio_sm_config c = loopback_program_get_default_config(offset);
+    pio_sm_init(pio, sm, offset, &c);
+    pio_stats_sample(pio, 1u << sm);
+    pio_stats_clear(pio, 1u << sm);
+    pio_sm_stats_t stats;
+
+    PICOTEST_START_SECTION("FIFO levels and errors");
+        // the state machine is not running, so it cannot stall
+        for (uint i = 0; i < 3; i++) pio_sm_put(pio, sm, i);
+        stats = sample(pio, sm);
+        PICOTEST_CHECK(stats.samples == 1, "Wrong sample count");
+        PICOTEST_CHECK(stats.tx_level[3] == 1 && stats.rx_level[0] == 1, "Wrong FIFO levels");
+        PICOTEST_CHECK(!stats.tx_stalls && !stats.rx_stalls, "Stall counted for a stopped state machine");
+        PICOTEST_CHECK(!stats.tx_overflows && !stats.rx_underflows, "Error counted before one happened");
+        // the fifth word does not fit
+        pio_sm_put(pio, sm, 3);
+        pio_sm_put(pio, sm, 4);
+        stats = sample(pio, sm);
+        PICOTEST_CHECK(stats.tx_level[4] == 1, "Full TX FIFO level not counted");
+        PICOTEST_CHECK(stats.tx_overflows == 1, "TX overflow not counted");
+        (void)pio_sm_get(pio, sm);
+        stats = sample(pio, sm);
+        PICOTEST_CHECK(stats.rx_underflows == 1, "RX underflow not counted");
+        PICOTEST_CHECK(stats.tx_overflows == 1, "TX overflow flag not cleared by sampling");
+        PICOTEST_CHECK(stats.samples == 3, "Wrong sample count");
+        PICOTEST_CHECK(sum(stats.tx_level, 9) == 3 && sum(stats.rx_level, 9) == 3, "Level histograms do not match sample count");
+        pio_sm_clear_fifos(pio, sm);
+        pio_stats_sample(pio, 1u << sm);
+        pio_stats_clear(pio, 1u << sm);
+        pio_sm_get_stats(pio, sm, &stats);
+        PICOTEST_CHECK(!stats.samples && !stats.tx_overflows && !stats.tx_level[4], "Statistics not cleared");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Stalls and stall runs");
+        // stalls on the empty TX FIFO
+        pio_sm_set_enabled(pio, sm, true);
+        for (uint i = 0; i < 3; i++) stats = sample(pio, sm);
+        PICOTEST_CHECK(stats.tx_stalls == 3 && !stats.rx_stalls, "TX stalls not counted");
+        PICOTEST_CHECK(!sum(stats.tx_stall_runs, PICO_PIO_STATS_RUN_BUCKETS), "Run counted before it ended");
+        // fills the RX FIFO, so stalls on the push of the fifth word instead; the TX stall flag is still set from
+        // before this sample
+        for (uint i = 0; i < 5; i++) pio_sm_put_blocking(pio, sm, i);
+        stats = sample(pio, sm);
+        PICOTEST_CHECK(stats.tx_stalls == 4 && stats.rx_stalls == 1, "Wrong stall counts");
+        stats = sample(pio, sm);
+        PICOTEST_CHECK(stats.tx_stalls == 4 && stats.rx_stalls == 2, "Wrong stall counts");
+        PICOTEST_CHECK(stats.tx_stall_runs[2] == 1 && sum(stats.tx_stall_runs, PICO_PIO_STATS_RUN_BUCKETS) == 1,
+                       "TX run of 4 samples not counted in bucket 2");
+        PICOTEST_CHECK(stats.rx_level[4] == 2 && stats.tx_level[0] == stats.samples, "Wrong FIFO levels");
+        // back to stalling on the empty TX FIFO
+        for (uint i = 0; i < 5; i++) pio_sm_get_blocking(pio, sm);
+        stats = sample(pio, sm);
+        stats = sample(pio, sm);
+        PICOTEST_CHECK(stats.tx_stalls == 6 && stats.rx_stalls == 3, "Wrong stall counts");
+        PICOTEST_CHECK(stats.rx_stall_runs[1] == 1 && sum(stats.rx_stall_runs, PICO_PIO_STATS_RUN_BUCKETS) == 1,
+                       "RX run of 3 samples not counted in bucket 1");
+        PICOTEST_CHECK(stats.samples == 7, "Wrong sample count");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Periodic sampling");
+        pio_stats_clear(pio, 1u << sm);
+        PICOTEST_CHECK(pio_stats_start(pio, 1u << sm, 1000) == PICO_OK, "Failed to start sampling");
+        sleep_ms(20);
+        pio_stats_stop(pio, 1u << sm);
+        pio_sm_get_stats(pio, sm, &stats);
+        uint32_t samples = stats.samples;
+        PICOTEST_CHECK(samples >= 15 && samples <= 21, "Wrong number of periodic samples");
+        PICOTEST_CHECK(stats.tx_stalls == samples, "TX stall not seen in every sample");
+        sleep_ms(5);
+        pio_sm_get_stats(pio, sm, &stats);
+        PICOTEST_CHECK(stats.samples == samples, "Sampling continued after stop");
+    PICOTEST_END_SECTION();
+
+    pio_sm_set_enabled(pio, sm, false);
+    pio_remove_program_and_unclaim_sm(&loopback_program, pio, sm, offset);
+
+    PICOTEST_END_TEST();
+}
@@ -0,0 +1,253 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <string.h>
+// Include sys/types.h before inttypes.h to work around issue with
+// certain versions of GCC and newlib which causes omission of PRIu64
+#include <sys/types.h>
+#include <inttypes.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/prng.h"
+#include "pico/rand.h"
+
+PICOTEST_MODULE_NAME("pico_prng_test", "pico_prng test harness");
+
+#define RESEED_INTERVAL 100
+#define BENCH_SIZE 4096
+
+static bool is_all(const uint8_t *buf, size_t len, uint8_t value) {
+    for (size_t i = 0; i < len; i++) {
+        if (buf[i] != value) return false;
+    }
+    return true;
+}
+
+// a seed source for the per core generators which counts its calls, and gives seeds which are easy to reproduce
+static uint seed_count;
+
+static size_t counting_seed(void *seed, __unused size_t max_len) {
+    uint64_t *s = (uint64_t *) seed;
+    seed_count++;
+    s[0] = seed_count;
+    s[1] = seed_count + 1;
+    return 2 * sizeof(uint64_t);
+}
+
+int main(void) {
+    stdio_init_all();
+    PICOTEST_START();
+
+    const uint64_t seed_1[2] = {1, 2};
+    const uint64_t seed_2[2] = {3, 4};
+    uint8_t buf[256];
+    uint8_t buf2[256];
+
+    PICOTEST_START_SECTION("xoroshiro output");
+        prng_xoroshiro_t prng = {0};
+        PICOTEST_CHECK(prng_xoroshiro_needs_reseed(&prng), "zero state does not need reseeding");
+        PICOTEST_CHECK(prng_xoroshiro_fill(&prng, buf, sizeof(buf)) == 0, "output without a seed");
+        prng_xoroshiro_reseed(&prng, seed_1, RESEED_INTERVAL);
+        PICOTEST_CHECK(!prng_xoroshiro_needs_reseed(&prng), "needs reseeding after reseed");
+        // xoroshiro128** from splitmix64 of the seed, after one output is discarded
+        const uint64_t expected[3] = { 0x872797c3f7830057ull, 0xaba5db09d617eac4ull, 0x4bc716d4ca79da4aull };
+        uint64_t out[3];
+        PICOTEST_CHECK(prng_xoroshiro_fill(&prng, out, sizeof(out)) == sizeof(out), "short fill");
+        PICOTEST_CHECK(!memcmp(out, expected, sizeof(out)), "wrong output");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("reseed interval");
+        prng_xoroshiro_t prng = {0};
+        prng_xoroshiro_reseed(&prng, seed_1, RESEED_INTERVAL);
+        memset(buf, 0, sizeof(buf));
+        // output stops exactly at the interval, even part way through a word, and the rest is untouched
+        PICOTEST_CHECK(prng_xoroshiro_fill(&prng, buf, 60) == 60, "short fill");
+        PICOTEST_CHECK(prng_xoroshiro_fill(&prng, buf + 60, 60) == RESEED_INTERVAL - 60, "fill crossed the interval");
+        PICOTEST_CHECK(prng_xoroshiro_needs_reseed(&prng), "does not need reseeding at the interval");
+        PICOTEST_CHECK(prng_xoroshiro_fill(&prng, buf + RESEED_INTERVAL, 1) == 0, "output after the interval");
+        PICOTEST_CHECK(is_all(buf + RESEED_INTERVAL, sizeof(buf) - RESEED_INTERVAL, 0), "wrote past the interval");
+        prng_xoroshiro_reseed(&prng, seed_2, RESEED_INTERVAL);
+        PICOTEST_CHECK(prng_xoroshiro_fill(&prng, buf + RESEED_INTERVAL, RESEED_INTERVAL) == RESEED_INTERVAL, "no output after reseed");
+        PICOTEST_CHECK(prng_xoroshiro_fill(&prng, buf, 0) == 0, "empty fill");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("reseed mixing");
+        // the same seeds give the same output
+        prng_xoroshiro_t a = {0}, b = {0};
+        prng_xoroshiro_reseed(&a, seed_1, RESEED_INTERVAL);
+        prng_xoroshiro_reseed(&b, seed_1, RESEED_INTERVAL);
+        prng_xoroshiro_fill(&a, buf, 32);
+        prng_xoroshiro_fill(&b, buf2, 32);
+        PICOTEST_CHECK(!memcmp(buf, buf2, 32), "same seeds gave different output");
+        // a reseed is mixed into the state rather than replacing it
+        prng_xoroshiro_t c = {0};
+        prng_xoroshiro_reseed(&a, seed_2, RESEED_INTERVAL);
+        prng_xoroshiro_reseed(&c, seed_2, RESEED_INTERVAL);
+        prng_xoroshiro_fill(&a, buf, 32);
+        prng_xoroshiro_fill(&c, buf2, 32);
+        PICOTEST_CHECK(memcmp(buf, buf2, 32), "reseed replaced the state");
+        // output split across calls and alignments is the same stream, a word at a time
+        prng_xoroshiro_t d = {0}, e = {0};
+        prng_xoroshiro_reseed(&d, seed_1, RESEED_INTERVAL);
+        prng_xoroshiro_reseed(&e, seed_1, RESEED_INTERVAL);
+        prng_xoroshiro_fill(&d, buf, 64);
+        prng_xoroshiro_fill(&e, buf2 + 1, 24);
+        prng_xoroshiro_fill(&e, buf2 + 25, 40);
+        PICOTEST_CHECK(!memcmp(buf, buf2 + 1, 64), "split output differs");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("xoroshiro per core");
+        static prng_xoroshiro_per_core_t pc = {
+            .get_seed = counting_seed,
+            .reseed_interval = RESEED_INTERVAL,
+        };
+        memset(buf, 0, sizeof(buf));
+        prng_xoroshiro_per_core_fill(&pc, buf, 250);
+        PICOTEST_CHECK(seed_count == 3, "not reseeded every interval");
+        PICOTEST_CHECK(is_all(buf + 250, sizeof(buf) - 250, 0), "wrote past the end");
+        // the same as a single generator reseeded with the same seeds, despite producing the output in chunks
+        prng_xoroshiro_t ref = {0};
+        for (uint i = 1; i <= 3; i++) {
+            const uint64_t seed[2] = {i, i + 1};
+            prng_xoroshiro_reseed(&ref, seed, RESEED_INTERVAL);
+            prng_xoroshiro_fill(&ref, buf2 + (i - 1) * RESEED_INTERVAL, MIN(250 - (i - 1) * RESEED_INTERVAL, RESEED_INTERVAL));
+        }
+        PICOTEST_CHECK(!memcmp(buf, buf2, 250), "wrong output");
+        prng_xoroshiro_per_core_fill(&pc, buf, 50);
+        PICOTEST_CHECK(seed_count == 3, "reseeded early");
+        prng_xoroshiro_per_core_fill(&pc, buf, 1);
+        PICOTEST_CHECK(seed_count == 4, "not reseeded at the interval");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("chacha20 output");
+        // RFC 8439 A.1 test vectors 1 and 2: the ChaCha20 keystream of the zero key, blocks 0 and 1
+        const uint8_t block_0[32] = {
+            0x76, 0xb8, 0xe0, 0xad, 0xa0, 0xf1, 0x3d, 0x90, 0x40, 0x5d, 0x6a, 0xe5, 0x53, 0x86, 0xbd, 0x28,
+            0xbd, 0xd2, 0x19, 0xb8, 0xa0, 0x8d, 0xed, 0x1a, 0xa8, 0x36, 0xef, 0xcc, 0x8b, 0x77, 0x0d, 0xc7 };
+        const uint8_t block_1[64] = {
+            0x9f, 0x07, 0xe7, 0xbe, 0x55, 0x51, 0x38, 0x7a, 0x98, 0xba, 0x97, 0x7c, 0x73, 0x2d, 0x08, 0x0d,
+            0xcb, 0x0f, 0x29, 0xa0, 0x48, 0xe3, 0x65, 0x69, 0x12, 0xc6, 0x53, 0x3e, 0x32, 0xee, 0x7a, 0xed,
+            0x29, 0xb7, 0x21, 0x76, 0x9c, 0xe6, 0x4e, 0x43, 0xd5, 0x71, 0x33, 0xb0, 0x74, 0xd8, 0x39, 0xd5,
+            0x31, 0xed, 0x1f, 0x28, 0x51, 0x0a, 0xfb, 0x45, 0xac, 0xe1, 0x0a, 0x1f, 0x4b, 0x79, 0x4d, 0x6f };
+        // and block 1 of the keystream of the first half of block 0
+        const uint8_t next_output[16] = {
+            0x55, 0x1a, 0xaa, 0x9b, 0xa4, 0x6f, 0xaa, 0xd5, 0x28, 0xf6, 0x76, 0x3d, 0xde, 0x93, 0xc0, 0x3f };
+        prng_chacha20_t prng = {0};
+        PICOTEST_CHECK(prng_chacha20_needs_reseed(&prng), "zero state does not need reseeding");
+        PICOTEST_CHECK(prng_chacha20_fill(&prng, buf, sizeof(buf)) == 0, "output without a seed");
+        // the zero key, without a reseed
+        prng.bytes_until_reseed = RESEED_INTERVAL;
+        PICOTEST_CHECK(prng_chacha20_fill(&prng, buf, sizeof(block_1)) == sizeof(block_1), "short fill");
+        PICOTEST_CHECK(!memcmp(buf, block_1, sizeof(block_1)), "wrong output");
+        PICOTEST_CHECK(!memcmp(prng.key, block_0, sizeof(block_0)), "key not replaced by block 0");
+        PICOTEST_CHECK(prng_chacha20_fill(&prng, buf, RESEED_INTERVAL) == RESEED_INTERVAL - sizeof(block_1), "fill crossed the interval");
+        PICOTEST_CHECK(!memcmp(buf, next_output, sizeof(next_output)), "wrong output after rekey");
+        PICOTEST_CHECK(prng_chacha20_needs_reseed(&prng), "does not need reseeding at the interval");
+        // reserving and generating separately is the same as filling
+        prng_chacha20_t a = {0}, b = {0};
+        a.bytes_until_reseed = b.bytes_until_reseed = RESEED_INTERVAL;
+        uint32_t request_key[8];
+        PICOTEST_CHECK(prng_chacha20_reserve(&a, 16, request_key) == 16, "short reserve");
+        prng_chacha20_output(request_key, buf2, 16);
+        PICOTEST_CHECK(prng_chacha20_fill(&b, buf, 16) == 16 && !memcmp(buf, buf2, 16), "reserved output differs");
+        PICOTEST_CHECK(!memcmp(a.key, b.key, sizeof(a.key)) && a.bytes_until_reseed == b.bytes_until_reseed, "reserved state differs");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("chacha20 reseed");
+        // a 40 byte seed is absorbed in two chunks
+        uint8_t seed[40];
+        for (uint i = 0; i < sizeof(seed); i++) seed[i] = (uint8_t)i;
+        const uint8_t reseeded_output[16] = {
+            0x16, 0x1c, 0x84, 0x60, 0x92, 0xfa, 0x48, 0xa0, 0x88, 0xbb, 0xad, 0x2a, 0xf0, 0x68, 0x37, 0x8a };
+        prng_chacha20_t prng = {0};
+        prng_chacha20_reseed(&prng, seed, sizeof(seed), RESEED_INTERVAL);
+        PICOTEST_CHECK(!prng_chacha20_needs_reseed(&prng), "needs reseeding after reseed");
+        PICOTEST_CHECK(prng_chacha20_fill(&prng, buf, 16) == 16, "short fill");
+        PICOTEST_CHECK(!memcmp(buf, reseeded_output, sizeof(reseeded_output)), "wrong output after reseed");
+        // a reseed is mixed into the state rather than replacing it
+        prng_chacha20_t c = {0};
+        prng_chacha20_reseed(&prng, seed, sizeof(seed), RESEED_INTERVAL);
+        prng_chacha20_reseed(&c, seed, sizeof(seed), RESEED_INTERVAL);
+        prng_chacha20_fill(&prng, buf, 32);
+        prng_chacha20_fill(&c, buf2, 32);
+        PICOTEST_CHECK(memcmp(buf, buf2, 32), "reseed replaced the state");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("chacha20 per core");
+        static prng_chacha20_per_core_t secure_pc = {
+            .get_seed = counting_seed,
+            .reseed_interval = RESEED_INTERVAL,
+        };
+        seed_count = 0;
+        memset(buf, 0, sizeof(buf));
+        // a request never spans a reseed
+        prng_chacha20_per_core_fill(&secure_pc, buf, 150);
+        PICOTEST_CHECK(seed_count == 2, "not reseeded every interval");
+        PICOTEST_CHECK(is_all(buf + 150, sizeof(buf) - 150, 0), "wrote past the end");
+        prng_chacha20_t ref = {0};
+        for (uint i = 1; i <= 2; i++) {
+            const uint64_t seed[2] = {i, i + 1};
+            prng_chacha20_reseed(&ref, seed, sizeof(seed), RESEED_INTERVAL);
+            prng_chacha20_fill(&ref, buf2 + (i - 1) * RESEED_INTERVAL, MIN(150 - (i - 1) * RESEED_INTERVAL, RESEED_INTERVAL));
+        }
+        PICOTEST_CHECK(!memcmp(buf, buf2, 150), "wrong output");
+        prng_chacha20_per_core_fill(&secure_pc, buf, 50);
+        PICOTEST_CHECK(seed_count == 2, "reseeded early");
+        prng_chacha20_per_core_fill(&secure_pc, buf, 1);
+        PICOTEST_CHECK(seed_count == 3, "not reseeded at the interval");
+
+        memset(buf, 0xa5, sizeof(buf));
+        prng_secure_wipe(buf + 1, 10);
+        PICOTEST_CHECK(buf[0] == 0xa5 && is_all(buf + 1, 10, 0) && buf[11] == 0xa5, "wrong bytes wiped");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("get_rand_bytes");
+        memset(buf, 0, sizeof(buf));
+        memset(buf2, 0, sizeof(buf2));
+        // enough to need reseeding more than once
+        for (uint i = 0; i < 3 * PICO_RAND_BYTES_RESEED_INTERVAL / sizeof(buf); i++) {
+            get_rand_bytes(buf, sizeof(buf) - 1);
+        }
+        get_rand_bytes(buf2 + 3, 13);
+        PICOTEST_CHECK(!is_all(buf, sizeof(buf) - 1, 0), "no output");
+        PICOTEST_CHECK(buf[sizeof(buf) - 1] == 0, "wrote past the end");
+        PICOTEST_CHECK(is_all(buf2, 3, 0) && !is_all(buf2 + 3, 13, 0) && is_all(buf2 + 16, sizeof(buf2) - 16, 0), "wrong bytes written");
+
+        static uint8_t bench[BENCH_SIZE];
+        uint64_t start = time_us_64();
+        get_rand_bytes(bench, sizeof(bench));
+        uint64_t bytes_time = time_us_64() - start;
+        start = time_us_64();
+        for (uint i = 0; i < BENCH_SIZE; i += sizeof(uint64_t)) {
+            uint64_t r = get_rand_64();
+            memcpy(bench + i, &r, sizeof(r));
+        }
+        uint64_t rand_64_time = time_us_64() - start;
+        printf("%d bytes: get_rand_bytes %"PRIu64"us, get_rand_64 %"PRIu64"us\n", BENCH_SIZE, bytes_time, rand_64_time);
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("get_secure_rand_bytes");
+        memset(buf, 0, sizeof(buf));
+        memset(buf2, 0, sizeof(buf2));
+        // enough to need reseeding more than once
+        static uint8_t bench[BENCH_SIZE];
+        for (uint i = 0; i < 3 * PICO_RAND_SECURE_RESEED_INTERVAL / sizeof(bench); i++) {
+            get_secure_rand_bytes(bench, sizeof(bench));
+        }
+        get_secure_rand_bytes(buf, 32);
+        get_secure_rand_bytes(buf2 + 3, 13);
+        PICOTEST_CHECK(!is_all(buf, 32, 0) && is_all(buf + 32, sizeof(buf) - 32, 0), "wrong bytes written");
+        PICOTEST_CHECK(is_all(buf2, 3, 0) && !is_all(buf2 + 3, 13, 0) && is_all(buf2 + 16, sizeof(buf2) - 16, 0), "wrong bytes written");
+        PICOTEST_CHECK(memcmp(buf, buf2 + 3, 13), "output repeated");
+
+        uint64_t start = time_us_64();
+        get_secure_rand_bytes(bench, sizeof(bench));
+        printf("%d bytes: get_secure_rand_bytes %"PRIu64"us\n", BENCH_SIZE, time_us_64() - start);
+    PICOTEST_END_SECTION();
+
+    PICOTEST_END_TEST();
+}
@@ -17,6 +17,12 @@
 
 #define BUFFER_SIZE 10000
 
+#if PICO_SHA256_SOFTWARE
+#define IMPLEMENTATION "sw"
+#else
+#define IMPLEMENTATION "hw"
+#endif
+
 static void run_test(bool use_dma) {
     pico_sha256_state_t state;
 
@@ -86,8 +92,8 @@ static void run_test(bool use_dma) {
     hard_assert(memcmp(rc_4_55_expected, result.bytes, SHA256_RESULT_BYTES) == 0);
 
     // nist 3
-    uint8_t *buffer = malloc(10000);
-    memset(buffer, 0x61, BUFFER_SIZE);
+    uint8_t *buffer = malloc(BUFFER_SIZE + 1);
+    memset(buffer, 0x61, BUFFER_SIZE + 1);
     const uint8_t nist_3_expected[] = { \
         0xcd, 0xc7, 0x6e, 0x5c, 0x99, 0x14, 0xfb, 0x92, 0x81, 0xa1, \
         0xc7, 0xe2, 0x84, 0xd7, 0x3e, 0x67, 0xf1, 0x80, 0x9a, 0x48, \
@@ -102,9 +108,22 @@ static void run_test(bool use_dma) {
     }
     pico_sha256_finish(&state, &result);
     uint64_t pico_time = time_us_64() - start;
-    printf("Pico hw time for sha256 of 1M bytes %s DMA %"PRIu64"ms\n", use_dma ? "with" : "without", pico_time / 1000);
+    printf("Pico " IMPLEMENTATION " time for sha256 of 1M bytes %s DMA %"PRIu64"ms\n", use_dma ? "with" : "without", pico_time / 1000);
+    hard_assert(memcmp(nist_3_expected, result.bytes, SHA256_RESULT_BYTES) == 0);
+
+    // again, from data which is not word aligned
+    start = time_us_64();
+    rc = pico_sha256_start_blocking(&state, SHA256_BIG_ENDIAN, use_dma);
+    hard_assert(rc == PICO_OK);
+    for(int i = 0; i < 1000000; i += BUFFER_SIZE) {
+        pico_sha256_update_blocking(&state, buffer + 1, BUFFER_SIZE);
+    }
+    pico_sha256_finish(&state, &result);
+    pico_time = time_us_64() - start;
+    printf("Pico " IMPLEMENTATION " time for sha256 of 1M unaligned bytes %s DMA %"PRIu64"ms\n", use_dma ? "with" : "without", pico_time / 1000);
     hard_assert(memcmp(nist_3_expected, result.bytes, SHA256_RESULT_BYTES) == 0);
 
+#if !PICO_SHA256_SOFTWARE
     // Cause an error
     rc = pico_sha256_start_blocking(&state, SHA256_BIG_ENDIAN, use_dma);
     hard_assert(rc == PICO_OK);
@@ -130,17 +149,20 @@ static void run_test(bool use_dma) {
     sha256_wait_ready_blocking();
     hard_assert(sha256_err_not_ready());
     pico_sha256_finish(&state, NULL); // passing null to just release the hardware
+#endif
 
     // check we can restart
     rc = pico_sha256_start_blocking(&state, SHA256_BIG_ENDIAN, use_dma);
     hard_assert(rc == PICO_OK);
 
+#if !PICO_SHA256_SOFTWARE
     // Check hardware is claimed
     pico_sha256_state_t duff = {0};
     rc = pico_sha256_try_start(&duff, SHA256_BIG_ENDIAN, use_dma);
     hard_assert(rc == PICO_ERROR_RESOURCE_IN_USE);
     rc = pico_sha256_start_blocking_until(&duff, SHA256_BIG_ENDIAN, use_dma, make_timeout_time_ms(100));
     hard_assert(rc == PICO_ERROR_TIMEOUT);
+#endif
 
     pico_sha256_update_blocking(&state, nist_1, sizeof(nist_1));
     pico_sha256_finish(&state, &result);
@@ -166,11 +188,128 @@ static void run_test(bool use_dma) {
     free(buffer);
 }
 
+// NIST multi-block messages, hashed in two parts split at every offset, and from every alignment
+static void run_split_test(bool use_dma) {
+    const char *nist_2 = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    const uint8_t nist_2_expected[] = { \
+        0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, \
+        0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, \
+        0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, \
+        0x06, 0xc1 };
+    const char *nist_4 = "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmnoijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu";
+    const uint8_t nist_4_expected[] = { \
+        0xcf, 0x5b, 0x16, 0xa7, 0x78, 0xaf, 0x83, 0x80, 0x03, 0x6c, \
+        0xe5, 0x9e, 0x7b, 0x04, 0x92, 0x37, 0x0b, 0x24, 0x9b, 0x11, \
+        0xe8, 0xf0, 0x7a, 0x51, 0xaf, 0xac, 0x45, 0x03, 0x7a, 0xfe, \
+        0xe9, 0xd1 };
+    const char *messages[] = { nist_2, nist_4 };
+    const uint8_t *expected[] = { nist_2_expected, nist_4_expected };
+
+    static uint8_t buffer[128 + 4];
+    pico_sha256_state_t state;
+    sha256_result_t result;
+    for (uint m = 0; m < count_of(messages); m++) {
+        size_t size = strlen(messages[m]);
+        for (uint align = 0; align < 4; align++) {
+            memcpy(buffer + align, messages[m], size);
+            for (size_t split = 0; split <= size; split++) {
+                int rc = pico_sha256_start_blocking(&state, SHA256_BIG_ENDIAN, use_dma);
+                hard_assert(rc == PICO_OK);
+                pico_sha256_update_blocking(&state, buffer + align, split);
+                pico_sha256_update_blocking(&state, buffer + align + split, size - split);
+                pico_sha256_finish(&state, &result);
+                hard_assert(memcmp(expected[m], result.bytes, SHA256_RESULT_BYTES) == 0);
+            }
+        }
+    }
+}
+
+#define QUEUE_JOBS 64
+
+static volatile uint queue_callbacks;
+
+static void queue_job_done(__unused pico_sha256_job_t *job, __unused void *user_data) {
+    queue_callbacks++;
+}
+
+static void run_queue_test(void) {
+    static uint8_t data[600];
+    static pico_sha256_job_t jobs[QUEUE_JOBS];
+    static pico_sha256_buffer_t buffers[QUEUE_JOBS][3];
+    for (uint i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 13 + 7);
+
+    int rc = pico_sha256_queue_init(0);
+    hard_assert(rc == PICO_OK);
+    // many small messages of various sizes, split into buffers at various offsets (including empty ones)
+    for (uint i = 0; i < QUEUE_JOBS; i++) {
+        uint size = (i * 37) % 200;
+        uint split1 = size / 3, split2 = (size * i) % (size + 1);
+        if (split2 < split1) split2 = split1;
+        buffers[i][0] = (pico_sha256_buffer_t) {data + i, split1};
+        buffers[i][1] = (pico_sha256_buffer_t) {data + i + split1, split2 - split1};
+        buffers[i][2] = (pico_sha256_buffer_t) {data + i + split2, size - split2};
+        jobs[i] = (pico_sha256_job_t) {
+            .buffers = buffers[i],
+            .buffer_count = 3,
+            .endianness = SHA256_BIG_ENDIAN,
+            .callback = queue_job_done,
+        };
+    }
+    uint64_t start = time_us_64();
+    for (uint i = 0; i < QUEUE_JOBS; i++) {
+        rc = pico_sha256_queue_submit(&jobs[i]);
+        hard_assert(rc == PICO_OK);
+    }
+    while (!pico_sha256_job_is_done(&jobs[QUEUE_JOBS - 1])) {
+        tight_loop_contents();
+    }
+    printf("Pico " IMPLEMENTATION " time for %d queued sha256 jobs %"PRIu64"us\n", QUEUE_JOBS, time_us_64() - start);
+    hard_assert(queue_callbacks == QUEUE_JOBS);
+
+    // the hardware is released once the queue is empty
+    pico_sha256_state_t state;
+    sha256_result_t result;
+    for (uint i = 0; i < QUEUE_JOBS; i++) {
+        hard_assert(pico_sha256_job_is_done(&jobs[i]));
+        rc = pico_sha256_try_start(&state, SHA256_BIG_ENDIAN, false);
+        hard_assert(rc == PICO_OK);
+        for (uint j = 0; j < 3; j++) {
+            pico_sha256_update_blocking(&state, buffers[i][j].data, buffers[i][j].size);
+        }
+        pico_sha256_finish(&state, &result);
+        hard_assert(memcmp(result.bytes, jobs[i].result.bytes, SHA256_RESULT_BYTES) == 0);
+    }
+
+#if !PICO_SHA256_SOFTWARE
+    // the queue cannot start while the hardware is in use
+    rc = pico_sha256_try_start(&state, SHA256_BIG_ENDIAN, false);
+    hard_assert(rc == PICO_OK);
+    hard_assert(pico_sha256_queue_submit(&jobs[0]) == PICO_ERROR_RESOURCE_IN_USE);
+    pico_sha256_finish(&state, NULL);
+#endif
+
+    // a buffer too large for a single DMA transfer is rejected before anything is read from it
+    static const pico_sha256_buffer_t oversized = {data, PICO_SHA256_QUEUE_MAX_BUFFER_SIZE + 1};
+    jobs[0].buffers = &oversized;
+    jobs[0].buffer_count = 1;
+    queue_callbacks = 0;
+    hard_assert(pico_sha256_queue_submit(&jobs[0]) == PICO_ERROR_INVALID_ARG);
+    hard_assert(!queue_callbacks);
+
+    pico_sha256_queue_deinit();
+}
+
 int main() {
     stdio_init_all();
 
     run_test(false);
+    run_split_test(false);
+#if !PICO_SHA256_SOFTWARE
+    // the DMA flag is ignored by the software implementation
     run_test(true);
+    run_split_test(true);
+#endif
+    run_queue_test();
 
     printf("Test passed\n");
 }
@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "pico/test.h"
+#include "pico/xip_profile.h"
+
+PICOTEST_MODULE_NAME("XIP_PROFILE", "pico_xip_profile test");
+
+#define INTERVAL_US 50
+#define BUSY_MS 100
+// a bound on the size of the busy loops below
+#define BUSY_LOOP_MAX_SIZE 64
+// the fraction of samples which must land in the busy loop; the rest are the loop's entry and exit
+#define MIN_PERCENT 90
+
+extern char __flash_binary_start;
+extern char __flash_binary_end;
+
+// the timer is read directly, so the samples are all taken in the loop itself rather than a function it calls
+static __noinline void busy_loop_in_flash(uint32_t duration_us) {
+    uint32_t start = timer_hw->timerawl;
+    while (timer_hw->timerawl - start < duration_us) {
+        tight_loop_contents();
+    }
+}
+
+static void __no_inline_not_in_flash_func(busy_loop_in_ram)(uint32_t duration_us) {
+    uint32_t start = timer_hw->timerawl;
+    while (timer_hw->timerawl - start < duration_us) {
+        tight_loop_contents();
+    }
+}
+
+int main() {
+    setup_default_uart();
+
+    PICOTEST_START();
+
+    // one bucket per 2^PICO_XIP_PROFILE_MIN_BUCKET_SHIFT bytes of the binary, so that the smallest bucket size is
+    // used, and the bucket for an address is easily found
+    uintptr_t base = (uintptr_t)&__flash_binary_start;
+    uint shift = PICO_XIP_PROFILE_MIN_BUCKET_SHIFT;
+    uint bucket_count = (uint)((((uintptr_t)&__flash_binary_end - base) >> shift) + 1);
+    uint32_t *counts = (uint32_t *)malloc(bucket_count * sizeof(uint32_t));
+    PICOTEST_CHECK_AND_ABORT(counts, "Could not allocate the histogram");
+    xip_profile_init(counts, bucket_count);
+
+    PICOTEST_START_SECTION("Busy loop in flash lands in its buckets");
+        PICOTEST_CHECK_AND_ABORT(xip_profile_start(INTERVAL_US), "Profile did not start");
+        busy_loop_in_flash(BUSY_MS * 1000);
+        xip_profile_stop();
+        uint32_t samples = xip_profile_get_sample_count();
+        uint32_t other = xip_profile_get_other_sample_count();
+        uintptr_t loop_start = (uintptr_t)busy_loop_in_flash & ~1u;
+        uint32_t in_loop = 0;
+        uint32_t in_flash = 0;
+        for (uint i = 0; i < bucket_count; i++) {
+            uintptr_t bucket_start = base + (i << shift);
+            if (bucket_start + (1u << shift) > loop_start && bucket_start < loop_start + BUSY_LOOP_MAX_SIZE) {
+                in_loop += counts[i];
+            }
+            in_flash += counts[i];
+        }
+        printf("  %u samples, %u in the loop, %u outside flash\n", (uint)samples, (uint)in_loop, (uint)other);
+        PICOTEST_CHECK(samples >= (BUSY_MS * 1000 / INTERVAL_US) / 2, "Too few samples");
+        PICOTEST_CHECK(in_flash + other == samples, "Samples not all counted");
+        PICOTEST_CHECK(in_loop * 100 >= samples * MIN_PERCENT, "Samples not in the busy loop's buckets");
+        // sampling has stopped
+        busy_wait_ms(1);
+        PICOTEST_CHECK(xip_profile_get_sample_count() == samples, "Samples taken after stop");
+    PICOTEST_END_SECTION();
+
+    PICOTEST_START_SECTION("Busy loop in RAM is counted outside flash");
+        xip_profile_clear();
+        PICOTEST_CHECK(!xip_profile_get_sample_count() && !xip_profile_get_other_sample_count(), "Counts not cleared");
+        PICOTEST_CHECK_AND_ABORT(xip_profile_start(INTERVAL_US), "Profile did not restart");
+        busy_loop_in_ram(BUSY_MS * 1000);
+        xip_profile_stop();
+        uint32_t samples = xip_profile_get_sample_count();
+        uint32_t other = xip_profile_get_other_sample_count();
+        printf("  %u samples, %u outside flash\n", (uint)samples, (uint)other);
+        PICOTEST_CHECK(samples >= (BUSY_MS * 1000 / INTERVAL_US) / 2, "Too few samples");
+        PICOTEST_CHECK(other * 100 >= samples * MIN_PERCENT, "Samples in RAM counted in flash");
+    PICOTEST_END_SECTION();
+
+    free(counts);
+
+    PICOTEST_END_TEST();
+}
@@ -32,6 +32,7 @@ BUILD_CONFIGURATIONS = (
         "exclusions": frozenset(
             (
                 "//test/cmsis_test:cmsis_test",
+                "//test/hardware_dma_callback_test:hardware_dma_callback_test",
                 "//test/hardware_irq_test:hardware_irq_test",
                 "//test/hardware_pwm_test:hardware_pwm_test",
                 "//test/hardware_sync_spin_lock_test:hardware_sync_spin_lock_test",
@@ -39,14 +40,25 @@ BUILD_CONFIGURATIONS = (
                 "//test/kitchen_sink:kitchen_sink_cpp",
                 "//test/kitchen_sink:kitchen_sink_lwip_poll",
                 "//test/kitchen_sink:kitchen_sink_lwip_background",
+                "//test/pico_dma_stream_test:pico_dma_stream_test",
                 "//test/pico_divider_test:pico_divider_test",
                 "//test/pico_divider_test:pico_divider_nesting_test",
+                "//test/pico_flash_erase_job_test:pico_flash_erase_job_test",
+                "//test/pico_flash_stream_test:pico_flash_stream_test",
+                "//test/pico_float_bench:pico_float_bench_compiler",
+                "//test/pico_float_bench:pico_float_bench_pico",
+                "//test/pico_float_bench:pico_float_bench_pico_dcp",
+                "//test/pico_float_bench:pico_float_bench_pico_vfp",
                 "//test/pico_float_test:pico_double_test",
                 "//test/pico_float_test:pico_float_test",
                 "//test/pico_float_test:pico_float_test_hazard3",
+                "//test/pico_pio_blob_test:pico_pio_blob_test",
+                "//test/pico_pio_buffer_test:pico_pio_buffer_test",
+                "//test/pico_pio_stats_test:pico_pio_stats_test",
                 "//test/pico_sha256_test:pico_sha256_test",
                 "//test/pico_stdio_test:pico_stdio_test",
                 "//test/pico_time_test:pico_time_test",
+                "//test/pico_xip_profile_test:pico_xip_profile_test",
 
                 # Pretty much only Picotool and pioasm build on Windows.
                 "//..." if os.name == "nt" else "",
@@ -66,11 +78,15 @@ BUILD_CONFIGURATIONS = (
                 "//test/kitchen_sink:kitchen_sink_lwip_poll",
                 "//test/kitchen_sink:kitchen_sink_lwip_background",
                 # Host only.
+                "//test/pico_float_bench:pico_float_bench_reference",
                 "//test/pico_float_test:hazard3_test_gen",
                 # No RISC-V on RP2040.
                 "//test/pico_float_test:pico_float_test_hazard3",
                 # hardware_sha256 doesn't appear to work on RP2040.
                 "//test/pico_sha256_test:pico_sha256_test",
+                # RP2350 only.
+                "//test/pico_float_bench:pico_float_bench_pico_dcp",
+                "//test/pico_float_bench:pico_float_bench_pico_vfp",
             )
         ),
     },
@@ -83,6 +99,7 @@ BUILD_CONFIGURATIONS = (
                 "//test/kitchen_sink:kitchen_sink_lwip_poll",
                 "//test/kitchen_sink:kitchen_sink_lwip_background",
                 # Host only.
+                "//test/pico_float_bench:pico_float_bench_reference",
                 "//test/pico_float_test:hazard3_test_gen",
                 # TODO: RISC-V support.
                 "//test/pico_float_test:pico_float_test_hazard3",
@@ -101,11 +118,15 @@ BUILD_CONFIGURATIONS = (
                 "//test/kitchen_sink:kitchen_sink_lwip_poll",
                 "//test/kitchen_sink:kitchen_sink_lwip_background",
                 # Host only.
+                "//test/pico_float_bench:pico_float_bench_reference",
                 "//test/pico_float_test:hazard3_test_gen",
                 # No RISC-V on RP2040.
                 "//test/pico_float_test:pico_float_test_hazard3",
                 # hardware_sha256 doesn't appear to work on RP2040.
                 "//test/pico_sha256_test:pico_sha256_test",
+                # RP2350 only.
+                "//test/pico_float_bench:pico_float_bench_pico_dcp",
+                "//test/pico_float_bench:pico_float_bench_pico_vfp",
             )
         ),
     },
@@ -121,6 +142,7 @@ BUILD_CONFIGURATIONS = (
                 "//test/kitchen_sink:kitchen_sink_lwip_poll",
                 "//test/kitchen_sink:kitchen_sink_lwip_background",
                 # Host only.
+                "//test/pico_float_bench:pico_float_bench_reference",
                 "//test/pico_float_test:hazard3_test_gen",
                 # TODO: RISC-V support.
                 "//test/pico_float_test:pico_float_test_hazard3",
@@ -137,11 +159,15 @@ BUILD_CONFIGURATIONS = (
         "exclusions": frozenset(
             (
                 # Host only.
+                "//test/pico_float_bench:pico_float_bench_reference",
                 "//test/pico_float_test:hazard3_test_gen",
                 # No RISC-V on RP2040.
                 "//test/pico_float_test:pico_float_test_hazard3",
                 # hardware_sha256 doesn't appear to work on RP2040.
                 "//test/pico_sha256_test:pico_sha256_test",
+                # RP2350 only.
+                "//test/pico_float_bench:pico_float_bench_pico_dcp",
+                "//test/pico_float_bench:pico_float_bench_pico_vfp",
             )
         ),
     },
@@ -155,6 +181,7 @@ BUILD_CONFIGURATIONS = (
         "exclusions": frozenset(
             (
                 # Host only.
+                "//test/pico_float_bench:pico_float_bench_reference",
                 "//test/pico_float_test:hazard3_test_gen",
                 # No RISC-V on RP2040.
                 "//test/pico_float_test:pico_float_test_hazard3",
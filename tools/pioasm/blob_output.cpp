@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <iostream>
+#include "output_format.h"
+#include "pio_disassembler.h"
+#include "version.h"
+
+#ifdef _MSC_VER
+#pragma warning(disable : 4996) // fopen
+#endif
+
+// Binary program blobs, loaded at runtime by pio_add_program_from_blob(); the layout is described in
+// pico/pio_blob.h and must be kept in step with it. All fields are little-endian.
+static const uint8_t blob_version = 1;
+static const uint8_t blob_header_size = 24;
+static const uint8_t blob_not_set = 0xff;
+
+static void put16(std::vector<uint8_t> &b, uint v) {
+    b.push_back((uint8_t)v);
+    b.push_back((uint8_t)(v >> 8));
+}
+
+static uint8_t shift_byte(const compiled_source::in_out &io) {
+    return (uint8_t)((io.right ? 1 : 0) | (io.autop ? 2 : 0) | ((io.threshold & 0x3f) << 2));
+}
+
+static std::vector<uint8_t> encode_blob(const compiled_source::program &program) {
+    std::vector<uint8_t> b;
+    b.push_back('P');
+    b.push_back('I');
+    b.push_back('O');
+    b.push_back('B');
+    b.push_back(blob_version);
+    b.push_back(blob_header_size);
+    b.push_back((uint8_t)program.instructions.size());
+    b.push_back((uint8_t)program.origin.get());
+    b.push_back((uint8_t)program.pio_version);
+    b.push_back((uint8_t)program.wrap_target);
+    b.push_back((uint8_t)program.wrap);
+    uint8_t sideset = 0;
+    if (program.sideset_bits_including_opt.is_specified()) {
+        sideset = (uint8_t)(0x80 | (program.sideset_pindirs ? 0x40 : 0) | (program.sideset_opt ? 0x20 : 0) |
+                            program.sideset_bits_including_opt.get());
+    }
+    b.push_back(sideset);
+    b.push_back(program.used_gpio_ranges);
+    // as enum pio_fifo_join
+    static const uint8_t fifo_join[] = {0, 1, 2, 4, 8, 12};
+    b.push_back(fifo_join[(int)program.fifo]);
+    b.push_back(program.in.pin_count >= 0 ? (uint8_t)program.in.pin_count : blob_not_set);
+    b.push_back(shift_byte(program.in));
+    b.push_back(program.out.pin_count >= 0 ? (uint8_t)program.out.pin_count : blob_not_set);
+    b.push_back(shift_byte(program.out));
+    b.push_back(program.set_count >= 0 ? (uint8_t)program.set_count : blob_not_set);
+    b.push_back(program.mov_status_type >= 0 ? (uint8_t)program.mov_status_type : blob_not_set);
+    b.push_back((uint8_t)program.mov_status_n);
+    b.push_back((uint8_t)program.clock_div_frac);
+    put16(b, program.clock_div_int);
+    for (uint inst : program.instructions) {
+        put16(b, inst);
+    }
+    return b;
+}
+
+struct bin_output : public output_format {
+    struct factory {
+        factory() {
+            output_format::add(new bin_output());
+        }
+    };
+
+    bin_output() : output_format("bin") {}
+
+    std::string get_description() override {
+        return "Binary program blobs for pio_add_program_from_blob(), one after another for each program";
+    }
+
+    int output(std::string destination, std::vector<std::string> output_options,
+               const compiled_source &source) override {
+        FILE *out = destination == "-" ? stdout : fopen(destination.c_str(), "wb");
+        if (!out) {
+            std::cerr << "Can't open output file '" << destination << "'" << std::endl;
+            return 1;
+        }
+        for (const auto &program : source.programs) {
+            auto blob = encode_blob(program);
+            fwrite(blob.data(), 1, blob.size(), out);
+        }
+        if (out != stdout) { fclose(out); }
+        return 0;
+    }
+};
+
+struct c_blob_output : public output_format {
+    struct factory {
+        factory() {
+            output_format::add(new c_blob_output());
+        }
+    };
+
+    c_blob_output() : output_format("c-blob") {}
+
+    std::string get_description() override {
+        return "C header with a program blob array for pio_add_program_from_blob() for each program";
+    }
+
+    int output(std::string destination, std::vector<std::string> output_options,
+               const compiled_source &source) override {
+        FILE *out = open_single_output(destination);
+        if (!out) return 1;
+
+        fprintf(out, "// This file is autogenerated by pioasm version %s; do not edit!\n\n", PIOASM_VERSION_STRING);
+        fprintf(out, "#pragma once\n\n");
+        fprintf(out, "#include <stdint.h>\n");
+        for (const auto &program : source.programs) {
+            auto blob = encode_blob(program);
+            fprintf(out, "\n// %s: %d instructions, %d bytes\n", program.name.c_str(), (int)program.instructions.size(),
+                    (int)blob.size());
+            fprintf(out, "static const uint8_t __attribute__((aligned(4))) %s_program_blob[] = {\n   ", program.name.c_str());
+            for (size_t i = 0; i < blob_header_size; i++) {
+                fprintf(out, " 0x%02x,", blob[i]);
+            }
+            fprintf(out, "\n");
+            for (size_t i = blob_header_size; i < blob.size(); i += 2) {
+                uint inst = program.instructions[(i - blob_header_size) / 2];
+                fprintf(out, "    0x%02x, 0x%02x, // %s\n", blob[i], blob[i + 1],
+                        disassemble(inst, program.sideset_bits_including_opt.get(), program.sideset_opt).c_str());
+            }
+            fprintf(out, "};\n");
+        }
+        if (out != stdout) { fclose(out); }
+        return 0;
+    }
+};
+
+static bin_output::factory bin_creator;
+static c_blob_output::factory c_blob_creator;
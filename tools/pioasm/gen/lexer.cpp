@@ -2907,6 +2907,9 @@ void pio_assembler::scan_begin ()
       std::cerr << "cannot open " << source << ": " << strerror(errno) << '\n';
       exit (EXIT_FAILURE);
     }
+  // reset the scanner, which may already have been used for a previous file
+  yyrestart (yyin);
+  BEGIN (INITIAL);
 }
 
 void pio_assembler::scan_end ()
@@ -4,14 +4,19 @@
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include "pio_assembler.h"
+#include "pio_output_cache.h"
 #include "version.h"
 
 #define DEFAULT_OUTPUT_FORMAT "c-sdk"
 
 void usage() {
-    std::cerr << "usage: pioasm <options> <input> (<output>)\n\n";
+    std::cerr << "usage: pioasm <options> <input> (<output>)\n";
+    std::cerr << "       pioasm <options> -m <input> <output> (<input> <output>...)\n\n";
     std::cerr << "Assemble file of PIO program(s) for use in applications.\n";
     std::cerr << "   <input>             the input filename\n";
     std::cerr << "   <output>            the output filename (or filename prefix if the output format produces multiple outputs).\n";
@@ -25,17 +30,114 @@ void usage() {
     }
     std::cerr << "  -p <output_param>    add a parameter to be passed to the output format generator" << std::endl;
     std::cerr << "  -v <version>         specify the default PIO version (0 or 1)" << std::endl;
+    std::cerr << "  -O                   optimise programs to use fewer instructions (without changing their timing)" << std::endl;
+    std::cerr << "  -m                   assemble multiple input files, each to its own output, with the same options" << std::endl;
+    std::cerr << "  -c <cache_dir>       reuse the output from an existing directory of previously generated outputs if the" << std::endl;
+    std::cerr << "                       input file and options are unchanged" << std::endl;
     std::cerr << "  --version            print pioasm version information" << std::endl;
     std::cerr << "  -?, --help           print this help and exit\n";
 }
 
+// copies everything written to a stream buffer into a string as well
+struct capturing_buf : public std::streambuf {
+    explicit capturing_buf(std::streambuf *target) : target(target) {}
+
+    int overflow(int c) override {
+        if (c == traits_type::eof()) return traits_type::not_eof(c);
+        captured += traits_type::to_char_type(c);
+        return target->sputc(traits_type::to_char_type(c));
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+        captured.append(s, (size_t)n);
+        return target->sputn(s, n);
+    }
+
+    int sync() override {
+        return target->pubsync();
+    }
+
+    std::streambuf *target;
+    std::string captured;
+};
+
+static bool read_file(const std::string &name, std::string &contents) {
+    std::ifstream in(name, std::ios::binary);
+    if (!in) return false;
+    std::stringstream ss;
+    ss << in.rdbuf();
+    contents = ss.str();
+    return !in.bad();
+}
+
+// move a newly generated output into place, leaving the existing output untouched (along with its timestamp, so
+// nothing that depends on it is rebuilt) if the contents are the same
+static int update_output(const std::string &tmp, const std::string &output) {
+    std::string generated, existing;
+    if (read_file(tmp, generated) && read_file(output, existing) && generated == existing) {
+        std::remove(tmp.c_str());
+        return 0;
+    }
+    // rename does not replace an existing file on Windows
+    std::remove(output.c_str());
+    if (std::rename(tmp.c_str(), output.c_str())) {
+        std::cerr << "Can't write output file '" << output << "'" << std::endl;
+        std::remove(tmp.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+static int generate(const pio_assembler &settings, const std::shared_ptr<output_format> &format,
+                    const std::string &input, const std::string &output, const std::vector<std::string> &options,
+                    const pio_output_cache *cache) {
+    std::string key;
+    if (cache) {
+        std::vector<std::string> cache_settings = {format->name, std::to_string(settings.default_pio_version),
+                                                   settings.optimize ? "O" : ""};
+        cache_settings.insert(cache_settings.end(), options.begin(), options.end());
+        key = pio_output_cache::key(input, cache_settings);
+        if (!key.empty() && cache->restore(key, output)) return 0;
+    }
+    // a fresh assembler for each file, as it accumulates the programs it has parsed
+    pio_assembler pioasm;
+    pioasm.default_pio_version = settings.default_pio_version;
+    pioasm.optimize = settings.optimize;
+    if (key.empty()) {
+        return pioasm.generate(format, input, output, options);
+    }
+    capturing_buf warnings(std::cerr.rdbuf());
+    std::cerr.rdbuf(&warnings);
+    int res = pioasm.generate(format, input, output, options);
+    std::cerr.rdbuf(warnings.target);
+    if (!res) cache->store(key, output, warnings.captured);
+    return res;
+}
+
+static int assemble(const pio_assembler &settings, const std::shared_ptr<output_format> &format,
+                    const std::string &input, const std::string &output, const std::vector<std::string> &options,
+                    const pio_output_cache *cache) {
+    if (output == "-") {
+        return generate(settings, format, input, output, options, cache);
+    }
+    std::string tmp = output + ".tmp";
+    int res = generate(settings, format, input, tmp, options, cache);
+    if (res) {
+        std::remove(tmp.c_str());
+        return res;
+    }
+    return update_output(tmp, output);
+}
+
 int main(int argc, char *argv[]) {
     int res = 0;
     pio_assembler pioasm;
     std::string format(DEFAULT_OUTPUT_FORMAT);
-    const char *input = nullptr;
-    const char *output = nullptr;
+    std::vector<std::string> inputs;
+    std::vector<std::string> outputs;
     std::vector<std::string> options;
+    bool multiple = false;
+    std::string cache_dir;
     int i = 1;
     for (; !res && i < argc; i++) {
         if (argv[i][0] != '-') break;
@@ -65,6 +167,17 @@ int main(int argc, char *argv[]) {
                 std::cerr << "error: -v requires version number" << std::endl;
                 res = 1;
             }
+        } else if (argv[i] == std::string("-O")) {
+            pioasm.optimize = true;
+        } else if (argv[i] == std::string("-m")) {
+            multiple = true;
+        } else if (argv[i] == std::string("-c")) {
+            if (++i < argc) {
+                cache_dir = argv[i];
+            } else {
+                std::cerr << "error: -c requires cache directory" << std::endl;
+                res = 1;
+            }
         } else if (argv[i] == std::string("-?") || argv[i] == std::string("--help")) {
             usage();
             return 1;
@@ -76,19 +189,29 @@ int main(int argc, char *argv[]) {
             res = 1;
         }
     }
-    if (!res) {
+    if (!res && multiple) {
+        if (i == argc || (argc - i) % 2) {
+            std::cerr << "error: -m requires pairs of input and output filenames\n";
+            res = 1;
+        }
+        for (; !res && i < argc; i += 2) {
+            inputs.emplace_back(argv[i]);
+            outputs.emplace_back(argv[i + 1]);
+        }
+    }
+    if (!res && !multiple) {
         if (i != argc) {
-            input = argv[i++];
+            inputs.emplace_back(argv[i++]);
         } else {
             std::cerr << "error: expected input filename\n";
             res = 1;
         }
     }
-    if (!res) {
+    if (!res && !multiple) {
         if (i != argc) {
-            output = argv[i++];
+            outputs.emplace_back(argv[i++]);
         } else {
-            output = "-";
+            outputs.emplace_back("-");
         }
     }
     if (!res && i != argc) {
@@ -112,7 +235,12 @@ int main(int argc, char *argv[]) {
         std::cerr << std::endl;
         usage();
     } else {
-        res = pioasm.generate(oformat, input, output, options);
+        std::unique_ptr<pio_output_cache> cache;
+        if (!cache_dir.empty()) cache.reset(new pio_output_cache(cache_dir));
+        // carry on after a failure, so all errors are reported
+        for (size_t n = 0; n < inputs.size(); n++) {
+            if (assemble(pioasm, oformat, inputs[n], outputs[n], options, cache.get())) res = 1;
+        }
     }
     return res;
-}
\ No newline at end of file
+}
@@ -85,6 +85,7 @@ struct compiled_source {
         fifo_config fifo;
         std::vector<uint> instructions;
         std::vector<symbol> symbols; // public only
+        std::vector<symbol> labels; // all labels, for analysis
         std::map<std::string, std::vector<std::string>> code_blocks;
         std::map<std::string, std::vector<std::pair<std::string,std::string>>> lang_opts;
 
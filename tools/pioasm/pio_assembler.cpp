@@ -7,6 +7,7 @@
 #include <cstdio>
 #include <iterator>
 #include "pio_assembler.h"
+#include "pio_optimizer.h"
 #include "parser.hpp"
 
 #ifdef _MSC_VER
@@ -527,6 +528,15 @@ int pio_assembler::write_output() {
         });
         cprogram.lang_opts = program.lang_opts;
         cprogram.symbols = public_symbols(program);
+        for (const auto &s : program.ordered_symbols) {
+            if (s->is_label) cprogram.labels.emplace_back(s->name, s->value->resolve(program), true);
+        }
+        if (optimize) {
+            std::string error;
+            if (!optimize_program(cprogram, error)) {
+                std::cerr << program.location << ": warning, " << error << "\n";
+            }
+        }
     }
     if (programs.empty()) {
         std::cout << "warning: input contained no programs" << std::endl;
@@ -36,6 +36,8 @@ public:
     std::string dest;
     std::vector<std::string> options;
     int default_pio_version = 0;
+    // run the peephole optimiser over each program before output
+    bool optimize = false;
 
     int write_output();
 
@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <functional>
+#include <sstream>
+#include "pio_optimizer.h"
+#include "pio_simulator.h"
+
+namespace {
+
+const uint NO_SUCCESSOR = ~0u;
+
+enum : uint {
+    OP_JMP = 0, OP_WAIT, OP_IN, OP_OUT, OP_PUSH_PULL, OP_MOV, OP_IRQ, OP_SET
+};
+
+const uint DEST_X = 1;
+const uint DEST_Y = 2;
+
+// The program being optimised, with helpers for decoding the instruction fields we care about
+struct optimizer {
+    compiled_source::program &program;
+    uint sideset_bits;
+    uint delay_bits;
+    uint max_delay;
+
+    explicit optimizer(compiled_source::program &program) : program(program) {
+        sideset_bits = program.sideset_bits_including_opt.get();
+        delay_bits = 5 - sideset_bits;
+        max_delay = (1u << delay_bits) - 1;
+    }
+
+    uint size() const { return (uint)program.instructions.size(); }
+    uint inst(uint i) const { return program.instructions[i]; }
+    static uint opcode(uint inst) { return inst >> 13u; }
+    static uint arg1(uint inst) { return (inst >> 5u) & 7u; }
+    static uint arg2(uint inst) { return inst & 0x1fu; }
+    uint delay(uint i) const { return (inst(i) >> 8u) & max_delay; }
+    uint sideset_field(uint i) const { return ((inst(i) >> 8u) & 0x1fu) >> delay_bits; }
+
+    bool has_sideset(uint i) const {
+        if (program.sideset_opt) return inst(i) & 0x1000u;
+        return sideset_bits != 0;
+    }
+
+    bool is_jmp(uint i) const { return opcode(inst(i)) == OP_JMP; }
+    bool is_unconditional_jmp(uint i) const { return is_jmp(i) && !arg1(inst(i)); }
+
+    // OUT/MOV PC or EXEC mean we can't know where control goes
+    bool is_dynamic(uint i) const {
+        uint op = opcode(inst(i)), dest = arg1(inst(i));
+        return (op == OP_OUT && (dest == 5 || dest == 7)) || (op == OP_MOV && (dest == 4 || dest == 5));
+    }
+
+    // the instruction which would follow i in the program, allowing for the .wrap
+    uint natural_next(uint i) const {
+        if (i == (uint)program.wrap) return program.wrap_target;
+        return i + 1 < size() ? i + 1 : NO_SUCCESSOR;
+    }
+
+    // the instruction executed after i when i doesn't jump
+    uint fall_through(uint i) const {
+        if (is_unconditional_jmp(i)) return NO_SUCCESSOR;
+        return natural_next(i);
+    }
+
+    // an unconditional JMP to where execution would have gone anyway
+    bool is_jmp_to_next(uint i) const {
+        return is_unconditional_jmp(i) && arg2(inst(i)) == natural_next(i);
+    }
+
+    bool is_entry(uint i) const {
+        if (!i) return true;
+        for (const auto &s : program.symbols) {
+            if (s.is_label && s.value == (int)i) return true;
+        }
+        return false;
+    }
+
+    bool is_jmp_target(uint n) const {
+        for (uint i = 0; i < size(); i++) {
+            if (is_jmp(i) && arg2(inst(i)) == n) return true;
+        }
+        return false;
+    }
+
+    // the only way to reach n is by falling through from the returned instruction (or NO_SUCCESSOR if not)
+    uint sole_predecessor(uint n) const {
+        if (is_entry(n) || is_jmp_target(n)) return NO_SUCCESSOR;
+        uint pred = NO_SUCCESSOR;
+        for (uint i = 0; i < size(); i++) {
+            if (fall_through(i) == n) {
+                if (pred != NO_SUCCESSOR) return NO_SUCCESSOR;
+                pred = i;
+            }
+        }
+        return pred;
+    }
+
+    // scratch register (DEST_X/DEST_Y) written by a SET/MOV with no other effect, else 0
+    uint pure_scratch_write(uint i) const {
+        uint op = opcode(inst(i)), dest = arg1(inst(i));
+        if ((op == OP_SET || op == OP_MOV) && (dest == DEST_X || dest == DEST_Y)) return dest;
+        return 0;
+    }
+
+    static bool reads_scratch(uint inst, uint reg) {
+        switch (opcode(inst)) {
+            case OP_JMP:
+                // !x, x--, !y, y--, x!=y
+                return arg1(inst) == 5 || (reg == DEST_X ? arg1(inst) == 1 || arg1(inst) == 2 : arg1(inst) == 3 || arg1(inst) == 4);
+            case OP_WAIT:
+            case OP_IRQ:
+                return false;
+            case OP_IN:
+            case OP_MOV:
+                return (inst & 7u) == reg;
+            case OP_PUSH_PULL:
+                // MOV RXFIFO[y], ISR / MOV OSR, RXFIFO[y]
+                return reg == DEST_Y && (inst & 0x10u) && !(inst & 0x08u);
+            default:
+                return false;
+        }
+    }
+
+    static bool overwrites_scratch(uint inst, uint reg) {
+        uint op = opcode(inst);
+        return (op == OP_SET || op == OP_MOV || op == OP_OUT) && arg1(inst) == reg && !reads_scratch(inst, reg);
+    }
+
+    // MOV x, x and MOV y, y (the latter being NOP)
+    bool is_nop(uint i) const {
+        uint in = inst(i);
+        return opcode(in) == OP_MOV && (arg1(in) == DEST_X || arg1(in) == DEST_Y) && !(in & 0x18u) && (in & 7u) == arg1(in);
+    }
+
+    // an instruction which has no effect other than taking its cycles and asserting its side-set
+    bool is_redundant(uint i) const {
+        if (is_nop(i) || is_jmp_to_next(i)) return true;
+        uint reg = pure_scratch_write(i);
+        if (!reg) return false;
+        // written again, without being read, by the only instruction which follows
+        uint next = fall_through(i);
+        if (next != NO_SUCCESSOR && next != i && sole_predecessor(next) == i && overwrites_scratch(inst(next), reg)) {
+            return true;
+        }
+        // the same write was just done by the only instruction which precedes
+        uint pred = sole_predecessor(i);
+        if (pred != NO_SUCCESSOR && pred != i && ((inst(pred) ^ inst(i)) & ~0x1f00u) == 0) {
+            uint src = inst(i) & 7u;
+            if (opcode(inst(i)) == OP_SET) return true;
+            // MOV from a source the MOV itself doesn't change: X, Y, NULL, ISR, OSR
+            return src != reg && (src == 1 || src == 2 || src == 3 || src == 6 || src == 7);
+        }
+        return false;
+    }
+
+    // can the cycles and side-set of n be given to pred instead?
+    bool can_absorb(uint pred, uint n) const {
+        if (is_jmp(pred)) return false;
+        if (delay(pred) + 1 + delay(n) > max_delay) return false;
+        return !has_sideset(n) || (has_sideset(pred) && sideset_field(pred) == sideset_field(n));
+    }
+
+    void add_delay(uint i, uint cycles) {
+        uint d = delay(i) + cycles;
+        program.instructions[i] = (inst(i) & ~(max_delay << 8u)) | (d << 8u);
+    }
+
+    // remove instructions [first, first + count); references to them are redirected (before the removal) by 'redirect'
+    void remove(uint first, uint count, const std::function<uint(uint)> &redirect) {
+        auto remap = [&](uint i) {
+            if (i >= first && i < first + count) i = redirect(i);
+            return i >= first + count ? i - count : i;
+        };
+        program.instructions.erase(program.instructions.begin() + first, program.instructions.begin() + first + count);
+        for (auto &in : program.instructions) {
+            if (opcode(in) == OP_JMP) in = (in & ~0x1fu) | remap(arg2(in));
+        }
+        for (auto &s : program.symbols) {
+            if (s.is_label) s.value = (int)remap((uint)s.value);
+        }
+        for (auto &s : program.labels) {
+            s.value = (int)remap((uint)s.value);
+        }
+        program.wrap = (int)remap((uint)program.wrap);
+        program.wrap_target = (int)remap((uint)program.wrap_target);
+    }
+
+    bool fold_redundant() {
+        for (uint n = 0; n < size(); n++) {
+            if (!is_redundant(n)) continue;
+            uint pred = sole_predecessor(n);
+            uint next = is_jmp_to_next(n) ? natural_next(n) : fall_through(n);
+            if (pred == NO_SUCCESSOR || pred == n || next == NO_SUCCESSOR || next == n || !can_absorb(pred, n)) continue;
+            add_delay(pred, 1 + delay(n));
+            // if n is the .wrap, its predecessor (n - 1) now wraps; if n is the .wrap_target, so is what followed it
+            if (n == (uint)program.wrap) program.wrap = (int)pred;
+            remove(n, 1, [&](uint) { return next; });
+            return true;
+        }
+        return false;
+    }
+
+    bool remove_jmp_at_wrap() {
+        uint j = program.wrap;
+        if (!is_unconditional_jmp(j)) return false;
+        uint target = arg2(inst(j));
+        uint pred = sole_predecessor(j);
+        if (target == j || target >= size() || pred == NO_SUCCESSOR || !can_absorb(pred, j)) return false;
+        add_delay(pred, 1 + delay(j));
+        program.wrap = (int)pred;
+        program.wrap_target = (int)target;
+        remove(j, 1, [&](uint) { return target; });
+        return true;
+    }
+
+    bool merge_tails() {
+        for (uint e = 0; e < size(); e++) {
+            if (!is_unconditional_jmp(e)) continue;
+            for (uint b = e; b > 0; b--) {
+                // [b, e] must run straight through, and b must not be fallen into from b - 1
+                if (b != e && (is_unconditional_jmp(b) || b == (uint)program.wrap)) break;
+                if (fall_through(b - 1) == b) continue;
+                uint len = e - b + 1;
+                for (uint a_end = len - 1; a_end < size(); a_end++) {
+                    if (a_end >= b && a_end - len + 1 <= e) continue; // overlaps
+                    bool match = true;
+                    for (uint k = 0; k < len && match; k++) {
+                        uint a = a_end - k;
+                        match = inst(a) == inst(e - k) && (!k || a != (uint)program.wrap);
+                    }
+                    if (!match) continue;
+                    // (if the .wrap is on the final JMP it moves to the matching JMP; neither falls through)
+                    remove(b, len, [&](uint i) { return a_end - (e - i); });
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool optimize() {
+        for (uint i = 0; i < size(); i++) {
+            if (is_dynamic(i)) return false;
+            // falling off the end of the program isn't something we can reason about
+            if (fall_through(i) == NO_SUCCESSOR && !is_unconditional_jmp(i)) return false;
+        }
+        bool changed = false;
+        // merging tails first, as folding into the end of a tail can stop it matching
+        while (merge_tails() || fold_redundant() || remove_jmp_at_wrap()) {
+            changed = true;
+        }
+        return changed;
+    }
+};
+
+uint32_t next_random(uint32_t &state) {
+    // xorshift32
+    state ^= state << 13u;
+    state ^= state >> 17u;
+    state ^= state << 5u;
+    return state;
+}
+
+// Run both programs from the given entry points with the same pseudo-random stimulus, returning a
+// description of the first difference seen, or an empty string if none
+std::string compare_in_simulator(const compiled_source::program &a, uint a_entry,
+                                 const compiled_source::program &b, uint b_entry, uint32_t seed) {
+    const uint CYCLES = 4096;
+    pio_sim sims[2] = {pio_sim(a.pio_version), pio_sim(b.pio_version)};
+    const compiled_source::program *programs[2] = {&a, &b};
+    uint entries[2] = {a_entry, b_entry};
+    for (int i = 0; i < 2; i++) {
+        pio_sim &sim = sims[i];
+        sim.load_program(*programs[i], 0);
+        sim.configure_from_program(0, *programs[i], 0);
+        pio_sim::sm_config &c = sim.sm[0].config;
+        // give each kind of pin write its own pins so that all of them are visible
+        c.out_base = 0;
+        c.out_count = 8;
+        c.set_base = 8;
+        c.set_count = 5;
+        c.sideset_base = 13;
+        c.in_base = 0;
+        c.jmp_pin = 2;
+        c.clkdiv_int = 1;
+        c.clkdiv_frac = 0;
+        sim.sm[0].x = sim.sm[0].y = seed;
+        sim.restart(0, entries[i]);
+        sim.set_enabled(0, true);
+    }
+    uint32_t rand = seed;
+    uint input_period = 1 + (seed & 15u);
+    for (uint cycle = 0; cycle < CYCLES; cycle++) {
+        if (!(cycle % input_period)) {
+            uint64_t input = next_random(rand);
+            for (auto &sim : sims) sim.gpio_external_in = input;
+        }
+        uint32_t tx = next_random(rand);
+        uint32_t rx[2] = {};
+        bool rx_valid[2];
+        for (int i = 0; i < 2; i++) {
+            pio_sim &sim = sims[i];
+            if (sim.sm[0].tx_level < sim.tx_capacity(0)) sim.tx_put(0, tx);
+            sim.step();
+            rx_valid[i] = sim.sm[0].rx_level && sim.rx_get(0, rx[i]);
+        }
+        std::stringstream diff;
+        if (sims[0].gpio_out != sims[1].gpio_out || sims[0].gpio_oe != sims[1].gpio_oe) {
+            diff << "GPIO outputs";
+        } else if (sims[0].irq_flags != sims[1].irq_flags) {
+            diff << "IRQ flags";
+        } else if (rx_valid[0] != rx_valid[1] || rx[0] != rx[1]) {
+            diff << "RX FIFO data";
+        } else if (sims[0].sm[0].tx_level != sims[1].sm[0].tx_level) {
+            diff << "TX FIFO consumption";
+        } else {
+            continue;
+        }
+        diff << " differ at cycle " << cycle;
+        return diff.str();
+    }
+    return "";
+}
+
+}
+
+bool optimize_program(compiled_source::program &program, std::string &error) {
+    compiled_source::program original = program;
+    optimizer opt(program);
+    if (!opt.optimize()) return true;
+
+    // check from each entry point: the start of the program and each public label
+    std::vector<std::pair<uint, uint>> entries = {{0, 0}};
+    for (uint i = 0; i < original.symbols.size(); i++) {
+        if (original.symbols[i].is_label) {
+            entries.emplace_back(original.symbols[i].value, program.symbols[i].value);
+        }
+    }
+    for (const auto &e : entries) {
+        for (uint32_t seed : {0x12345678u, 0x9abcdef1u, 0x0badf00du, 0xdeadbeefu}) {
+            std::string diff = compare_in_simulator(original, e.first, program, e.second, seed);
+            if (!diff.empty()) {
+                std::stringstream msg;
+                msg << "optimised program '" << program.name << "' does not match the original when started at "
+                    << e.first << " (" << diff << "); leaving it unoptimised";
+                error = msg.str();
+                program = original;
+                return false;
+            }
+        }
+    }
+    return true;
+}
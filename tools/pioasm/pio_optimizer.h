@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PIO_OPTIMIZER_H
+#define _PIO_OPTIMIZER_H
+
+#include <string>
+#include "output_format.h"
+
+// Peephole optimisation of a compiled program, reducing its instruction count without changing its cycle
+// timing or its externally visible behaviour:
+//
+// - a NOP (or an instruction made redundant: a write to X/Y which is overwritten before being read, a
+//   repeat of the same SET/MOV to X/Y, or an unconditional JMP to the instruction which follows it anyway) is
+//   folded into the delay field of the instruction before it
+// - an unconditional JMP at the .wrap is removed by moving the .wrap to the instruction before it and the
+//   .wrap_target to the JMP's target, with the JMP's cycle moved into that instruction's delay
+// - a block reached only by JMPs which is identical to the tail of another block ending in the same JMP is
+//   removed, and the JMPs (and labels) pointing into it are redirected
+//
+// Each of these only applies where the removed instruction has a single predecessor which can absorb its
+// cycles (delay bits permitting) and side-set, and is not an entry point (instruction 0 or a public label);
+// programs using OUT/MOV PC or EXEC are left alone. The public labels, .wrap and .wrap_target of the program
+// are updated to match.
+//
+// The result is checked by running the original and optimised programs side by side on the simulator with
+// pseudo-random inputs from each entry point; if their GPIO, IRQ or RX FIFO activity ever differs the
+// original program is kept, and false is returned with a description in 'error'.
+bool optimize_program(compiled_source::program &program, std::string &error);
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <utility>
+#include "pio_output_cache.h"
+#include "version.h"
+
+static bool read_file(const std::string &name, std::string &contents) {
+    std::ifstream in(name, std::ios::binary);
+    if (!in) return false;
+    std::stringstream ss;
+    ss << in.rdbuf();
+    contents = ss.str();
+    return !in.bad();
+}
+
+static bool write_file(const std::string &name, const std::string &contents) {
+    std::ofstream out(name, std::ios::binary | std::ios::trunc);
+    out << contents;
+    out.close();
+    return !out.fail();
+}
+
+// 128 bits from two FNV-1a hashes with different offsets
+struct content_hash {
+    uint64_t h[2] = {0xcbf29ce484222325ull, 0x6c62272e07bb0142ull};
+
+    void add(const std::string &s) {
+        // length prefixed, so that the boundaries between fields matter
+        add_bytes(std::to_string(s.size()) + ":");
+        add_bytes(s);
+    }
+
+    void add_bytes(const std::string &s) {
+        for (unsigned char c : s) {
+            for (auto &v : h) {
+                v ^= c;
+                v *= 0x100000001b3ull;
+            }
+        }
+    }
+
+    std::string str() const {
+        char buf[33];
+        snprintf(buf, sizeof(buf), "%016llx%016llx", (unsigned long long)h[0], (unsigned long long)h[1]);
+        return buf;
+    }
+};
+
+std::string pio_output_cache::key(const std::string &input, const std::vector<std::string> &settings) {
+    std::string contents;
+    if (input.empty() || input == "-" || !read_file(input, contents)) return "";
+    content_hash hash;
+    hash.add(PIOASM_VERSION_STRING);
+    // the name appears in any warnings
+    hash.add(input);
+    hash.add(contents);
+    for (const auto &s : settings) {
+        hash.add(s);
+    }
+    return hash.str();
+}
+
+bool pio_output_cache::restore(const std::string &key, const std::string &dest) const {
+    std::string output, warnings;
+    if (!read_file(path(key), output)) return false;
+    read_file(path(key) + ".log", warnings);
+    if (dest == "-") {
+        std::cout << output;
+    } else if (!write_file(dest, output)) {
+        return false;
+    }
+    std::cerr << warnings;
+    return true;
+}
+
+void pio_output_cache::store(const std::string &key, const std::string &dest, const std::string &warnings) const {
+    std::string output;
+    if (dest == "-" || !read_file(dest, output)) return;
+    // the log is written first, as the presence of the output marks a complete entry. rename fails on Windows
+    // if another process has already stored the entry, which is fine as the contents are the same
+    std::random_device rd;
+    std::string tmp = path(key) + ".tmp" + std::to_string(rd());
+    typedef std::pair<std::string, const std::string *> file;
+    for (const auto &f : {file(path(key) + ".log", &warnings), file(path(key), &output)}) {
+        if (!write_file(tmp, *f.second) || std::rename(tmp.c_str(), f.first.c_str())) {
+            std::remove(tmp.c_str());
+            return;
+        }
+    }
+}
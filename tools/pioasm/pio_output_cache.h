@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PIO_OUTPUT_CACHE_H
+#define _PIO_OUTPUT_CACHE_H
+
+#include <string>
+#include <vector>
+
+// Cache of generated output files, keyed by a hash of the input file name and contents, the pioasm version,
+// and the settings (output format, parameters, PIO version, optimisation) used to generate them.
+//
+// Each entry is a copy of the output, stored as <dir>/<key>, along with any warnings printed while generating
+// it (<dir>/<key>.log) so they can be repeated when the entry is used. Entries are written to a temporary file
+// and renamed into place, so the directory may be shared by concurrent pioasm processes. Only successful
+// results written to a file are stored; entries are never removed.
+struct pio_output_cache {
+    explicit pio_output_cache(std::string dir) : dir(std::move(dir)) {}
+
+    // returns an empty key if the input cannot be read
+    static std::string key(const std::string &input, const std::vector<std::string> &settings);
+
+    // copy a cached output to dest ("-" for stdout) and replay its warnings; false if there is no entry
+    bool restore(const std::string &key, const std::string &dest) const;
+
+    void store(const std::string &key, const std::string &dest, const std::string &warnings) const;
+
+private:
+    std::string dir;
+
+    std::string path(const std::string &key) const { return dir + "/" + key; }
+};
+
+#endif
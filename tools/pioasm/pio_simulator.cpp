@@ -0,0 +1,461 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <algorithm>
+#include "pio_simulator.h"
+
+static inline uint32_t rotl32(uint32_t v, uint n) {
+    n &= 31u;
+    return n ? (v << n) | (v >> (32u - n)) : v;
+}
+
+static inline uint32_t rotr32(uint32_t v, uint n) {
+    n &= 31u;
+    return n ? (v >> n) | (v << (32u - n)) : v;
+}
+
+static inline uint32_t low_mask(uint bits) {
+    return bits >= 32 ? 0xffffffffu : (1u << bits) - 1u;
+}
+
+static inline uint32_t bit_reverse(uint32_t v) {
+    v = ((v >> 1) & 0x55555555u) | ((v & 0x55555555u) << 1);
+    v = ((v >> 2) & 0x33333333u) | ((v & 0x33333333u) << 2);
+    v = ((v >> 4) & 0x0f0f0f0fu) | ((v & 0x0f0f0f0fu) << 4);
+    v = ((v >> 8) & 0x00ff00ffu) | ((v & 0x00ff00ffu) << 8);
+    return (v >> 16) | (v << 16);
+}
+
+pio_sim::pio_sim(int pio_version) : pio_version(pio_version) {
+}
+
+bool pio_sim::load_program(const compiled_source::program &program, uint offset) {
+    if (offset + program.instructions.size() > INSTRUCTION_COUNT) return false;
+    for (uint i = 0; i < program.instructions.size(); i++) {
+        uint16_t instr = (uint16_t)program.instructions[i];
+        // relocate JMPs, as pio_add_program does
+        if (!(instr >> 13u)) {
+            instr = (uint16_t)((instr & ~0x1fu) | (((instr & 0x1fu) + offset) & 0x1fu));
+        }
+        instr_mem[offset + i] = instr;
+    }
+    return true;
+}
+
+void pio_sim::configure_from_program(uint sm_num, const compiled_source::program &program, uint offset) {
+    sm_config &c = sm[sm_num].config;
+    c.wrap_target = offset + program.wrap_target;
+    c.wrap = offset + program.wrap;
+    if (program.sideset_bits_including_opt.is_specified()) {
+        c.sideset_bits_including_opt = program.sideset_bits_including_opt.get();
+        c.sideset_opt = program.sideset_opt;
+        c.sideset_pindirs = program.sideset_pindirs;
+    } else {
+        c.sideset_bits_including_opt = 0;
+        c.sideset_opt = false;
+        c.sideset_pindirs = false;
+    }
+    if (program.in.pin_count >= 0) {
+        c.in_count = program.in.pin_count;
+        c.in_shift_right = program.in.right;
+        c.autopush = program.in.autop;
+        c.push_threshold = program.in.threshold ? program.in.threshold : 32;
+    }
+    if (program.out.pin_count >= 0) {
+        c.out_count = program.out.pin_count;
+        c.out_shift_right = program.out.right;
+        c.autopull = program.out.autop;
+        c.pull_threshold = program.out.threshold ? program.out.threshold : 32;
+    }
+    if (program.set_count >= 0) {
+        c.set_count = program.set_count;
+    }
+    if (program.mov_status_type >= 0) {
+        c.mov_status_type = program.mov_status_type;
+        c.mov_status_n = program.mov_status_n;
+    }
+    c.fifo = program.fifo;
+    c.clkdiv_int = program.clock_div_int;
+    c.clkdiv_frac = program.clock_div_frac;
+}
+
+void pio_sim::restart(uint sm_num, uint pc) {
+    state_machine &s = sm[sm_num];
+    s.pc = pc & (INSTRUCTION_COUNT - 1);
+    s.isr_count = 0;
+    s.osr_count = 32;
+    s.delay = 0;
+    s.stalled = false;
+    s.exec_pending = false;
+    s.irq_wait_pending = false;
+    s.autopush_pending = false;
+    s.clk_acc = 0;
+}
+
+uint pio_sim::tx_capacity(uint sm_num) const {
+    switch (sm[sm_num].config.fifo) {
+        case fifo_config::tx: return 2 * FIFO_DEPTH;
+        case fifo_config::rx: return 0;
+        default: return FIFO_DEPTH;
+    }
+}
+
+uint pio_sim::rx_capacity(uint sm_num) const {
+    switch (sm[sm_num].config.fifo) {
+        case fifo_config::txrx: return FIFO_DEPTH;
+        case fifo_config::rx: return 2 * FIFO_DEPTH;
+        default: return 0; // joined to the TX FIFO, or used as put/get registers
+    }
+}
+
+bool pio_sim::tx_put(uint sm_num, uint32_t value) {
+    state_machine &s = sm[sm_num];
+    if (s.tx_level >= tx_capacity(sm_num)) {
+        fdebug |= 1u << (FDEBUG_TXOVER_LSB + sm_num);
+        return false;
+    }
+    s.tx_fifo[(s.tx_head + s.tx_level++) & (2 * FIFO_DEPTH - 1)] = value;
+    return true;
+}
+
+bool pio_sim::rx_get(uint sm_num, uint32_t &value) {
+    state_machine &s = sm[sm_num];
+    if (!s.rx_level) {
+        fdebug |= 1u << (FDEBUG_RXUNDER_LSB + sm_num);
+        return false;
+    }
+    value = s.rx_fifo[s.rx_head];
+    s.rx_head = (s.rx_head + 1) & (2 * FIFO_DEPTH - 1);
+    s.rx_level--;
+    return true;
+}
+
+bool pio_sim::push(state_machine &s) {
+    if (s.rx_level >= rx_capacity((uint)(&s - sm))) return false;
+    s.rx_fifo[(s.rx_head + s.rx_level++) & (2 * FIFO_DEPTH - 1)] = s.isr;
+    s.isr = 0;
+    s.isr_count = 0;
+    return true;
+}
+
+bool pio_sim::pull(state_machine &s) {
+    if (!s.tx_level) return false;
+    s.osr = s.tx_fifo[s.tx_head];
+    s.tx_head = (s.tx_head + 1) & (2 * FIFO_DEPTH - 1);
+    s.tx_level--;
+    s.osr_count = 0;
+    return true;
+}
+
+void pio_sim::write_pins(uint base, uint count, uint32_t values, bool pindirs) {
+    uint64_t mask = (uint64_t)rotl32(low_mask(count), base) << gpio_base;
+    uint64_t bits = (uint64_t)rotl32(values, base) << gpio_base;
+    uint64_t &reg = pindirs ? gpio_oe : gpio_out;
+    reg = (reg & ~mask) | (bits & mask);
+}
+
+uint32_t pio_sim::read_in_pins(const state_machine &s) const {
+    uint32_t v = rotr32(cycle_pins_in, s.config.in_base);
+    if (pio_version > 0 && s.config.in_count) v &= low_mask(s.config.in_count);
+    return v;
+}
+
+uint pio_sim::irq_index(uint sm_num, uint arg) const {
+    uint idx = arg & 7u;
+    if ((arg & 0x18u) == 0x10u) {
+        // rel
+        idx = (idx & 4u) | ((idx + sm_num) & 3u);
+    }
+    return idx;
+}
+
+uint32_t pio_sim::mov_status(const state_machine &s) const {
+    bool b;
+    switch (s.config.mov_status_type) {
+        case 0: b = s.tx_level < s.config.mov_status_n; break;
+        case 1: b = s.rx_level < s.config.mov_status_n; break;
+        default: b = (cycle_irq_flags >> (s.config.mov_status_n & 7u)) & 1u; break;
+    }
+    return b ? 0xffffffffu : 0;
+}
+
+void pio_sim::advance_pc(state_machine &s) {
+    s.pc = s.pc == s.config.wrap ? s.config.wrap_target : (s.pc + 1) & (INSTRUCTION_COUNT - 1);
+}
+
+// returns false if the instruction stalled
+bool pio_sim::execute(uint sm_num, uint16_t instr, bool &jumped) {
+    state_machine &s = sm[sm_num];
+    const sm_config &c = s.config;
+    uint arg1 = (instr >> 5u) & 7u;
+    uint arg2 = instr & 0x1fu;
+    switch (instr >> 13u) {
+        case 0b000: { // JMP
+            bool take;
+            switch (arg1) {
+                case 0: take = true; break;
+                case 1: take = !s.x; break;
+                case 2: take = s.x != 0; s.x--; break;
+                case 3: take = !s.y; break;
+                case 4: take = s.y != 0; s.y--; break;
+                case 5: take = s.x != s.y; break;
+                case 6: take = (cycle_pins_in >> (c.jmp_pin & 31u)) & 1u; break;
+                default: take = s.osr_count < c.pull_threshold; break;
+            }
+            if (take) {
+                s.pc = arg2;
+                jumped = true;
+            }
+            return true;
+        }
+        case 0b001: { // WAIT
+            uint polarity = arg1 >> 2u;
+            uint level;
+            switch (arg1 & 3u) {
+                case 0: level = (cycle_pins_in >> arg2) & 1u; break;
+                case 1: level = (cycle_pins_in >> ((c.in_base + arg2) & 31u)) & 1u; break;
+                case 2: {
+                    // prev/next refer to IRQ flags in neighbouring PIO blocks, which are not modelled
+                    if (pio_version > 0 && (arg2 & 0x08u)) return true;
+                    uint idx = irq_index(sm_num, arg2);
+                    level = (cycle_irq_flags >> idx) & 1u;
+                    if (level == polarity && polarity) irq_clear_mask |= (uint8_t)(1u << idx);
+                    break;
+                }
+                default: level = (cycle_pins_in >> ((c.jmp_pin + (arg2 & 3u)) & 31u)) & 1u; break;
+            }
+            return level == polarity;
+        }
+        case 0b010: { // IN
+            if (!s.autopush_pending) {
+                uint bit_count = arg2 ? arg2 : 32;
+                uint32_t data;
+                switch (arg1) {
+                    case 0: data = read_in_pins(s); break;
+                    case 1: data = s.x; break;
+                    case 2: data = s.y; break;
+                    case 6: data = s.isr; break;
+                    case 7: data = s.osr; break;
+                    default: data = 0; break;
+                }
+                data &= low_mask(bit_count);
+                if (bit_count == 32) {
+                    s.isr = data;
+                } else if (c.in_shift_right) {
+                    s.isr = (s.isr >> bit_count) | (data << (32 - bit_count));
+                } else {
+                    s.isr = (s.isr << bit_count) | data;
+                }
+                s.isr_count = std::min(32u, s.isr_count + bit_count);
+                if (!c.autopush || s.isr_count < c.push_threshold) return true;
+            }
+            // the shift has been done; stall (without shifting again) until the push succeeds
+            s.autopush_pending = !push(s);
+            if (s.autopush_pending) fdebug |= 1u << (FDEBUG_RXSTALL_LSB + sm_num);
+            return !s.autopush_pending;
+        }
+        case 0b011: { // OUT
+            if (c.autopull && s.osr_count >= c.pull_threshold && !pull(s)) {
+                fdebug |= 1u << (FDEBUG_TXSTALL_LSB + sm_num);
+                return false;
+            }
+            uint bit_count = arg2 ? arg2 : 32;
+            uint32_t data;
+            if (bit_count == 32) {
+                data = s.osr;
+                s.osr = 0;
+            } else if (c.out_shift_right) {
+                data = s.osr & low_mask(bit_count);
+                s.osr >>= bit_count;
+            } else {
+                data = s.osr >> (32 - bit_count);
+                s.osr <<= bit_count;
+            }
+            s.osr_count = std::min(32u, s.osr_count + bit_count);
+            switch (arg1) {
+                case 0: write_pins(c.out_base, c.out_count, data, false); break;
+                case 1: s.x = data; break;
+                case 2: s.y = data; break;
+                case 4: write_pins(c.out_base, c.out_count, data, true); break;
+                case 5: s.pc = data & (INSTRUCTION_COUNT - 1); jumped = true; break;
+                case 6: s.isr = data; s.isr_count = bit_count; break;
+                case 7: s.exec_pending = true; s.exec_instr = (uint16_t)data; break;
+                default: break;
+            }
+            // refill in the background so that jmp !osre sees a full OSR
+            if (c.autopull && s.osr_count >= c.pull_threshold) pull(s);
+            return true;
+        }
+        case 0b100: { // PUSH/PULL, and MOV to/from the RX FIFO storage on PIO version 1
+            if (arg2) {
+                uint idx = (arg2 & 0x08u) ? (arg2 & 3u) : (s.y & 3u);
+                if (arg1 & 4u) {
+                    s.osr = s.rxf_regs[idx];
+                    s.osr_count = 0;
+                } else {
+                    s.rxf_regs[idx] = s.isr;
+                    s.isr_count = 0;
+                }
+                return true;
+            }
+            bool if_flag = arg1 & 2u;
+            bool block = arg1 & 1u;
+            if (!(arg1 & 4u)) {
+                if (if_flag && s.isr_count < c.push_threshold) return true;
+                if (!push(s)) {
+                    if (block) {
+                        fdebug |= 1u << (FDEBUG_RXSTALL_LSB + sm_num);
+                        return false;
+                    }
+                    // noblock: the data is lost
+                    s.isr = 0;
+                    s.isr_count = 0;
+                }
+            } else {
+                // with autopull enabled a PULL of a non-empty OSR is a no-op
+                if ((if_flag || c.autopull) && s.osr_count < c.pull_threshold) return true;
+                if (!pull(s)) {
+                    if (block) {
+                        fdebug |= 1u << (FDEBUG_TXSTALL_LSB + sm_num);
+                        return false;
+                    }
+                    // noblock: copy X to the OSR
+                    s.osr = s.x;
+                    s.osr_count = 0;
+                }
+            }
+            return true;
+        }
+        case 0b101: { // MOV
+            uint32_t data;
+            switch (arg2 & 7u) {
+                case 0: data = read_in_pins(s); break;
+                case 1: data = s.x; break;
+                case 2: data = s.y; break;
+                case 5: data = mov_status(s); break;
+                case 6: data = s.isr; break;
+                case 7: data = s.osr; break;
+                default: data = 0; break;
+            }
+            switch ((arg2 >> 3u) & 3u) {
+                case 1: data = ~data; break;
+                case 2: data = bit_reverse(data); break;
+                default: break;
+            }
+            switch (arg1) {
+                case 0: write_pins(c.out_base, c.out_count, data, false); break;
+                case 1: s.x = data; break;
+                case 2: s.y = data; break;
+                case 3: write_pins(c.out_base, c.out_count, data, true); break;
+                case 4: s.exec_pending = true; s.exec_instr = (uint16_t)data; break;
+                case 5: s.pc = data & (INSTRUCTION_COUNT - 1); jumped = true; break;
+                case 6: s.isr = data; s.isr_count = 0; break;
+                default: s.osr = data; s.osr_count = 0; break;
+            }
+            return true;
+        }
+        case 0b110: { // IRQ
+            // prev/next refer to IRQ flags in neighbouring PIO blocks, which are not modelled
+            if (pio_version > 0 && (arg2 & 0x08u)) return true;
+            uint8_t bit = (uint8_t)(1u << irq_index(sm_num, arg2));
+            if (arg1 & 2u) {
+                irq_clear_mask |= bit;
+                return true;
+            }
+            if (!(arg1 & 1u)) {
+                irq_set_mask |= bit;
+                return true;
+            }
+            if (!s.irq_wait_pending) {
+                irq_set_mask |= bit;
+                s.irq_wait_pending = true;
+                return false;
+            }
+            if (cycle_irq_flags & bit) return false;
+            s.irq_wait_pending = false;
+            return true;
+        }
+        default: { // SET
+            switch (arg1) {
+                case 0: write_pins(c.set_base, c.set_count, arg2, false); break;
+                case 1: s.x = arg2; break;
+                case 2: s.y = arg2; break;
+                case 4: write_pins(c.set_base, c.set_count, arg2, true); break;
+                default: break;
+            }
+            return true;
+        }
+    }
+}
+
+void pio_sim::sm_cycle(uint sm_num) {
+    state_machine &s = sm[sm_num];
+    const sm_config &c = s.config;
+    s.cycles++;
+    if (s.delay) {
+        s.delay--;
+        return;
+    }
+    bool from_exec = s.exec_pending;
+    uint16_t instr = from_exec ? s.exec_instr : instr_mem[s.pc];
+    s.exec_pending = false;
+
+    uint delay_sideset = (instr >> 8u) & 0x1fu;
+    uint sideset_bits = c.sideset_bits_including_opt;
+    uint delay = delay_sideset & low_mask(5 - sideset_bits);
+
+    bool jumped = false;
+    bool done = execute(sm_num, instr, jumped);
+
+    // side-set is asserted on the first cycle the instruction is issued even if it stalls, and takes
+    // priority over an OUT/SET to the same pins
+    if (sideset_bits && (!c.sideset_opt || (delay_sideset & 0x10u))) {
+        uint count = sideset_bits - (c.sideset_opt ? 1 : 0);
+        uint32_t value = (delay_sideset >> (5 - sideset_bits)) & low_mask(count);
+        write_pins(c.sideset_base, count, value, c.sideset_pindirs);
+    }
+
+    if (!done) {
+        if (from_exec) s.exec_pending = true;
+        s.stalled = true;
+        s.stall_cycles++;
+        return;
+    }
+    s.stalled = false;
+    s.instructions++;
+    // an EXEC'd instruction does not advance the PC
+    if (!jumped && !from_exec) advance_pc(s);
+    // the delay on an OUT/MOV EXEC is ignored
+    s.delay = s.exec_pending ? 0 : delay;
+}
+
+void pio_sim::step() {
+    uint32_t pads = (uint32_t)(gpio_pad_values() >> gpio_base);
+    if (input_sync_bypass) {
+        cycle_pins_in = pads;
+    } else {
+        cycle_pins_in = pins_in_sync[1];
+        pins_in_sync[1] = pins_in_sync[0];
+        pins_in_sync[0] = pads;
+    }
+    cycle_irq_flags = irq_flags;
+    irq_set_mask = irq_clear_mask = 0;
+    for (uint i = 0; i < NUM_STATE_MACHINES; i++) {
+        state_machine &s = sm[i];
+        if (!s.enabled) continue;
+        uint div = s.config.clkdiv_int ? (s.config.clkdiv_int << 8u) + s.config.clkdiv_frac : 0x1000000u;
+        s.clk_acc += 256;
+        if (s.clk_acc < div) continue;
+        s.clk_acc -= div;
+        sm_cycle(i);
+    }
+    irq_flags = (uint8_t)((irq_flags & ~irq_clear_mask) | irq_set_mask);
+    cycle++;
+}
+
+void pio_sim::run(uint64_t cycles) {
+    while (cycles--) step();
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PIO_SIMULATOR_H
+#define _PIO_SIMULATOR_H
+
+#include <cstdint>
+#include "output_format.h"
+
+// Simulates one PIO block (instruction memory, four state machines, FIFOs, IRQ flags and the GPIOs it
+// can see) one system clock cycle at a time.
+//
+// The model follows the datasheet's description of instruction timing: an instruction takes one cycle plus
+// its delay, a stalled instruction is re-evaluated each cycle (with its side-set asserted from the first),
+// OUT/MOV EXEC executes the written instruction on the next cycle, and all state machines observe the IRQ
+// flags and GPIO inputs as they were at the start of the cycle. GPIO inputs pass through the two-stage
+// input synchronizer unless it is bypassed.
+//
+// Not modelled: IRQ flags of neighbouring PIO blocks (irq prev/next are ignored), the system-level
+// interrupt outputs, and DMA (the FIFOs are accessed directly via tx_put/rx_get).
+struct pio_sim {
+    static const uint NUM_STATE_MACHINES = 4;
+    static const uint INSTRUCTION_COUNT = 32;
+    static const uint FIFO_DEPTH = 4;
+
+    // FDEBUG bits, as in the hardware register
+    static const uint32_t FDEBUG_RXSTALL_LSB = 0;
+    static const uint32_t FDEBUG_RXUNDER_LSB = 8;
+    static const uint32_t FDEBUG_TXOVER_LSB = 16;
+    static const uint32_t FDEBUG_TXSTALL_LSB = 24;
+
+    struct sm_config {
+        uint clkdiv_int = 1;
+        uint clkdiv_frac = 0; // in 1/256ths
+        uint wrap_target = 0;
+        uint wrap = INSTRUCTION_COUNT - 1;
+        uint sideset_bits_including_opt = 0;
+        bool sideset_opt = false;
+        bool sideset_pindirs = false;
+        uint sideset_base = 0;
+        uint out_base = 0;
+        uint out_count = 0;
+        uint set_base = 0;
+        uint set_count = 0;
+        uint in_base = 0;
+        uint in_count = 0; // PIO version 1 only; 0 means all 32 pins
+        uint jmp_pin = 0;
+        bool in_shift_right = true;
+        bool out_shift_right = true;
+        bool autopush = false;
+        bool autopull = false;
+        uint push_threshold = 32;
+        uint pull_threshold = 32;
+        fifo_config fifo = fifo_config::txrx;
+        int mov_status_type = 0; // as compiled_source::program::mov_status_type
+        uint mov_status_n = 0;
+    };
+
+    struct state_machine {
+        sm_config config;
+        bool enabled = false;
+        uint pc = 0;
+        uint32_t x = 0, y = 0, isr = 0, osr = 0;
+        uint isr_count = 0;
+        uint osr_count = 32;
+        uint delay = 0;
+        bool stalled = false;
+        bool exec_pending = false;
+        uint16_t exec_instr = 0;
+        bool irq_wait_pending = false;
+        bool autopush_pending = false;
+        uint32_t tx_fifo[2 * FIFO_DEPTH];
+        uint32_t rx_fifo[2 * FIFO_DEPTH];
+        uint tx_head = 0, tx_level = 0;
+        uint rx_head = 0, rx_level = 0;
+        uint32_t rxf_regs[FIFO_DEPTH] = {};
+        uint clk_acc = 0;
+        // statistics
+        uint64_t cycles = 0;        // cycles on which the state machine was clocked
+        uint64_t instructions = 0;  // instructions completed
+        uint64_t stall_cycles = 0;  // cycles spent stalled
+    };
+
+    explicit pio_sim(int pio_version = 0);
+
+    int pio_version;
+    uint16_t instr_mem[INSTRUCTION_COUNT] = {};
+    state_machine sm[NUM_STATE_MACHINES];
+    uint8_t irq_flags = 0;
+    uint32_t fdebug = 0;
+    uint gpio_base = 0; // PIO version 1 only; 0 or 16
+    bool input_sync_bypass = false;
+    uint64_t cycle = 0;
+
+    // pad state (up to 48 GPIOs)
+    uint64_t gpio_out = 0;
+    uint64_t gpio_oe = 0;
+    uint64_t gpio_external_in = 0;
+
+    // Copy a program into instruction memory at the given offset, relocating its JMPs.
+    // Returns false if it does not fit.
+    bool load_program(const compiled_source::program &program, uint offset);
+
+    // Set a state machine's configuration from the program's directives (wrap, side-set, shift
+    // configuration, pin counts, FIFO join, clock divider etc.); pin bases are left unchanged.
+    void configure_from_program(uint sm_num, const compiled_source::program &program, uint offset);
+
+    // Reset a state machine's internal state (not its configuration or FIFOs) and jump to pc
+    void restart(uint sm_num, uint pc);
+
+    void set_enabled(uint sm_num, bool enabled) {
+        sm[sm_num].enabled = enabled;
+    }
+
+    // Execute an instruction on a state machine immediately (as via SMx_INSTR); it takes effect on the next cycle
+    void exec(uint sm_num, uint16_t instr) {
+        sm[sm_num].exec_pending = true;
+        sm[sm_num].exec_instr = instr;
+        sm[sm_num].delay = 0;
+    }
+
+    // Advance the simulation by the given number of system clock cycles
+    void run(uint64_t cycles);
+    void step();
+
+    uint tx_capacity(uint sm_num) const;
+    uint rx_capacity(uint sm_num) const;
+
+    // Host side FIFO access; these set TXOVER/RXUNDER in fdebug on failure, like the hardware
+    bool tx_put(uint sm_num, uint32_t value);
+    bool rx_get(uint sm_num, uint32_t &value);
+
+    // Value of the GPIO pads as seen by the outside world (driven value where output enabled, else the external input)
+    uint64_t gpio_pad_values() const {
+        return (gpio_out & gpio_oe) | (gpio_external_in & ~gpio_oe);
+    }
+
+private:
+    uint32_t pins_in_sync[2] = {};
+    uint8_t irq_set_mask, irq_clear_mask;
+    uint32_t cycle_pins_in; // pins as seen by the state machines this cycle, relative to gpio_base
+    uint8_t cycle_irq_flags;
+
+    void sm_cycle(uint sm_num);
+    bool execute(uint sm_num, uint16_t instr, bool &jumped);
+    void write_pins(uint base, uint count, uint32_t values, bool pindirs);
+    uint32_t read_in_pins(const state_machine &s) const;
+    uint irq_index(uint sm_num, uint arg) const;
+    uint32_t mov_status(const state_machine &s) const;
+    bool push(state_machine &s);
+    bool pull(state_machine &s);
+    void advance_pc(state_machine &s);
+};
+
+#endif
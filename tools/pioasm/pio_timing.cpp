@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <algorithm>
+#include <functional>
+#include "pio_timing.h"
+
+pio_timing::pio_timing(const compiled_source::program &program) : program(program) {
+    uint count = (uint)program.instructions.size();
+    instructions.resize(count);
+    for (uint i = 0; i < count; i++) {
+        analyze_instruction(i);
+    }
+    points.push_back(program.wrap_target);
+    for (const auto &l : program.labels) {
+        if (l.value >= 0 && (uint)l.value < count) points.push_back(l.value);
+    }
+    for (uint i = 0; i < count; i++) {
+        uint inst = program.instructions[i];
+        if (!(inst >> 13u) && (inst & 0x1fu) < count) points.push_back(inst & 0x1fu);
+    }
+    std::sort(points.begin(), points.end());
+    points.erase(std::unique(points.begin(), points.end()), points.end());
+    for (uint p : points) {
+        find_paths(p);
+    }
+    find_wrap_loop();
+}
+
+bool pio_timing::is_point(uint index) const {
+    return std::binary_search(points.begin(), points.end(), index);
+}
+
+std::string pio_timing::point_name(uint index) const {
+    for (const auto &l : program.labels) {
+        if (l.value == (int)index) return l.name;
+    }
+    if (index == (uint)program.wrap_target) return ".wrap_target";
+    return std::to_string(index);
+}
+
+void pio_timing::analyze_instruction(uint index) {
+    instruction_info &info = instructions[index];
+    uint inst = program.instructions[index];
+    uint sideset_bits = program.sideset_bits_including_opt.get();
+    info.cycles = 1 + (((inst >> 8u) & 0x1fu) & ((1u << (5 - sideset_bits)) - 1u));
+    uint arg1 = (inst >> 5u) & 7u;
+    uint arg2 = inst & 0x1fu;
+    uint count = (uint)program.instructions.size();
+    uint next = index == (uint)program.wrap ? (uint)program.wrap_target : index + 1;
+    bool falls_through = true;
+    switch (inst >> 13u) {
+        case 0b000: // JMP
+            if (arg2 < count) info.successors.push_back(arg2); else info.dynamic = true;
+            falls_through = arg1 != 0;
+            break;
+        case 0b001: // WAIT
+            info.may_stall = true;
+            break;
+        case 0b010: // IN
+            info.may_stall = program.in.autop;
+            break;
+        case 0b011: // OUT
+            info.may_stall = program.out.autop;
+            if (arg1 == 5 || arg1 == 7) {
+                // OUT PC / OUT EXEC
+                info.dynamic = true;
+                falls_through = arg1 == 7;
+            }
+            break;
+        case 0b100: // PUSH/PULL (or MOV to/from RX FIFO storage)
+            info.may_stall = !arg2 && (arg1 & 1u);
+            break;
+        case 0b101: // MOV
+            if (arg1 == 4 || arg1 == 5) {
+                // MOV EXEC / MOV PC
+                info.dynamic = true;
+                falls_through = arg1 == 4;
+            }
+            break;
+        case 0b110: // IRQ
+            info.may_stall = (arg1 & 3u) == 1;
+            break;
+        default:
+            break;
+    }
+    if (falls_through && next < count) info.successors.push_back(next);
+}
+
+void pio_timing::find_paths(uint from) {
+    // depth first over the (acyclic) graph until the next point is reached on each branch
+    std::function<void(uint, uint, bool, bool, bool)> visit = [&](uint index, uint cycles, bool stall, bool dynamic, bool wrapped) {
+        const instruction_info &info = instructions[index];
+        cycles += info.cycles;
+        stall |= info.may_stall;
+        dynamic |= info.dynamic;
+        for (uint next : info.successors) {
+            bool via_wrap = wrapped || (index == (uint)program.wrap && next == (uint)program.wrap_target && next != index + 1);
+            if (is_point(next)) {
+                auto p = std::find_if(paths.begin(), paths.end(), [&](const path &p) {
+                    return p.from == from && p.to == next;
+                });
+                if (p == paths.end()) {
+                    paths.push_back({from, next, cycles, cycles, stall, dynamic, via_wrap});
+                } else {
+                    p->min_cycles = std::min(p->min_cycles, cycles);
+                    p->max_cycles = std::max(p->max_cycles, cycles);
+                    p->may_stall |= stall;
+                    p->dynamic |= dynamic;
+                    p->via_wrap |= via_wrap;
+                }
+            } else {
+                visit(next, cycles, stall, dynamic, via_wrap);
+            }
+        }
+    };
+    visit(from, 0, false, false, false);
+}
+
+void pio_timing::find_wrap_loop() {
+    uint start = program.wrap_target;
+    if (start >= instructions.size()) return;
+    // simple paths only; the programs are tiny, but bound the work anyway
+    uint budget = 100000;
+    uint32_t visited = 0;
+    std::function<void(uint, uint, bool, bool)> visit = [&](uint index, uint cycles, bool stall, bool dynamic) {
+        if (!budget--) return;
+        const instruction_info &info = instructions[index];
+        cycles += info.cycles;
+        stall |= info.may_stall;
+        dynamic |= info.dynamic;
+        visited |= 1u << index;
+        for (uint next : info.successors) {
+            if (next == start) {
+                if (!wrap_loop_found) {
+                    wrap_loop_found = true;
+                    wrap_loop_min = wrap_loop_max = cycles;
+                } else {
+                    wrap_loop_min = std::min(wrap_loop_min, cycles);
+                    wrap_loop_max = std::max(wrap_loop_max, cycles);
+                }
+                wrap_loop_may_stall |= stall;
+                wrap_loop_dynamic |= dynamic;
+            } else if (!(visited & (1u << next))) {
+                visit(next, cycles, stall, dynamic);
+            }
+        }
+        visited &= ~(1u << index);
+    };
+    visit(start, 0, false, false);
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#ifndef _PIO_TIMING_H
+#define _PIO_TIMING_H
+
+#include <string>
+#include <vector>
+#include "output_format.h"
+
+// Static cycle count analysis of a compiled program.
+//
+// The program is split at "points": labels, JMP targets and the .wrap_target. Every path from one point to
+// the next point reached is acyclic, so its minimum and maximum cycle counts (one cycle per instruction plus
+// its delay) can be found exactly. Instructions which can stall (WAIT, blocking PUSH/PULL, IRQ WAIT, IN/OUT
+// with autopush/autopull) only contribute their minimum, and the path is flagged; paths through OUT/MOV PC
+// or EXEC cannot be followed and are flagged as dynamic.
+struct pio_timing {
+    struct instruction_info {
+        uint cycles = 1;           // 1 + delay
+        bool may_stall = false;
+        bool dynamic = false;      // destination (or executed instruction) not known statically
+        std::vector<uint> successors;
+    };
+
+    struct path {
+        uint from, to;
+        uint min_cycles, max_cycles;
+        bool may_stall;
+        bool dynamic;
+        bool via_wrap;             // the path wraps from .wrap to .wrap_target
+    };
+
+    std::vector<instruction_info> instructions;
+    std::vector<uint> points;      // instruction indices
+    std::vector<path> paths;
+
+    // one pass around the .wrap loop, i.e. .wrap_target back to itself, taking each inner loop at most once
+    bool wrap_loop_found = false;
+    uint wrap_loop_min = 0, wrap_loop_max = 0;
+    bool wrap_loop_may_stall = false;
+    bool wrap_loop_dynamic = false;
+
+    explicit pio_timing(const compiled_source::program &program);
+
+    // name of a point: its first label, ".wrap_target", or its address
+    std::string point_name(uint index) const;
+
+private:
+    const compiled_source::program &program;
+
+    bool is_point(uint index) const;
+    void analyze_instruction(uint index);
+    void find_paths(uint from);
+    void find_wrap_loop();
+};
+
+#endif
@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include "output_format.h"
+#include "pio_disassembler.h"
+#include "pio_simulator.h"
+
+struct sim_output : public output_format {
+    struct factory {
+        factory() {
+            output_format::add(new sim_output());
+        }
+    };
+
+    sim_output() : output_format("sim") {}
+
+    std::string get_description() override {
+        return "Run a program on a simulated state machine, printing GPIO changes and RX FIFO contents (see -p sim options below)";
+    }
+
+    static void usage() {
+        std::cerr << "sim options (-p name=value):\n";
+        std::cerr << "  program=<name>       program to run (default: the first)\n";
+        std::cerr << "  cycles=<n>           number of system clock cycles to simulate (default 1000)\n";
+        std::cerr << "  offset=<n>           instruction memory offset to load at (default: origin, or 0)\n";
+        std::cerr << "  out_base=, set_base=, sideset_base=, in_base=, jmp_pin=\n";
+        std::cerr << "                       state machine pin mapping (default 0)\n";
+        std::cerr << "  out_count=, set_count=, in_count=\n";
+        std::cerr << "                       override the pin counts from the program's directives\n";
+        std::cerr << "  gpio_base=<n>        PIO version 1 GPIO base (0 or 16)\n";
+        std::cerr << "  clkdiv=<f>           override the program's clock divider\n";
+        std::cerr << "  input=<n>            value driven onto the GPIOs from outside\n";
+        std::cerr << "  tx=<n>[,<n>...]      values fed into the TX FIFO as space becomes available\n";
+        std::cerr << "  x=<n>, y=<n>         initial scratch register values\n";
+        std::cerr << "  sync_bypass=1        bypass the input synchronizers\n";
+        std::cerr << "  trace=1              print every instruction as it completes\n";
+    }
+
+    static bool parse_number(const std::string &s, uint64_t &value) {
+        try {
+            size_t pos;
+            value = std::stoull(s, &pos, 0);
+            return pos == s.size();
+        } catch (...) {
+            return false;
+        }
+    }
+
+    static bool parse_float(const std::string &s, float &value) {
+        char *end;
+        value = strtof(s.c_str(), &end);
+        return !s.empty() && !*end;
+    }
+
+    int output(std::string destination, std::vector<std::string> output_options,
+               const compiled_source &source) override {
+        std::map<std::string, std::string> opts;
+        for (const auto &o : output_options) {
+            auto eq = o.find('=');
+            if (eq == std::string::npos) {
+                std::cerr << "error: sim option '" << o << "' should be of the form name=value\n";
+                usage();
+                return 1;
+            }
+            opts[o.substr(0, eq)] = o.substr(eq + 1);
+        }
+        if (source.programs.empty()) {
+            std::cerr << "error: no program to simulate\n";
+            return 1;
+        }
+        const compiled_source::program *program = &source.programs[0];
+        if (opts.count("program")) {
+            auto p = std::find_if(source.programs.begin(), source.programs.end(),
+                                  [&](const compiled_source::program &p) { return p.name == opts["program"]; });
+            if (p == source.programs.end()) {
+                std::cerr << "error: unknown program '" << opts["program"] << "'\n";
+                return 1;
+            }
+            program = &*p;
+        }
+
+        std::map<std::string, uint64_t> values = {
+                {"cycles", 1000},
+                {"offset", program->origin.get() >= 0 ? program->origin.get() : 0},
+                {"out_base", 0}, {"set_base", 0}, {"sideset_base", 0}, {"in_base", 0}, {"jmp_pin", 0},
+                {"out_count", 0}, {"set_count", 0}, {"in_count", 0},
+                {"gpio_base", 0}, {"input", 0}, {"x", 0}, {"y", 0}, {"sync_bypass", 0}, {"trace", 0},
+        };
+        std::vector<uint32_t> tx;
+        float clkdiv = 0;
+        for (const auto &o : opts) {
+            if (o.first == "program") continue;
+            if (o.first == "tx") {
+                std::stringstream ss(o.second);
+                std::string item;
+                while (std::getline(ss, item, ',')) {
+                    uint64_t v;
+                    if (!parse_number(item, v)) {
+                        std::cerr << "error: invalid tx value '" << item << "'\n";
+                        return 1;
+                    }
+                    tx.push_back((uint32_t)v);
+                }
+            } else if (o.first == "clkdiv") {
+                if (!parse_float(o.second, clkdiv) || clkdiv < 1.0f || clkdiv >= 65536.0f) {
+                    std::cerr << "error: clkdiv must be between 1 and 65535\n";
+                    return 1;
+                }
+            } else if (!values.count(o.first)) {
+                std::cerr << "error: unknown sim option '" << o.first << "'\n";
+                usage();
+                return 1;
+            } else if (!parse_number(o.second, values[o.first])) {
+                std::cerr << "error: invalid value for sim option '" << o.first << "'\n";
+                return 1;
+            }
+        }
+
+        pio_sim sim(program->pio_version);
+        uint offset = (uint)values["offset"];
+        if (!sim.load_program(*program, offset)) {
+            std::cerr << "error: program does not fit at offset " << offset << "\n";
+            return 1;
+        }
+        sim.configure_from_program(0, *program, offset);
+        pio_sim::sm_config &c = sim.sm[0].config;
+        c.out_base = (uint)values["out_base"];
+        c.set_base = (uint)values["set_base"];
+        c.sideset_base = (uint)values["sideset_base"];
+        c.in_base = (uint)values["in_base"];
+        c.jmp_pin = (uint)values["jmp_pin"];
+        for (const auto &count : {std::make_pair("out_count", &c.out_count), std::make_pair("set_count", &c.set_count),
+                                  std::make_pair("in_count", &c.in_count)}) {
+            if (opts.count(count.first)) *count.second = (uint)values[count.first];
+        }
+        if (clkdiv) {
+            c.clkdiv_int = (uint)clkdiv;
+            c.clkdiv_frac = (uint)((clkdiv - (float)c.clkdiv_int) * 256.0f);
+        }
+        sim.gpio_base = (uint)values["gpio_base"];
+        sim.gpio_external_in = values["input"];
+        sim.input_sync_bypass = values["sync_bypass"] != 0;
+        sim.sm[0].x = (uint32_t)values["x"];
+        sim.sm[0].y = (uint32_t)values["y"];
+        // start at the beginning of the program, as pio_sm_init(pio, sm, offset, &c) does
+        sim.restart(0, offset);
+        sim.set_enabled(0, true);
+
+        FILE *out = open_single_output(destination);
+        if (!out) return 1;
+
+        bool trace = values["trace"] != 0;
+        uint sideset_bits = program->sideset_bits_including_opt.get();
+        fprintf(out, "; simulating '%s' at offset %d for %llu cycles\n", program->name.c_str(), offset,
+                (unsigned long long)values["cycles"]);
+        fprintf(out, "; %10s  %-18s %-18s\n", "cycle", "gpio", "oe");
+        uint64_t last_out = ~sim.gpio_out, last_oe = ~sim.gpio_oe;
+        size_t tx_index = 0;
+        const pio_sim::state_machine &s = sim.sm[0];
+        for (uint64_t cycle = 0; cycle < values["cycles"]; cycle++) {
+            while (tx_index < tx.size() && s.tx_level < sim.tx_capacity(0)) sim.tx_put(0, tx[tx_index++]);
+            uint pc = s.pc;
+            uint16_t instr = s.exec_pending ? s.exec_instr : sim.instr_mem[pc];
+            uint64_t completed = s.instructions;
+            sim.step();
+            if (trace && s.instructions != completed) {
+                fprintf(out, "  %10llu  %2d: %s\n", (unsigned long long)cycle, pc,
+                        disassemble(instr, sideset_bits, program->sideset_opt).c_str());
+            }
+            if (sim.gpio_out != last_out || sim.gpio_oe != last_oe) {
+                fprintf(out, "  %10llu  0x%016llx 0x%016llx\n", (unsigned long long)cycle,
+                        (unsigned long long)sim.gpio_out, (unsigned long long)sim.gpio_oe);
+                last_out = sim.gpio_out;
+                last_oe = sim.gpio_oe;
+            }
+            uint32_t rx;
+            while (s.rx_level && sim.rx_get(0, rx)) {
+                fprintf(out, "  %10llu  rx 0x%08x\n", (unsigned long long)cycle, rx);
+            }
+        }
+        fprintf(out, "; pc=%d x=0x%08x y=0x%08x isr=0x%08x osr=0x%08x%s\n", s.pc, s.x, s.y, s.isr, s.osr,
+                s.stalled ? " (stalled)" : "");
+        fprintf(out, "; %llu instructions, %llu stall cycles, %llu/%zu tx values consumed, fdebug=0x%08x\n",
+                (unsigned long long)s.instructions, (unsigned long long)s.stall_cycles,
+                (unsigned long long)(tx_index - s.tx_level), tx.size(), sim.fdebug);
+        if (out != stdout) { fclose(out); }
+        return 0;
+    }
+};
+
+static sim_output::factory creator;
@@ -0,0 +1,186 @@
+// ---------------------------------------------------------------- //
+// This file is autogenerated by pioasm version 2.1.0; do not edit! //
+// ---------------------------------------------------------------- //
+
+#pragma once
+
+#if !PICO_NO_HARDWARE
+#include "hardware/pio.h"
+#endif
+
+// -------- //
+// fold_nop //
+// -------- //
+
+#define fold_nop_wrap_target 0
+#define fold_nop_wrap 1
+#define fold_nop_pio_version 0
+
+static const uint16_t fold_nop_program_instructions[] = {
+            //     .wrap_target
+    0xe301, //  0: set    pins, 1                [3]
+    0xe200, //  1: set    pins, 0                [2]
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program fold_nop_program = {
+    .instructions = fold_nop_program_instructions,
+    .length = 2,
+    .origin = -1,
+    .pio_version = fold_nop_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config fold_nop_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + fold_nop_wrap_target, offset + fold_nop_wrap);
+    return c;
+}
+#endif
+
+// ------------ //
+// fold_scratch //
+// ------------ //
+
+#define fold_scratch_wrap_target 0
+#define fold_scratch_wrap 4
+#define fold_scratch_pio_version 0
+
+static const uint16_t fold_scratch_program_instructions[] = {
+            //     .wrap_target
+    0xe100, //  0: set    pins, 0                [1]
+    0xe025, //  1: set    x, 5
+    0xa101, //  2: mov    pins, x                [1]
+    0xa141, //  3: mov    y, x                   [1]
+    0xa002, //  4: mov    pins, y
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program fold_scratch_program = {
+    .instructions = fold_scratch_program_instructions,
+    .length = 5,
+    .origin = -1,
+    .pio_version = fold_scratch_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config fold_scratch_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + fold_scratch_wrap_target, offset + fold_scratch_wrap);
+    return c;
+}
+#endif
+
+// ----------- //
+// jmp_at_wrap //
+// ----------- //
+
+#define jmp_at_wrap_wrap_target 1
+#define jmp_at_wrap_wrap 2
+#define jmp_at_wrap_pio_version 0
+
+static const uint16_t jmp_at_wrap_program_instructions[] = {
+    0xe000, //  0: set    pins, 0
+            //     .wrap_target
+    0xe301, //  1: set    pins, 1                [3]
+    0xe102, //  2: set    pins, 2                [1]
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program jmp_at_wrap_program = {
+    .instructions = jmp_at_wrap_program_instructions,
+    .length = 3,
+    .origin = -1,
+    .pio_version = jmp_at_wrap_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config jmp_at_wrap_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + jmp_at_wrap_wrap_target, offset + jmp_at_wrap_wrap);
+    return c;
+}
+#endif
+
+// ----------- //
+// merge_tails //
+// ----------- //
+
+#define merge_tails_wrap_target 0
+#define merge_tails_wrap 3
+#define merge_tails_pio_version 0
+
+static const uint16_t merge_tails_program_instructions[] = {
+            //     .wrap_target
+    0x00c2, //  0: jmp    pin, 2
+    0xe001, //  1: set    pins, 1
+    0xe203, //  2: set    pins, 3                [2]
+    0xe000, //  3: set    pins, 0
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program merge_tails_program = {
+    .instructions = merge_tails_program_instructions,
+    .length = 4,
+    .origin = -1,
+    .pio_version = merge_tails_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config merge_tails_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + merge_tails_wrap_target, offset + merge_tails_wrap);
+    return c;
+}
+#endif
+
+// --------- //
+// unchanged //
+// --------- //
+
+#define unchanged_wrap_target 0
+#define unchanged_wrap 3
+#define unchanged_pio_version 0
+
+#define unchanged_offset_entry 2u
+
+static const uint16_t unchanged_program_instructions[] = {
+            //     .wrap_target
+    0xe001, //  0: set    pins, 1         side 0
+    0xb042, //  1: nop                    side 1
+    0xe000, //  2: set    pins, 0         side 0
+    0x1002, //  3: jmp    2               side 1
+            //     .wrap
+};
+
+#if !PICO_NO_HARDWARE
+static const struct pio_program unchanged_program = {
+    .instructions = unchanged_program_instructions,
+    .length = 4,
+    .origin = -1,
+    .pio_version = unchanged_pio_version,
+#if PICO_PIO_VERSION > 0
+    .used_gpio_ranges = 0x0
+#endif
+};
+
+static inline pio_sm_config unchanged_program_get_default_config(uint offset) {
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset + unchanged_wrap_target, offset + unchanged_wrap);
+    sm_config_set_sideset(&c, 1, false, false);
+    return c;
+}
+#endif
+
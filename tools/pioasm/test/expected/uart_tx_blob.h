@@ -0,0 +1,14 @@
+// This file is autogenerated by pioasm version 2.1.0; do not edit!
+
+#pragma once
+
+#include <stdint.h>
+
+// uart_tx: 4 instructions, 32 bytes
+static const uint8_t __attribute__((aligned(4))) uart_tx_program_blob[] = {
+    0x50, 0x49, 0x4f, 0x42, 0x01, 0x18, 0x04, 0xff, 0x00, 0x00, 0x03, 0xa2, 0x00, 0x00, 0xff, 0x00, 0xff, 0x00, 0xff, 0xff, 0x00, 0x00, 0x01, 0x00,
+    0xa0, 0x9f, // pull   block           side 1 [7]
+    0x27, 0xf7, // set    x, 7            side 0 [7]
+    0x01, 0x60, // out    pins, 1
+    0x42, 0x06, // jmp    x--, 2                 [6]
+};
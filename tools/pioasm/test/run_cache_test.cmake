@@ -0,0 +1,58 @@
+# Check the -c output cache, and that an output whose contents have not changed is left untouched:
+#
+# - a second run with the same input and options uses the cached output
+# - changing the options generates a fresh output
+# - regenerating an identical output does not rewrite the file
+function(run_pioasm)
+    execute_process(COMMAND ${PIOASM} ${ARGN}
+            RESULT_VARIABLE rc
+            ERROR_VARIABLE err)
+    if (NOT rc STREQUAL "0")
+        message(FATAL_ERROR "pioasm returned '${rc}':\n${err}")
+    endif()
+endfunction()
+
+set(CACHE_DIR ${OUTPUT}.cache)
+file(REMOVE_RECURSE ${CACHE_DIR})
+file(MAKE_DIRECTORY ${CACHE_DIR})
+file(REMOVE ${OUTPUT})
+
+run_pioasm(-c ${CACHE_DIR} ${INPUT} ${OUTPUT})
+file(READ ${OUTPUT} generated)
+file(GLOB entries LIST_DIRECTORIES false ${CACHE_DIR}/*)
+list(FILTER entries EXCLUDE REGEX "\\.log$")
+list(LENGTH entries count)
+if (NOT count EQUAL 1)
+    message(FATAL_ERROR "expected one cache entry, found: ${entries}")
+endif()
+file(READ ${entries} cached)
+if (NOT cached STREQUAL generated)
+    message(FATAL_ERROR "cache entry ${entries} differs from ${OUTPUT}")
+endif()
+
+# mark the entry, so its use can be seen
+file(APPEND ${entries} "// from the cache\n")
+run_pioasm(-c ${CACHE_DIR} ${INPUT} ${OUTPUT})
+file(READ ${OUTPUT} output)
+if (NOT output STREQUAL "${generated}// from the cache\n")
+    message(FATAL_ERROR "unchanged input did not use the cache entry")
+endif()
+
+run_pioasm(-c ${CACHE_DIR} -O ${INPUT} ${OUTPUT})
+file(READ ${OUTPUT} output)
+string(FIND "${output}" "// from the cache" pos)
+if (NOT pos EQUAL -1)
+    message(FATAL_ERROR "changed options used the cache entry for the old options")
+endif()
+
+# without the cache, an identical output is not rewritten
+file(TIMESTAMP ${OUTPUT} before "%s")
+execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.1)
+run_pioasm(-O ${INPUT} ${OUTPUT})
+file(TIMESTAMP ${OUTPUT} after "%s")
+if (NOT before STREQUAL after)
+    message(FATAL_ERROR "identical output ${OUTPUT} was rewritten")
+endif()
+if (EXISTS ${OUTPUT}.tmp)
+    message(FATAL_ERROR "temporary output ${OUTPUT}.tmp was left behind")
+endif()
@@ -0,0 +1,62 @@
+# Run pioasm on INPUT with ARGS (separated by '|') and check the result:
+#
+# - if EXPECT_ERROR is set, that pioasm reports an error containing EXPECT_ERROR
+# - if OTHER_ARGS is set, that the output matches the output with OTHER_ARGS instead, ignoring ';' comment lines
+# - otherwise that the output matches EXPECTED, ignoring the pioasm version in the header
+#
+# Set PIOASM_UPDATE_EXPECTED in the environment to overwrite EXPECTED with the new output instead.
+function(run_pioasm ARGS OUTPUT)
+    string(REPLACE "|" ";" ARGS "${ARGS}")
+    execute_process(COMMAND ${PIOASM} ${ARGS} ${INPUT} ${OUTPUT}
+            RESULT_VARIABLE rc
+            ERROR_VARIABLE err)
+    set(rc "${rc}" PARENT_SCOPE)
+    set(err "${err}" PARENT_SCOPE)
+endfunction()
+
+function(read_output FILE REGEX VAR)
+    file(READ ${FILE} text)
+    string(REGEX REPLACE "${REGEX}" "" text "${text}")
+    set(${VAR} "${text}" PARENT_SCOPE)
+endfunction()
+
+run_pioasm("${ARGS}" ${OUTPUT})
+
+if (DEFINED EXPECT_ERROR)
+    if (NOT rc STREQUAL "1")
+        message(FATAL_ERROR "pioasm returned '${rc}', expected an error:\n${err}")
+    endif()
+    string(FIND "${err}" "${EXPECT_ERROR}" pos)
+    if (pos EQUAL -1)
+        message(FATAL_ERROR "pioasm error did not contain '${EXPECT_ERROR}':\n${err}")
+    endif()
+    return()
+endif()
+
+if (NOT rc STREQUAL "0")
+    message(FATAL_ERROR "pioasm returned '${rc}':\n${err}")
+endif()
+
+if (DEFINED OTHER_ARGS)
+    run_pioasm("${OTHER_ARGS}" ${OUTPUT}.other)
+    if (NOT rc STREQUAL "0")
+        message(FATAL_ERROR "pioasm returned '${rc}':\n${err}")
+    endif()
+    set(regex "(^|\n);[^\n]*")
+    read_output(${OUTPUT} "${regex}" output)
+    read_output(${OUTPUT}.other "${regex}" other)
+    if (NOT output STREQUAL other)
+        message(FATAL_ERROR "output ${OUTPUT} differs from ${OUTPUT}.other")
+    endif()
+    return()
+endif()
+
+if (DEFINED ENV{PIOASM_UPDATE_EXPECTED})
+    configure_file(${OUTPUT} ${EXPECTED} COPYONLY)
+endif()
+set(regex "[^\n]*--------+[^\n]*\n[^\n]*pioasm version[^\n]*\n[^\n]*--------+[^\n]*\n|[^\n]*pioasm version[^\n]*\n")
+read_output(${OUTPUT} "${regex}" output)
+read_output(${EXPECTED} "${regex}" expected)
+if (NOT output STREQUAL expected)
+    message(FATAL_ERROR "output ${OUTPUT} differs from ${EXPECTED}")
+endif()
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include "output_format.h"
+#include "pio_disassembler.h"
+#include "pio_timing.h"
+
+struct timing_output : public output_format {
+    struct factory {
+        factory() {
+            output_format::add(new timing_output());
+        }
+    };
+
+    timing_output() : output_format("timing") {}
+
+    std::string get_description() override {
+        return "Cycle counts for each path between labels and for the .wrap loop (-p sysclk=<hz>, -p clkdiv=<f>; "
+               "programs may declare '.lang_opt timing rate = <hz>' and '.lang_opt timing period = <label>')";
+    }
+
+    static std::string flags(bool stall, bool dynamic) {
+        std::string s;
+        if (stall) s += " +stall";
+        if (dynamic) s += " +dynamic";
+        return s;
+    }
+
+    static bool parse_double(const std::string &s, double &value) {
+        char *end;
+        value = strtod(s.c_str(), &end);
+        return !s.empty() && !*end;
+    }
+
+    static std::string hz(double v) {
+        char buf[32];
+        snprintf(buf, sizeof(buf), "%.0f Hz", v);
+        return buf;
+    }
+
+    int output(std::string destination, std::vector<std::string> output_options,
+               const compiled_source &source) override {
+        double sysclk = 0;
+        double clkdiv_override = 0;
+        for (const auto &o : output_options) {
+            auto eq = o.find('=');
+            std::string key = o.substr(0, eq);
+            if (eq == std::string::npos || (key != "sysclk" && key != "clkdiv")) {
+                std::cerr << "error: unknown timing option '" << o << "'; expected sysclk=<hz> or clkdiv=<f>\n";
+                return 1;
+            }
+            double &value = key == "sysclk" ? sysclk : clkdiv_override;
+            if (!parse_double(o.substr(eq + 1), value) || value <= 0 || (key == "clkdiv" && (value < 1 || value >= 65536))) {
+                std::cerr << "error: invalid value for timing option '" << o << "'\n";
+                return 1;
+            }
+        }
+        FILE *out = open_single_output(destination);
+        if (!out) return 1;
+
+        int rc = 0;
+        bool first = true;
+        for (const auto &program : source.programs) {
+            std::string rate_opt, period_opt;
+            for (const auto &p : program.lang_opts) {
+                if (p.first != name) continue;
+                for (const auto &o : p.second) {
+                    if (o.first == "rate") rate_opt = o.second;
+                    else if (o.first == "period") period_opt = o.second;
+                    else std::cerr << "warning: unknown timing lang_opt '" << o.first << "' ignored\n";
+                }
+            }
+            double program_sysclk = sysclk ? sysclk : program.pio_version ? 150e6 : 125e6;
+            bool clkdiv_declared = clkdiv_override || program.clock_div_int != 1 || program.clock_div_frac != 0;
+            double clkdiv = clkdiv_override ? clkdiv_override : program.clock_div_int + program.clock_div_frac / 256.0;
+
+            if (!first) fprintf(out, "\n");
+            first = false;
+            fprintf(out, "program %s (system clock %.0f Hz, clock divider %g)\n\n", program.name.c_str(), program_sysclk, clkdiv);
+
+            pio_timing timing(program);
+            for (uint i = 0; i < program.instructions.size(); i++) {
+                const auto &info = timing.instructions[i];
+                std::string dis = disassemble(program.instructions[i], program.sideset_bits_including_opt.get(), program.sideset_opt);
+                fprintf(out, "  %2d: %-40s %3d%s\n", i, dis.c_str(), info.cycles, flags(info.may_stall, info.dynamic).c_str());
+            }
+
+            fprintf(out, "\n  %-16s %-16s %6s %6s\n", "from", "to", "min", "max");
+            for (const auto &p : timing.paths) {
+                fprintf(out, "  %-16s %-16s %6d %6d%s%s\n", timing.point_name(p.from).c_str(), timing.point_name(p.to).c_str(),
+                        p.min_cycles, p.max_cycles, flags(p.may_stall, p.dynamic).c_str(), p.via_wrap ? " (via .wrap)" : "");
+            }
+            if (timing.wrap_loop_found) {
+                fprintf(out, "\n  .wrap loop: %d..%d cycles per wrap iteration (each inner loop taken at most once)%s\n",
+                        timing.wrap_loop_min, timing.wrap_loop_max, flags(timing.wrap_loop_may_stall, timing.wrap_loop_dynamic).c_str());
+            }
+
+            // the period is a loop through the named label, or else one iteration of the .wrap loop
+            bool have_period = false;
+            uint period_min = 0, period_max = 0;
+            bool period_stall = false;
+            std::string period_name;
+            if (!period_opt.empty()) {
+                for (const auto &p : timing.paths) {
+                    if (p.from == p.to && timing.point_name(p.from) == period_opt) {
+                        have_period = true;
+                        period_min = p.min_cycles;
+                        period_max = p.max_cycles;
+                        period_stall = p.may_stall;
+                        period_name = period_opt + " loop";
+                    }
+                }
+                if (!have_period) {
+                    std::cerr << "warning: program '" << program.name << "': no loop through label '" << period_opt << "' for the timing period\n";
+                }
+            } else if (timing.wrap_loop_found) {
+                have_period = true;
+                period_min = timing.wrap_loop_min;
+                period_max = timing.wrap_loop_max;
+                period_stall = timing.wrap_loop_may_stall;
+                period_name = "one .wrap iteration";
+            }
+            if (!have_period) continue;
+
+            fprintf(out, "\n  period (%s): ", period_name.c_str());
+            for (uint cycles : {period_min, period_max}) {
+                fprintf(out, "%d cycles = %.1f ns (%.0f Hz)", cycles, cycles * clkdiv * 1e9 / program_sysclk,
+                        program_sysclk / (cycles * clkdiv));
+                if (cycles == period_max) break;
+                fprintf(out, " to ");
+            }
+            fprintf(out, "\n");
+            if (period_min != period_max || period_stall) {
+                std::cerr << "warning: program '" << program.name << "': the period (" << period_name << ") does not take a fixed number of cycles\n";
+            }
+
+            if (!rate_opt.empty()) {
+                double rate;
+                if (!parse_double(rate_opt, rate) || rate <= 0) {
+                    std::cerr << "error: program '" << program.name << "': invalid timing rate '" << rate_opt << "'\n";
+                    rc = 1;
+                    continue;
+                }
+                double needed = program_sysclk / (rate * period_max);
+                fprintf(out, "  rate %.0f Hz requires clock divider %.4f\n", rate, needed);
+                if (needed < 1.0) {
+                    std::cerr << "warning: program '" << program.name << "' cannot reach " << hz(rate) << " at a "
+                              << hz(program_sysclk) << " system clock (" << period_max << " cycles per period)\n";
+                } else if (needed >= 65536.0) {
+                    std::cerr << "warning: program '" << program.name << "' cannot run as slowly as " << hz(rate) << "\n";
+                } else if (clkdiv_declared) {
+                    double actual = program_sysclk / (clkdiv * period_max);
+                    if (std::fabs(actual - rate) > rate * 0.01) {
+                        std::cerr << "warning: program '" << program.name << "' runs at " << hz(actual) << " with clock divider "
+                                  << clkdiv << ", not the declared " << hz(rate) << "\n";
+                    }
+                }
+            }
+        }
+        if (out != stdout) { fclose(out); }
+        return rc;
+    }
+};
+
+static timing_output::factory creator;
@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Attribute a pico_xip_profile histogram (the output of xip_profile_dump()) to the functions in an ELF file,
+# and list the hottest ones, or choose which to move out of XIP flash within a budget of bytes:
+#
+#   report - a table of functions by number of samples
+#   pins   - C source for a function which pins the chosen functions in the XIP cache with xip_cache_pin_range()
+#            (RP2350 only). A function needing a cache line already pinned for a different address (i.e. one at the
+#            same offset modulo the cache size) is skipped, as pinning one would evict the other.
+#   ld     - a linker script fragment of input section descriptions for the chosen functions, for use in a custom
+#            linker script, within an output section in RAM that precedes the one which holds .text* in flash.
+#            This relies on the code having been compiled with -ffunction-sections, as it is by default.
+#
+# Functions are chosen in order of samples per byte. Usage:
+#
+#   xip_profile.py app.elf capture.txt [--format report|pins|ld] [--budget BYTES] [--top N]
+#
+# capture.txt is e.g. a log of the serial output; anything outside the xip_profile: lines is ignored, and if
+# it contains several dumps, they are added together.
+
+import argparse
+import re
+import struct
+import sys
+
+XIP_BASE = 0x10000000
+XIP_CACHE_SIZE = 16 * 1024
+XIP_CACHE_LINE_SIZE = 8
+
+EM_ARM = 40
+SHT_SYMTAB = 2
+STT_FUNC = 2
+
+
+class Function:
+    def __init__(self, name, address, size):
+        self.name = name
+        self.address = address
+        self.size = size
+        self.samples = 0.0
+
+
+def read_functions(elf_filename):
+    with open(elf_filename, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 1 or elf[5] != 1:
+        sys.exit(f"{elf_filename}: not a 32-bit little-endian ELF file")
+    e_machine, = struct.unpack_from("<H", elf, 18)
+    e_shoff, = struct.unpack_from("<I", elf, 32)
+    e_shentsize, e_shnum = struct.unpack_from("<HH", elf, 46)
+    sections = [struct.unpack_from("<IIIIIIIIII", elf, e_shoff + i * e_shentsize) for i in range(e_shnum)]
+    functions = {}
+    for sh_name, sh_type, _, _, sh_offset, sh_size, sh_link, _, _, sh_entsize in sections:
+        if sh_type != SHT_SYMTAB:
+            continue
+        strtab_offset = sections[sh_link][4]
+        for offset in range(sh_offset, sh_offset + sh_size, sh_entsize):
+            st_name, st_value, st_size, st_info, _, st_shndx = struct.unpack_from("<IIIBBH", elf, offset)
+            if st_info & 0xf != STT_FUNC or not st_size:
+                continue
+            end = elf.index(b"\0", strtab_offset + st_name)
+            name = elf[strtab_offset + st_name:end].decode(errors="replace")
+            if e_machine == EM_ARM:
+                # clear the Thumb bit
+                st_value &= ~1
+            # aliases share an address; keep the first name
+            functions.setdefault(st_value, Function(name, st_value, st_size))
+    return sorted(functions.values(), key=lambda fn: fn.address)
+
+
+def read_profile(profile_filename):
+    header = re.compile(r"xip_profile: base=(0x[0-9a-fA-F]+) shift=(\d+) samples=(\d+) other=(\d+)")
+    bucket = re.compile(r"^\s*(0x[0-9a-fA-F]+) (\d+)\s*$")
+    counts = {}
+    shift = None
+    samples = other = 0
+    in_dump = False
+    with open(profile_filename, errors="replace") as f:
+        for line in f:
+            m = header.search(line)
+            if m:
+                if shift is not None and int(m.group(2)) != shift:
+                    sys.exit(f"{profile_filename}: dumps have different bucket sizes")
+                shift = int(m.group(2))
+                samples += int(m.group(3))
+                other += int(m.group(4))
+                in_dump = True
+            elif "xip_profile: end" in line:
+                in_dump = False
+            elif in_dump:
+                m = bucket.match(line)
+                if m:
+                    address = int(m.group(1), 16)
+                    counts[address] = counts.get(address, 0) + int(m.group(2))
+    if shift is None:
+        sys.exit(f"{profile_filename}: no xip_profile dump found")
+    return counts, 1 << shift, samples, other
+
+
+def attribute(functions, counts, bucket_size):
+    # a bucket's samples are shared between the functions which overlap it, in proportion to the overlap
+    starts = [fn.address for fn in functions]
+    unattributed = 0.0
+    for address, count in counts.items():
+        end = address + bucket_size
+        # find the first function which could overlap the bucket
+        lo, hi = 0, len(functions)
+        while lo < hi:
+            mid = (lo + hi) // 2
+            if functions[mid].address + functions[mid].size <= address:
+                lo = mid + 1
+            else:
+                hi = mid
+        attributed = 0.0
+        i = lo
+        while i < len(functions) and starts[i] < end:
+            fn = functions[i]
+            overlap = min(end, fn.address + fn.size) - max(address, fn.address)
+            if overlap > 0:
+                share = count * overlap / bucket_size
+                fn.samples += share
+                attributed += share
+            i += 1
+        unattributed += count - attributed
+    return unattributed
+
+
+def cache_lines(fn):
+    start = fn.address & ~(XIP_CACHE_LINE_SIZE - 1)
+    end = (fn.address + fn.size + XIP_CACHE_LINE_SIZE - 1) & ~(XIP_CACHE_LINE_SIZE - 1)
+    return start, end
+
+
+def choose(functions, budget, pins):
+    chosen = []
+    used = 0
+    # for pins, the line address pinned at each cache line index
+    pinned = {}
+    for fn in sorted(functions, key=lambda fn: fn.samples / fn.size, reverse=True):
+        if not fn.samples:
+            break
+        if pins:
+            start, end = cache_lines(fn)
+            if not XIP_BASE <= fn.address < XIP_BASE + 0x4000000:
+                continue
+            lines = {(a - XIP_BASE) % XIP_CACHE_SIZE: a for a in range(start, end, XIP_CACHE_LINE_SIZE)}
+            # a line may already be pinned for a neighbouring function, but not for another address
+            if any(pinned.get(index, a) != a for index, a in lines.items()):
+                continue
+            size = XIP_CACHE_LINE_SIZE * sum(index not in pinned for index in lines)
+        else:
+            size = fn.size
+        if used + size > budget:
+            continue
+        if pins:
+            pinned.update(lines)
+        chosen.append(fn)
+        used += size
+    return chosen
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Attribute a pico_xip_profile histogram to functions")
+    parser.add_argument("elf", help="ELF file of the profiled binary")
+    parser.add_argument("profile", help="captured output of xip_profile_dump()")
+    parser.add_argument("--format", choices=["report", "pins", "ld"], default="report", help="output format")
+    parser.add_argument("--budget", type=int, default=4096,
+                        help="maximum number of bytes of functions to choose for pins or ld (default 4096)")
+    parser.add_argument("--top", type=int, default=30, help="number of functions in the report (default 30)")
+    parser.add_argument("--function-name", default="xip_profile_pin_hot_functions",
+                        help="name of the function generated by the pins format")
+    parser.add_argument("-o", "--output", help="output file (default stdout)")
+    args = parser.parse_args()
+
+    functions = read_functions(args.elf)
+    counts, bucket_size, samples, other = read_profile(args.profile)
+    unattributed = attribute(functions, counts, bucket_size)
+    if not samples:
+        sys.exit(f"{args.profile}: no samples")
+
+    out = open(args.output, "w") if args.output else sys.stdout
+    if args.format == "report":
+        hot = sorted((fn for fn in functions if fn.samples), key=lambda fn: fn.samples, reverse=True)
+        out.write(f"{samples} samples, {other} ({100 * other / samples:.1f}%) outside flash, "
+                  f"{unattributed:.0f} ({100 * unattributed / samples:.1f}%) in flash but not in a function\n")
+        out.write(f"{'samples':>9} {'%':>6} {'cum %':>6} {'size':>6}  {'address':10}  function\n")
+        total = 0.0
+        for fn in hot[:args.top]:
+            total += fn.samples
+            out.write(f"{fn.samples:9.0f} {100 * fn.samples / samples:6.2f} {100 * total / samples:6.2f} "
+                      f"{fn.size:6}  0x{fn.address:08x}  {fn.name}\n")
+    else:
+        chosen = choose(functions, args.budget, args.format == "pins")
+        covered = sum(fn.samples for fn in chosen)
+        summary = (f"{len(chosen)} functions, {sum(fn.size for fn in chosen)} bytes, "
+                   f"{100 * covered / samples:.1f}% of samples")
+        if args.format == "pins":
+            out.write(f"// Generated by xip_profile.py from {args.elf}: {summary}\n")
+            out.write('#include "hardware/xip_cache.h"\n\n')
+            out.write(f"void {args.function_name}(void) {{\n")
+            for fn in sorted(chosen, key=lambda fn: fn.address):
+                start, end = cache_lines(fn)
+                out.write(f"    xip_cache_pin_range(0x{start - XIP_BASE:08x}, 0x{end - start:x}); "
+                          f"// {fn.name}: {fn.samples:.0f} samples\n")
+            out.write("}\n")
+        else:
+            out.write(f"/* Generated by xip_profile.py from {args.elf}: {summary} */\n")
+            for fn in chosen:
+                out.write(f"*(.text.{fn.name}) /* {fn.samples:.0f} samples */\n")
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
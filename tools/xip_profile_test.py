@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2024 Raspberry Pi (Trading) Ltd.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Tests for xip_profile.py, using a minimal ELF file and capture generated here, so no toolchain is needed:
+#
+#   python3 tools/xip_profile_test.py
+
+import os
+import struct
+import sys
+import tempfile
+import unittest
+from unittest import mock
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import xip_profile
+
+STT_OBJECT = 1
+
+# (name, address, size, type); bar and baz are a cache size apart, so cannot both be pinned
+SYMBOLS = (
+    ("foo", 0x10000100 | 1, 0x48, xip_profile.STT_FUNC),   # Thumb bit set, as in a real Arm ELF file
+    ("foo_alias", 0x10000100 | 1, 0x48, xip_profile.STT_FUNC),
+    ("bar", 0x10000148 | 1, 0x18, xip_profile.STT_FUNC),
+    ("baz", 0x10004148 | 1, 0x18, xip_profile.STT_FUNC),
+    ("no_size", 0x10000200 | 1, 0, xip_profile.STT_FUNC),
+    ("data", 0x10003000, 0x100, STT_OBJECT),
+)
+
+# two dumps with noise around them; 16 byte buckets
+CAPTURE = """\
+boot message
+xip_profile: base=0x10000000 shift=4 samples=40 other=2
+0x10000100 10
+0x10000140 4
+0x10000150 20
+xip_profile: end
+0x10000150 1000
+xip_profile: base=0x10000000 shift=4 samples=41 other=1
+0x10000150 10
+0x10004150 20
+0x10002000 5
+xip_profile: end
+"""
+
+
+def build_elf(symbols):
+    strtab = b"\0"
+    symtab = bytes(16)
+    for name, address, size, sym_type in symbols:
+        symtab += struct.pack("<IIIBBH", len(strtab), address, size, sym_type, 0, 1)
+        strtab += name.encode() + b"\0"
+    symtab_offset = 52
+    strtab_offset = symtab_offset + len(symtab)
+    shoff = (strtab_offset + len(strtab) + 3) & ~3
+    header = b"\x7fELF\x01\x01\x01" + bytes(9)
+    header += struct.pack("<HHIIIIIHHHHHH", 2, xip_profile.EM_ARM, 1, 0, 0, shoff, 0, 52, 0, 0, 40, 3, 0)
+    sections = bytes(40)
+    sections += struct.pack("<IIIIIIIIII", 0, xip_profile.SHT_SYMTAB, 0, 0, symtab_offset, len(symtab), 2, 1, 4, 16)
+    sections += struct.pack("<IIIIIIIIII", 0, 3, 0, 0, strtab_offset, len(strtab), 0, 0, 1, 0)
+    return (header + symtab + strtab).ljust(shoff, b"\0") + sections
+
+
+class XipProfileTest(unittest.TestCase):
+    def setUp(self):
+        self.dir = tempfile.TemporaryDirectory()
+        self.elf = os.path.join(self.dir.name, "test.elf")
+        self.capture = os.path.join(self.dir.name, "capture.txt")
+        with open(self.elf, "wb") as f:
+            f.write(build_elf(SYMBOLS))
+        with open(self.capture, "w") as f:
+            f.write(CAPTURE)
+
+    def tearDown(self):
+        self.dir.cleanup()
+
+    def attributed_functions(self):
+        functions = xip_profile.read_functions(self.elf)
+        counts, bucket_size, _, _ = xip_profile.read_profile(self.capture)
+        unattributed = xip_profile.attribute(functions, counts, bucket_size)
+        return {fn.name: fn for fn in functions}, unattributed
+
+    def run_main(self, *args):
+        output = os.path.join(self.dir.name, "out.txt")
+        with mock.patch.object(sys, "argv", ["xip_profile.py", self.elf, self.capture, "-o", output, *args]):
+            xip_profile.main()
+        with open(output) as f:
+            return f.read().splitlines()
+
+    def test_read_functions(self):
+        functions = xip_profile.read_functions(self.elf)
+        # Thumb bit cleared, aliases, zero sized functions and data dropped
+        self.assertEqual([(fn.name, fn.address, fn.size) for fn in functions],
+                         [("foo", 0x10000100, 0x48), ("bar", 0x10000148, 0x18), ("baz", 0x10004148, 0x18)])
+
+    def test_read_profile(self):
+        counts, bucket_size, samples, other = xip_profile.read_profile(self.capture)
+        self.assertEqual(bucket_size, 16)
+        self.assertEqual((samples, other), (81, 3))
+        # the dumps are added together, and the line between them ignored
+        self.assertEqual(counts, {0x10000100: 10, 0x10000140: 4, 0x10000150: 30, 0x10004150: 20, 0x10002000: 5})
+
+    def test_attribute(self):
+        functions, unattributed = self.attributed_functions()
+        # the bucket at 0x10000140 is split evenly between the end of foo and the start of bar
+        self.assertAlmostEqual(functions["foo"].samples, 10 + 2)
+        self.assertAlmostEqual(functions["bar"].samples, 30 + 2)
+        self.assertAlmostEqual(functions["baz"].samples, 20)
+        self.assertAlmostEqual(unattributed, 5)
+
+    def test_pins(self):
+        lines = self.run_main("--format", "pins", "--function-name", "pin_hot")
+        self.assertIn("void pin_hot(void) {", lines)
+        pins = [line.strip() for line in lines if "xip_cache_pin_range" in line]
+        # baz is hotter per byte than foo, but needs the cache lines pinned for bar
+        self.assertEqual(pins, [
+            "xip_cache_pin_range(0x00000100, 0x48); // foo: 12 samples",
+            "xip_cache_pin_range(0x00000148, 0x18); // bar: 32 samples",
+        ])
+
+    def test_pins_budget(self):
+        lines = self.run_main("--format", "pins", "--budget", "24")
+        pins = [line.strip() for line in lines if "xip_cache_pin_range" in line]
+        self.assertEqual(pins, ["xip_cache_pin_range(0x00000148, 0x18); // bar: 32 samples"])
+
+    def test_ld(self):
+        lines = self.run_main("--format", "ld")
+        # in order of samples per byte; there are no cache line conflicts to skip
+        self.assertEqual(lines[1:], [
+            "*(.text.bar) /* 32 samples */",
+            "*(.text.baz) /* 20 samples */",
+            "*(.text.foo) /* 12 samples */",
+        ])
+
+
+if __name__ == "__main__":
+    unittest.main()